@@ -6,6 +6,7 @@
 
 #include <userver/storages/clickhouse/cluster.hpp>
 #include <userver/storages/clickhouse/component.hpp>
+#include <userver/storages/clickhouse/cursor.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 #include <userver/storages/clickhouse/query.hpp>
@@ -20,6 +21,7 @@
 /// - Connection pooling;
 /// - Variadic template query parameter passing;
 /// - Query result extraction to C++ types;
+/// - Streaming of big query results block by block with backpressure;
 /// - Mapping C++ types to native ClickHouse types.
 ///
 /// @section info More information
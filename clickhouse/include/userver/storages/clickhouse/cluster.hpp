@@ -11,6 +11,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
 
+#include <userver/storages/clickhouse/cursor.hpp>
 #include <userver/storages/clickhouse/fwd.hpp>
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 #include <userver/storages/clickhouse/impl/pool.hpp>
@@ -60,6 +61,26 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters and stream its result block by block.
+  ///
+  /// The result is not materialized in memory: see
+  /// storages::clickhouse::Cursor for details.
+  template <typename... Args>
+  Cursor ExecuteStreaming(const Query& query, const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters and stream its
+  /// result block by block.
+  ///
+  /// The result is not materialized in memory: see
+  /// storages::clickhouse::Cursor for details.
+  /// @note execute timeout limits the whole streaming, including the time
+  /// spent on processing the blocks already received.
+  template <typename... Args>
+  Cursor ExecuteStreaming(OptionalCommandControl, const Query& query,
+                          const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -131,6 +152,8 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  Cursor DoExecuteStreaming(OptionalCommandControl, const Query& query) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -189,6 +212,20 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename... Args>
+Cursor Cluster::ExecuteStreaming(const Query& query,
+                                 const Args&... args) const {
+  return ExecuteStreaming(OptionalCommandControl{}, query, args...);
+}
+
+template <typename... Args>
+Cursor Cluster::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                 const Query& query,
+                                 const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  return DoExecuteStreaming(optional_cc, formatted_query);
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,83 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/cursor.hpp
+/// @brief @copybrief storages::clickhouse::Cursor
+
+#include <memory>
+#include <optional>
+
+#include <userver/storages/clickhouse/execution_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+class CursorImpl;
+}
+
+// clang-format off
+
+/// @brief Streaming accessor for a result of a query, returned by
+/// storages::clickhouse::Cluster ExecuteStreaming methods.
+///
+/// Blocks of the result are yielded one by one as the driver receives them
+/// from the server, so memory consumption doesn't depend on the overall size
+/// of the result. Only a couple of blocks are buffered ahead: while the cursor
+/// is not read the driver doesn't read from the connection either.
+///
+/// The cursor holds a connection until the result is exhausted. Destroying
+/// the cursor before that cancels the query and drops the connection.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/cursor_chtest.cpp  Sample Cursor usage
+
+// clang-format on
+class Cursor final {
+ public:
+  explicit Cursor(std::unique_ptr<impl::CursorImpl>&&);
+  Cursor(Cursor&&) noexcept;
+  ~Cursor();
+
+  /// Waits for the next block of the result, returns std::nullopt once the
+  /// result is exhausted.
+  /// @throws the query execution error, if any
+  std::optional<ExecutionResult> NextBlock();
+
+  /// Waits for the next block of the result and converts it to strongly-typed
+  /// struct of vectors, returns std::nullopt once the result is exhausted.
+  /// See @ref clickhouse_io for better understanding of `T`'s requirements.
+  template <typename T>
+  std::optional<T> NextAs();
+
+  /// Waits for the next block of the result and converts it to strongly-typed
+  /// container, returns std::nullopt once the result is exhausted.
+  /// See @ref clickhouse_io for better understanding
+  /// of `Container::value_type`'s requirements.
+  template <typename Container>
+  std::optional<Container> NextAsContainer();
+
+ private:
+  std::unique_ptr<impl::CursorImpl> impl_;
+};
+
+template <typename T>
+std::optional<T> Cursor::NextAs() {
+  auto block = NextBlock();
+  if (!block.has_value()) return std::nullopt;
+
+  return std::move(*block).As<T>();
+}
+
+template <typename Container>
+std::optional<Container> Cursor::NextAsContainer() {
+  auto block = NextBlock();
+  if (!block.has_value()) return std::nullopt;
+
+  return std::move(*block).AsContainer<Container>();
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,26 @@
+#include <userver/storages/clickhouse/cursor.hpp>
+
+#include <storages/clickhouse/impl/cursor_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+Cursor::Cursor(std::unique_ptr<impl::CursorImpl>&& impl)
+    : impl_{std::move(impl)} {}
+
+Cursor::Cursor(Cursor&&) noexcept = default;
+
+Cursor::~Cursor() = default;
+
+std::optional<ExecutionResult> Cursor::NextBlock() {
+  UASSERT(impl_);
+  auto block = impl_->Next();
+  if (!block) return std::nullopt;
+
+  return ExecutionResult{std::move(block)};
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -104,6 +104,28 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteStreaming(
+    OptionalCommandControl optional_cc, const Query& query,
+    const std::function<bool(BlockWrapperPtr&&)>& on_block) {
+  clickhouse_cpp::Query native_query{query.QueryText()};
+
+  auto& span = tracing::Span::CurrentSpan();
+  auto scope = span.CreateScopeTime(scopes::kExec);
+
+  native_query.OnDataCancelable([&on_block, &scope](const NativeBlock& data) {
+    // we must return 'true' if we don't want to cancel query
+    if (engine::current_task::ShouldCancel()) return false;
+    if (data.GetRowCount() == 0) return true;
+
+    scope.Reset(scopes::kExec);
+    // columns are shared between the copies, so this doesn't copy the data
+    auto block_ptr = std::make_unique<BlockWrapper>(NativeBlock{data});
+    return on_block(BlockWrapperPtr{block_ptr.release()});
+  });
+
+  DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
@@ -2,6 +2,8 @@
 
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
+#include <functional>
+
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/options.hpp>
@@ -28,6 +30,11 @@ class Connection final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  // Calls `on_block` for every non-empty block of the result as it arrives,
+  // `on_block` returning false cancels the query.
+  void ExecuteStreaming(OptionalCommandControl, const Query&,
+                        const std::function<bool(BlockWrapperPtr&&)>& on_block);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
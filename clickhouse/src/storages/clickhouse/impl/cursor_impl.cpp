@@ -0,0 +1,37 @@
+#include "cursor_impl.hpp"
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+CursorImpl::CursorImpl(std::shared_ptr<Queue>&& queue,
+                       engine::TaskWithResult<void>&& task)
+    : consumer_{queue->GetConsumer()}, task_{std::move(task)} {}
+
+CursorImpl::~CursorImpl() {
+  // The query is still running if the result is not exhausted: the task gets
+  // cancelled in the middle of reading from the connection, which breaks the
+  // connection and it won't be returned to the pool.
+  if (task_.IsValid() && !task_.IsFinished()) {
+    task_.SyncCancel();
+  }
+}
+
+BlockWrapperPtr CursorImpl::Next() {
+  BlockWrapperPtr block;
+  if (consumer_.Pop(block)) {
+    return block;
+  }
+
+  // Producer is dead, so the query is done: rethrow its error, if any
+  if (task_.IsValid()) {
+    task_.Get();
+  }
+  return nullptr;
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
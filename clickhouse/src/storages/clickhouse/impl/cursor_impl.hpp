@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+// Blocks are pushed by a task executing the query and popped by the user.
+// The queue is bounded, so the executing task stops reading from the
+// connection while the queue is full.
+class CursorImpl final {
+ public:
+  using Queue = concurrent::SpscQueue<BlockWrapperPtr>;
+
+  CursorImpl(std::shared_ptr<Queue>&& queue,
+             engine::TaskWithResult<void>&& task);
+  ~CursorImpl();
+
+  // Returns nullptr once the result is exhausted
+  BlockWrapperPtr Next();
+
+ private:
+  Queue::Consumer consumer_;
+  engine::TaskWithResult<void> task_;
+};
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -4,9 +4,11 @@
 
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/async.hpp>
 
 #include <storages/clickhouse/impl/connection.hpp>
 #include <storages/clickhouse/impl/connection_ptr.hpp>
+#include <storages/clickhouse/impl/cursor_impl.hpp>
 #include <storages/clickhouse/impl/pool_impl.hpp>
 #include <storages/clickhouse/impl/tracing_tags.hpp>
 #include <userver/formats/json/value_builder.hpp>
@@ -17,6 +19,10 @@ namespace storages::clickhouse::impl {
 
 namespace {
 
+// Blocks are usually big enough, so we only buffer a couple of them
+// ahead of the consumer.
+constexpr std::size_t kCursorMaxBufferedBlocks = 2;
+
 tracing::Span PrepareExecutionSpan(const std::string& scope,
                                    const std::string& db_instance) {
   tracing::Span span{scope};
@@ -45,6 +51,36 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc,
   return conn_ptr->Execute(optional_cc, query);
 }
 
+Cursor Pool::ExecuteStreaming(OptionalCommandControl optional_cc,
+                              const Query& query) const {
+  auto conn_ptr = impl_->Acquire();
+
+  auto queue = CursorImpl::Queue::Create(kCursorMaxBufferedBlocks);
+  auto task = USERVER_NAMESPACE::utils::Async(
+      impl::scopes::kQuery,
+      [pool = impl_, conn_ptr = std::move(conn_ptr), optional_cc, query,
+       producer = queue->GetProducer()]() mutable {
+        // Producer is destroyed on exit from the task no matter what,
+        // so that the cursor could detect the end of the result
+        const auto local_producer = std::move(producer);
+
+        auto& span = tracing::Span::CurrentSpan();
+        span.AddTag(tracing::kDatabaseInstance, pool->GetHostName());
+        query.FillSpanTags(span);
+
+        const auto timer = pool->GetExecuteTimer();
+        conn_ptr->ExecuteStreaming(
+            optional_cc, query, [&local_producer](BlockWrapperPtr&& block) {
+              // Blocks while the cursor is behind: the connection is not read
+              // until the callback returns. Fails if the cursor is gone.
+              return local_producer.Push(std::move(block));
+            });
+      });
+
+  return Cursor{
+      std::make_unique<CursorImpl>(std::move(queue), std::move(task))};
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc,
                   const InsertionRequest& request) const {
   auto conn_ptr = impl_->Acquire();
@@ -0,0 +1,88 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/storages/clickhouse/cursor.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kRowsCount = 100000;
+constexpr std::size_t kBlockSize = 1000;
+
+const storages::clickhouse::Query streaming_query{
+    "SELECT number FROM numbers(0, {}) SETTINGS max_block_size = {}"};
+
+struct Data final {
+  std::vector<uint64_t> numbers;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Data> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(Cursor, StreamsWholeResult) {
+  ClusterWrapper cluster{};
+
+  /// [Sample Cursor usage]
+  auto cursor =
+      cluster->ExecuteStreaming(streaming_query, kRowsCount, kBlockSize);
+
+  std::size_t blocks_count = 0;
+  std::size_t rows_count = 0;
+  uint64_t sum = 0;
+  while (auto block = cursor.NextAs<Data>()) {
+    ++blocks_count;
+    rows_count += block->numbers.size();
+    for (const auto number : block->numbers) sum += number;
+  }
+  /// [Sample Cursor usage]
+
+  EXPECT_GT(blocks_count, 1);
+  EXPECT_EQ(rows_count, kRowsCount);
+  EXPECT_EQ(sum, kRowsCount * (kRowsCount - 1) / 2);
+  EXPECT_FALSE(cursor.NextBlock().has_value());
+}
+
+UTEST(Cursor, EmptyResult) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteStreaming(streaming_query, 0, kBlockSize);
+  EXPECT_FALSE(cursor.NextBlock().has_value());
+}
+
+UTEST(Cursor, RethrowsErrors) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteStreaming(
+      storages::clickhouse::Query{"SELECT * FROM non_existent_table"});
+  UEXPECT_THROW(cursor.NextBlock(), std::exception);
+}
+
+UTEST(Cursor, EarlyDestructionCancelsQuery) {
+  ClusterWrapper cluster{};
+
+  {
+    auto cursor = cluster->ExecuteStreaming(streaming_query, 100 * kRowsCount,
+                                            kBlockSize);
+    const auto block = cursor.NextAs<Data>();
+    ASSERT_TRUE(block.has_value());
+    EXPECT_EQ(block->numbers.size(), kBlockSize);
+  }
+
+  auto cursor = cluster->ExecuteStreaming(streaming_query, 1, kBlockSize);
+  const auto block = cursor.NextAs<Data>();
+  ASSERT_TRUE(block.has_value());
+  EXPECT_EQ(block->numbers, std::vector<uint64_t>{0});
+}
+
+USERVER_NAMESPACE_END
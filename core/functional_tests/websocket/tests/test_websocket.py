@@ -70,6 +70,33 @@ async def test_origin(service_client, service_port):
         assert response == 'localhost'
 
 
+def _response_headers(chat):
+    # websockets >= 14 keeps the handshake response in `response`
+    response = getattr(chat, 'response', None)
+    return response.headers if response else chat.response_headers
+
+
+async def test_deflate(websocket_client):
+    async with websocket_client.get('chat') as chat:
+        extensions = _response_headers(chat)['Sec-WebSocket-Extensions']
+        assert extensions.startswith('permessage-deflate')
+
+        msg = 'hello' * 10000
+        await chat.send(msg)
+        response = await chat.recv()
+        assert response == msg
+
+
+async def test_no_deflate(service_client, service_port):
+    async with websockets.connect(
+            f'ws://localhost:{service_port}/chat', compression=None,
+    ) as chat:
+        assert 'Sec-WebSocket-Extensions' not in _response_headers(chat)
+        await chat.send('hello')
+        response = await chat.recv()
+        assert response == 'hello'
+
+
 async def test_duplex(websocket_client):
     async with websocket_client.get('duplex') as chat:
         await chat.send('ping')
@@ -29,6 +29,10 @@ struct UpdateStatistics final {
   std::atomic<std::chrono::steady_clock::time_point>
       last_successful_update_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+  std::atomic<std::chrono::milliseconds> last_update_slowest_partition_duration{
+      {}};
+  // Whether any update was loaded in partitions
+  std::atomic<bool> is_partitioned{false};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -83,6 +87,12 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Each part of an `Update` loaded in parallel with others should be
+  /// accounted with this function, the slowest one is reported
+  /// @note This method can be called concurrently
+  /// @param duration the time it took to load the part
+  void AccountPartitionDuration(std::chrono::milliseconds duration);
+
  private:
   void DoFinish(impl::UpdateState new_state);
 
@@ -90,6 +100,8 @@ class UpdateStatisticsScope final {
   impl::UpdateStatistics& update_stats_;
   impl::UpdateState state_{impl::UpdateState::kNotFinished};
   const std::chrono::steady_clock::time_point update_start_time_;
+  std::atomic<std::chrono::milliseconds> slowest_partition_duration_{{}};
+  std::atomic<bool> has_partitions_{false};
 };
 
 }  // namespace cache
@@ -71,6 +71,10 @@ class ExpirableLruCache final {
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
                     const Equal& equal = Equal());
 
+  /// Creates a cache with the `policy` eviction in each of the ways
+  ExpirableLruCache(size_t ways, size_t way_size, CachePolicy policy,
+                    const Hash& hash = Hash(), const Equal& equal = Equal());
+
   ~ExpirableLruCache();
 
   void SetWaySize(size_t way_size);
@@ -168,7 +172,13 @@ class ExpirableLruCache final {
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
+    : ExpirableLruCache(ways, way_size, CachePolicy::kLRU, hash, equal) {}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
+    size_t ways, size_t way_size, CachePolicy policy, const Hash& hash,
+    const Equal& equal)
+    : lru_(ways, way_size, policy, hash, equal),
       mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
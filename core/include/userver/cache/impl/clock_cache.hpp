@@ -0,0 +1,510 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <userver/cache/impl/read_epoch.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// @brief Hash map with the CLOCK eviction and lock-free lookups.
+///
+/// Open addressing table of pointers to immutable nodes. Lookups only set
+/// the access bit of the found node, the eviction clears the bits with its
+/// hand until it finds a node that was not accessed since the previous pass.
+/// Updates replace the node, the unlinked nodes and tables are freed once no
+/// reader may see them, see ReadEpoch.
+///
+/// Visit() and GetSize() may be called concurrently with anything, the rest of
+/// the methods must be serialized by the caller.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ClockMap final {
+ public:
+  ClockMap(std::size_t max_size, ReadEpoch& epoch, const Hash& hash = Hash(),
+           const Equal& equal = Equal());
+  ~ClockMap();
+
+  ClockMap(ClockMap&&) = delete;
+  ClockMap& operator=(ClockMap&&) = delete;
+
+  /// Calls `func(const U&)` for the value of the key, returns false if there
+  /// is no such key
+  template <typename Function>
+  bool Visit(const T& key, Function&& func) const;
+
+  void Put(const T& key, U value);
+
+  /// Erases the key if `predicate(const U&)` returns true for its value
+  template <typename Predicate>
+  void EraseIf(const T& key, Predicate predicate);
+
+  void Erase(const T& key);
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear();
+
+  /// Calls `func(const T&, const U&)` for all the entries
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  std::size_t GetSize() const noexcept;
+
+ private:
+  struct Node final {
+    Node(T key, U value, std::size_t hash)
+        : key(std::move(key)), value(std::move(value)), hash(hash) {}
+
+    const T key;
+    const U value;
+    const std::size_t hash;
+    mutable std::atomic<bool> referenced{false};
+  };
+
+  struct Table final {
+    explicit Table(std::size_t buckets_count)
+        : buckets(std::make_unique<std::atomic<Node*>[]>(buckets_count)),
+          mask(buckets_count - 1) {}
+
+    std::unique_ptr<std::atomic<Node*>[]> buckets;
+    const std::size_t mask;
+  };
+
+  struct Retired final {
+    std::uint64_t epoch;
+    std::unique_ptr<Node> node;
+    std::unique_ptr<Table> table;
+  };
+
+  static constexpr std::size_t kReclaimBatch = 64;
+
+  // Marks the erased nodes, so that the lookups continue probing past them
+  static Node* Tombstone() noexcept {
+    return reinterpret_cast<Node*>(alignof(Node));
+  }
+
+  static bool IsLive(const Node* node) noexcept {
+    return node && node != Tombstone();
+  }
+
+  // Keeps at least a quarter of the buckets empty, so that probing is short
+  // and always terminates
+  static std::size_t GetBucketsCount(std::size_t max_size) noexcept;
+
+  static std::size_t GetMaxUsedBuckets(const Table& table) noexcept {
+    return (table.mask + 1) / 4 * 3;
+  }
+
+  // Fibonacci hashing, so that the keys of a way do not cluster in the table
+  // if the user provided hash is weak
+  static std::size_t GetBucket(std::size_t hash, const Table& table) noexcept {
+    const auto mixed = std::uint64_t{hash} * 0x9e3779b97f4a7c15ULL;
+    return static_cast<std::size_t>(mixed >> 32) & table.mask;
+  }
+
+  std::atomic<Node*>* Find(const T& key, std::size_t hash) const noexcept;
+  void Insert(std::unique_ptr<Node> node);
+  void Evict();
+  void Rebuild(std::size_t buckets_count);
+  void Unlink(std::atomic<Node*>& bucket);
+  void Retire(std::unique_ptr<Node> node, std::unique_ptr<Table> table);
+
+  ReadEpoch& epoch_;
+  Hash hash_;
+  Equal equal_;
+  std::atomic<Table*> table_;
+  std::atomic<std::size_t> size_{0};
+
+  // Writer side state
+  std::size_t max_size_;
+  std::size_t used_buckets_{0};
+  std::size_t hand_{0};
+  std::vector<Retired> retired_;
+  std::size_t next_reclaim_size_{kReclaimBatch};
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+ClockMap<T, U, Hash, Equal>::ClockMap(std::size_t max_size, ReadEpoch& epoch,
+                                      const Hash& hash, const Equal& equal)
+    : epoch_(epoch),
+      hash_(hash),
+      equal_(equal),
+      table_(new Table(GetBucketsCount(max_size))),
+      max_size_(std::max(max_size, std::size_t{1})) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+ClockMap<T, U, Hash, Equal>::~ClockMap() {
+  // No readers are left at this point
+  std::unique_ptr<Table> table(table_.load());
+  for (std::size_t i = 0; i <= table->mask; ++i) {
+    auto* node = table->buckets[i].load(std::memory_order_relaxed);
+    if (IsLive(node)) delete node;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+bool ClockMap<T, U, Hash, Equal>::Visit(const T& key, Function&& func) const {
+  const auto hash = hash_(key);
+  const auto guard = epoch_.Enter();
+
+  const auto* table = table_.load(std::memory_order_acquire);
+  for (auto i = GetBucket(hash, *table);; i = (i + 1) & table->mask) {
+    const auto* node = table->buckets[i].load(std::memory_order_acquire);
+    if (!node) return false;
+    if (node == Tombstone() || node->hash != hash || !equal_(node->key, key)) {
+      continue;
+    }
+
+    // Avoids bouncing the cache line of a hot node between the readers
+    if (!node->referenced.load(std::memory_order_relaxed)) {
+      node->referenced.store(true, std::memory_order_relaxed);
+    }
+    func(node->value);
+    return true;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Put(const T& key, U value) {
+  const auto hash = hash_(key);
+  auto node = std::make_unique<Node>(T{key}, std::move(value), hash);
+
+  auto* bucket = Find(key, hash);
+  if (bucket) {
+    auto* old = bucket->exchange(node.release(), std::memory_order_acq_rel);
+    Retire(std::unique_ptr<Node>(old), nullptr);
+    return;
+  }
+
+  if (size_.load(std::memory_order_relaxed) >= max_size_) Evict();
+  Insert(std::move(node));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Predicate>
+void ClockMap<T, U, Hash, Equal>::EraseIf(const T& key, Predicate predicate) {
+  auto* bucket = Find(key, hash_(key));
+  if (bucket && predicate(bucket->load(std::memory_order_relaxed)->value)) {
+    Unlink(*bucket);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Erase(const T& key) {
+  EraseIf(key, [](const U&) { return true; });
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  max_size_ = std::max(new_max_size, std::size_t{1});
+  while (size_.load(std::memory_order_relaxed) > max_size_) Evict();
+  Rebuild(GetBucketsCount(max_size_));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Clear() {
+  auto* table = table_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i <= table->mask; ++i) {
+    auto& bucket = table->buckets[i];
+    if (IsLive(bucket.load(std::memory_order_relaxed))) Unlink(bucket);
+  }
+  Rebuild(table->mask + 1);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ClockMap<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  const auto* table = table_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i <= table->mask; ++i) {
+    const auto* node = table->buckets[i].load(std::memory_order_relaxed);
+    if (IsLive(node)) func(node->key, node->value);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ClockMap<T, U, Hash, Equal>::GetSize() const noexcept {
+  return size_.load(std::memory_order_relaxed);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ClockMap<T, U, Hash, Equal>::GetBucketsCount(
+    std::size_t max_size) noexcept {
+  std::size_t buckets_count = 8;
+  while (buckets_count < max_size * 2) buckets_count <<= 1;
+  return buckets_count;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::atomic<typename ClockMap<T, U, Hash, Equal>::Node*>*
+ClockMap<T, U, Hash, Equal>::Find(const T& key,
+                                  std::size_t hash) const noexcept {
+  auto* table = table_.load(std::memory_order_relaxed);
+  for (auto i = GetBucket(hash, *table);; i = (i + 1) & table->mask) {
+    auto& bucket = table->buckets[i];
+    const auto* node = bucket.load(std::memory_order_relaxed);
+    if (!node) return nullptr;
+    if (node != Tombstone() && node->hash == hash && equal_(node->key, key)) {
+      return &bucket;
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Insert(std::unique_ptr<Node> node) {
+  auto* table = table_.load(std::memory_order_relaxed);
+  if (used_buckets_ >= GetMaxUsedBuckets(*table)) {
+    Rebuild(table->mask + 1);
+    table = table_.load(std::memory_order_relaxed);
+  }
+
+  // The key is not in the table, so the first free bucket is taken
+  for (auto i = GetBucket(node->hash, *table);; i = (i + 1) & table->mask) {
+    auto& bucket = table->buckets[i];
+    auto* old = bucket.load(std::memory_order_relaxed);
+    if (IsLive(old)) continue;
+
+    if (!old) ++used_buckets_;
+    bucket.store(node.release(), std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Evict() {
+  UASSERT(size_.load(std::memory_order_relaxed) > 0);
+  auto* table = table_.load(std::memory_order_relaxed);
+
+  // Terminates within two passes, as the first one clears all the bits
+  while (true) {
+    auto& bucket = table->buckets[hand_++ & table->mask];
+    const auto* node = bucket.load(std::memory_order_relaxed);
+    if (!IsLive(node)) continue;
+
+    if (node->referenced.load(std::memory_order_relaxed)) {
+      node->referenced.store(false, std::memory_order_relaxed);
+      continue;
+    }
+
+    Unlink(bucket);
+    return;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Rebuild(std::size_t buckets_count) {
+  auto table = std::make_unique<Table>(buckets_count);
+  std::size_t used_buckets = 0;
+
+  auto* old_table = table_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i <= old_table->mask; ++i) {
+    auto* node = old_table->buckets[i].load(std::memory_order_relaxed);
+    if (!IsLive(node)) continue;
+
+    auto j = GetBucket(node->hash, *table);
+    while (table->buckets[j].load(std::memory_order_relaxed)) {
+      j = (j + 1) & table->mask;
+    }
+    table->buckets[j].store(node, std::memory_order_relaxed);
+    ++used_buckets;
+  }
+
+  used_buckets_ = used_buckets;
+  hand_ = 0;
+  // The nodes are moved to the new table, only the buckets are retired
+  table_.store(table.release(), std::memory_order_release);
+  Retire(nullptr, std::unique_ptr<Table>(old_table));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Unlink(std::atomic<Node*>& bucket) {
+  auto* node = bucket.exchange(Tombstone(), std::memory_order_acq_rel);
+  UASSERT(IsLive(node));
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  Retire(std::unique_ptr<Node>(node), nullptr);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Retire(std::unique_ptr<Node> node,
+                                         std::unique_ptr<Table> table) {
+  // Readers that have entered after this point can not see the memory
+  retired_.push_back({epoch_.GetCurrent(), std::move(node), std::move(table)});
+  if (retired_.size() < next_reclaim_size_) return;
+
+  // Scanning the reader slots is not free, so it is amortized over a batch
+  const auto current = epoch_.TryAdvance();
+  const auto reclaimable_end =
+      std::find_if(retired_.begin(), retired_.end(),
+                   [current](const Retired& retired) {
+                     return retired.epoch + 2 > current;
+                   });
+  retired_.erase(retired_.begin(), reclaimable_end);
+  next_reclaim_size_ = retired_.size() + kReclaimBatch;
+}
+
+/// @brief NWayLRU storage for CachePolicy::kClock: ClockMap ways with
+/// lock-free lookups, updates are serialized by a mutex per way.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ClockCache final {
+ public:
+  ClockCache(std::size_t ways, std::size_t way_size, const Hash& hash,
+             const Equal& equal);
+
+  void Put(const T& key, U value);
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator);
+
+  void Erase(const T& key);
+
+  void Clear();
+
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  std::size_t GetSize() const;
+
+  void SetWaySize(std::size_t way_size);
+
+  void Write(dump::Writer& writer) const;
+
+ private:
+  struct Way final {
+    Way(std::size_t way_size, ReadEpoch& epoch, const Hash& hash,
+        const Equal& equal)
+        : map(way_size, epoch, hash, equal) {}
+
+    mutable engine::Mutex mutex;
+    ClockMap<T, U, Hash, Equal> map;
+  };
+
+  Way& GetWay(const T& key);
+
+  // Outlives the ways
+  ReadEpoch epoch_;
+  std::vector<std::unique_ptr<Way>> ways_;
+  Hash hash_fn_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+ClockCache<T, U, Hash, Equal>::ClockCache(std::size_t ways,
+                                          std::size_t way_size,
+                                          const Hash& hash, const Equal& equal)
+    : hash_fn_(hash) {
+  ways_.reserve(ways);
+  for (std::size_t i = 0; i < ways; ++i) {
+    ways_.push_back(std::make_unique<Way>(way_size, epoch_, hash, equal));
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockCache<T, U, Hash, Equal>::Put(const T& key, U value) {
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  way.map.Put(key, std::move(value));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Validator>
+std::optional<U> ClockCache<T, U, Hash, Equal>::Get(const T& key,
+                                                    Validator validator) {
+  auto& way = GetWay(key);
+  std::optional<U> result;
+  way.map.Visit(key, [&result](const U& value) { result.emplace(value); });
+
+  if (!result || validator(*result)) return result;
+
+  // The value might have been updated since the lookup
+  std::lock_guard lock(way.mutex);
+  way.map.EraseIf(key, [&validator](const U& value) {
+    return !validator(value);
+  });
+  return std::nullopt;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockCache<T, U, Hash, Equal>::Erase(const T& key) {
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  way.map.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockCache<T, U, Hash, Equal>::Clear() {
+  for (auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+    way->map.Clear();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ClockCache<T, U, Hash, Equal>::VisitAll(Function func) const {
+  for (const auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+    way->map.VisitAll(func);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ClockCache<T, U, Hash, Equal>::GetSize() const {
+  std::size_t size{0};
+  for (const auto& way : ways_) size += way->map.GetSize();
+  return size;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockCache<T, U, Hash, Equal>::SetWaySize(std::size_t way_size) {
+  for (auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+    way->map.SetMaxSize(way_size);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockCache<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
+  writer.Write(ways_.size());
+
+  for (const auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+
+    writer.Write(way->map.GetSize());
+
+    way->map.VisitAll([&writer](const T& key, const U& value) {
+      writer.Write(key);
+      writer.Write(value);
+    });
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename ClockCache<T, U, Hash, Equal>::Way&
+ClockCache<T, U, Hash, Equal>::GetWay(const T& key) {
+  // See NWayLRU::GetWay
+  auto seed = hash_fn_(key);
+  boost::hash_combine(seed, 0);
+  return *ways_[seed % ways_.size()];
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// @brief Epoch based memory reclamation for the lock-free readers.
+///
+/// Readers mark themselves in per-thread slots with the current epoch parity
+/// for the duration of a ReadGuard. A writer that has unlinked some memory
+/// remembers GetCurrent() and may free it once the epoch has advanced by 2,
+/// the epoch advances only if no reader is left in the previous one.
+///
+/// Entering and leaving are lock-free and touch only the memory of the current
+/// thread slot. Read sections must be short and must not suspend.
+class ReadEpoch final {
+ public:
+  class [[nodiscard]] ReadGuard final {
+   public:
+    ReadGuard(ReadGuard&& other) noexcept
+        : counter_(std::exchange(other.counter_, nullptr)) {}
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(ReadGuard&&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    ~ReadGuard() {
+      if (counter_) counter_->fetch_sub(1, std::memory_order_release);
+    }
+
+   private:
+    friend class ReadEpoch;
+
+    explicit ReadGuard(std::atomic<std::int64_t>& counter) noexcept
+        : counter_(&counter) {}
+
+    std::atomic<std::int64_t>* counter_;
+  };
+
+  ReadEpoch();
+  ~ReadEpoch();
+
+  ReadEpoch(ReadEpoch&&) = delete;
+  ReadEpoch& operator=(ReadEpoch&&) = delete;
+
+  /// Protects the memory reachable at the moment from being freed until the
+  /// guard is destroyed
+  ReadGuard Enter() noexcept;
+
+  std::uint64_t GetCurrent() const noexcept;
+
+  /// Advances the epoch if there are no readers left in the previous one,
+  /// returns the resulting current epoch
+  std::uint64_t TryAdvance() noexcept;
+
+ private:
+  struct ReaderSlot;
+
+  ReaderSlot& GetSlot() noexcept;
+
+  std::atomic<std::uint64_t> epoch_{0};
+  std::size_t slot_mask_;
+  std::unique_ptr<ReaderSlot[]> slots_;
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
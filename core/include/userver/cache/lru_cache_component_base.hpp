@@ -62,6 +62,7 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// policy | eviction policy, one of `lru`, `slru`, `w-tinylfu`, `clock`; see cache::CachePolicy | lru
 ///
 /// ## Example usage:
 ///
@@ -131,7 +132,8 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(),
+                                     static_config_.policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
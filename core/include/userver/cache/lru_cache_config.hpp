@@ -3,8 +3,10 @@
 #include <chrono>
 #include <cstddef>
 #include <optional>
+#include <string_view>
 #include <unordered_map>
 
+#include <userver/cache/policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -35,6 +37,11 @@ struct LruCacheConfig final {
 LruCacheConfig Parse(const formats::json::Value& value,
                      formats::parse::To<LruCacheConfig>);
 
+CachePolicy Parse(const yaml_config::YamlConfig& config,
+                  formats::parse::To<CachePolicy>);
+
+std::string_view ToString(CachePolicy policy);
+
 struct LruCacheConfigStatic final {
   explicit LruCacheConfigStatic(const yaml_config::YamlConfig& config);
   explicit LruCacheConfigStatic(const components::ComponentConfig& config);
@@ -44,6 +51,8 @@ struct LruCacheConfigStatic final {
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  /// Eviction policy, can not be changed by the dynamic config
+  CachePolicy policy;
 };
 
 extern const dynamic_config::Key<
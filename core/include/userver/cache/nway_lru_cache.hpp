@@ -1,10 +1,13 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <vector>
 
-#include <userver/cache/lru_map.hpp>
+#include <userver/cache/impl/clock_cache.hpp>
+#include <userver/cache/impl/policy_lru_map.hpp>
+#include <userver/cache/policy.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
@@ -21,6 +24,11 @@ class NWayLRU final {
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
           const Equal& equal = Equal());
 
+  /// Creates a cache with the `policy` eviction in each of the ways.
+  /// With CachePolicy::kClock the lookups do not lock the ways.
+  NWayLRU(size_t ways, size_t way_size, CachePolicy policy,
+          const Hash& hash = Hash(), const Equal& equal = Equal());
+
   void Put(const T& key, U value);
 
   template <typename Validator>
@@ -56,10 +64,11 @@ class NWayLRU final {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+    Way(CachePolicy policy, const Hash& hash, const Equal& equal)
+        : cache(1, policy, hash, equal) {}
 
     mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    impl::PolicyLruMap<T, U, Hash, Equal> cache;
   };
 
   Way& GetWay(const T& key);
@@ -67,6 +76,8 @@ class NWayLRU final {
   void NotifyDumper();
 
   std::vector<Way> caches_;
+  // Replaces `caches_` for CachePolicy::kClock
+  std::unique_ptr<impl::ClockCache<T, U, Hash, Equal>> clock_;
   Hash hash_fn_;
   std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
@@ -74,9 +85,22 @@ class NWayLRU final {
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
                                  const Eq& equal)
+    : NWayLRU(ways, way_size, CachePolicy::kLRU, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size,
+                                 CachePolicy policy, const Hash& hash,
+                                 const Eq& equal)
     : caches_(), hash_fn_(hash) {
+  if (policy == CachePolicy::kClock) {
+    if (ways == 0) throw std::logic_error("Ways must be positive");
+    clock_ = std::make_unique<impl::ClockCache<T, U, Hash, Eq>>(
+        ways, way_size, hash, equal);
+    return;
+  }
+
   caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(policy, hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
   for (auto& way : caches_) way.cache.SetMaxSize(way_size);
@@ -84,6 +108,12 @@ NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
+  if (clock_) {
+    clock_->Put(key, std::move(value));
+    NotifyDumper();
+    return;
+  }
+
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
@@ -96,6 +126,8 @@ template <typename T, typename U, typename Hash, typename Eq>
 template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
+  if (clock_) return clock_->Get(key, std::move(validator));
+
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
   auto* value = way.cache.Get(key);
@@ -110,6 +142,12 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+  if (clock_) {
+    clock_->Erase(key);
+    NotifyDumper();
+    return;
+  }
+
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
@@ -120,6 +158,8 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
+  if (clock_) return Get(key).value_or(default_value);
+
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
   return way.cache.GetOr(key, default_value);
@@ -127,6 +167,7 @@ U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
+  if (clock_) clock_->Clear();
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.Clear();
@@ -137,6 +178,7 @@ void NWayLRU<T, U, Hash, Eq>::Invalidate() {
 template <typename T, typename U, typename Hash, typename Eq>
 template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
+  if (clock_) clock_->VisitAll(func);
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.VisitAll(func);
@@ -145,6 +187,8 @@ void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
 
 template <typename T, typename U, typename Hash, typename Eq>
 size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
+  if (clock_) return clock_->GetSize();
+
   size_t size{0};
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
@@ -155,6 +199,7 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
+  if (clock_) clock_->SetWaySize(way_size);
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.SetMaxSize(way_size);
@@ -176,6 +221,11 @@ typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
 
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
+  if (clock_) {
+    clock_->Write(writer);
+    return;
+  }
+
   writer.Write(caches_.size());
 
   for (const Way& way : caches_) {
@@ -49,6 +49,7 @@ class Manager;
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 10000
+/// timer-wheel | keep deadline timers of tasks (sleeps, deadline-bounded waits, task deadlines) in a 1ms-tick timing wheel of each worker thread instead of sending them to the ev threads. Timers are fired by the workers between tasks, so a task that runs long without yielding delays the timers of its worker | false
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
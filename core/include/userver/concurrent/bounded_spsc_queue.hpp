@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file userver/concurrent/bounded_spsc_queue.hpp
+/// @brief @copybrief concurrent::BoundedSpscQueue
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#include <userver/concurrent/impl/spsc_ring_buffer.hpp>
+#include <userver/concurrent/queue_helpers.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Bounded single producer single consumer queue over a ring buffer.
+///
+/// A drop-in replacement for concurrent::SpscQueue with a fixed capacity.
+/// The elements are stored contiguously in a ring buffer allocated once on
+/// creation, and pushing or popping an element is wait-free unless the queue
+/// is full or empty respectively. Use it for hot single producer pipelines,
+/// especially with the batched `PushMany` and `PopMany`.
+///
+/// `T` must be default constructible and nothrow movable.
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename T>
+class BoundedSpscQueue final
+    : public std::enable_shared_from_this<BoundedSpscQueue<T>> {
+  struct EmplaceEnabler final {
+    // Disable {}-initialization in Queue's constructor
+    explicit EmplaceEnabler() = default;
+  };
+
+  using Token = impl::NoToken;
+
+  friend class concurrent::Producer<BoundedSpscQueue, Token, EmplaceEnabler>;
+  friend class concurrent::Consumer<BoundedSpscQueue, Token, EmplaceEnabler>;
+
+ public:
+  using ValueType = T;
+
+  using Producer =
+      concurrent::Producer<BoundedSpscQueue, Token, EmplaceEnabler>;
+  using Consumer =
+      concurrent::Consumer<BoundedSpscQueue, Token, EmplaceEnabler>;
+
+  /// @cond
+  // For internal use only
+  BoundedSpscQueue(std::size_t capacity, EmplaceEnabler /*unused*/)
+      : queue_(capacity) {}
+
+  ~BoundedSpscQueue() {
+    UASSERT(consumers_count_ == kCreatedAndDead || !consumers_count_);
+    UASSERT(producers_count_ == kCreatedAndDead || !producers_count_);
+  }
+
+  BoundedSpscQueue(BoundedSpscQueue&&) = delete;
+  BoundedSpscQueue(const BoundedSpscQueue&) = delete;
+  BoundedSpscQueue& operator=(BoundedSpscQueue&&) = delete;
+  BoundedSpscQueue& operator=(const BoundedSpscQueue&) = delete;
+  /// @endcond
+
+  /// Create a new queue that holds up to `capacity` elements
+  static std::shared_ptr<BoundedSpscQueue> Create(std::size_t capacity) {
+    return std::make_shared<BoundedSpscQueue>(capacity, EmplaceEnabler{});
+  }
+
+  /// Get the `Producer` which makes it possible to push items into the queue.
+  /// A new `Producer` may only be obtained after the previous one is dead.
+  ///
+  /// @note `Producer` may outlive the queue and the consumer.
+  Producer GetProducer() {
+    [[maybe_unused]] const auto old_producers_count =
+        producers_count_.exchange(1);
+    UASSERT_MSG(old_producers_count != 1,
+                "BoundedSpscQueue can only have a single producer at a time");
+    return Producer(this->shared_from_this(), EmplaceEnabler{});
+  }
+
+  /// Get the `Consumer` which makes it possible to read items from the queue.
+  /// A new `Consumer` may only be obtained after the previous one is dead.
+  ///
+  /// @note `Consumer` may outlive the queue and the producer.
+  Consumer GetConsumer() {
+    [[maybe_unused]] const auto old_consumers_count =
+        consumers_count_.exchange(1);
+    UASSERT_MSG(old_consumers_count != 1,
+                "BoundedSpscQueue can only have a single consumer at a time");
+    return Consumer(this->shared_from_this(), EmplaceEnabler{});
+  }
+
+  /// @brief Gets the max number of elements in the queue
+  std::size_t GetCapacity() const noexcept { return queue_.GetCapacity(); }
+
+  /// @brief Gets the approximate size of queue
+  std::size_t GetSizeApproximate() const noexcept {
+    return queue_.GetSizeApproximate();
+  }
+
+ private:
+  [[nodiscard]] bool Push(Token& token, T&& value, engine::Deadline deadline) {
+    return PushMany(token, utils::span<T>(&value, &value + 1), deadline) == 1;
+  }
+
+  [[nodiscard]] bool PushNoblock(Token& /*token*/, T&& value) {
+    return DoPushMany(utils::span<T>(&value, &value + 1)) == 1;
+  }
+
+  // Blocks while the queue is full and there is a consumer
+  [[nodiscard]] std::size_t PushMany(Token& /*token*/, utils::span<T> values,
+                                     engine::Deadline deadline) {
+    std::size_t pushed = 0;
+    while (true) {
+      pushed += DoPushMany(values.subspan(pushed, values.size() - pushed));
+      if (pushed == values.size() || NoMoreConsumers() ||
+          !non_full_event_.WaitForEventUntil(deadline)) {
+        return pushed;
+      }
+    }
+  }
+
+  [[nodiscard]] bool Pop(Token& token, T& value, engine::Deadline deadline) {
+    return PopMany(token, utils::span<T>(&value, &value + 1), deadline) == 1;
+  }
+
+  [[nodiscard]] bool PopNoblock(Token& /*token*/, T& value) {
+    return DoPopMany(utils::span<T>(&value, &value + 1)) == 1;
+  }
+
+  // Blocks only if queue is empty
+  [[nodiscard]] std::size_t PopMany(Token& /*token*/, utils::span<T> values,
+                                    engine::Deadline deadline) {
+    if (values.empty()) return 0;
+
+    while (true) {
+      const std::size_t popped = DoPopMany(values);
+      if (popped != 0) return popped;
+
+      if (NoMoreProducers() || !nonempty_event_.WaitForEventUntil(deadline)) {
+        // Producer might have pushed something in queue between the pop
+        // and the NoMoreProducers() check. Check twice to avoid TOCTOU.
+        return DoPopMany(values);
+      }
+    }
+  }
+
+  // The events are not reset after the operations, so that a wakeup is never
+  // lost. Spurious wakeups just retry the operation.
+  std::size_t DoPushMany(utils::span<T> values) {
+    if (values.empty() || NoMoreConsumers()) return 0;
+
+    const std::size_t pushed = queue_.TryPushMany(values);
+    if (pushed != 0) nonempty_event_.Send();
+    return pushed;
+  }
+
+  std::size_t DoPopMany(utils::span<T> values) {
+    const std::size_t popped = queue_.TryPopMany(values);
+    if (popped != 0) non_full_event_.Send();
+    return popped;
+  }
+
+  void MarkConsumerIsDead() {
+    consumers_count_ = kCreatedAndDead;
+    non_full_event_.Send();
+  }
+
+  void MarkProducerIsDead() {
+    producers_count_ = kCreatedAndDead;
+    nonempty_event_.Send();
+  }
+
+  bool NoMoreConsumers() const { return consumers_count_ == kCreatedAndDead; }
+
+  bool NoMoreProducers() const { return producers_count_ == kCreatedAndDead; }
+
+  impl::SpscRingBuffer<T> queue_;
+  engine::SingleConsumerEvent nonempty_event_;
+  engine::SingleConsumerEvent non_full_event_;
+  std::atomic<std::size_t> consumers_count_{0};
+  std::atomic<std::size_t> producers_count_{0};
+
+  static constexpr std::size_t kCreatedAndDead =
+      std::numeric_limits<std::size_t>::max();
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
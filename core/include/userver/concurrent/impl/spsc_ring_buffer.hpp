@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+/// @brief Bounded wait-free ring buffer for a single producer thread and
+/// a single consumer thread, with the elements stored contiguously.
+///
+/// The producer and the consumer each own a cache line with their position
+/// and a cached copy of the other's position, so that they only touch each
+/// other's cache line when the buffer looks full or empty.
+template <typename T>
+class SpscRingBuffer final {
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_assignable_v<T>,
+                "Elements are moved into and out of the buffer in batches, "
+                "which is only exception safe for noexcept moves");
+
+ public:
+  explicit SpscRingBuffer(std::size_t capacity)
+      : capacity_(capacity),
+        mask_(RoundUpToPowerOf2(std::max(capacity, std::size_t{1})) - 1),
+        slots_(std::make_unique<Slot[]>(mask_ + 1)) {}
+
+  ~SpscRingBuffer() {
+    const auto tail = producer_.tail.load(std::memory_order_acquire);
+    for (auto head = consumer_.head.load(std::memory_order_relaxed);
+         head != tail; ++head) {
+      At(head).~T();
+    }
+  }
+
+  SpscRingBuffer(SpscRingBuffer&&) = delete;
+  SpscRingBuffer& operator=(SpscRingBuffer&&) = delete;
+
+  std::size_t GetCapacity() const noexcept { return capacity_; }
+
+  std::size_t GetSizeApproximate() const noexcept {
+    // head is loaded first, so it never overtakes tail
+    const auto head = consumer_.head.load(std::memory_order_acquire);
+    const auto tail = producer_.tail.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  /// Moves out as many of the first `values` as fit into the buffer.
+  /// Must only be called by the producer.
+  /// @returns the number of pushed elements
+  std::size_t TryPushMany(utils::span<T> values) noexcept {
+    const auto tail = producer_.tail.load(std::memory_order_relaxed);
+    auto free_slots = capacity_ - (tail - producer_.cached_head);
+    if (free_slots < values.size()) {
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      free_slots = capacity_ - (tail - producer_.cached_head);
+    }
+
+    const auto count = std::min(free_slots, values.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      new (&slots_[(tail + i) & mask_].storage) T(std::move(values[i]));
+    }
+    producer_.tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  /// Moves up to `values.size()` elements from the buffer into `values`.
+  /// Must only be called by the consumer.
+  /// @returns the number of popped elements
+  std::size_t TryPopMany(utils::span<T> values) noexcept {
+    const auto head = consumer_.head.load(std::memory_order_relaxed);
+    auto available = consumer_.cached_tail - head;
+    if (available < values.size()) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      available = consumer_.cached_tail - head;
+    }
+
+    const auto count = std::min(available, values.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      auto& element = At(head + i);
+      values[i] = std::move(element);
+      element.~T();
+    }
+    consumer_.head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+ private:
+  // Not exposed to keep the public headers free of the platform specifics
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  struct Slot final {
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  struct alignas(kCacheLineSize) ProducerPosition final {
+    std::atomic<std::size_t> tail{0};
+    std::size_t cached_head{0};
+  };
+
+  struct alignas(kCacheLineSize) ConsumerPosition final {
+    std::atomic<std::size_t> head{0};
+    std::size_t cached_tail{0};
+  };
+
+  static std::size_t RoundUpToPowerOf2(std::size_t value) noexcept {
+    std::size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+  }
+
+  T& At(std::size_t position) noexcept {
+    return *std::launder(
+        reinterpret_cast<T*>(&slots_[position & mask_].storage));
+  }
+
+  ProducerPosition producer_;
+  ConsumerPosition consumer_;
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+};
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <limits>
 #include <memory>
 
@@ -14,6 +16,7 @@
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/atomic.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -223,6 +226,13 @@ class GenericQueue final
     return producer_side_.PushNoblock(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t PushMany(Token& token, utils::span<T> values,
+                                     engine::Deadline deadline) {
+    if (values.empty()) return 0;
+    return producer_side_.PushMany(token, values, deadline);
+  }
+
   template <typename Token>
   [[nodiscard]] bool Pop(Token& token, T& value, engine::Deadline deadline) {
     return consumer_side_.Pop(token, value, deadline);
@@ -233,6 +243,19 @@ class GenericQueue final
     return consumer_side_.PopNoblock(token, value);
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t PopMany(Token& token, utils::span<T> values,
+                                    engine::Deadline deadline) {
+    if (values.empty()) return 0;
+    return consumer_side_.PopMany(token, values, deadline);
+  }
+
+  static std::size_t GetElementsSize(utils::span<T> values) {
+    std::size_t size = 0;
+    for (const auto& value : values) size += QueuePolicy::GetElementSize(value);
+    return size;
+  }
+
   void PrepareProducer() {
     std::size_t old_producers_count{};
     utils::AtomicUpdate(producers_count_, [&](auto old_value) {
@@ -304,6 +327,24 @@ class GenericQueue final
     consumer_side_.OnElementPushed();
   }
 
+  template <typename Token>
+  void DoPushMany(Token& token, utils::span<T> values) {
+    const auto first = std::make_move_iterator(values.begin());
+    if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(token, first, values.size());
+    } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(first, values.size());
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(single_producer_token_, first, values.size());
+    }
+
+    consumer_side_.OnElementsPushed(values.size());
+  }
+
   template <typename Token>
   [[nodiscard]] bool DoPop(Token& token, T& value) {
     bool success{};
@@ -328,6 +369,30 @@ class GenericQueue final
     return false;
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopMany(Token& token, utils::span<T> values) {
+    std::size_t popped{};
+
+    if constexpr (std::is_same_v<Token, moodycamel::ConsumerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      popped = queue_.try_dequeue_bulk(token, values.begin(), values.size());
+    } else if constexpr (std::is_same_v<Token, impl::MultiToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      popped = queue_.try_dequeue_bulk(values.begin(), values.size());
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!QueuePolicy::kIsMultipleProducer);
+      popped = queue_.try_dequeue_bulk_from_producer(
+          single_producer_token_, values.begin(), values.size());
+    }
+
+    if (popped != 0) {
+      producer_side_.OnElementPopped(
+          GetElementsSize(values.subspan(0, popped)));
+    }
+    return popped;
+  }
+
   moodycamel::ConcurrentQueue<T> queue_{1};
   std::atomic<std::size_t> consumers_count_{0};
   std::atomic<std::size_t> producers_count_{0};
@@ -368,6 +433,20 @@ class GenericQueue<T, QueuePolicy>::SingleProducerSide final {
     return DoPush(token, std::move(value));
   }
 
+  // Falls back to pushing elements one by one if the whole batch does not fit
+  template <typename Token>
+  [[nodiscard]] std::size_t PushMany(Token& token, utils::span<T> values,
+                                     engine::Deadline deadline) {
+    if (DoPushMany(token, values)) return values.size();
+
+    std::size_t pushed = 0;
+    for (auto& value : values) {
+      if (!Push(token, std::move(value), deadline)) break;
+      ++pushed;
+    }
+    return pushed;
+  }
+
   void OnElementPopped(std::size_t released_capacity) {
     used_capacity_.fetch_sub(released_capacity);
     non_full_event_.Send();
@@ -406,6 +485,20 @@ class GenericQueue<T, QueuePolicy>::SingleProducerSide final {
     return true;
   }
 
+  template <typename Token>
+  [[nodiscard]] bool DoPushMany(Token& token, utils::span<T> values) {
+    const std::size_t values_size = GetElementsSize(values);
+    if (queue_.NoMoreConsumers() ||
+        used_capacity_.load() + values_size > total_capacity_.load()) {
+      return false;
+    }
+
+    used_capacity_.fetch_add(values_size);
+    queue_.DoPushMany(token, values);
+    non_full_event_.Reset();
+    return true;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent non_full_event_;
   std::atomic<std::size_t> used_capacity_;
@@ -438,6 +531,28 @@ class GenericQueue<T, QueuePolicy>::MultiProducerSide final {
            DoPush(token, std::move(value));
   }
 
+  // Falls back to pushing elements one by one if the whole batch does not fit
+  template <typename Token>
+  [[nodiscard]] std::size_t PushMany(Token& token, utils::span<T> values,
+                                     engine::Deadline deadline) {
+    const std::size_t values_size = GetElementsSize(values);
+    if (remaining_capacity_.try_lock_shared_count(values_size)) {
+      if (queue_.NoMoreConsumers()) {
+        remaining_capacity_.unlock_shared_count(values_size);
+        return 0;
+      }
+      queue_.DoPushMany(token, values);
+      return values.size();
+    }
+
+    std::size_t pushed = 0;
+    for (auto& value : values) {
+      if (!Push(token, std::move(value), deadline)) break;
+      ++pushed;
+    }
+    return pushed;
+  }
+
   void OnElementPopped(std::size_t value_size) {
     remaining_capacity_.unlock_shared_count(value_size);
   }
@@ -508,11 +623,32 @@ class GenericQueue<T, QueuePolicy>::SingleConsumerSide final {
     return DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  template <typename Token>
+  [[nodiscard]] std::size_t PopMany(Token& token, utils::span<T> values,
+                                    engine::Deadline deadline) {
+    while (true) {
+      const std::size_t popped = DoPopMany(token, values);
+      if (popped != 0) return popped;
+
+      if (queue_.NoMoreProducers() ||
+          !nonempty_event_.WaitForEventUntil(deadline)) {
+        // See Pop for the TOCTOU
+        return DoPopMany(token, values);
+      }
+    }
+  }
+
   void OnElementPushed() {
     ++element_count_;
     nonempty_event_.Send();
   }
 
+  void OnElementsPushed(std::size_t count) {
+    element_count_ += count;
+    nonempty_event_.Send();
+  }
+
   void StopBlockingOnPop() { nonempty_event_.Send(); }
 
   void ResumeBlockingOnPop() {}
@@ -530,6 +666,16 @@ class GenericQueue<T, QueuePolicy>::SingleConsumerSide final {
     return false;
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopMany(Token& token, utils::span<T> values) {
+    const std::size_t popped = queue_.DoPopMany(token, values);
+    if (popped != 0) {
+      element_count_ -= popped;
+      nonempty_event_.Reset();
+    }
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent nonempty_event_;
   std::atomic<std::size_t> element_count_;
@@ -561,8 +707,28 @@ class GenericQueue<T, QueuePolicy>::MultiConsumerSide final {
     return element_count_.try_lock_shared() && DoPop(token, value);
   }
 
+  // Blocks only if queue is empty, then takes the elements that are already
+  // there without waiting for more
+  template <typename Token>
+  [[nodiscard]] std::size_t PopMany(Token& token, utils::span<T> values,
+                                    engine::Deadline deadline) {
+    if (!element_count_.try_lock_shared_until(deadline)) return 0;
+
+    std::size_t count = 1;
+    const std::size_t extra =
+        std::min(values.size() - 1, element_count_.RemainingApprox());
+    if (extra != 0 && element_count_.try_lock_shared_count(extra)) {
+      count += extra;
+    }
+    return DoPopMany(token, values.subspan(0, count));
+  }
+
   void OnElementPushed() { element_count_.unlock_shared(); }
 
+  void OnElementsPushed(std::size_t count) {
+    element_count_.unlock_shared_count(count);
+  }
+
   void StopBlockingOnPop() {
     element_count_control_.SetCapacityOverride(kUnbounded +
                                                kSemaphoreUnlockValue);
@@ -598,6 +764,22 @@ class GenericQueue<T, QueuePolicy>::MultiConsumerSide final {
     }
   }
 
+  // Pops exactly `values.size()` elements locked in `element_count_`
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopMany(Token& token, utils::span<T> values) {
+    std::size_t popped = 0;
+    while (popped < values.size()) {
+      popped += queue_.DoPopMany(
+          token, values.subspan(popped, values.size() - popped));
+      if (popped < values.size() && queue_.NoMoreProducers()) {
+        element_count_.unlock_shared_count(values.size() - popped);
+        break;
+      }
+      // See DoPop for the elements that may be left behind
+    }
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::CancellableSemaphore element_count_;
   concurrent::impl::SemaphoreCapacityControl element_count_control_;
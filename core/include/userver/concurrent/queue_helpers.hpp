@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include <userver/engine/deadline.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -63,6 +65,18 @@ class Producer final {
     return queue_->PushNoblock(token_, std::move(value));
   }
 
+  /// Push elements into queue, synchronizing with the consumers once per batch
+  /// rather than once per element where possible. May wait asynchronously if
+  /// the queue is full.
+  /// @returns the number of elements pushed before the deadline and before
+  /// the task was canceled. The pushed elements form a prefix of `values` and
+  /// are moved out, the rest are left unmodified.
+  [[nodiscard]] std::size_t PushMany(utils::span<ValueType> values,
+                                     engine::Deadline deadline = {}) const {
+    UASSERT(queue_);
+    return queue_->PushMany(token_, values, deadline);
+  }
+
   void Reset() && {
     if (queue_) queue_->MarkProducerIsDead();
     queue_.reset();
@@ -124,6 +138,17 @@ class Consumer final {
     return queue_->PopNoblock(token_, value);
   }
 
+  /// Pop up to `values.size()` elements from queue into the beginning of
+  /// `values`. May wait asynchronously if the queue is empty, but the producer
+  /// is alive. Does not wait for more elements once at least one is popped.
+  /// @returns the number of elements popped before the deadline.
+  /// @note `0` can be returned before the deadline
+  /// when the producer is no longer alive.
+  [[nodiscard]] std::size_t PopMany(utils::span<ValueType> values,
+                                    engine::Deadline deadline = {}) const {
+    return queue_->PopMany(token_, values, deadline);
+  }
+
   /// Const access to source queue.
   [[nodiscard]] std::shared_ptr<const QueueType> Queue() const {
     return {queue_};
@@ -25,6 +25,7 @@ struct ClientConfig {
   bool append_path_to_url{true};
   std::string stage_name;
   bool fallback_to_no_proxy{true};
+  std::chrono::milliseconds long_poll_timeout{std::chrono::seconds{30}};
 };
 
 /// @ingroup userver_clients
@@ -60,12 +61,22 @@ class Client final {
   JsonReply FetchJson(const std::optional<Timestamp>& last_update,
                       const std::unordered_set<std::string>& fields_to_load);
 
+  /// @brief Long-polls the configs service for the configs updated since
+  /// `last_update`.
+  ///
+  /// The service holds the request until any of the requested configs
+  /// changes or ClientConfig::long_poll_timeout expires. In the latter case
+  /// the reply contains no docs.
+  Reply WaitForDocsMapUpdates(const Timestamp& last_update,
+                              const std::vector<std::string>& fields_to_load);
+
  private:
   formats::json::Value FetchConfigs(
       const std::optional<Timestamp>& last_update,
-      formats::json::ValueBuilder&& fields_to_load);
+      formats::json::ValueBuilder&& fields_to_load, bool long_poll = false);
 
-  std::string FetchConfigsValues(const std::string& body);
+  std::string FetchConfigsValues(const std::string& body,
+                                 std::chrono::milliseconds timeout);
 
   const ClientConfig config_;
   clients::http::Client& http_client_;
@@ -33,6 +33,7 @@ namespace components {
 /// configs-stage: stage name provided statically, can be overridden from file | -
 /// configs-stage-filepath: file to read stage name from, overrides static "configs-stage" if both are provided, expected format: json file with "env_name" property | -
 /// fallback-to-no-proxy | make additional attempts to retrieve configs by bypassing proxy that is set in USERVER_HTTP_PROXY runtime variable | true
+/// long-poll-timeout | how long the configs service may hold a long poll request if there are no config changes, see `long-poll` option of components::DynamicConfigClientUpdater | 30s
 ///
 /// ## Static configuration example:
 ///
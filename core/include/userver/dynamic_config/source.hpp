@@ -210,6 +210,37 @@ class Source final {
                              std::move(wrapper));
   }
 
+  /// @brief Subscribes to updates of a subset of all configs with information
+  /// about the current and previous states.
+  ///
+  /// Same as the overload above, but the listener method receives
+  /// `dynamic_config::Diff`. The first invocation gets `std::nullopt` as
+  /// `Diff::previous`, the subsequent ones happen only if one of the passed
+  /// configs is changed. `Diff::previous` is the config right before the
+  /// update, so the passed configs in it are the same as in the previous
+  /// invocation.
+  ///
+  /// @warning To use this function, configs must have the `operator==`.
+  ///
+  /// @see dynamic_config::Diff
+  template <typename Class, typename... Keys>
+  concurrent::AsyncEventSubscriberScope UpdateAndListen(
+      Class* obj, std::string_view name,
+      void (Class::*func)(const dynamic_config::Diff& diff),
+      const Keys&... keys) {
+    static_assert(sizeof...(Keys) > 0,
+                  "Pass at least one key to subscribe to or use the overload "
+                  "without keys");
+    auto wrapper = [obj, func, keys = std::make_tuple(std::cref(keys)...)](
+                       const Diff& diff) {
+      const auto args = std::tuple_cat(std::tie(diff), keys);
+      if (!std::apply(HasChanged<Keys...>, args)) return;
+      (obj->*func)(diff);
+    };
+    return DoUpdateAndListen(concurrent::FunctionId(obj), name,
+                             std::move(wrapper));
+  }
+
   SnapshotEventSource& GetEventChannel();
 
  private:
@@ -20,6 +20,7 @@
 #include <userver/dynamic_config/updater/additional_keys_token.hpp>
 #include <userver/dynamic_config/updates_sink/component.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/internal_tag_fwd.hpp>
 
@@ -58,6 +59,18 @@ namespace components {
 /// will be sent to every dynamic config subscriber if *any* part of the config
 /// has updated, not if the interesting part has updated.
 ///
+/// ## Long polling
+///
+/// With `long-poll: true` a background task waits on the configs service
+/// until any of the configs changes, for up to `long-poll-timeout` of
+/// components::DynamicConfigClient, and triggers an incremental update on
+/// changes. Changes arrive within milliseconds without frequent polling, the
+/// periodic updates keep running at `update-interval` as usual. The long poll
+/// is off by default, the configs service must support `long_poll_timeout_ms`.
+///
+/// To run a callback only on changes of particular configs, subscribe with
+/// dynamic_config::Source::UpdateAndListen overloads that accept keys.
+///
 /// ## Static options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
@@ -65,6 +78,7 @@ namespace components {
 /// store-enabled | store the retrieved values into the updates sink determined by the `updates-sink` option | true
 /// load-only-my-values | request from the client only the values used by this service | true
 /// deduplicate-update-types | update types for best-effort update event deduplication, see above | `full-and-incremental`
+/// long-poll | long poll the configs service for changes in a background task, see above | false
 ///
 /// See also the options for components::CachingComponentBase.
 ///
@@ -110,6 +124,12 @@ class DynamicConfigClientUpdater final
 
   void UpdateAdditionalKeys(const std::vector<std::string>& keys);
 
+  dynamic_config::Client::Timestamp GetServerTimestamp();
+  void SetServerTimestamp(dynamic_config::Client::Timestamp timestamp);
+
+  // Waits for the config changes and triggers the incremental updates
+  void LongPollChanges();
+
   bool IsDuplicate(cache::UpdateType update_type,
                    const dynamic_config::DocsMap& new_value) const;
 
@@ -117,13 +137,16 @@ class DynamicConfigClientUpdater final
   const bool load_only_my_values_;
   const bool store_enabled_;
   const std::optional<cache::AllowedUpdateTypes> deduplicate_update_types_;
+  const bool long_poll_;
   dynamic_config::Client& config_client_;
 
-  dynamic_config::Client::Timestamp server_timestamp_;
+  // Read by the long poll task concurrently with the updates
+  concurrent::Variable<dynamic_config::Client::Timestamp> server_timestamp_;
   // for atomic updates of cached data
   engine::Mutex update_config_mutex_;
   DocsMapKeys docs_map_keys_;
   concurrent::Variable<AdditionalDocsMapKeys> additional_docs_map_keys_;
+  engine::TaskWithResult<void> long_poll_task_;
 };
 
 template <>
@@ -67,6 +67,13 @@ class WritableBase {
     }
     return result;
   }
+
+  /// @brief Sends the data that the stream has buffered, if it buffers
+  /// the writes.
+  ///
+  /// Call it before waiting for the next data to write. Does nothing by
+  /// default.
+  virtual void Flush() {}
 };
 
 /// @ingroup userver_base_classes
@@ -5,6 +5,7 @@
 
 #include <sys/socket.h>
 
+#include <cstdint>
 #include <initializer_list>
 
 #include <userver/engine/deadline.hpp>
@@ -41,6 +42,34 @@ class [[nodiscard]] Socket final : public RwBase {
     Sockaddr src_addr;
   };
 
+  /// @brief A datagram for the batched RecvSomeMessagesFrom() and
+  /// SendAllMessagesTo()
+  struct Datagram {
+    /// Buffer to receive into or data to send, the data is not modified
+    /// by sending
+    void* data{nullptr};
+
+    /// Buffer capacity or size of the data to send
+    size_t len{0};
+
+    /// @brief Source address of the received datagram or destination address.
+    ///
+    /// The datagram is sent to the peer of a connected socket if the domain of
+    /// the address is AddrDomain::kUnspecified.
+    Sockaddr addr;
+
+    /// Size of the received datagram, longer datagrams are truncated to `len`
+    size_t bytes_received{0};
+
+    /// @brief UDP segmentation offload segment size, Linux only.
+    ///
+    /// For sending, a non-zero value makes the kernel split `data` into
+    /// datagrams of this size (UDP GSO). For receiving, it is set to the size of
+    /// the segments coalesced into the datagram if `UDP_GRO` option is enabled
+    /// on the socket, otherwise it is 0.
+    std::uint16_t segment_size{0};
+  };
+
   /// Constructs an invalid socket.
   Socket() = default;
 
@@ -127,6 +156,23 @@ class [[nodiscard]] Socket final : public RwBase {
   [[nodiscard]] size_t SendAllTo(const Sockaddr& dest_addr, const void* buf,
                                  size_t len, Deadline deadline);
 
+  /// @brief Receives up to `count` datagrams, filling `data` buffers,
+  /// `addr`, `bytes_received` and `segment_size` of the `datagrams`.
+  /// @returns the number of received datagrams, at least one.
+  /// @note Takes a single `recvmmsg` syscall per wakeup where available.
+  /// @note Not for SocketType::kStream connections.
+  [[nodiscard]] size_t RecvSomeMessagesFrom(Datagram* datagrams, size_t count,
+                                            Deadline deadline);
+
+  /// @brief Sends `count` datagrams.
+  /// @returns the number of sent datagrams, can be less than `count` if an
+  /// error occurs after some of the datagrams are sent.
+  /// @note Takes a single `sendmmsg` syscall per wakeup where available.
+  /// @note Sockaddr domains must match the socket's domain.
+  /// @note Not for SocketType::kStream connections.
+  [[nodiscard]] size_t SendAllMessagesTo(const Datagram* datagrams,
+                                         size_t count, Deadline deadline);
+
   /// File descriptor corresponding to this socket.
   int Fd() const;
 
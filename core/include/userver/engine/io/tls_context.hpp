@@ -0,0 +1,112 @@
+#pragma once
+
+/// @file userver/engine/io/tls_context.hpp
+/// @brief TLS contexts shared by many connections
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <userver/crypto/certificate.hpp>
+#include <userver/crypto/private_key.hpp>
+
+struct ssl_ctx_st;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+class TlsWrapper;
+
+/// Settings of engine::io::TlsServerContext
+struct TlsServerSessionSettings final {
+  /// Max number of sessions in the server session cache, 0 disables the cache
+  std::size_t session_cache_size{20 * 1024};
+
+  /// Lifetime of cached sessions and of session tickets
+  std::chrono::seconds session_timeout{std::chrono::minutes{5}};
+
+  /// Session ticket keys are replaced with new ones once in this period. The
+  /// previous keys are still accepted during the next period. 0 disables
+  /// session tickets.
+  std::chrono::seconds ticket_key_rotation_period{std::chrono::hours{1}};
+
+  /// Offload the encryption of sent data to the kernel after the handshake,
+  /// see engine::io::TlsWrapper::IsKernelTlsSendEnabled
+  bool kernel_tls_offload{false};
+};
+
+/// @brief Server side TLS context to be shared by all the connections of
+/// a listener.
+///
+/// Holds the certificate chain and the key, the server session cache and
+/// the rotating session ticket keys, so that new connections skip the context
+/// setup and returning clients skip the full handshake.
+///
+/// Thread safe.
+class TlsServerContext final {
+ public:
+  TlsServerContext(
+      const crypto::Certificate& cert, const crypto::PrivateKey& key,
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const TlsServerSessionSettings& settings = {});
+
+  TlsServerContext(TlsServerContext&&) noexcept;
+  TlsServerContext& operator=(TlsServerContext&&) noexcept;
+  ~TlsServerContext();
+
+  /// @brief Replaces the certificate, the key and the certificate
+  /// authorities for new connections.
+  ///
+  /// Established connections are not affected. Sessions established before
+  /// the reload are not resumed: the session ticket keys are replaced,
+  /// the session cache starts from scratch and the sessions are bound to
+  /// the certificate authorities that verified the client certificates.
+  void Reload(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+              const std::vector<crypto::Certificate>& cert_authorities = {});
+
+ private:
+  friend class TlsWrapper;
+
+  std::shared_ptr<ssl_ctx_st> GetNative() const;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// @brief Client side TLS context to be shared by many connections.
+///
+/// Keeps the sessions established with servers in a cache keyed by the server
+/// name (SNI) and resumes them on the next connection to the same server.
+/// Connections without a server name are not resumed.
+///
+/// Thread safe.
+class TlsClientContext final {
+ public:
+  /// @param session_cache_size max number of cached sessions, 0 disables
+  /// the session resumption
+  /// @param cert_authorities trusted in addition to the system ones
+  /// @param kernel_tls_offload offload the encryption of sent data to
+  /// the kernel after the handshake
+  explicit TlsClientContext(
+      std::size_t session_cache_size = 1024,
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      bool kernel_tls_offload = false);
+
+  TlsClientContext(TlsClientContext&&) noexcept;
+  TlsClientContext& operator=(TlsClientContext&&) noexcept;
+  ~TlsClientContext();
+
+ private:
+  friend class TlsWrapper;
+
+  ssl_ctx_st* GetNative() const noexcept;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
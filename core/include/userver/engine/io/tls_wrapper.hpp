@@ -11,6 +11,7 @@
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/common.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_context.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,17 +26,34 @@ namespace engine::io {
 /// @snippet src/engine/io/tls_wrapper_test.cpp TLS wrapper usage
 class [[nodiscard]] TlsWrapper final : public RwBase {
  public:
-  /// Starts a TLS client on an opened socket
+  /// Starts a TLS client on an opened socket using the process-wide client
+  /// context
   static TlsWrapper StartTlsClient(Socket&& socket,
                                    const std::string& server_name,
                                    Deadline deadline);
 
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS client on an opened socket
+  ///
+  /// The session is resumed if the `context` holds one for the `server_name`.
+  static TlsWrapper StartTlsClient(Socket&& socket,
+                                   const TlsClientContext& context,
+                                   const std::string& server_name,
+                                   Deadline deadline);
+
+  /// @brief Starts a TLS server on an opened socket
+  ///
+  /// @warning Sets up a new TLS context for each call, prefer the overload
+  /// with engine::io::TlsServerContext for accepted connections.
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
       const std::vector<crypto::Certificate>& cert_authorities = {});
 
+  /// Starts a TLS server on an opened socket with a shared context
+  static TlsWrapper StartTlsServer(Socket&& socket,
+                                   const TlsServerContext& context,
+                                   Deadline deadline);
+
   ~TlsWrapper() override;
 
   TlsWrapper(const TlsWrapper&) = delete;
@@ -47,6 +65,22 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// Whether the socket is valid.
   bool IsValid() const override;
 
+  /// Whether the handshake resumed a previous TLS session.
+  bool IsSessionReused() const;
+
+  /// @brief Whether the sent data is encrypted by the kernel.
+  ///
+  /// Kernel TLS offload is enabled by the `kernel_tls_offload` option of the
+  /// TLS context and requires Linux with the `tls` module, OpenSSL 3.0 - 3.5
+  /// and an AES-GCM, AES-CCM or ChaCha20-Poly1305 cipher. Otherwise OpenSSL
+  /// encrypts the data as usual.
+  ///
+  /// With the offload SendAll writes to the socket directly, and the data
+  /// may also be sent with `sendfile` on GetRawFd(). If the kernel fails to
+  /// take the new keys of a TLS 1.3 key update, the connection is broken:
+  /// the following sends throw TlsException.
+  bool IsKernelTlsSendEnabled() const;
+
   /// Suspends current task until the socket has data available.
   [[nodiscard]] bool WaitReadable(Deadline) override;
 
@@ -69,6 +103,8 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
+  /// @throws TlsException if IsKernelTlsSendEnabled(), the socket cannot be
+  ///   used for plaintext any more.
   [[nodiscard]] Socket StopTls(Deadline deadline);
 
   /// @brief Receives at least one byte from the socket.
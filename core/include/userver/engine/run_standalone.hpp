@@ -21,6 +21,9 @@ struct TaskProcessorPoolsConfig final {
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
   bool defer_events = true;
+  /// Keep deadline timers in the worker threads, see `timer-wheel` option of
+  /// components::ManagerControllerComponent
+  bool timer_wheel_enabled = false;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
@@ -0,0 +1,165 @@
+#pragma once
+
+/// @file userver/engine/sharded_shared_mutex.hpp
+/// @brief @copybrief engine::ShardedSharedMutex
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @ingroup userver_concurrency
+///
+/// @brief engine::SharedMutex replacement for read-mostly data, where shared
+/// locking scales with the number of threads.
+///
+/// Readers are counted in per-thread slots, each in its own cache line, so
+/// shared locking without writers touches only the memory local to the
+/// current thread. Unique locking revokes that fast path, lets the readers
+/// queue on an engine::SharedMutex and waits for the existing readers in all
+/// the slots to unlock.
+///
+/// Thus shared locking is cheaper and unique locking is more expensive than
+/// with engine::SharedMutex. The mutex takes a cache line per hardware thread,
+/// so prefer engine::SharedMutex unless it is contended by readers.
+///
+/// Ignores task cancellations (succeeds even if the current task is cancelled).
+///
+/// Writers (unique locks) have priority over readers (shared locks).
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+class ShardedSharedMutex final {
+ public:
+  ShardedSharedMutex();
+  ~ShardedSharedMutex();
+
+  ShardedSharedMutex(const ShardedSharedMutex&) = delete;
+  ShardedSharedMutex(ShardedSharedMutex&&) = delete;
+  ShardedSharedMutex& operator=(const ShardedSharedMutex&) = delete;
+  ShardedSharedMutex& operator=(ShardedSharedMutex&&) = delete;
+
+  /// Locks the mutex for unique ownership. Blocks current coroutine if the
+  /// mutex is locked by another coroutine for reading or writing.
+  ///
+  /// @note The method waits for the mutex even if the current task is
+  /// cancelled.
+  void lock();
+
+  /// Unlocks the mutex for unique ownership. Before calling this method the
+  /// the mutex should be locked for unique ownership by current coroutine.
+  void unlock();
+
+  /// Tries to lock the mutex for unique ownership without blocking the
+  /// coroutine, returns true if succeeded.
+  [[nodiscard]] bool try_lock();
+
+  /// Tries to lock the mutex for unique ownership in specified duration.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Rep, typename Period>
+  [[nodiscard]] bool try_lock_for(const std::chrono::duration<Rep, Period>&);
+
+  /// Tries to lock the mutex for unique ownership till specified time point.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Clock, typename Duration>
+  [[nodiscard]] bool try_lock_until(
+      const std::chrono::time_point<Clock, Duration>&);
+
+  /// @overload
+  [[nodiscard]] bool try_lock_until(Deadline deadline);
+
+  /// Locks the mutex for shared ownership. Blocks current coroutine if the
+  /// mutex is locked by another coroutine for writing.
+  ///
+  /// @note The method waits for the mutex even if the current task is
+  /// cancelled.
+  void lock_shared();
+
+  /// Unlocks the mutex for shared ownership. Before calling this method the
+  /// mutex should be locked for shared ownership by current coroutine.
+  void unlock_shared();
+
+  /// Tries to lock the mutex for shared ownership without blocking the
+  /// coroutine, returns true if succeeded.
+  [[nodiscard]] bool try_lock_shared();
+
+  /// Tries to lock the mutex for shared ownership in specified duration.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Rep, typename Period>
+  [[nodiscard]] bool try_lock_shared_for(
+      const std::chrono::duration<Rep, Period>&);
+
+  /// Tries to lock the mutex for shared ownership till specified time point.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Clock, typename Duration>
+  [[nodiscard]] bool try_lock_shared_until(
+      const std::chrono::time_point<Clock, Duration>&);
+
+  /// @overload
+  [[nodiscard]] bool try_lock_shared_until(Deadline deadline);
+
+ private:
+  struct ReaderSlot;
+
+  std::atomic<std::int64_t>& GetReaderCounter() noexcept;
+  bool TryLockSharedFast();
+  void AddReaderUnderGate() noexcept;
+
+  bool WaitForReaders(Deadline deadline);
+  bool HasReaders() const noexcept;
+  void ReleaseWriter() noexcept;
+
+  /* Writers hold it uniquely for the whole critical section, readers pass
+   * through it in shared mode while there are writers, so that the readers
+   * queue behind the writers.
+   */
+  SharedMutex gate_;
+
+  /* Readers take the fast path only if there are no writers */
+  std::atomic<std::size_t> writers_count_{0};
+
+  /* Sent by the readers that unlock while a writer waits for them */
+  SingleConsumerEvent readers_left_event_;
+
+  std::size_t slot_mask_;
+  std::unique_ptr<ReaderSlot[]> slots_;
+};
+
+template <typename Rep, typename Period>
+bool ShardedSharedMutex::try_lock_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_until(Deadline::FromDuration(duration));
+}
+
+template <typename Rep, typename Period>
+bool ShardedSharedMutex::try_lock_shared_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_shared_until(Deadline::FromDuration(duration));
+}
+
+template <typename Clock, typename Duration>
+bool ShardedSharedMutex::try_lock_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_until(Deadline::FromTimePoint(until));
+}
+
+template <typename Clock, typename Duration>
+bool ShardedSharedMutex::try_lock_shared_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_shared_until(Deadline::FromTimePoint(until));
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/os_signals/component.hpp>
 #include <userver/server/server.hpp>
 #include <userver/utils/statistics/entry.hpp>
 
@@ -24,6 +25,10 @@ namespace components {
 /// Starts listening and accepting connections only after **all** the
 /// components are loaded.
 ///
+/// On SIGUSR1 the files of `tls.cert`, `tls.private-key` and `tls.ca` are read
+/// again and used for the new connections, the sessions established before
+/// are not resumed.
+///
 /// All the classes inherited from server::handlers::HttpHandlerBase and
 /// registered in components list bind to the components::Server component.
 ///
@@ -65,6 +70,7 @@ namespace components {
 /// tls.cert | path to TLS server certificate | -
 /// tls.private-key | path to TLS server certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.kernel-offload | offload the encryption of responses to the kernel TLS after the handshake, if supported | false
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
@@ -75,7 +81,10 @@ namespace components {
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.zero_copy_body_threshold | request bodies larger than this value are kept as views into the receive buffers instead of being copied, see server::http::HttpRequest::RequestBodyPieces(); the URL and the headers are always copied; 0 to always copy | 0
+/// connection.out_buffer_size | max size of the responses of the pipelined requests and of the body chunks that are coalesced into a single write, the data is sent as soon as there is nothing more to send at the moment; 0 to write each of them separately | 65536
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// steering | how the kernel distributes new connections between the shards: `none` by the address hash, `incoming-cpu` to the shard with the index of the CPU that received the connection (Linux 6.2+), `cpu-bpf` to the shard `cpu % shards` by a BPF program; set `shards` to the CPU count for the last two; best-effort, the shards are not pinned to the CPUs | none
 ///
 /// @see @ref scripts/docs/en/userver/http_server.md
 
@@ -107,10 +116,13 @@ class Server final : public LoggableComponentBase {
 
  private:
   void WriteStatistics(utils::statistics::Writer& writer);
+  void OnTlsReload();
 
   std::unique_ptr<server::Server> server_;
   utils::statistics::Entry server_statistics_holder_;
   utils::statistics::Entry handler_statistics_holder_;
+  os_signals::Processor& signal_processor_;
+  os_signals::Subscriber signal_subscriber_;
 };
 
 template <>
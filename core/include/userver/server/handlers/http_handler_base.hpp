@@ -145,6 +145,10 @@ class HttpHandlerBase : public HandlerBase {
   virtual bool NeedCheckAuth() const { return true; }
 
   /// Override it if you need a custom request body logging.
+  ///
+  /// A body received without copying (see `connection.zero_copy_body_threshold`
+  /// in components::Server) is passed truncated to
+  /// `request_body_size_log_limit`, the full body is available via `request`.
   virtual std::string GetRequestBodyForLogging(
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& request_body) const;
@@ -5,7 +5,9 @@
 
 #include <chrono>
 #include <functional>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -188,14 +190,44 @@ class HttpRequest final {
   CookiesMapKeys GetCookieNames() const;
 
   /// @return HTTP body.
+  ///
+  /// A body received without copying (see `connection.zero_copy_body_threshold`
+  /// in components::Server) is concatenated on the first call.
   const std::string& RequestBody() const;
 
+  /// @return HTTP body as a sequence of pieces, empty for an empty body.
+  ///
+  /// Bodies larger than `connection.zero_copy_body_threshold` are views into
+  /// the connection receive buffers and are not concatenated, other bodies
+  /// consist of a single piece. The views are valid as long as the request.
+  /// Only the body is received without copying, the URL and the headers are
+  /// always copied into the request.
+  std::vector<std::string_view> RequestBodyPieces() const;
+
   /// @return HTTP headers.
   const HeadersMap& RequestHeaders() const;
 
   /// @return HTTP cookies.
   const CookiesMap& RequestCookies() const;
 
+  /// @brief Memory resource that lives as long as the request.
+  ///
+  /// Allocations are served from a monotonic arena that is reused by the
+  /// subsequent requests of the same connection, memory is released all at
+  /// once when the request is destroyed. Suitable for the temporaries of a
+  /// handler:
+  /// @code
+  /// std::pmr::vector<std::string_view> parts{&request.GetArena()};
+  /// @endcode
+  ///
+  /// The arena holds the argument indexes of the request. The URL, the
+  /// headers, the cookies and the argument strings themselves are
+  /// std::string and are allocated on the heap as usual.
+  ///
+  /// @warning Not thread-safe, do not use from the tasks spawned by the
+  /// handler and do not let the allocated objects outlive the request.
+  std::pmr::memory_resource& GetArena() const;
+
   /// @cond
   void SetRequestBody(std::string body);
   void ParseArgsFromBody();
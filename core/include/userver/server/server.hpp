@@ -61,6 +61,10 @@ class Server final : public congestion_control::Limitee {
 
   void SetRpsRatelimitStatusCode(http::HttpStatus status_code);
 
+  /// Re-reads the TLS certificate, private key and CAs of the listener from
+  /// the files of the static config, new connections use them
+  void ReloadTls();
+
  private:
   std::unique_ptr<ServerImpl> pimpl;
 };
@@ -45,11 +45,29 @@ struct Message {
 
 class WebSocketConnectionImpl;
 
+/// @brief permessage-deflate extension (RFC 7692) options
+struct DeflateConfig final {
+  /// For a connection: whether the extension was negotiated with the client
+  bool enabled = false;
+  /// Reset the compression context after each sent message
+  bool server_no_context_takeover = false;
+  /// Ask the client to reset its compression context after each message
+  bool client_no_context_takeover = false;
+  /// LZ77 window size of the compression of the sent messages, 9..15
+  unsigned server_max_window_bits = 15;
+  /// Smaller messages are sent uncompressed
+  unsigned min_compress_size = 64;
+};
+
 struct Config final {
   unsigned max_remote_payload = 65536;
   unsigned fragment_size = 65536;  // 0 - do not fragment
+  DeflateConfig deflate{};
 };
 
+DeflateConfig Parse(const yaml_config::YamlConfig&,
+                    formats::parse::To<DeflateConfig>);
+
 Config Parse(const yaml_config::YamlConfig&, formats::parse::To<Config>);
 
 struct Statistics final {
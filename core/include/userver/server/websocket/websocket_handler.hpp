@@ -28,6 +28,11 @@ namespace server::websocket {
 /// status-codes-log-level | map of "status": log_level items to override span log level for specific status codes | {}
 /// max-remote-payload | max remote payload size | 65536
 /// fragment-size | max output fragment size | 65536
+/// deflate.enabled | compress the messages with the permessage-deflate extension (RFC 7692) if the client offers it | false
+/// deflate.server-no-context-takeover | reset the compression context after each sent message, uses less memory and compresses worse | false
+/// deflate.client-no-context-takeover | ask the client to reset its compression context after each message | false
+/// deflate.server-max-window-bits | LZ77 window size of the compression of the sent messages as a power of 2, 9..15 | 15
+/// deflate.min-compress-size | messages smaller than this value are sent uncompressed | 64
 ///
 /// ## Example usage:
 ///
@@ -5,6 +5,7 @@
 
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,6 +27,16 @@ namespace components {
 /// ---- | ----------- | -------------
 /// service-name | name of the service to write in traces | ''
 /// tracer | type of the tracer to trace, currently supported only 'native' | 'native'
+/// tail-sampling.enabled | buffer spans of each trace until its local root span finishes and write out only slow, failed or sampled traces | false
+/// tail-sampling.slow-threshold | traces with a longer local root span are always written | 1s
+/// tail-sampling.sample-rate | fraction of traces to write regardless of duration and errors | 0
+/// tail-sampling.max-spans-per-trace | spans of a trace over this limit are discarded | 1000
+/// tail-sampling.max-buffered-bytes | memory limit for all the buffered spans, spans over this limit are discarded | 64MiB
+/// tail-sampling.max-trace-age | buffered traces without a finished local root span are discarded after this time | 1m
+///
+/// Tail sampling works for the default logger, the "opentracing" logger and
+/// tracing::OtlpExporterComponent. A trace is written out if any of its spans
+/// has the tracing::kErrorFlag tag.
 ///
 /// ## Static configuration example:
 ///
@@ -39,8 +50,12 @@ class Tracer final : public impl::ComponentBase {
   static constexpr std::string_view kName = "tracer";
 
   Tracer(const ComponentConfig& config, const ComponentContext& context);
+  ~Tracer() override;
 
   static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  utils::statistics::Entry statistics_holder_;
 };
 
 template <>
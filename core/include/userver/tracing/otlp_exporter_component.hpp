@@ -0,0 +1,78 @@
+#pragma once
+
+/// @file userver/tracing/otlp_exporter_component.hpp
+/// @brief @copybrief tracing::OtlpExporterComponent
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace otlp {
+class Exporter;
+}  // namespace otlp
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that sends finished tracing::Span to an OpenTelemetry
+/// collector via OTLP/HTTP in protobuf encoding.
+///
+/// Spans are batched in a lock-free bounded queue and sent asynchronously.
+/// When the queue is full the spans are dropped and counted in metrics. While
+/// the component is alive spans are not written into the default logger and
+/// the "opentracing" logger.
+///
+/// Span log levels, `no_log_spans` and local log levels are honoured the same
+/// way as for span logging.
+///
+/// The component can be configured in service config.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | URL of the OTLP/HTTP traces receiver, for example 'http://localhost:4318/v1/traces' | -
+/// max-queue-size | max amount of spans waiting for the send | 65536
+/// max-batch-size | max amount of spans in a single request to the collector | 512
+/// max-batch-delay | max time to wait for the batch to fill up | 100ms
+/// http-timeout | timeout of a single request to the collector | 1s
+///
+/// ## Static configuration example:
+///
+/// @code
+/// # yaml
+/// otlp-span-exporter:
+///     endpoint: http://localhost:4318/v1/traces
+///     max-batch-size: 1024
+/// @endcode
+
+// clang-format on
+class OtlpExporterComponent final : public components::LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of tracing::OtlpExporterComponent
+  static constexpr std::string_view kName = "otlp-span-exporter";
+
+  OtlpExporterComponent(const components::ComponentConfig&,
+                        const components::ComponentContext&);
+  ~OtlpExporterComponent() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::shared_ptr<otlp::Exporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace tracing
+
+template <>
+inline constexpr bool
+    components::kHasValidate<tracing::OtlpExporterComponent> = true;
+
+USERVER_NAMESPACE_END
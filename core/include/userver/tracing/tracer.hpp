@@ -17,6 +17,10 @@ namespace tracing {
 
 struct NoLogSpans;
 
+namespace impl {
+class TailSampler;
+}  // namespace impl
+
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
   static void SetNoLogSpans(NoLogSpans&& spans);
@@ -39,6 +43,15 @@ class Tracer : public std::enable_shared_from_this<Tracer> {
 
   logging::LoggerPtr GetOptionalLogger() const { return optional_logger_; }
 
+  /// @cond
+  // For internal use only. Must be called before the tracer is shared.
+  void SetTailSampler(std::shared_ptr<impl::TailSampler> tail_sampler);
+
+  impl::TailSampler* GetTailSampler() const noexcept {
+    return tail_sampler_.get();
+  }
+  /// @endcond
+
  protected:
   explicit Tracer(std::string_view service_name,
                   logging::LoggerPtr optional_logger)
@@ -50,6 +63,7 @@ class Tracer : public std::enable_shared_from_this<Tracer> {
  private:
   const std::string service_name_;
   const logging::LoggerPtr optional_logger_;
+  std::shared_ptr<impl::TailSampler> tail_sampler_;
 };
 
 /// Make a tracer that could be set globally via tracing::Tracer::SetTracer
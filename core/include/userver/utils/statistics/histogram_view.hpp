@@ -42,6 +42,10 @@ class HistogramView final {
   /// (greater than the largest bucket boundary).
   std::uint64_t GetValueAtInf() const noexcept;
 
+  /// Returns the sum of all the accounted values, including the "infinity"
+  /// bucket ones.
+  double GetSum() const noexcept;
+
  private:
   friend struct impl::histogram::Access;
 
@@ -18,6 +18,8 @@ namespace utils::statistics::impl::histogram {
 // The additional first HistogramBucket contains:
 // - size in 'upper_bound'
 // - inf count in 'counter'
+// The additional last HistogramBucket contains the sum of the accounted values
+// as the bits of a double in 'counter'
 union BoundOrSize {
   double bound;
   std::size_t size;
@@ -33,6 +35,11 @@ struct Bucket final {
   std::atomic<std::uint64_t> counter{0};
 };
 
+// The number of Buckets to allocate for `bounds_count` bounds
+constexpr std::size_t GetBucketArraySize(std::size_t bounds_count) noexcept {
+  return bounds_count + 2;
+}
+
 void CopyBounds(Bucket* bucket_array, utils::span<const double> upper_bounds);
 
 void CopyBoundsAndValues(Bucket* destination_array, HistogramView source);
@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file userver/utils/statistics/log_linear_histogram.hpp
+/// @brief @copybrief utils::statistics::LogLinearHistogram
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram_aggregator.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// Settings of utils::statistics::LogLinearHistogram
+struct LogLinearHistogramSettings final {
+  /// Upper bound of the first bucket, must be positive. Values not greater
+  /// than it fall into the first bucket.
+  double lowest_bound{1.0};
+
+  /// Values greater than this bound (rounded up to the nearest bucket bound)
+  /// fall into the "infinity" bucket.
+  double highest_bound{1'000'000.0};
+
+  /// Maximum width of a bucket relative to its lower bound,
+  /// must be in [0.001, 0.5]. The actual precision is rounded to a power of 2.
+  double relative_precision{0.01};
+
+  /// Number of per-thread counter shards, rounded up to a power of 2.
+  /// 0 means the number of hardware threads.
+  std::size_t shards{0};
+};
+
+/// @brief A histogram with log-linear buckets that are generated from
+/// the desired relative precision, with contention-free Account.
+///
+/// Each octave [2^e, 2^(e+1)) of `[lowest_bound, highest_bound]`
+/// (in the units of `lowest_bound`) is split into 2^k linear buckets, where
+/// 2^-k is the closest power of 2 not greater than `relative_precision`.
+/// Bucket lookup is a few bit operations on the value, independent of
+/// the number of buckets. Bucket semantics are the same as in
+/// utils::statistics::Histogram: values on the bucket borders fall into
+/// the lower bucket.
+///
+/// Counters are spread over per-thread shards, each on its own cache lines,
+/// so that concurrent Account calls from different threads do not contend.
+/// Readers sum up the shards in GetSnapshot.
+///
+/// ## Snapshots and serialization
+///
+/// GetSnapshot returns a utils::statistics::HistogramAggregator with all the
+/// buckets. Snapshots of histograms with the same settings can be merged
+/// using utils::statistics::HistogramAggregator::Add.
+///
+/// A log-linear histogram usually has hundreds of buckets, so DumpMetric
+/// writes the coarser octave buckets: the bounds `lowest_bound * 2^e` and
+/// the highest bucket bound. The set of buckets depends only on the settings,
+/// as the monitoring systems expect. Use GetSnapshot for the full precision.
+///
+/// Usage example:
+/// @snippet utils/statistics/log_linear_histogram_test.cpp  sample
+class LogLinearHistogram final {
+ public:
+  explicit LogLinearHistogram(const LogLinearHistogramSettings& settings = {});
+
+  LogLinearHistogram(LogLinearHistogram&&) noexcept;
+  LogLinearHistogram& operator=(LogLinearHistogram&&) noexcept;
+  ~LogLinearHistogram();
+
+  /// Atomically increment the bucket corresponding to the given value
+  /// in the shard of the current thread.
+  void Account(double value, std::uint64_t count = 1) noexcept;
+
+  /// Atomically reset all counters to zero.
+  friend void ResetMetric(LogLinearHistogram& histogram) noexcept;
+
+  /// Sums up the shards into a histogram with all the buckets.
+  HistogramAggregator GetSnapshot() const;
+
+  /// Upper bounds of the non-"infinity" buckets.
+  const std::vector<double>& GetBounds() const noexcept { return bounds_; }
+
+ private:
+  struct CounterLine;
+
+  std::size_t GetBucketIndex(double value) const noexcept;
+  std::size_t GetShardIndex() const noexcept;
+  std::atomic<std::uint64_t>& GetCounter(std::size_t shard,
+                                         std::size_t index) const noexcept;
+  std::uint64_t LoadCounter(std::size_t shard,
+                            std::size_t index) const noexcept;
+
+  std::vector<double> bounds_;
+  double lowest_bound_;
+  // log2 of the number of buckets per octave
+  int precision_bits_;
+  std::size_t shard_mask_;
+  // Each shard takes this many cache lines
+  std::size_t lines_per_shard_;
+  std::unique_ptr<CounterLine[]> lines_;
+};
+
+/// Metric serialization support for LogLinearHistogram, writes the octave
+/// buckets.
+void DumpMetric(Writer& writer, const LogLinearHistogram& histogram);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
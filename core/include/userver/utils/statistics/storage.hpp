@@ -4,9 +4,11 @@
 /// @brief @copybrief utils::statistics::Storage
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -86,8 +88,14 @@ using ExtenderFunc =
 
 using WriterFunc = std::function<void(Writer&)>;
 
+/// Returns a value that changes whenever the metrics of a writer may change,
+/// see Storage::RegisterCachedWriter.
+using WriterGenerationFunc = std::function<std::uint64_t()>;
+
 namespace impl {
 
+struct WriterCache;
+
 struct MetricsSource final {
   std::string prefix_path;
   std::vector<std::string> path_segments;
@@ -95,6 +103,9 @@ struct MetricsSource final {
 
   WriterFunc writer;
   std::vector<Label> writer_labels;
+
+  WriterGenerationFunc generation;
+  std::shared_ptr<WriterCache> cache;
 };
 
 using StorageData = std::list<MetricsSource>;
@@ -104,12 +115,41 @@ inline constexpr bool kCheckSubscriptionUB = utils::impl::kEnableAssert;
 
 }  // namespace impl
 
+/// @brief Output of a single writer recorded by a BaseFormatBuilder, see
+/// Storage::RegisterCachedWriter.
+class CachedFormatOutput {
+ public:
+  virtual ~CachedFormatOutput();
+};
+
 class BaseFormatBuilder {
  public:
   virtual ~BaseFormatBuilder();
 
   virtual void HandleMetric(std::string_view path, LabelsSpan labels,
                             const MetricValue& value) = 0;
+
+  /// @brief Identifies the format and its settings in the cache of the writers
+  /// registered via Storage::RegisterCachedWriter.
+  ///
+  /// Builders that do not support reusing their output return an empty string,
+  /// which is the default.
+  virtual std::string_view GetCachedFormatId() const noexcept;
+
+  /// @brief Starts recording the output of a single writer.
+  ///
+  /// `previous` is the outdated output of the same writer, if any. Builders
+  /// may reuse its rendered metric names and labels.
+  virtual void BeginCachedOutput(const CachedFormatOutput* previous);
+
+  /// Returns the output written since the last BeginCachedOutput call.
+  virtual std::shared_ptr<const CachedFormatOutput> EndCachedOutput();
+
+  /// @brief Appends the output recorded by this format earlier.
+  ///
+  /// Returns false and writes nothing if the output can not be reused at
+  /// the current position, in which case the writer is called again.
+  virtual bool AppendCachedOutput(const CachedFormatOutput& output);
 };
 
 /// @ingroup userver_clients
@@ -143,6 +183,20 @@ class Storage final {
   Entry RegisterWriter(std::string common_prefix, WriterFunc func,
                        std::vector<Label> add_labels = {});
 
+  /// @brief Add a writer function, whose output is reused while `generation`
+  /// returns the same value.
+  ///
+  /// Formats that support it (Prometheus) keep the rendered output of the
+  /// writer and do not call `func` at all while the generation is unchanged,
+  /// which makes scrapes of large, rarely changing sets of metrics cheap.
+  /// Requests with a path, a prefix or required labels always call `func`.
+  ///
+  /// Both `func` and `generation` are called concurrently with other code, so
+  /// they should be thread\coroutine safe.
+  Entry RegisterCachedWriter(std::string common_prefix, WriterFunc func,
+                             WriterGenerationFunc generation,
+                             std::vector<Label> add_labels = {});
+
   /// @deprecated Use RegisterWriter instead.
   Entry RegisterExtender(std::string prefix, ExtenderFunc func);
 
@@ -152,6 +206,13 @@ class Storage final {
  private:
   Entry DoRegisterExtender(impl::MetricsSource&& source);
 
+  // Returns false if the writer has thrown
+  static bool VisitWriter(const impl::MetricsSource& entry,
+                          impl::WriterState& state);
+  static void VisitCachedWriter(const impl::MetricsSource& entry,
+                                impl::WriterState& state,
+                                std::string_view format_id);
+
   std::atomic<bool> may_register_extenders_;
   impl::StorageData metrics_sources_;
   mutable engine::SharedMutex mutex_;
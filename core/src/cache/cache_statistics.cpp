@@ -46,6 +46,10 @@ void CombineStatistics(const impl::UpdateStatistics& a,
                b.last_successful_update_start_time.load());
   result.last_update_duration =
       std::max(a.last_update_duration.load(), b.last_update_duration.load());
+  result.last_update_slowest_partition_duration =
+      std::max(a.last_update_slowest_partition_duration.load(),
+               b.last_update_slowest_partition_duration.load());
+  result.is_partitioned = a.is_partitioned.load() || b.is_partitioned.load();
 }
 
 }  // namespace
@@ -74,6 +78,10 @@ void DumpMetric(utils::statistics::Writer& writer,
         std::chrono::duration_cast<std::chrono::milliseconds>(
             stats.last_update_duration.load())
             .count();
+    if (stats.is_partitioned) {
+      age["last-update-slowest-partition-ms"] =
+          stats.last_update_slowest_partition_duration.load().count();
+    }
   }
 }
 
@@ -137,6 +145,16 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += add;
 }
 
+void UpdateStatisticsScope::AccountPartitionDuration(
+    std::chrono::milliseconds duration) {
+  has_partitions_ = true;
+  auto& slowest = slowest_partition_duration_;
+  auto current = slowest.load();
+  while (current < duration &&
+         !slowest.compare_exchange_weak(current, duration)) {
+  }
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
@@ -150,6 +168,9 @@ void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   update_stats_.last_update_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time -
                                                             update_start_time_);
+  update_stats_.last_update_slowest_partition_duration =
+      slowest_partition_duration_.load();
+  if (has_partitions_) update_stats_.is_partitioned = true;
 
   state_ = new_state;
 }
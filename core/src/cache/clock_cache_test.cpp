@@ -0,0 +1,140 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/cache/impl/clock_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ClockMap = cache::impl::ClockMap<int, int>;
+using ClockCache = cache::impl::ClockCache<int, std::string>;
+
+std::optional<int> Find(const ClockMap& map, int key) {
+  std::optional<int> result;
+  map.Visit(key, [&result](int value) { result = value; });
+  return result;
+}
+
+}  // namespace
+
+UTEST(ClockMap, PutVisitErase) {
+  cache::impl::ReadEpoch epoch;
+  ClockMap map(10, epoch);
+
+  map.Put(1, 10);
+  map.Put(2, 20);
+  EXPECT_EQ(Find(map, 1), 10);
+  EXPECT_EQ(Find(map, 2), 20);
+  EXPECT_EQ(Find(map, 3), std::nullopt);
+  EXPECT_EQ(map.GetSize(), 2);
+
+  map.Put(1, 11);
+  EXPECT_EQ(Find(map, 1), 11);
+  EXPECT_EQ(map.GetSize(), 2);
+
+  map.EraseIf(1, [](int value) { return value == 10; });
+  EXPECT_EQ(Find(map, 1), 11);
+  map.Erase(1);
+  EXPECT_EQ(Find(map, 1), std::nullopt);
+  EXPECT_EQ(map.GetSize(), 1);
+
+  map.Clear();
+  EXPECT_EQ(map.GetSize(), 0);
+  EXPECT_EQ(Find(map, 2), std::nullopt);
+}
+
+UTEST(ClockMap, Capacity) {
+  constexpr std::size_t kMaxSize = 100;
+  cache::impl::ReadEpoch epoch;
+  ClockMap map(kMaxSize, epoch);
+
+  // Erased keys leave tombstones, the table is rebuilt to drop them
+  for (int i = 0; i < 10'000; ++i) {
+    map.Put(i, i);
+    if (i % 3 == 1) map.Erase(i);
+    ASSERT_LE(map.GetSize(), kMaxSize);
+  }
+  EXPECT_EQ(map.GetSize(), kMaxSize);
+
+  std::size_t visited = 0;
+  map.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, kMaxSize);
+
+  map.SetMaxSize(10);
+  EXPECT_EQ(map.GetSize(), 10);
+}
+
+UTEST(ClockMap, EvictionKeepsReferenced) {
+  constexpr int kMaxSize = 10;
+  cache::impl::ReadEpoch epoch;
+  ClockMap map(kMaxSize, epoch);
+  for (int i = 0; i < kMaxSize; ++i) map.Put(i, i);
+
+  for (int i = 0; i < kMaxSize; i += 2) Find(map, i);
+
+  // The hand evicts the keys that were not accessed before it reaches them
+  for (int i = kMaxSize; i < kMaxSize + kMaxSize / 2; ++i) map.Put(i, i);
+  EXPECT_EQ(map.GetSize(), kMaxSize);
+  for (int i = 0; i < kMaxSize; i += 2) {
+    EXPECT_EQ(Find(map, i), i) << "key " << i;
+  }
+}
+
+UTEST(ClockCache, Get) {
+  ClockCache cache(4, 10, {}, {});
+  cache.Put(1, "one");
+  EXPECT_EQ(cache.Get(1, [](const std::string&) { return true; }), "one");
+
+  EXPECT_EQ(cache.Get(1, [](const std::string&) { return false; }),
+            std::nullopt);
+  EXPECT_EQ(cache.GetSize(), 0);
+
+  cache.Put(2, "two");
+  cache.Erase(2);
+  EXPECT_EQ(cache.Get(2, [](const std::string&) { return true; }),
+            std::nullopt);
+}
+
+UTEST_MT(ClockCache, ConcurrentReadersAndWriters, 4) {
+  constexpr int kKeys = 1000;
+  // Small ways, so that the nodes are evicted and freed all the time
+  ClockCache cache(2, 50, {}, {});
+
+  std::atomic<bool> keep_running{true};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < GetThreadCount() - 1; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, i] {
+      for (int key = 0; keep_running; key = (key + 1) % kKeys) {
+        const auto value =
+            cache.Get(key, [](const std::string&) { return true; });
+        if (value) {
+          ASSERT_EQ(*value, std::to_string(key));
+        }
+        if (key % 7 == static_cast<int>(i)) cache.Erase(key);
+      }
+    }));
+  }
+
+  for (int round = 0; round < 50; ++round) {
+    for (int key = 0; key < kKeys; ++key) {
+      cache.Put(key, std::to_string(key));
+    }
+    if (round % 10 == 0) cache.SetWaySize(40 + round);
+  }
+  keep_running = false;
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(cache.GetSize(), 2 * (40 + 40));
+}
+
+USERVER_NAMESPACE_END
@@ -72,6 +72,15 @@ properties:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    policy:
+        type: string
+        description: eviction policy, can not be changed by the dynamic config
+        defaultDescription: lru
+        enum:
+          - lru
+          - slru
+          - w-tinylfu
+          - clock
 )");
 }
 
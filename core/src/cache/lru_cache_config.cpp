@@ -6,6 +6,7 @@
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,6 +19,15 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kPolicy = "policy";
+
+constexpr utils::TrivialBiMap kCachePolicyMap([](auto selector) {
+  return selector()
+      .Case(CachePolicy::kLRU, "lru")
+      .Case(CachePolicy::kSLRU, "slru")
+      .Case(CachePolicy::kWTinyLFU, "w-tinylfu")
+      .Case(CachePolicy::kClock, "clock");
+});
 
 }  // namespace
 
@@ -54,11 +64,21 @@ LruCacheConfig Parse(const formats::json::Value& value,
   return LruCacheConfig{value};
 }
 
+CachePolicy Parse(const yaml_config::YamlConfig& config,
+                  formats::parse::To<CachePolicy>) {
+  return utils::ParseFromValueString(config, kCachePolicyMap);
+}
+
+std::string_view ToString(CachePolicy policy) {
+  return utils::impl::EnumToStringView(policy, kCachePolicyMap);
+}
+
 LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      policy(config[kPolicy].As<CachePolicy>(CachePolicy::kLRU)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
 
@@ -0,0 +1,74 @@
+#include <userver/cache/nway_lru_cache.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1024;
+constexpr std::uint64_t kKeys = kWays * kWaySize;
+
+using Cache = cache::NWayLRU<std::uint64_t, std::uint64_t>;
+
+// Most of the lookups hit a handful of hot keys, so the ways of the hot keys
+// are contended
+std::uint64_t GetKey(std::uint64_t i) {
+  return i % 4 == 0 ? (i * 0x9e3779b97f4a7c15ULL) % kKeys : i % 8;
+}
+
+}  // namespace
+
+// Each of range(0) threads runs the lookups, every range(1)-th one is a Put
+template <cache::CachePolicy Policy>
+void nway_lru_cache_mixed(benchmark::State& state) {
+  const std::size_t threads = state.range(0);
+  const std::uint64_t put_every = state.range(1);
+
+  engine::RunStandalone(threads, [&] {
+    Cache cache(kWays, kWaySize, Policy);
+    for (std::uint64_t i = 0; i < kKeys; ++i) cache.Put(i, i);
+
+    const auto run = [&cache, put_every](std::uint64_t i) {
+      const auto key = GetKey(i);
+      if (put_every != 0 && i % put_every == 0) {
+        cache.Put(key, i);
+      } else {
+        benchmark::DoNotOptimize(cache.Get(key));
+      }
+    };
+
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads - 1);
+    for (std::size_t thread_id = 1; thread_id < threads; ++thread_id) {
+      tasks.push_back(engine::AsyncNoSpan([&, thread_id] {
+        for (std::uint64_t i = thread_id; keep_running; i += threads) run(i);
+      }));
+    }
+
+    std::uint64_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      run(i);
+      i += threads;
+    }
+
+    keep_running = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+BENCHMARK_TEMPLATE(nway_lru_cache_mixed, cache::CachePolicy::kLRU)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 10}});
+BENCHMARK_TEMPLATE(nway_lru_cache_mixed, cache::CachePolicy::kClock)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 10}});
+
+USERVER_NAMESPACE_END
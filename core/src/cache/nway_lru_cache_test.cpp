@@ -54,6 +54,29 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, Policies) {
+  for (const auto policy :
+       {cache::CachePolicy::kLRU, cache::CachePolicy::kSLRU,
+        cache::CachePolicy::kWTinyLFU, cache::CachePolicy::kClock}) {
+    Cache cache(2, 10, policy);
+    for (int i = 0; i < 100; ++i) cache.Put(i, i);
+    EXPECT_EQ(20, cache.GetSize());
+
+    cache.Put(1000, 1);
+    EXPECT_EQ(1, cache.Get(1000));
+    EXPECT_EQ(1, cache.GetOr(1000, -1));
+
+    cache.InvalidateByKey(1000);
+    EXPECT_FALSE(cache.Get(1000).has_value());
+
+    cache.UpdateWaySize(5);
+    EXPECT_GE(10, cache.GetSize());
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetSize());
+  }
+}
+
 UTEST(NWayLRU, HashCombine) {
   for (const auto seed : std::vector<std::size_t>{0, 1, 7, 42, 100, 1000}) {
     /// @note: checking for seed used in way selection to not be equal after
@@ -0,0 +1,78 @@
+#include <userver/cache/impl/read_epoch.hpp>
+
+#include <algorithm>
+#include <thread>
+
+#include <userver/utils/assert.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <concurrent/impl/thread_index.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize)
+    ReadEpoch::ReaderSlot final {
+  /* Readers of the even and of the odd epochs */
+  std::atomic<std::int64_t> readers[2]{};
+};
+
+ReadEpoch::ReadEpoch() {
+  const auto slots = concurrent::impl::RoundUpToPowerOf2(
+      std::max(std::thread::hardware_concurrency(), 1U));
+  slot_mask_ = slots - 1;
+  slots_ = std::make_unique<ReaderSlot[]>(slots);
+}
+
+ReadEpoch::~ReadEpoch() = default;
+
+ReadEpoch::ReadGuard ReadEpoch::Enter() noexcept {
+  auto& slot = GetSlot();
+  auto epoch = epoch_.load(std::memory_order_seq_cst);
+  while (true) {
+    auto& counter = slot.readers[epoch & 1];
+    counter.fetch_add(1, std::memory_order_seq_cst);
+
+    /* Paired with the check of the readers in TryAdvance(): a reader is
+     * either seen by the writer, or sees the epoch advanced by it and retries.
+     * So an active reader of the epoch E has entered before E + 1 began.
+     */
+    const auto current = epoch_.load(std::memory_order_seq_cst);
+    if (current == epoch) return ReadGuard{counter};
+
+    counter.fetch_sub(1, std::memory_order_relaxed);
+    epoch = current;
+  }
+}
+
+std::uint64_t ReadEpoch::GetCurrent() const noexcept {
+  return epoch_.load(std::memory_order_seq_cst);
+}
+
+std::uint64_t ReadEpoch::TryAdvance() noexcept {
+  auto epoch = epoch_.load(std::memory_order_seq_cst);
+
+  const auto previous_parity = (epoch + 1) & 1;
+  std::int64_t readers = 0;
+  for (std::size_t i = 0; i <= slot_mask_; ++i) {
+    readers +=
+        slots_[i].readers[previous_parity].load(std::memory_order_seq_cst);
+  }
+  UASSERT(readers >= 0);
+  if (readers != 0) return epoch;
+
+  /* Fails if another writer has advanced the epoch concurrently */
+  epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+  return epoch_.load(std::memory_order_seq_cst);
+}
+
+// Threads get sequential indexes, so up to 'hardware_concurrency' threads
+// never share a slot.
+ReadEpoch::ReaderSlot& ReadEpoch::GetSlot() noexcept {
+  return slots_[concurrent::impl::GetCurrentThreadIndex() & slot_mask_];
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
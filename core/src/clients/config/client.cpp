@@ -4,12 +4,25 @@
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config {
 namespace {
+
 const std::string kConfigsValues = "/configs/values";
+
+Client::Reply ParseDocsMapReply(const formats::json::Value& json_value) {
+  auto configs_json = json_value["configs"];
+
+  Client::Reply reply;
+  reply.docs_map.Parse(formats::json::ToString(configs_json), true);
+
+  reply.timestamp = json_value["updated_at"].As<std::string>();
+  return reply;
+}
+
 }  // namespace
 
 Client::Client(clients::http::Client& http_client, const ClientConfig& config)
@@ -17,8 +30,9 @@ Client::Client(clients::http::Client& http_client, const ClientConfig& config)
 
 Client::~Client() = default;
 
-std::string Client::FetchConfigsValues(const std::string& body) {
-  const auto timeout_ms = config_.timeout.count();
+std::string Client::FetchConfigsValues(const std::string& body,
+                                       std::chrono::milliseconds timeout) {
+  const auto timeout_ms = timeout.count();
   const auto retries = config_.retries;
   const auto url = config_.append_path_to_url
                        ? config_.config_url + kConfigsValues
@@ -67,14 +81,14 @@ std::string Client::FetchConfigsValues(const std::string& body) {
 Client::Reply Client::FetchDocsMap(
     const std::optional<Timestamp>& last_update,
     const std::vector<std::string>& fields_to_load) {
-  auto json_value = FetchConfigs(last_update, fields_to_load);
-  auto configs_json = json_value["configs"];
-
-  Reply reply;
-  reply.docs_map.Parse(formats::json::ToString(configs_json), true);
+  return ParseDocsMapReply(FetchConfigs(last_update, fields_to_load));
+}
 
-  reply.timestamp = json_value["updated_at"].As<std::string>();
-  return reply;
+Client::Reply Client::WaitForDocsMapUpdates(
+    const Timestamp& last_update,
+    const std::vector<std::string>& fields_to_load) {
+  return ParseDocsMapReply(
+      FetchConfigs(last_update, fields_to_load, /*long_poll=*/true));
 }
 
 Client::Reply Client::DownloadFullDocsMap() {
@@ -96,7 +110,7 @@ Client::JsonReply Client::FetchJson(
 
 formats::json::Value Client::FetchConfigs(
     const std::optional<Timestamp>& last_update,
-    formats::json::ValueBuilder&& fields_to_load) {
+    formats::json::ValueBuilder&& fields_to_load, bool long_poll) {
   formats::json::ValueBuilder body_builder(formats::json::Type::kObject);
 
   if (!fields_to_load.IsEmpty()) {
@@ -115,10 +129,19 @@ formats::json::Value Client::FetchConfigs(
     body_builder["service"] = config_.service_name;
   }
 
+  auto timeout = config_.timeout;
+  if (long_poll) {
+    UINVARIANT(config_.long_poll_timeout.count() > 0,
+               "Long polling is disabled by a zero long_poll_timeout");
+    body_builder["long_poll_timeout_ms"] = config_.long_poll_timeout.count();
+    // The service replies after the long poll timeout at the latest
+    timeout += config_.long_poll_timeout;
+  }
+
   auto request_body = formats::json::ToString(body_builder.ExtractValue());
   LOG_TRACE() << "request body: " << request_body;
 
-  auto json = FetchConfigsValues(request_body);
+  auto json = FetchConfigsValues(request_body, timeout);
 
   return formats::json::FromString(json);
 }
@@ -0,0 +1,69 @@
+#include <userver/dynamic_config/client/client.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/http_server_mock.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kTimeout{50};
+constexpr std::chrono::milliseconds kReplyDelay{200};
+
+}  // namespace
+
+UTEST(DynamicConfigClient, WaitForDocsMapUpdates) {
+  utest::HttpServerMock mock_server(
+      [](const utest::HttpServerMock::HttpRequest& request) {
+        EXPECT_EQ(request.path, "/configs/values");
+        const auto body = formats::json::FromString(request.body);
+        EXPECT_EQ(body["updated_since"].As<std::string>(), "2023-01-01");
+        EXPECT_EQ(body["ids"][0].As<std::string>(), "FOO");
+        EXPECT_EQ(body["long_poll_timeout_ms"].As<std::int64_t>(),
+                  std::chrono::milliseconds{utest::kMaxTestWaitTime}.count());
+
+        // The service holds the request until a config changes
+        engine::SleepFor(kReplyDelay);
+        return utest::HttpServerMock::HttpResponse{
+            200, {}, R"({"configs":{"FOO":42},"updated_at":"2023-01-02"})"};
+      });
+  const auto http_client = utest::CreateHttpClient();
+
+  dynamic_config::ClientConfig config;
+  config.service_name = "service";
+  config.config_url = mock_server.GetBaseUrl();
+  // The long poll is longer than the usual request timeout
+  config.timeout = kTimeout;
+  config.long_poll_timeout = utest::kMaxTestWaitTime;
+  dynamic_config::Client client{*http_client, config};
+
+  const auto reply = client.WaitForDocsMapUpdates("2023-01-01", {"FOO"});
+  EXPECT_EQ(reply.timestamp, "2023-01-02");
+  EXPECT_EQ(reply.docs_map.Get("FOO").As<int>(), 42);
+}
+
+UTEST(DynamicConfigClient, FetchDocsMapIsNotLongPoll) {
+  utest::HttpServerMock mock_server(
+      [](const utest::HttpServerMock::HttpRequest& request) {
+        const auto body = formats::json::FromString(request.body);
+        EXPECT_FALSE(body.HasMember("long_poll_timeout_ms"));
+        return utest::HttpServerMock::HttpResponse{
+            200, {}, R"({"configs":{},"updated_at":"2023-01-02"})"};
+      });
+  const auto http_client = utest::CreateHttpClient();
+
+  dynamic_config::ClientConfig config;
+  config.service_name = "service";
+  config.config_url = mock_server.GetBaseUrl();
+  config.timeout = utest::kMaxTestWaitTime;
+  dynamic_config::Client client{*http_client, config};
+
+  const auto reply = client.FetchDocsMap("2023-01-01", {"FOO"});
+  EXPECT_EQ(reply.timestamp, "2023-01-02");
+  EXPECT_EQ(reply.docs_map.Size(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -166,6 +166,12 @@ properties:
                         tunes the number of spin-wait iterations in case of
                         an empty task queue before threads go to sleep
                     defaultDescription: 10000
+                timer-wheel:
+                    type: boolean
+                    description: |
+                        keep deadline timers of tasks in a per-worker timing
+                        wheel instead of the ev threads
+                    defaultDescription: false
                 task-trace:
                     type: object
                     description: .
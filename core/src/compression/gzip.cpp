@@ -1,5 +1,9 @@
 #include <compression/gzip.hpp>
 
+#include <algorithm>
+#include <cstring>
+
+#include <boost/iostreams/concepts.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -8,10 +12,42 @@ USERVER_NAMESPACE_BEGIN
 namespace compression::gzip {
 
 namespace {
+
 constexpr auto kDecompressBufferSize = 1024;
-}
 
-std::string Decompress(std::string_view compressed, size_t max_size) {
+namespace bio = boost::iostreams;
+
+// Reads the pieces one after another
+class PiecesSource final : public bio::source {
+ public:
+  explicit PiecesSource(const std::vector<std::string_view>& pieces)
+      : pieces_(&pieces) {}
+
+  std::streamsize read(char* s, std::streamsize n) {
+    std::streamsize total = 0;
+    while (total < n && piece_index_ < pieces_->size()) {
+      const auto piece = (*pieces_)[piece_index_];
+      const auto count = std::min(piece.size() - piece_offset_,
+                                  static_cast<std::size_t>(n - total));
+      std::memcpy(s + total, piece.data() + piece_offset_, count);
+      total += static_cast<std::streamsize>(count);
+      piece_offset_ += count;
+      if (piece_offset_ == piece.size()) {
+        ++piece_index_;
+        piece_offset_ = 0;
+      }
+    }
+    return total ? total : -1;
+  }
+
+ private:
+  const std::vector<std::string_view>* pieces_;
+  std::size_t piece_index_{0};
+  std::size_t piece_offset_{0};
+};
+
+template <typename Source>
+std::string DecompressImpl(Source&& source, size_t max_size) {
   std::string decompressed;
 
   // A guess for "small" data chunk
@@ -19,11 +55,9 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   // (stdlibc++ allocates capacity+1 bytes).
   decompressed.reserve(kDecompressBufferSize - 1);
 
-  namespace bio = boost::iostreams;
-
   bio::filtering_istream stream;
   stream.push(bio::gzip_decompressor());
-  stream.push(bio::array_source(compressed.data(), compressed.size()));
+  stream.push(std::forward<Source>(source));
 
   while (stream && (decompressed.size() < max_size)) {
     char buf[kDecompressBufferSize];
@@ -38,6 +72,18 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+}  // namespace
+
+std::string Decompress(std::string_view compressed, size_t max_size) {
+  return DecompressImpl(bio::array_source(compressed.data(), compressed.size()),
+                        max_size);
+}
+
+std::string Decompress(const std::vector<std::string_view>& compressed,
+                       size_t max_size) {
+  return DecompressImpl(PiecesSource{compressed}, max_size);
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string_view>
+#include <vector>
 
 #include <compression/error.hpp>
 
@@ -12,6 +13,12 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Decompresses the concatenation of `compressed` pieces without
+/// concatenating them.
+/// @throws DecompressionError
+std::string Decompress(const std::vector<std::string_view>& compressed,
+                       size_t max_size);
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
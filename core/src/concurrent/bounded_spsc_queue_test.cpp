@@ -0,0 +1,158 @@
+#include <userver/concurrent/bounded_spsc_queue.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Queue = concurrent::BoundedSpscQueue<std::size_t>;
+
+constexpr std::size_t kMessageCount = 10000;
+
+}  // namespace
+
+UTEST(BoundedSpscQueue, Ctr) {
+  auto queue = Queue::Create(10);
+  EXPECT_EQ(queue->GetCapacity(), 10);
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+}
+
+UTEST(BoundedSpscQueue, Fifo) {
+  auto queue = Queue::Create(100);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(producer.Push(std::size_t{i}));
+    EXPECT_EQ(queue->GetSizeApproximate(), i + 1);
+  }
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    std::size_t value{};
+    EXPECT_TRUE(consumer.Pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+}
+
+UTEST(BoundedSpscQueue, Capacity) {
+  auto queue = concurrent::BoundedSpscQueue<std::unique_ptr<int>>::Create(3);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(producer.PushNoblock(std::make_unique<int>(i)));
+  }
+
+  auto value = std::make_unique<int>(3);
+  EXPECT_FALSE(producer.PushNoblock(std::move(value)));
+  EXPECT_TRUE(value);
+  EXPECT_FALSE(producer.Push(std::move(value), engine::Deadline::Passed()));
+  EXPECT_TRUE(value);
+
+  std::unique_ptr<int> popped;
+  EXPECT_TRUE(consumer.PopNoblock(popped));
+  EXPECT_EQ(*popped, 0);
+  EXPECT_TRUE(producer.PushNoblock(std::move(value)));
+}
+
+UTEST(BoundedSpscQueue, WrapAround) {
+  auto queue = Queue::Create(5);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < 100; i += 3) {
+    std::vector<std::size_t> values{i, i + 1, i + 2};
+    EXPECT_EQ(producer.PushMany(values), 3);
+
+    std::vector<std::size_t> popped(4);
+    EXPECT_EQ(consumer.PopMany(popped), 3);
+    for (std::size_t j = 0; j < 3; ++j) {
+      EXPECT_EQ(popped[j], expected++);
+    }
+  }
+}
+
+UTEST(BoundedSpscQueue, QueueCleanUp) {
+  auto value = std::make_shared<int>(1);
+  auto queue = concurrent::BoundedSpscQueue<std::shared_ptr<int>>::Create(4);
+  {
+    auto producer = queue->GetProducer();
+    EXPECT_TRUE(producer.Push(std::shared_ptr{value}));
+    EXPECT_TRUE(producer.Push(std::shared_ptr{value}));
+  }
+  EXPECT_EQ(value.use_count(), 3);
+
+  queue = nullptr;
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+UTEST(BoundedSpscQueue, Block) {
+  auto queue = Queue::Create(1);
+
+  auto consumer_task =
+      utils::Async("consumer", [consumer = queue->GetConsumer()] {
+        std::size_t value{};
+        EXPECT_TRUE(consumer.Pop(value));
+        EXPECT_EQ(value, 0);
+
+        EXPECT_TRUE(consumer.Pop(value));
+        EXPECT_EQ(value, 1);
+
+        EXPECT_FALSE(consumer.Pop(value));
+      });
+
+  {
+    auto producer = queue->GetProducer();
+    EXPECT_TRUE(producer.Push(0));
+    EXPECT_TRUE(producer.Push(1));
+  }
+
+  consumer_task.Get();
+}
+
+UTEST(BoundedSpscQueue, ConsumerIsDead) {
+  auto queue = Queue::Create(1);
+  auto producer = queue->GetProducer();
+
+  EXPECT_TRUE(producer.Push(0));
+  (void)queue->GetConsumer();
+  EXPECT_FALSE(producer.Push(1));
+}
+
+UTEST_MT(BoundedSpscQueue, Batches, 1 + 1) {
+  auto queue = Queue::Create(64);
+
+  auto producer = queue->GetProducer();
+  auto producer_task = utils::Async("producer", [&] {
+    std::vector<std::size_t> values(48);
+    for (std::size_t message = 0; message < kMessageCount;) {
+      values.resize(std::min(values.size(), kMessageCount - message));
+      for (auto& value : values) value = message++;
+      ASSERT_EQ(producer.PushMany(values), values.size());
+    }
+  });
+
+  auto consumer = queue->GetConsumer();
+  std::size_t expected = 0;
+  std::vector<std::size_t> popped(40);
+  while (expected < kMessageCount) {
+    const auto count = consumer.PopMany(popped);
+    ASSERT_NE(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(popped[i], expected++);
+    }
+  }
+
+  producer_task.Get();
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+}
+
+USERVER_NAMESPACE_END
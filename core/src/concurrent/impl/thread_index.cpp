@@ -0,0 +1,37 @@
+#include <concurrent/impl/thread_index.hpp>
+
+#include <atomic>
+
+#include <userver/compiler/thread_local.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+namespace {
+
+constexpr auto kNoThreadIndex = static_cast<std::size_t>(-1);
+
+std::atomic<std::size_t> next_thread_index{0};
+
+compiler::ThreadLocal local_thread_index = [] { return kNoThreadIndex; };
+
+}  // namespace
+
+std::size_t GetCurrentThreadIndex() noexcept {
+  auto thread_index = local_thread_index.Use();
+  if (*thread_index == kNoThreadIndex) {
+    *thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  }
+  return *thread_index;
+}
+
+std::size_t RoundUpToPowerOf2(std::size_t value) noexcept {
+  std::size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
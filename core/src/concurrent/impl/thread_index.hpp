@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+/// Returns the sequential index of the current thread, stable for the thread
+/// lifetime. The first N threads to call the function get indexes [0, N).
+///
+/// Used to pick a per-thread shard of a counter. Coroutines may migrate to
+/// another thread between the calls, so the shards must stay consistent for
+/// any thread-to-shard mapping.
+std::size_t GetCurrentThreadIndex() noexcept;
+
+/// Returns the smallest power of 2 that is not less than `value`
+std::size_t RoundUpToPowerOf2(std::size_t value) noexcept;
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
+#include <userver/concurrent/bounded_spsc_queue.hpp>
 #include <userver/concurrent/mpsc_queue.hpp>
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -95,4 +98,50 @@ BENCHMARK_TEMPLATE(producer_consumer, concurrent::MpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 1}, {1'000'000'000, 1'000'000'000}});
 
+// Single producer and single consumer passing `state.range(0)` elements at
+// once through PushMany and PopMany
+template <typename QueueType>
+void producer_consumer_batch(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    const std::size_t batch_size = state.range(0);
+    auto queue = QueueType::Create(1024);
+
+    auto consumer_task =
+        utils::Async("consumer", [consumer = queue->GetConsumer(), batch_size] {
+          std::vector<std::size_t> values(batch_size);
+          while (consumer.PopMany(values) != 0) {
+            benchmark::DoNotOptimize(values.data());
+          }
+        });
+
+    {
+      std::vector<std::size_t> values(batch_size);
+      std::size_t message = 0;
+      auto producer = queue->GetProducer();
+      for ([[maybe_unused]] auto _ : state) {
+        for (auto& value : values) value = message++;
+        const auto pushed = producer.PushMany(values);
+        benchmark::DoNotOptimize(pushed);
+      }
+    }
+
+    consumer_task.Get();
+    state.SetItemsProcessed(state.iterations() * batch_size);
+  });
+}
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::NonFifoMpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 256);
+
+BENCHMARK_TEMPLATE(producer_consumer_batch, concurrent::SpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 256);
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::BoundedSpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 256);
+
 USERVER_NAMESPACE_END
@@ -1,7 +1,9 @@
 #include <userver/concurrent/queue.hpp>
 
+#include <algorithm>
 #include <optional>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/range/irange.hpp>
 
@@ -307,6 +309,76 @@ UTEST_MT(NonFifoSpscQueue, Spsc, 1 + 1) {
                           [](int item) { return item == 1; }));
 }
 
+template <typename T>
+class QueueBatchTest : public ::testing::Test {};
+
+TYPED_UTEST_SUITE(QueueBatchTest, TestQueueTypes);
+
+TYPED_UTEST(QueueBatchTest, PushManyPopMany) {
+  auto queue = TypeParam::Create();
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> values{0, 1, 2, 3, 4};
+  EXPECT_EQ(producer.PushMany(values), 5);
+  EXPECT_EQ(queue->GetSizeApproximate(), 5);
+
+  std::vector<std::size_t> popped(3);
+  EXPECT_EQ(consumer.PopMany(popped), 3);
+  EXPECT_EQ(queue->GetSizeApproximate(), 2);
+
+  std::vector<std::size_t> rest(10);
+  EXPECT_EQ(consumer.PopMany(rest), 2);
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+
+  popped.insert(popped.end(), rest.begin(), rest.begin() + 2);
+  std::sort(popped.begin(), popped.end());
+  EXPECT_EQ(popped, values);
+
+  EXPECT_EQ(consumer.PopMany(rest, engine::Deadline::Passed()), 0);
+}
+
+TYPED_UTEST(QueueBatchTest, PushManyOverCapacity) {
+  auto queue = TypeParam::Create(3);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> values{0, 1, 2, 3, 4};
+  EXPECT_EQ(producer.PushMany(values, engine::Deadline::Passed()), 3);
+  EXPECT_EQ(queue->GetSizeApproximate(), 3);
+
+  auto task = utils::Async("pusher", [&] {
+    return producer.PushMany(utils::span<std::size_t>(values).subspan(3, 2));
+  });
+
+  std::vector<std::size_t> popped;
+  std::vector<std::size_t> buffer(2);
+  while (popped.size() < values.size()) {
+    const auto count = consumer.PopMany(buffer);
+    ASSERT_NE(count, 0);
+    popped.insert(popped.end(), buffer.begin(), buffer.begin() + count);
+  }
+  EXPECT_EQ(task.Get(), 2);
+
+  std::sort(popped.begin(), popped.end());
+  EXPECT_EQ(popped, (std::vector<std::size_t>{0, 1, 2, 3, 4}));
+}
+
+TYPED_UTEST(QueueBatchTest, PopManyProducerIsDead) {
+  auto queue = TypeParam::Create();
+  auto consumer = queue->GetConsumer();
+
+  {
+    auto producer = queue->GetProducer();
+    std::vector<std::size_t> values{1, 2};
+    EXPECT_EQ(producer.PushMany(values), 2);
+  }
+
+  std::vector<std::size_t> popped(4);
+  EXPECT_EQ(consumer.PopMany(popped), 2);
+  EXPECT_EQ(consumer.PopMany(popped), 0);
+}
+
 // TODO(TAXICOMMON-7429) the test occasionally hangs; fix and re-enable
 UTEST_MT(QueueFixture, DISABLED_MultiConsumerToken,
          kProducersCount + kConsumersCount) {
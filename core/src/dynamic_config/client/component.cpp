@@ -50,6 +50,9 @@ DynamicConfigClient::DynamicConfigClient(const ComponentConfig& config,
   client_config.config_url = config["config-url"].As<std::string>();
   client_config.fallback_to_no_proxy =
       config["fallback-to-no-proxy"].As<bool>(true);
+  client_config.long_poll_timeout =
+      config["long-poll-timeout"].As<std::chrono::milliseconds>(
+          client_config.long_poll_timeout);
 
   if (!client_config.stage_name.empty() &&
       client_config.get_configs_overrides_for_service) {
@@ -103,6 +106,10 @@ properties:
         type: boolean
         description: add default path '/configs/values' to 'config-url'
         defaultDescription: true
+    long-poll-timeout:
+        type: string
+        description: how long the configs service may hold a long poll request if there are no config changes, see 'long-poll' option of dynamic-config-client-updater
+        defaultDescription: 30s
 )");
 }
 
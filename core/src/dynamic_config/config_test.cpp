@@ -408,6 +408,25 @@ UTEST(DynamicConfig, CustomSubscription) {
   EXPECT_EQ(subscriber.GetCounter(), 2);
 }
 
+UTEST(DynamicConfig, CustomSubsetSubscription) {
+  dynamic_config::StorageMock storage{{kIntConfig, 1}, {kBoolConfig, false}};
+  auto source = storage.GetSource();
+  CustomSubscriber subscriber;
+
+  auto scope = source.UpdateAndListen(
+      &subscriber, "", &CustomSubscriber::OnConfigUpdate, kIntConfig);
+  EXPECT_EQ(subscriber.GetCounter(), 1);
+
+  storage.Extend({{kBoolConfig, true}});
+  EXPECT_EQ(subscriber.GetCounter(), 1);
+
+  storage.Extend({{kIntConfig, 2}});
+  EXPECT_EQ(subscriber.GetCounter(), 2);
+
+  storage.Extend({{kIntConfig, 2}, {kBoolConfig, false}});
+  EXPECT_EQ(subscriber.GetCounter(), 2);
+}
+
 class ConfigSubscriber final {
  public:
   /*! [Custom subscription for dynamic config update] */
@@ -1,11 +1,16 @@
 #include <userver/dynamic_config/updater/component.hpp>
 
+#include <algorithm>
+
 #include <userver/cache/update_type.hpp>
 #include <userver/clients/http/component.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/client/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/updates_sink/find.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/fs/read.hpp>
 #include <userver/utils/algo.hpp>
@@ -19,6 +24,8 @@ namespace components {
 
 namespace {
 
+constexpr std::chrono::seconds kLongPollRetryDelay{1};
+
 std::optional<cache::AllowedUpdateTypes> ParseDeduplicateUpdateTypes(
     const yaml_config::YamlConfig& value) {
   const auto str = value.As<std::optional<std::string>>();
@@ -63,6 +70,7 @@ DynamicConfigClientUpdater::DynamicConfigClientUpdater(
       store_enabled_(component_config["store-enabled"].As<bool>(true)),
       deduplicate_update_types_(ParseDeduplicateUpdateTypes(
           component_config["deduplicate-update-types"])),
+      long_poll_(component_config["long-poll"].As<bool>(false)),
       config_client_(
           component_context.FindComponent<components::DynamicConfigClient>()
               .GetClient()),
@@ -81,9 +89,15 @@ DynamicConfigClientUpdater::DynamicConfigClientUpdater(
      */
     StartPeriodicUpdates(Flag::kNoFirstUpdate);
   }
+
+  if (long_poll_) {
+    long_poll_task_ =
+        engine::CriticalAsyncNoSpan([this] { LongPollChanges(); });
+  }
 }
 
 DynamicConfigClientUpdater::~DynamicConfigClientUpdater() {
+  if (long_poll_task_.IsValid()) long_poll_task_.SyncCancel();
   StopPeriodicUpdates();
 }
 
@@ -167,7 +181,7 @@ void DynamicConfigClientUpdater::Update(
       const std::lock_guard lock(update_config_mutex_);
       if (IsDuplicate(update_type, docs_map)) {
         stats.FinishNoChanges();
-        server_timestamp_ = reply.timestamp;
+        SetServerTimestamp(reply.timestamp);
         return;
       }
 
@@ -176,22 +190,23 @@ void DynamicConfigClientUpdater::Update(
     }
 
     stats.Finish(size);
-    server_timestamp_ = reply.timestamp;
+    SetServerTimestamp(reply.timestamp);
   } else {
     // kIncremental
+    const auto server_timestamp = GetServerTimestamp();
     auto reply = config_client_.FetchDocsMap(
-        server_timestamp_, GetDocsMapKeysToFetch(*additional_docs_map_keys));
+        server_timestamp, GetDocsMapKeysToFetch(*additional_docs_map_keys));
     auto& docs_map = reply.docs_map;
 
     /* Timestamp can be compared lexicographically */
-    if (reply.timestamp < server_timestamp_) {
+    if (reply.timestamp < server_timestamp) {
       stats.FinishNoChanges();
       return;
     }
 
     if (reply.docs_map.Size() == 0) {
       stats.FinishNoChanges();
-      server_timestamp_ = reply.timestamp;
+      SetServerTimestamp(reply.timestamp);
       return;
     }
 
@@ -204,7 +219,7 @@ void DynamicConfigClientUpdater::Update(
 
       if (IsDuplicate(update_type, combined)) {
         stats.FinishNoChanges();
-        server_timestamp_ = reply.timestamp;
+        SetServerTimestamp(reply.timestamp);
         return;
       }
 
@@ -214,7 +229,49 @@ void DynamicConfigClientUpdater::Update(
 
       stats.Finish(size);
     }
-    server_timestamp_ = reply.timestamp;
+    SetServerTimestamp(reply.timestamp);
+  }
+}
+
+dynamic_config::Client::Timestamp
+DynamicConfigClientUpdater::GetServerTimestamp() {
+  auto server_timestamp = server_timestamp_.Lock();
+  return *server_timestamp;
+}
+
+void DynamicConfigClientUpdater::SetServerTimestamp(
+    dynamic_config::Client::Timestamp timestamp) {
+  auto server_timestamp = server_timestamp_.Lock();
+  *server_timestamp = std::move(timestamp);
+}
+
+void DynamicConfigClientUpdater::LongPollChanges() {
+  dynamic_config::Client::Timestamp last_update;
+  while (!engine::current_task::ShouldCancel()) {
+    /* Timestamp can be compared lexicographically */
+    last_update = std::max(last_update, GetServerTimestamp());
+    if (last_update.empty()) {
+      // No successful update yet, the periodic updates retry it
+      engine::InterruptibleSleepFor(kLongPollRetryDelay);
+      continue;
+    }
+
+    try {
+      auto keys_to_fetch = [this] {
+        auto additional_docs_map_keys = additional_docs_map_keys_.Lock();
+        return GetDocsMapKeysToFetch(*additional_docs_map_keys);
+      }();
+      const auto reply =
+          config_client_.WaitForDocsMapUpdates(last_update, keys_to_fetch);
+      last_update = std::max(last_update, reply.timestamp);
+      if (reply.docs_map.Size() != 0) {
+        InvalidateAsync(cache::UpdateType::kIncremental);
+      }
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Long poll of the configs service failed: " << e;
+      engine::InterruptibleSleepFor(kLongPollRetryDelay);
+    }
   }
 }
 
@@ -273,6 +330,10 @@ properties:
           - only-full
           - only-incremental
           - full-and-incremental
+    long-poll:
+        type: boolean
+        description: long poll the configs service for changes in a background task that triggers incremental updates
+        defaultDescription: false
 )");
 }
 
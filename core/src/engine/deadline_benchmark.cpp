@@ -2,7 +2,11 @@
 
 #include <chrono>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -47,6 +51,25 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+// Arms a deadline timer that is never reached and drops it
+void deadline_bounded_wait(benchmark::State& state, bool timer_wheel_enabled) {
+  engine::TaskProcessorPoolsConfig config;
+  config.timer_wheel_enabled = timer_wheel_enabled;
+
+  engine::RunStandalone(1, config, [&] {
+    for ([[maybe_unused]] auto _ : state) {
+      engine::SingleConsumerEvent event;
+      auto task = engine::AsyncNoSpan([&event] {
+        const bool is_sent = event.WaitForEventFor(std::chrono::seconds{20});
+        benchmark::DoNotOptimize(is_sent);
+      });
+      engine::Yield();
+      event.Send();
+      task.Wait();
+    }
+  });
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +79,7 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK_CAPTURE(deadline_bounded_wait, ev_timers, false);
+BENCHMARK_CAPTURE(deadline_bounded_wait, timer_wheel, true);
+
 USERVER_NAMESPACE_END
@@ -32,10 +32,11 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 TaskProcessorHolder TaskProcessorHolder::Make(
     std::size_t threads_num, std::string thread_name,
-    std::shared_ptr<TaskProcessorPools> pools) {
+    std::shared_ptr<TaskProcessorPools> pools, bool timer_wheel_enabled) {
   TaskProcessorConfig config;
   config.worker_threads = threads_num;
   config.thread_name = std::move(thread_name);
+  config.timer_wheel_enabled = timer_wheel_enabled;
 
   return TaskProcessorHolder(
       std::make_unique<TaskProcessor>(std::move(config), std::move(pools)));
@@ -31,7 +31,8 @@ class TaskProcessorHolder final {
  public:
   static TaskProcessorHolder Make(std::size_t threads_num,
                                   std::string thread_name,
-                                  std::shared_ptr<TaskProcessorPools> pools);
+                                  std::shared_ptr<TaskProcessorPools> pools,
+                                  bool timer_wheel_enabled = false);
 
   explicit TaskProcessorHolder(std::unique_ptr<TaskProcessor>&&);
 
@@ -86,6 +86,15 @@ class Direction final {
                     TransferMode mode, Deadline deadline,
                     const Context&... context);
 
+  // (IoFunc*)(int, Message*, size_t) returning the count of the transferred
+  // messages, e.g. sendmmsg. The processed count reported by the exceptions is
+  // in messages rather than in bytes.
+  template <typename IoFunc, typename Message, typename... Context>
+  size_t PerformIoMessages(SingleUserGuard& guard, IoFunc&& io_func,
+                           Message* messages, std::size_t count,
+                           TransferMode mode, Deadline deadline,
+                           const Context&... context);
+
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
@@ -249,6 +258,29 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
   return pos - begin;
 }
 
+template <typename IoFunc, typename Message, typename... Context>
+size_t Direction::PerformIoMessages(SingleUserGuard&, IoFunc&& io_func,
+                                    Message* messages, std::size_t count,
+                                    TransferMode mode, Deadline deadline,
+                                    const Context&... context) {
+  std::size_t processed = 0;
+
+  while (processed < count) {
+    auto chunk_size = io_func(Fd(), messages + processed, count - processed);
+
+    if (chunk_size > 0) {
+      processed += chunk_size;
+      if (mode == TransferMode::kOnce) {
+        break;
+      }
+    } else if (!chunk_size || TryHandleError(errno, processed, mode, deadline,
+                                             context...) == ErrorMode::kFatal) {
+      break;
+    }
+  }
+  return processed;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
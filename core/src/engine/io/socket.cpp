@@ -1,14 +1,19 @@
 #include <userver/engine/io/socket.hpp>
 
 #include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
 #include <cerrno>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
@@ -106,6 +111,97 @@ class SendToWrapper {
   const Sockaddr& dest_addr_;
 };
 
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+using MessageHeader = struct ::mmsghdr;
+#else
+// MAC_COMPAT: no recvmmsg and sendmmsg, datagrams are transferred one by one
+struct MessageHeader {
+  struct ::msghdr msg_hdr;
+  unsigned int msg_len;
+};
+#endif
+
+// Room for a single UDP_SEGMENT or UDP_GRO control message
+constexpr std::size_t kSegmentControlSize = CMSG_SPACE(sizeof(int));
+
+// Pointees of the MessageHeader of a datagram
+struct MessageStorage {
+  struct ::iovec iov;
+  alignas(struct ::cmsghdr) char control[kSegmentControlSize];
+};
+
+template <typename T>
+using MessagesVector = boost::container::small_vector<T, kMaxStackSizeVector>;
+
+[[nodiscard]] ssize_t RecvMessagesWrapper(int fd, MessageHeader* messages,
+                                          size_t count) {
+#ifdef HAVE_RECVMMSG
+  return ::recvmmsg(fd, messages, count, 0, /*timeout=*/nullptr);
+#else
+  UASSERT(count > 0);
+  const auto ret = ::recvmsg(fd, &messages->msg_hdr, 0);
+  if (ret == -1) return -1;
+  messages->msg_len = ret;
+  return 1;
+#endif
+}
+
+[[nodiscard]] ssize_t SendMessagesWrapper(int fd, MessageHeader* messages,
+                                          size_t count) {
+  constexpr int kFlags =
+// MAC_COMPAT: does not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+      MSG_NOSIGNAL |
+#endif
+      0;
+#ifdef HAVE_SENDMMSG
+  return ::sendmmsg(fd, messages, count, kFlags);
+#else
+  UASSERT(count > 0);
+  const auto ret = ::sendmsg(fd, &messages->msg_hdr, kFlags);
+  if (ret == -1) return -1;
+  messages->msg_len = ret;
+  return 1;
+#endif
+}
+
+// Sets up the UDP GSO of a datagram to send
+void SetSegmentSize(struct ::msghdr& header, MessageStorage& storage,
+                    std::uint16_t segment_size) {
+#ifdef UDP_SEGMENT
+  header.msg_control = storage.control;
+  header.msg_controllen = CMSG_SPACE(sizeof(segment_size));
+  auto* cmsg = CMSG_FIRSTHDR(&header);
+  cmsg->cmsg_level = IPPROTO_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(segment_size));
+  std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+#else
+  (void)header;
+  (void)storage;
+  throw IoException() << "UDP segmentation offload is not supported, "
+                         "segment_size="
+                      << segment_size;
+#endif
+}
+
+// Returns the UDP GRO segment size of a received datagram
+std::uint16_t GetSegmentSize(struct ::msghdr& header) {
+#ifdef UDP_GRO
+  for (auto* cmsg = CMSG_FIRSTHDR(&header); cmsg;
+       cmsg = CMSG_NXTHDR(&header, cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size = 0;
+      std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size;
+    }
+  }
+#else
+  (void)header;
+#endif
+  return 0;
+}
+
 void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
   UASSERT(data);
   UASSERT(count > 0);
@@ -319,6 +415,92 @@ size_t Socket::SendAllTo(const Sockaddr& dest_addr, const void* buf, size_t len,
                        "SendAllTo to ", dest_addr);
 }
 
+size_t Socket::RecvSomeMessagesFrom(Datagram* datagrams, size_t count,
+                                    Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to RecvSomeMessagesFrom via closed socket");
+  }
+  UASSERT(datagrams);
+  UASSERT(count > 0);
+
+  MessagesVector<MessageHeader> messages(count);
+  MessagesVector<MessageStorage> storage(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto& datagram = datagrams[i];
+    storage[i].iov.iov_base = datagram.data;
+    storage[i].iov.iov_len = datagram.len;
+
+    auto& header = messages[i].msg_hdr;
+    header.msg_name = datagram.addr.Data();
+    header.msg_namelen = datagram.addr.Capacity();
+    header.msg_iov = &storage[i].iov;
+    header.msg_iovlen = 1;
+    header.msg_control = storage[i].control;
+    header.msg_controllen = sizeof(storage[i].control);
+  }
+
+  size_t received = 0;
+  {
+    auto& dir = fd_control_->Read();
+    impl::Direction::SingleUserGuard guard(dir);
+    received = dir.PerformIoMessages(guard, &RecvMessagesWrapper,
+                                     messages.data(), count,
+                                     impl::TransferMode::kOnce, deadline,
+                                     "RecvSomeMessagesFrom");
+  }
+
+  for (size_t i = 0; i < received; ++i) {
+    auto& header = messages[i].msg_hdr;
+    UASSERT(header.msg_namelen <= datagrams[i].addr.Capacity());
+    datagrams[i].bytes_received = messages[i].msg_len;
+    datagrams[i].segment_size = GetSegmentSize(header);
+  }
+  return received;
+}
+
+size_t Socket::SendAllMessagesTo(const Datagram* datagrams, size_t count,
+                                 Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendAllMessagesTo via closed socket");
+  }
+  UASSERT(datagrams);
+  UASSERT(count > 0);
+
+  MessagesVector<MessageHeader> messages(count);
+  MessagesVector<MessageStorage> storage(count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto& datagram = datagrams[i];
+    storage[i].iov.iov_base = datagram.data;
+    storage[i].iov.iov_len = datagram.len;
+
+    auto& header = messages[i].msg_hdr;
+    header.msg_iov = &storage[i].iov;
+    header.msg_iovlen = 1;
+
+    const auto dest_domain = datagram.addr.Domain();
+    if (dest_domain != AddrDomain::kUnspecified) {
+      if (dest_domain != domain_) {
+        throw AddrException(fmt::format(
+            "Socket address domain ({}) does not match address domain ({})",
+            static_cast<int>(domain_), static_cast<int>(dest_domain)));
+      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      header.msg_name = const_cast<struct sockaddr*>(datagram.addr.Data());
+      header.msg_namelen = datagram.addr.Size();
+    }
+
+    if (datagram.segment_size != 0) {
+      SetSegmentSize(header, storage[i], datagram.segment_size);
+    }
+  }
+
+  auto& dir = fd_control_->Write();
+  impl::Direction::SingleUserGuard guard(dir);
+  return dir.PerformIoMessages(guard, &SendMessagesWrapper, messages.data(),
+                               count, impl::TransferMode::kWhole, deadline,
+                               "SendAllMessagesTo");
+}
+
 Socket Socket::Accept(Deadline deadline) {
   if (!IsValid()) {
     throw IoException("Attempt to Accept from closed socket");
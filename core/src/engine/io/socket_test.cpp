@@ -302,6 +302,62 @@ UTEST(Socket, DomainMismatch) {
   UEXPECT_THROW([[maybe_unused]] auto ret =
                     unix_socket.SendAllTo(listener.addr, "1", 1, test_deadline),
                 io::AddrException);
+
+  char c = '1';
+  io::Socket::Datagram datagram{&c, 1, listener.addr};
+  UEXPECT_THROW([[maybe_unused]] auto ret =
+                    unix_socket.SendAllMessagesTo(&datagram, 1, test_deadline),
+                io::AddrException);
+}
+
+UTEST(Socket, DgramMessages) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  constexpr std::size_t kMessages = 40;
+
+  UdpListener listener;
+  engine::io::Socket client{listener.addr.Domain(), UdpListener::kType};
+  client.Connect(listener.addr, test_deadline);
+  const auto client_port = client.Getsockname().Port();
+
+  // Both to the explicit address and to the connected peer
+  std::array<char, kMessages> payload{};
+  std::array<io::Socket::Datagram, kMessages> datagrams{};
+  for (std::size_t i = 0; i < kMessages; ++i) {
+    payload[i] = static_cast<char>('a' + i % 26);
+    datagrams[i].data = &payload[i];
+    datagrams[i].len = 1;
+    if (i % 2 == 0) datagrams[i].addr = listener.addr;
+  }
+  EXPECT_EQ(kMessages,
+            client.SendAllMessagesTo(datagrams.data(), kMessages,
+                                     test_deadline));
+
+  std::array<std::array<char, 4>, kMessages> buffers{};
+  std::array<io::Socket::Datagram, kMessages> received{};
+  for (std::size_t i = 0; i < kMessages; ++i) {
+    received[i].data = buffers[i].data();
+    received[i].len = buffers[i].size();
+  }
+
+  std::size_t received_count = 0;
+  while (received_count < kMessages) {
+    received_count += listener.socket.RecvSomeMessagesFrom(
+        received.data() + received_count, kMessages - received_count,
+        test_deadline);
+  }
+
+  for (std::size_t i = 0; i < kMessages; ++i) {
+    EXPECT_EQ(1, received[i].bytes_received);
+    EXPECT_EQ(payload[i], buffers[i][0]);
+    EXPECT_EQ(client_port, received[i].addr.Port());
+    EXPECT_EQ(0, received[i].segment_size);
+  }
+
+  UEXPECT_THROW(
+      [[maybe_unused]] auto ret = listener.socket.RecvSomeMessagesFrom(
+          received.data(), kMessages,
+          Deadline::FromDuration(std::chrono::milliseconds{10})),
+      io::IoTimeout);
 }
 
 UTEST(Socket, DgramBound) {
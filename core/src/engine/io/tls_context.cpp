@@ -0,0 +1,491 @@
+#include <userver/engine/io/tls_context.hpp>
+
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#else
+#include <openssl/hmac.h>
+#endif
+
+#include <crypto/helpers.hpp>
+#include <crypto/openssl.hpp>
+#include <engine/io/tls_context_impl.hpp>
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/crypto/hash.hpp>
+#include <userver/crypto/random.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+namespace {
+
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
+constexpr std::size_t kTicketKeyNameSize = 16;
+constexpr std::size_t kTicketSecretSize = 32;
+
+struct TicketKey final {
+  std::array<unsigned char, kTicketKeyNameSize> name{};
+  std::array<unsigned char, kTicketSecretSize> aes_key{};
+  std::array<unsigned char, kTicketSecretSize> hmac_key{};
+  std::chrono::steady_clock::time_point created;
+
+  static TicketKey Generate() {
+    TicketKey key;
+    crypto::GenerateRandomBlock(utils::span<unsigned char>{key.name});
+    crypto::GenerateRandomBlock(utils::span<unsigned char>{key.aes_key});
+    crypto::GenerateRandomBlock(utils::span<unsigned char>{key.hmac_key});
+    key.created = std::chrono::steady_clock::now();
+    return key;
+  }
+};
+
+struct TicketKeys final {
+  TicketKey current;
+  std::optional<TicketKey> previous;
+};
+
+// Shared by all the SSL_CTX of a TlsServerContext, the keys are replaced on
+// the reloads
+struct TicketKeyStore final {
+  explicit TicketKeyStore(std::chrono::seconds rotation_period)
+      : rotation_period(rotation_period),
+        keys(TicketKeys{TicketKey::Generate(), std::nullopt}) {}
+
+  // Rotation is lazy, it happens on the first new ticket of a period
+  rcu::ReadablePtr<TicketKeys> GetKeysForEncryption() {
+    auto keys_ptr = keys.Read();
+    if (std::chrono::steady_clock::now() - keys_ptr->current.created <
+        rotation_period) {
+      return keys_ptr;
+    }
+
+    {
+      auto writer = keys.StartWrite();
+      if (std::chrono::steady_clock::now() - writer->current.created >=
+          rotation_period) {
+        writer->previous = writer->current;
+        writer->current = TicketKey::Generate();
+        writer.Commit();
+      }
+    }
+    return keys.Read();
+  }
+
+  // Drops the keys of all the issued tickets
+  void Reset() { keys.Assign(TicketKeys{TicketKey::Generate(), std::nullopt}); }
+
+  const std::chrono::seconds rotation_period;
+  rcu::Variable<TicketKeys> keys;
+};
+
+struct ClientSessionCache final {
+  explicit ClientSessionCache(std::size_t size) : sessions(size) {}
+
+  concurrent::Variable<cache::LruMap<std::string, SslSession>, std::mutex>
+      sessions;
+};
+
+// The data is owned by the SSL_CTX, so that it outlives all the connections
+// that might use it from OpenSSL callbacks
+template <typename T>
+int GetCtxDataIndex() {
+  static const int index = SSL_CTX_get_ex_new_index(
+      0, nullptr, nullptr, nullptr,
+      [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<T*>(ptr);
+      });
+  UINVARIANT(index >= 0, "Failed to allocate SSL_CTX ex data index");
+  return index;
+}
+
+template <typename T>
+void SetCtxData(SSL_CTX* ctx, std::unique_ptr<T> data) {
+  if (1 != SSL_CTX_set_ex_data(ctx, GetCtxDataIndex<T>(), data.get())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up TLS context: SSL_CTX_set_ex_data"));
+  }
+  [[maybe_unused]] auto* disowned_data = data.release();
+}
+
+template <typename T>
+T* GetCtxData(const SSL_CTX* ctx) noexcept {
+  return static_cast<T*>(SSL_CTX_get_ex_data(ctx, GetCtxDataIndex<T>()));
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+// HMAC_CTX and the callbacks that use it are deprecated since OpenSSL 3.0
+using TicketMacCtx = EVP_MAC_CTX;
+
+bool InitTicketMac(const TicketKey& key, EVP_MAC_CTX* mac_ctx) noexcept {
+  char digest[] = "SHA256";
+  const OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+      OSSL_PARAM_construct_end()};
+  return 1 == EVP_MAC_init(mac_ctx, key.hmac_key.data(), key.hmac_key.size(),
+                           params);
+}
+#else
+using TicketMacCtx = HMAC_CTX;
+
+bool InitTicketMac(const TicketKey& key, HMAC_CTX* hmac_ctx) noexcept {
+  return 1 == HMAC_Init_ex(hmac_ctx, key.hmac_key.data(),
+                           key.hmac_key.size(), EVP_sha256(), nullptr);
+}
+#endif
+
+int InitTicketCipher(const TicketKey& key, unsigned char* iv,
+                     EVP_CIPHER_CTX* cipher_ctx, TicketMacCtx* mac_ctx,
+                     int enc) noexcept {
+  if (!InitTicketMac(key, mac_ctx)) return -1;
+  const auto init = enc ? &EVP_EncryptInit_ex : &EVP_DecryptInit_ex;
+  if (1 != init(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key.data(),
+                iv)) {
+    return -1;
+  }
+  return 1;
+}
+
+// See SSL_CTX_set_tlsext_ticket_key_evp_cb
+int TicketKeyCallback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                      EVP_CIPHER_CTX* cipher_ctx, TicketMacCtx* mac_ctx,
+                      int enc) noexcept {
+  auto* store = GetCtxData<std::shared_ptr<TicketKeyStore>>(
+      SSL_get_SSL_CTX(ssl));
+  if (!store) return -1;
+
+  try {
+    if (enc) {
+      const auto keys = (*store)->GetKeysForEncryption();
+      std::memcpy(key_name, keys->current.name.data(), kTicketKeyNameSize);
+      if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()))) {
+        return -1;
+      }
+      return InitTicketCipher(keys->current, iv, cipher_ctx, mac_ctx, enc);
+    }
+
+    const auto keys = (*store)->keys.Read();
+    const auto matches = [key_name](const TicketKey& key) {
+      return std::memcmp(key_name, key.name.data(), kTicketKeyNameSize) == 0;
+    };
+    if (matches(keys->current)) {
+      return InitTicketCipher(keys->current, iv, cipher_ctx, mac_ctx, enc);
+    }
+    if (keys->previous && matches(*keys->previous)) {
+      const auto result =
+          InitTicketCipher(*keys->previous, iv, cipher_ctx, mac_ctx, enc);
+      // Ask for a new ticket encrypted with the current key
+      return result == 1 ? 2 : result;
+    }
+    // Unknown or expired key, fall back to a full handshake
+    return 0;
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_ERROR() << "Failed to process a TLS session ticket: " << ex;
+    return -1;
+  }
+}
+
+int NewClientSessionCallback(SSL* ssl, SSL_SESSION* session) noexcept {
+  auto* cache = GetCtxData<ClientSessionCache>(SSL_get_SSL_CTX(ssl));
+  const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  if (!cache || !server_name) return 0;
+
+  try {
+    SslSession cached_session{session};
+    // The cache holds its own reference to the session
+    SSL_SESSION_up_ref(session);
+    auto sessions = cache->sessions.Lock();
+    sessions->Put(server_name, std::move(cached_session));
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Failed to cache a TLS session: " << ex;
+  }
+  return 0;
+}
+
+// Client certificates of the cached sessions were verified against the CAs,
+// so the sessions are not resumed by a context with other CAs
+std::string MakeSessionIdContext(
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  std::string pems;
+  for (const auto& ca : cert_authorities) {
+    auto pem = ca.GetPemString();
+    if (!pem) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up TLS context: PEM_write_bio_X509"));
+    }
+    pems += *pem;
+  }
+  return crypto::hash::Sha256(pems, crypto::hash::OutputEncoding::kBinary);
+}
+
+void SetUpCertificates(
+    SSL_CTX* ssl_ctx, const crypto::Certificate& cert,
+    const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  if (!cert_authorities.empty()) {
+    auto* store = SSL_CTX_get_cert_store(ssl_ctx);
+    for (const auto& ca : cert_authorities) {
+      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
+      }
+    }
+    SSL_CTX_set_verify(ssl_ctx,
+                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                       nullptr);
+    LOG_INFO() << "Client SSL cert is verified";
+  } else {
+    LOG_INFO() << "Client SSL cert is not verified";
+  }
+
+  if (1 != SSL_CTX_use_certificate(ssl_ctx, cert.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
+  }
+
+  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx, key.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
+  }
+}
+
+}  // namespace
+
+namespace impl {
+
+SslCtx MakeSslCtx() {
+  crypto::impl::Openssl::Init();
+
+  SslCtx ssl_ctx{SSL_CTX_new(SSLv23_method())};
+  if (!ssl_ctx) {
+    throw TlsException(
+        crypto::FormatSslError("Failed create an SSL context: SSL_CTX_new"));
+  }
+#if OPENSSL_VERSION_NUMBER >= 0x010100000L
+  if (1 != SSL_CTX_set_min_proto_version(ssl_ctx.get(), TLS1_VERSION)) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed create an SSL context: SSL_CTX_set_min_proto_version"));
+  }
+#endif
+
+  constexpr auto options = SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 |
+                           SSL_OP_NO_COMPRESSION
+#if OPENSSL_VERSION_NUMBER >= 0x010100000L
+                           | SSL_OP_NO_RENEGOTIATION
+#endif
+      ;
+  SSL_CTX_set_options(ssl_ctx.get(), options);
+  SSL_CTX_set_mode(ssl_ctx.get(), SSL_MODE_ENABLE_PARTIAL_WRITE);
+  SSL_CTX_clear_mode(ssl_ctx.get(), SSL_MODE_AUTO_RETRY);
+  if (1 != SSL_CTX_set_default_verify_paths(ssl_ctx.get())) {
+    LOG_LIMITED_WARNING() << crypto::FormatSslError(
+        "Failed create an SSL context: SSL_CTX_set_default_verify_paths");
+  }
+  return ssl_ctx;
+}
+
+void EnableKernelTlsOffload(SSL_CTX* ssl_ctx) noexcept {
+#ifdef SSL_OP_ENABLE_KTLS
+  SSL_CTX_set_options(ssl_ctx, SSL_OP_ENABLE_KTLS);
+#else
+  LOG_WARNING() << "Kernel TLS offload is not supported by the OpenSSL version";
+#endif
+}
+
+void ResumeClientSession(SSL* ssl, const std::string& server_name) {
+  auto* cache = GetCtxData<ClientSessionCache>(SSL_get_SSL_CTX(ssl));
+  if (!cache || server_name.empty()) return;
+
+  auto sessions = cache->sessions.Lock();
+  auto* session = sessions->Get(server_name);
+  if (!session) return;
+
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+  if (!SSL_SESSION_is_resumable(session->get())) {
+    sessions->Erase(server_name);
+    return;
+  }
+#endif
+  // Takes its own reference to the session
+  if (1 != SSL_set_session(ssl, session->get())) {
+    LOG_LIMITED_WARNING() << crypto::FormatSslError(
+        "Failed to resume a TLS session: SSL_set_session");
+  }
+}
+
+}  // namespace impl
+
+class TlsServerContext::Impl final {
+ public:
+  Impl(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+       const std::vector<crypto::Certificate>& cert_authorities,
+       const TlsServerSessionSettings& settings)
+      : settings_(settings),
+        ticket_keys_(settings.ticket_key_rotation_period.count() > 0
+                         ? std::make_shared<TicketKeyStore>(
+                               settings.ticket_key_rotation_period)
+                         : nullptr),
+        ssl_ctx_(MakeServerCtx(cert, key, cert_authorities)) {}
+
+  void Reload(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+              const std::vector<crypto::Certificate>& cert_authorities) {
+    auto ssl_ctx = MakeServerCtx(cert, key, cert_authorities);
+    if (ticket_keys_) ticket_keys_->Reset();
+    ssl_ctx_.Assign(std::move(ssl_ctx));
+  }
+
+  std::shared_ptr<SSL_CTX> GetNative() const { return ssl_ctx_.ReadCopy(); }
+
+ private:
+  std::shared_ptr<SSL_CTX> MakeServerCtx(
+      const crypto::Certificate& cert, const crypto::PrivateKey& key,
+      const std::vector<crypto::Certificate>& cert_authorities) const {
+    auto ssl_ctx = impl::MakeSslCtx();
+    SetUpCertificates(ssl_ctx.get(), cert, key, cert_authorities);
+
+    // Required for the resumption of sessions with client certificates
+    const auto session_id_context = MakeSessionIdContext(cert_authorities);
+    static_assert(SSL_MAX_SID_CTX_LENGTH >= 32);
+    if (1 != SSL_CTX_set_session_id_context(
+                 ssl_ctx.get(),
+                 reinterpret_cast<const unsigned char*>(
+                     session_id_context.data()),
+                 session_id_context.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up TLS context: SSL_CTX_set_session_id_context"));
+    }
+    SSL_CTX_set_timeout(ssl_ctx.get(), settings_.session_timeout.count());
+    if (settings_.session_cache_size > 0) {
+      SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_SERVER);
+      SSL_CTX_sess_set_cache_size(ssl_ctx.get(), settings_.session_cache_size);
+    } else {
+      SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_OFF);
+    }
+
+    if (ticket_keys_) {
+      using TicketKeyStorePtr = std::shared_ptr<TicketKeyStore>;
+      SetCtxData(ssl_ctx.get(),
+                 std::make_unique<TicketKeyStorePtr>(ticket_keys_));
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+      SSL_CTX_set_tlsext_ticket_key_evp_cb(ssl_ctx.get(), &TicketKeyCallback);
+#else
+      // cast in openssl macro expansion
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+      SSL_CTX_set_tlsext_ticket_key_cb(ssl_ctx.get(), &TicketKeyCallback);
+#endif
+    } else {
+      SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_NO_TICKET);
+    }
+
+    if (settings_.kernel_tls_offload) {
+      impl::EnableKernelTlsOffload(ssl_ctx.get());
+    }
+
+    return {ssl_ctx.release(), impl::SslCtxDeleter{}};
+  }
+
+  const TlsServerSessionSettings settings_;
+  const std::shared_ptr<TicketKeyStore> ticket_keys_;
+  rcu::Variable<std::shared_ptr<SSL_CTX>> ssl_ctx_;
+};
+
+TlsServerContext::TlsServerContext(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const TlsServerSessionSettings& settings)
+    : impl_(std::make_unique<Impl>(cert, key, cert_authorities, settings)) {}
+
+TlsServerContext::TlsServerContext(TlsServerContext&&) noexcept = default;
+
+TlsServerContext& TlsServerContext::operator=(TlsServerContext&&) noexcept =
+    default;
+
+TlsServerContext::~TlsServerContext() = default;
+
+void TlsServerContext::Reload(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  UASSERT(impl_);
+  impl_->Reload(cert, key, cert_authorities);
+}
+
+std::shared_ptr<SSL_CTX> TlsServerContext::GetNative() const {
+  UASSERT(impl_);
+  return impl_->GetNative();
+}
+
+class TlsClientContext::Impl final {
+ public:
+  Impl(std::size_t session_cache_size,
+       const std::vector<crypto::Certificate>& cert_authorities,
+       bool kernel_tls_offload)
+      : ssl_ctx_(impl::MakeSslCtx()) {
+    if (kernel_tls_offload) impl::EnableKernelTlsOffload(ssl_ctx_.get());
+
+    auto* store = SSL_CTX_get_cert_store(ssl_ctx_.get());
+    for (const auto& ca : cert_authorities) {
+      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up client TLS context: X509_STORE_add_cert"));
+      }
+    }
+
+    if (session_cache_size == 0) {
+      SSL_CTX_set_session_cache_mode(ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+      return;
+    }
+
+    // Sessions are kept by the ClientSessionCache, keyed by the server name
+    SetCtxData(ssl_ctx_.get(),
+               std::make_unique<ClientSessionCache>(session_cache_size));
+    SSL_CTX_set_session_cache_mode(
+        ssl_ctx_.get(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL);
+    SSL_CTX_sess_set_new_cb(ssl_ctx_.get(), &NewClientSessionCallback);
+  }
+
+  SSL_CTX* GetNative() const noexcept { return ssl_ctx_.get(); }
+
+ private:
+  impl::SslCtx ssl_ctx_;
+};
+
+TlsClientContext::TlsClientContext(
+    std::size_t session_cache_size,
+    const std::vector<crypto::Certificate>& cert_authorities,
+    bool kernel_tls_offload)
+    : impl_(std::make_unique<Impl>(session_cache_size, cert_authorities,
+                                   kernel_tls_offload)) {}
+
+TlsClientContext::TlsClientContext(TlsClientContext&&) noexcept = default;
+
+TlsClientContext& TlsClientContext::operator=(TlsClientContext&&) noexcept =
+    default;
+
+TlsClientContext::~TlsClientContext() = default;
+
+SSL_CTX* TlsClientContext::GetNative() const noexcept {
+  UASSERT(impl_);
+  return impl_->GetNative();
+}
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <openssl/ssl.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+struct SslCtxDeleter {
+  void operator()(SSL_CTX* ctx) const noexcept { SSL_CTX_free(ctx); }
+};
+using SslCtx = std::unique_ptr<SSL_CTX, SslCtxDeleter>;
+
+SslCtx MakeSslCtx();
+
+// Makes OpenSSL hand the traffic keys to the socket BIO after the handshake
+void EnableKernelTlsOffload(SSL_CTX* ssl_ctx) noexcept;
+
+// Resumes the session cached by the TlsClientContext of `ssl` for the
+// `server_name`, if any.
+void ResumeClientSession(SSL* ssl, const std::string& server_name);
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
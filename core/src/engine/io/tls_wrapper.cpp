@@ -1,5 +1,10 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <cerrno>
 #include <exception>
 #include <memory>
 
@@ -7,23 +12,31 @@
 #include <openssl/bio.h>
 #include <openssl/ssl.h>
 
+// OpenSSL hands the traffic keys to the BIO and expects it to set up
+// the kernel TLS, see BIO_CTRL_SET_KTLS in OpenSSL sources. The controls are
+// private, so the offload is limited to the OpenSSL versions that reserve
+// their numbers in openssl/bio.h. Other versions encrypt in userspace.
+#if defined(__linux__) && !defined(OPENSSL_NO_KTLS) && \
+    OPENSSL_VERSION_NUMBER >= 0x30000000L &&           \
+    OPENSSL_VERSION_NUMBER < 0x30600000L
+#include <linux/tls.h>
+#define USERVER_IMPL_KERNEL_TLS 1
+#endif
+
 #include <crypto/helpers.hpp>
-#include <crypto/openssl.hpp>
 #include <engine/io/fd_control.hpp>
+#include <engine/io/tls_context_impl.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 namespace {
 
-struct SslCtxDeleter {
-  void operator()(SSL_CTX* ctx) const noexcept { SSL_CTX_free(ctx); }
-};
-using SslCtx = std::unique_ptr<SSL_CTX, SslCtxDeleter>;
-
 struct SslDeleter {
   void operator()(SSL* ssl) const noexcept { SSL_free(ssl); }
 };
@@ -58,8 +71,119 @@ struct SocketBioData {
   Socket socket;
   Deadline current_deadline;
   std::exception_ptr last_exception;
+  // The "tls" ULP is attached to the socket, it may not be attached twice
+  bool kernel_tls_ulp{false};
+  // Records are encrypted by the kernel, OpenSSL writes plaintext
+  bool kernel_tls_send{false};
+  // The kernel has rejected the new keys of a TLS 1.3 key update and keeps
+  // encrypting with the old ones, nothing may be sent any more
+  bool kernel_tls_failed{false};
+  // Type of the non application data record being written with kernel TLS
+  unsigned char kernel_tls_record_type{0};
 };
 
+#ifdef USERVER_IMPL_KERNEL_TLS
+// Internal OpenSSL BIO controls, not exposed in headers. openssl/bio.h
+// reserves 72, 74 and 75 for them around the public 73 and 76.
+constexpr int kBioCtrlSetKtls = 72;
+constexpr int kBioCtrlSetKtlsSendCtrlMsg = 74;
+constexpr int kBioCtrlClearKtlsCtrlMsg = 75;
+static_assert(BIO_CTRL_GET_KTLS_SEND == kBioCtrlSetKtls + 1 &&
+                  BIO_CTRL_GET_KTLS_RECV == kBioCtrlClearKtlsCtrlMsg + 1,
+              "OpenSSL has renumbered the kernel TLS BIO controls");
+
+std::size_t GetKernelTlsCryptoInfoSize(const tls_crypto_info& info) {
+  switch (info.cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+      return sizeof(tls12_crypto_info_aes_gcm_128);
+    case TLS_CIPHER_AES_GCM_256:
+      return sizeof(tls12_crypto_info_aes_gcm_256);
+#ifdef TLS_CIPHER_AES_CCM_128
+    case TLS_CIPHER_AES_CCM_128:
+      return sizeof(tls12_crypto_info_aes_ccm_128);
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      return sizeof(tls12_crypto_info_chacha20_poly1305);
+#endif
+    default:
+      return 0;
+  }
+}
+
+// Returns false if the kernel does not support the TLS offload or the cipher,
+// OpenSSL keeps encrypting the records in that case.
+//
+// Called again with the new keys on a TLS 1.3 KeyUpdate, only the keys are
+// replaced then.
+bool StartKernelTlsSend(SocketBioData& bio_data,
+                        const tls_crypto_info& info) noexcept {
+  const auto info_size = GetKernelTlsCryptoInfoSize(info);
+  if (!info_size) return false;
+
+  const int fd = bio_data.socket.Fd();
+  if (!bio_data.kernel_tls_ulp) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    if (-1 == ::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls"))) {
+      LOG_LIMITED_INFO() << "Kernel TLS is not available, errno=" << errno;
+      return false;
+    }
+    bio_data.kernel_tls_ulp = true;
+  }
+  if (-1 == ::setsockopt(fd, SOL_TLS, TLS_TX, &info, info_size)) {
+    if (bio_data.kernel_tls_send) {
+      // OpenSSL would encrypt the following records itself, and the kernel
+      // would encrypt them once more with the old keys
+      LOG_LIMITED_WARNING() << "Kernel TLS key update failed, errno=" << errno
+                            << ", closing the connection";
+      bio_data.kernel_tls_failed = true;
+      return false;
+    }
+    LOG_LIMITED_INFO() << "Kernel TLS does not support the cipher "
+                       << info.cipher_type << ", errno=" << errno;
+    return false;
+  }
+  bio_data.kernel_tls_send = true;
+  return true;
+}
+
+// Sends a whole non application data record, the kernel encrypts it
+std::size_t SendKernelTlsRecord(SocketBioData& bio_data, const char* data,
+                                std::size_t len) {
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(unsigned char))]{};
+  std::size_t sent = 0;
+  while (sent < len) {
+    iovec iov{const_cast<char*>(data + sent), len - sent};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    auto* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_TLS;
+    cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cmsg) = bio_data.kernel_tls_record_type;
+
+    const auto ret = ::sendmsg(bio_data.socket.Fd(), &msg, MSG_NOSIGNAL);
+    if (ret >= 0) {
+      sent += ret;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      if (!bio_data.socket.WaitWriteable(bio_data.current_deadline)) {
+        if (current_task::ShouldCancel()) {
+          throw IoCancelled(sent) << "SendKernelTlsRecord";
+        }
+        throw IoTimeout(sent) << "SendKernelTlsRecord";
+      }
+    } else if (errno != EINTR) {
+      utils::CheckSyscallCustomException<IoSystemError>(
+          -1, "sending a TLS record");
+    }
+  }
+  return sent;
+}
+#endif
+
 int SocketBioWriteEx(BIO* bio, const char* data, size_t len,
                      size_t* bytes_written) noexcept {
   auto* bio_data = static_cast<SocketBioData*>(BIO_get_data(bio));
@@ -67,8 +191,19 @@ int SocketBioWriteEx(BIO* bio, const char* data, size_t len,
   UASSERT(bytes_written);
 
   try {
-    *bytes_written =
-        bio_data->socket.SendAll(data, len, bio_data->current_deadline);
+#ifdef USERVER_IMPL_KERNEL_TLS
+    if (bio_data->kernel_tls_failed) {
+      throw TlsException("Kernel TLS key update failed");
+    }
+    if (bio_data->kernel_tls_record_type) {
+      *bytes_written = SendKernelTlsRecord(*bio_data, data, len);
+      bio_data->kernel_tls_record_type = 0;
+    } else
+#endif
+    {
+      *bytes_written =
+          bio_data->socket.SendAll(data, len, bio_data->current_deadline);
+    }
     BIO_clear_retry_flags(bio);
     if (bio_data->last_exception) bio_data->last_exception = {};
     if (*bytes_written) return 1;  // success
@@ -103,12 +238,34 @@ int SocketBioReadEx(BIO* bio, char* data, size_t len,
   return 0;
 }
 
-long SocketBioControl(BIO*, int cmd, long, void*) noexcept {
-  if (cmd == BIO_CTRL_FLUSH) {
-    // ignore for Socket
-    return 1;
+long SocketBioControl(BIO* bio, int cmd, [[maybe_unused]] long larg,
+                      [[maybe_unused]] void* parg) noexcept {
+  [[maybe_unused]] auto* bio_data =
+      static_cast<SocketBioData*>(BIO_get_data(bio));
+  switch (cmd) {
+    case BIO_CTRL_FLUSH:
+      // ignore for Socket
+      return 1;
+
+#ifdef USERVER_IMPL_KERNEL_TLS
+    case kBioCtrlSetKtls:
+      // only sending is offloaded, OpenSSL decrypts the incoming records
+      if (!larg) return 0;
+      return StartKernelTlsSend(*bio_data,
+                                *static_cast<const tls_crypto_info*>(parg));
+    case BIO_CTRL_GET_KTLS_SEND:
+      return bio_data->kernel_tls_send;
+    case kBioCtrlSetKtlsSendCtrlMsg:
+      bio_data->kernel_tls_record_type = static_cast<unsigned char>(larg);
+      return 1;
+    case kBioCtrlClearKtlsCtrlMsg:
+      bio_data->kernel_tls_record_type = 0;
+      return 1;
+#endif
+
+    default:
+      return 0;
   }
-  return 0;
 }
 
 #if OPENSSL_VERSION_NUMBER >= 0x010100000L
@@ -194,37 +351,6 @@ int SSL_write_ex(SSL* ssl, const void* data, size_t len,
 }
 #endif
 
-SslCtx MakeSslCtx() {
-  crypto::impl::Openssl::Init();
-
-  SslCtx ssl_ctx{SSL_CTX_new(SSLv23_method())};
-  if (!ssl_ctx) {
-    throw TlsException(
-        crypto::FormatSslError("Failed create an SSL context: SSL_CTX_new"));
-  }
-#if OPENSSL_VERSION_NUMBER >= 0x010100000L
-  if (1 != SSL_CTX_set_min_proto_version(ssl_ctx.get(), TLS1_VERSION)) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed create an SSL context: SSL_CTX_set_min_proto_version"));
-  }
-#endif
-
-  constexpr auto options = SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 |
-                           SSL_OP_NO_COMPRESSION
-#if OPENSSL_VERSION_NUMBER >= 0x010100000L
-                           | SSL_OP_NO_RENEGOTIATION
-#endif
-      ;
-  SSL_CTX_set_options(ssl_ctx.get(), options);
-  SSL_CTX_set_mode(ssl_ctx.get(), SSL_MODE_ENABLE_PARTIAL_WRITE);
-  SSL_CTX_clear_mode(ssl_ctx.get(), SSL_MODE_AUTO_RETRY);
-  if (1 != SSL_CTX_set_default_verify_paths(ssl_ctx.get())) {
-    LOG_LIMITED_WARNING() << crypto::FormatSslError(
-        "Failed create an SSL context: SSL_CTX_set_default_verify_paths");
-  }
-  return ssl_ctx;
-}
-
 enum InterruptAction {
   kPass,
   kFail,
@@ -244,7 +370,7 @@ class TlsWrapper::Impl {
     SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
+  void SetUp(SSL_CTX* ssl_ctx) {
     Bio socket_bio{BIO_new(GetSocketBioMethod())};
     if (!socket_bio) {
       throw TlsException(
@@ -254,7 +380,7 @@ class TlsWrapper::Impl {
     SyncBioData(socket_bio.get(), nullptr);
     BIO_set_init(socket_bio.get(), 1);
 
-    ssl.reset(SSL_new(ssl_ctx.get()));
+    ssl.reset(SSL_new(ssl_ctx));
     if (!ssl) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: SSL_new"));
@@ -350,45 +476,50 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
                                       Deadline deadline) {
-  auto ssl_ctx = MakeSslCtx();
+  static TlsClientContext default_context;
+  return StartTlsClient(std::move(socket), default_context, server_name,
+                        deadline);
+}
 
+TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
+                                      const TlsClientContext& context,
+                                      const std::string& server_name,
+                                      Deadline deadline) {
+  TlsWrapper wrapper{std::move(socket)};
+  wrapper.impl_->SetUp(context.GetNative());
+  auto* ssl = wrapper.impl_->ssl.get();
   if (!server_name.empty()) {
-    X509_VERIFY_PARAM* verify_param = SSL_CTX_get0_param(ssl_ctx.get());
+    X509_VERIFY_PARAM* verify_param = SSL_get0_param(ssl);
     if (!verify_param) {
       throw TlsException(
-          "Failed to set up client TLS wrapper: SSL_CTX_get0_param");
+          "Failed to set up client TLS wrapper: SSL_get0_param");
     }
     if (1 != X509_VERIFY_PARAM_set1_host(verify_param, server_name.data(),
                                          server_name.size())) {
       throw TlsException(crypto::FormatSslError(
           "Failed to set up client TLS wrapper: X509_VERIFY_PARAM_set1_host"));
     }
-    SSL_CTX_set_verify(ssl_ctx.get(), SSL_VERIFY_PEER, nullptr);
-  }
+    SSL_set_verify(ssl, SSL_VERIFY_PEER, nullptr);
 
-  TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-    if (1 != SSL_set_tlsext_host_name(wrapper.impl_->ssl.get(),
-                                      server_name.c_str())) {
+    if (1 != SSL_set_tlsext_host_name(ssl, server_name.c_str())) {
       throw TlsException(crypto::FormatSslError(
           "Failed to set up client TLS wrapper: SSL_set_tlsext_host_name"));
     }
+    impl::ResumeClientSession(ssl, server_name);
   }
 
   wrapper.impl_->bio_data.current_deadline = deadline;
 
-  auto ret = SSL_connect(wrapper.impl_->ssl.get());
+  auto ret = SSL_connect(ssl);
   if (1 != ret) {
     if (wrapper.impl_->bio_data.last_exception) {
       std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
     }
 
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up client TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+    throw TlsException(crypto::FormatSslError(fmt::format(
+        "Failed to set up client TLS wrapper ({})", SSL_get_error(ssl, ret))));
   }
   return wrapper;
 }
@@ -397,36 +528,19 @@ TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
     const std::vector<crypto::Certificate>& cert_authorities) {
-  auto ssl_ctx = MakeSslCtx();
-
-  if (!cert_authorities.empty()) {
-    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
-    for (const auto& ca : cert_authorities) {
-      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
-        throw TlsException(crypto::FormatSslError(
-            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
-      }
-    }
-    SSL_CTX_set_verify(ssl_ctx.get(),
-                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
-                       nullptr);
-    LOG_INFO() << "Client SSL cert is verified";
-  } else {
-    LOG_INFO() << "Client SSL cert is not verified";
-  }
-
-  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
-  }
-
-  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
-  }
+  // The context is not reused, so there is nothing to resume
+  TlsServerSessionSettings settings;
+  settings.session_cache_size = 0;
+  settings.ticket_key_rotation_period = std::chrono::seconds::zero();
+  const TlsServerContext context{cert, key, cert_authorities, settings};
+  return StartTlsServer(std::move(socket), context, deadline);
+}
 
+TlsWrapper TlsWrapper::StartTlsServer(Socket&& socket,
+                                      const TlsServerContext& context,
+                                      Deadline deadline) {
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(context.GetNative().get());
   wrapper.impl_->bio_data.current_deadline = deadline;
 
   auto ret = SSL_accept(wrapper.impl_->ssl.get());
@@ -443,6 +557,14 @@ TlsWrapper TlsWrapper::StartTlsServer(
   return wrapper;
 }
 
+bool TlsWrapper::IsKernelTlsSendEnabled() const {
+  return impl_->bio_data.kernel_tls_send && !impl_->bio_data.kernel_tls_failed;
+}
+
+bool TlsWrapper::IsSessionReused() const {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get()) == 1;
+}
+
 TlsWrapper::~TlsWrapper() {
   if (!IsValid()) return;
 
@@ -482,6 +604,18 @@ size_t TlsWrapper::RecvAll(void* buf, size_t len, Deadline deadline) {
 
 size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
   impl_->CheckAlive();
+  if (impl_->bio_data.kernel_tls_failed) {
+    throw TlsException("Kernel TLS key update failed");
+  }
+#ifdef USERVER_IMPL_KERNEL_TLS
+  // A key update requested by the peer is sent by SSL_write, which also
+  // hands the new keys to the kernel
+  if (impl_->bio_data.kernel_tls_send &&
+      SSL_get_key_update_type(impl_->ssl.get()) == SSL_KEY_UPDATE_NONE) {
+    // the kernel frames and encrypts the data
+    return impl_->bio_data.socket.SendAll(buf, len, deadline);
+  }
+#endif
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   return impl_->PerformSslIo(&SSL_write_ex, const_cast<void*>(buf), len,
                              impl::TransferMode::kWhole, InterruptAction::kFail,
@@ -489,6 +623,9 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
 }
 
 Socket TlsWrapper::StopTls(Deadline deadline) {
+  if (impl_->bio_data.kernel_tls_send) {
+    throw TlsException("Cannot stop TLS with kernel TLS offload enabled");
+  }
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
     impl_->bio_data.current_deadline = deadline;
@@ -1,6 +1,7 @@
 #include <userver/utest/utest.hpp>
 
 #include <openssl/opensslv.h>
+#include <openssl/ssl.h>
 #include <sys/socket.h>
 
 #include <stdexcept>
@@ -137,6 +138,148 @@ v2R63aFo/UfQSQ4dhC0o2Vy74DyLwnO3pH8wudfBJ8/LX/Uz/A==
 
 constexpr auto kShortTimeout = std::chrono::milliseconds{10};
 
+// Makes two connections with the same contexts, returns whether the sessions
+// were resumed by the server
+std::vector<bool> ConnectTwice(const io::TlsServerSessionSettings& settings) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto ca = crypto::Certificate::LoadFromString(cert);
+  const io::TlsServerContext server_context{
+      ca, crypto::PrivateKey::LoadFromString(key), {}, settings};
+  const io::TlsClientContext client_context{16, {ca}};
+
+  std::vector<bool> reused;
+  TcpListener tcp_listener;
+  for (int i = 0; i < 2; ++i) {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [&server_context, test_deadline](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server), server_context,
+              test_deadline);
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          return tls_server.IsSessionReused();
+        },
+        std::move(server));
+
+    auto tls_client = io::TlsWrapper::StartTlsClient(
+        std::move(client), client_context, "tlswrapper_test", test_deadline);
+    char c = 0;
+    // TLS 1.3 session tickets arrive after the handshake
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+    const bool server_reused = server_task.Get();
+    EXPECT_EQ(server_reused, tls_client.IsSessionReused());
+    reused.push_back(server_reused);
+  }
+  return reused;
+}
+
+// OpenSSL client on top of an engine socket, for the TLS features that
+// TlsWrapper does not expose
+class RawTlsClient final {
+ public:
+  struct SslSessionDeleter {
+    void operator()(SSL_SESSION* session) const noexcept {
+      SSL_SESSION_free(session);
+    }
+  };
+  using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
+  RawTlsClient(io::Socket& socket, Deadline deadline)
+      : RawTlsClient(socket, deadline, nullptr, nullptr, nullptr) {}
+
+  // Presents the client certificate and resumes the `session` if it is set
+  RawTlsClient(io::Socket& socket, Deadline deadline,
+               const crypto::Certificate* client_cert,
+               const crypto::PrivateKey* client_key, SSL_SESSION* session)
+      : socket_(socket),
+        deadline_(deadline),
+        ctx_(SSL_CTX_new(TLS_client_method())),
+        ssl_(SSL_new(ctx_.get())) {
+    SSL_set_fd(ssl_.get(), socket_.Fd());
+    if (client_cert && client_key &&
+        (1 != SSL_use_certificate(ssl_.get(), client_cert->GetNative()) ||
+         1 != SSL_use_PrivateKey(ssl_.get(), client_key->GetNative()))) {
+      throw std::runtime_error("Failed to set the client certificate");
+    }
+    if (session && 1 != SSL_set_session(ssl_.get(), session)) {
+      throw std::runtime_error("SSL_set_session failed");
+    }
+    if (Retry([this] { return SSL_connect(ssl_.get()); }) != 1) {
+      throw std::runtime_error("SSL_connect failed");
+    }
+  }
+
+  bool IsSessionReused() const { return SSL_session_reused(ssl_.get()) == 1; }
+
+  SslSession GetSession() const {
+    return SslSession{SSL_get1_session(ssl_.get())};
+  }
+
+  void RequestKeyUpdate() {
+    if (1 != SSL_key_update(ssl_.get(), SSL_KEY_UPDATE_REQUESTED)) {
+      throw std::runtime_error("SSL_key_update failed");
+    }
+  }
+
+  void Send(std::string_view data) {
+    if (Retry([&] {
+          return SSL_write(ssl_.get(), data.data(), data.size());
+        }) != static_cast<int>(data.size())) {
+      throw std::runtime_error("SSL_write failed");
+    }
+  }
+
+  // Returns less than `size` if the connection breaks
+  std::string Recv(std::size_t size) {
+    std::string result(size, '\0');
+    std::size_t received = 0;
+    while (received < size) {
+      const auto ret = Retry([&] {
+        return SSL_read(ssl_.get(), result.data() + received,
+                        size - received);
+      });
+      if (ret <= 0) break;
+      received += ret;
+    }
+    result.resize(received);
+    return result;
+  }
+
+ private:
+  struct SslCtxDeleter {
+    void operator()(SSL_CTX* ctx) const noexcept { SSL_CTX_free(ctx); }
+  };
+  struct SslDeleter {
+    void operator()(SSL* ssl) const noexcept { SSL_free(ssl); }
+  };
+
+  template <typename Func>
+  int Retry(Func func) {
+    while (true) {
+      const auto ret = func();
+      if (ret > 0) return ret;
+      switch (SSL_get_error(ssl_.get(), ret)) {
+        case SSL_ERROR_WANT_READ:
+          if (!socket_.WaitReadable(deadline_)) return ret;
+          break;
+        case SSL_ERROR_WANT_WRITE:
+          if (!socket_.WaitWriteable(deadline_)) return ret;
+          break;
+        default:
+          return ret;
+      }
+    }
+  }
+
+  io::Socket& socket_;
+  const Deadline deadline_;
+  std::unique_ptr<SSL_CTX, SslCtxDeleter> ctx_;
+  std::unique_ptr<SSL, SslDeleter> ssl_;
+};
+
 }  // namespace
 
 UTEST_MT(TlsWrapper, Smoke, 2) {
@@ -572,4 +715,157 @@ UTEST(TlsWrapper, PeerDisconnect) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, SessionCacheResumption, 2) {
+  io::TlsServerSessionSettings settings;
+  settings.ticket_key_rotation_period = std::chrono::seconds::zero();
+  EXPECT_EQ(ConnectTwice(settings), (std::vector<bool>{false, true}));
+}
+
+UTEST_MT(TlsWrapper, SessionTicketResumption, 2) {
+  io::TlsServerSessionSettings settings;
+  settings.session_cache_size = 0;
+  EXPECT_EQ(ConnectTwice(settings), (std::vector<bool>{false, true}));
+}
+
+UTEST_MT(TlsWrapper, NoSessionResumption, 2) {
+  io::TlsServerSessionSettings settings;
+  settings.session_cache_size = 0;
+  settings.ticket_key_rotation_period = std::chrono::seconds::zero();
+  EXPECT_EQ(ConnectTwice(settings), (std::vector<bool>{false, false}));
+}
+
+UTEST_MT(TlsWrapper, KernelTlsOffload, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  io::TlsServerSessionSettings settings;
+  settings.kernel_tls_offload = true;
+  const io::TlsServerContext server_context{
+      crypto::Certificate::LoadFromString(cert),
+      crypto::PrivateKey::LoadFromString(key), {}, settings};
+  const std::string data(100 * 1024, 'a');
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+  auto server_task = engine::AsyncNoSpan(
+      [&server_context, &data, test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::forward<decltype(server)>(server), server_context,
+            test_deadline);
+        // Falls back to OpenSSL if the kernel does not support TLS
+        LOG_INFO() << "Kernel TLS: " << tls_server.IsKernelTlsSendEnabled();
+        EXPECT_EQ(data.size(),
+                  tls_server.SendAll(data.data(), data.size(), test_deadline));
+        char c = 0;
+        EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+        EXPECT_EQ('2', c);
+        if (tls_server.IsKernelTlsSendEnabled()) {
+          UEXPECT_THROW(static_cast<void>(tls_server.StopTls(test_deadline)),
+                        io::TlsException);
+        }
+      },
+      std::move(server));
+
+  auto tls_client =
+      io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+  std::string received(data.size(), '\0');
+  EXPECT_EQ(data.size(), tls_client.RecvAll(received.data(), received.size(),
+                                            test_deadline));
+  EXPECT_EQ(data, received);
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+  server_task.Get();
+}
+
+UTEST_MT(TlsWrapper, KernelTlsKeyUpdate, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  io::TlsServerSessionSettings settings;
+  settings.kernel_tls_offload = true;
+  const io::TlsServerContext server_context{
+      crypto::Certificate::LoadFromString(cert),
+      crypto::PrivateKey::LoadFromString(key), {}, settings};
+  const std::string data(100 * 1024, 'a');
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+  auto server_task = engine::AsyncNoSpan(
+      [&server_context, &data, test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::forward<decltype(server)>(server), server_context,
+            test_deadline);
+        LOG_INFO() << "Kernel TLS: " << tls_server.IsKernelTlsSendEnabled();
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+
+        // Receives the key update request of the client
+        char c = 0;
+        EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+        EXPECT_EQ('2', c);
+
+        // The kernel may be unable to rekey, then the connection breaks
+        // instead of sending the data encrypted with the stale keys
+        try {
+          return tls_server.SendAll(data.data(), data.size(),
+                                    test_deadline) == data.size();
+        } catch (const io::TlsException& ex) {
+          LOG_INFO() << "Send after the key update failed: " << ex;
+          return false;
+        }
+      },
+      std::move(server));
+
+  RawTlsClient tls_client{client, test_deadline};
+  EXPECT_EQ(tls_client.Recv(1), "1");
+  tls_client.RequestKeyUpdate();
+  tls_client.Send("2");
+
+  const auto received = tls_client.Recv(data.size());
+  const bool sent = server_task.Get();
+  if (sent) {
+    EXPECT_EQ(received, data);
+  } else {
+    EXPECT_LT(received.size(), data.size());
+  }
+}
+
+UTEST_MT(TlsWrapper, NoResumptionAfterCaReload, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto server_cert = crypto::Certificate::LoadFromString(cert);
+  const auto server_key = crypto::PrivateKey::LoadFromString(key);
+  // The self-signed certificate is also the client certificate and its CA
+  io::TlsServerContext server_context{server_cert, server_key, {server_cert}};
+
+  TcpListener tcp_listener;
+  RawTlsClient::SslSession session;
+  const auto connect = [&] {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [&server_context, test_deadline](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server), server_context,
+              test_deadline);
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          return tls_server.IsSessionReused();
+        },
+        std::move(server));
+
+    RawTlsClient tls_client{client, test_deadline, &server_cert, &server_key,
+                            session.get()};
+    // TLS 1.3 session tickets arrive after the handshake
+    EXPECT_EQ(tls_client.Recv(1), "1");
+    tls_client.Send("2");
+    session = tls_client.GetSession();
+    const bool server_reused = server_task.Get();
+    EXPECT_EQ(server_reused, tls_client.IsSessionReused());
+    return server_reused;
+  };
+
+  EXPECT_FALSE(connect());
+  EXPECT_TRUE(connect());
+
+  const auto other_ca = crypto::Certificate::LoadFromString(other_cert);
+  server_context.Reload(server_cert, server_key, {server_cert, other_ca});
+  EXPECT_FALSE(connect());
+  EXPECT_TRUE(connect());
+}
+
 USERVER_NAMESPACE_END
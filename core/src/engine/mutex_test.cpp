@@ -3,6 +3,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/sharded_shared_mutex.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/single_waiting_task_mutex.hpp>
 #include <userver/engine/sleep.hpp>
@@ -172,6 +173,8 @@ REGISTER_TYPED_UTEST_SUITE_P(Mutex,
 
 INSTANTIATE_TYPED_UTEST_SUITE_P(EngineMutex, Mutex, engine::Mutex);
 INSTANTIATE_TYPED_UTEST_SUITE_P(EngineSharedMutex, Mutex, engine::SharedMutex);
+INSTANTIATE_TYPED_UTEST_SUITE_P(EngineShardedSharedMutex, Mutex,
+                                engine::ShardedSharedMutex);
 INSTANTIATE_TYPED_UTEST_SUITE_P(EngineSingleWaitingTaskMutex, Mutex,
                                 engine::SingleWaitingTaskMutex);
 
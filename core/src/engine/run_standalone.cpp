@@ -26,7 +26,8 @@ void RunStandalone(std::size_t worker_threads,
 
   auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
       worker_threads, "coro-runner",
-      engine::impl::MakeTaskProcessorPools(config));
+      engine::impl::MakeTaskProcessorPools(config),
+      config.timer_wheel_enabled);
 
   engine::impl::RunOnTaskProcessorSync(*task_processor_holder,
                                        std::move(payload));
@@ -0,0 +1,151 @@
+#include <userver/engine/sharded_shared_mutex.hpp>
+
+#include <algorithm>
+#include <thread>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <concurrent/impl/thread_index.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize)
+    ShardedSharedMutex::ReaderSlot final {
+  /* Goes negative if a coroutine migrates to another thread and unlocks
+   * there, only the sum over all the slots is meaningful.
+   */
+  std::atomic<std::int64_t> readers{0};
+};
+
+ShardedSharedMutex::ShardedSharedMutex() {
+  const auto slots = concurrent::impl::RoundUpToPowerOf2(
+      std::max(std::thread::hardware_concurrency(), 1U));
+  slot_mask_ = slots - 1;
+  slots_ = std::make_unique<ReaderSlot[]>(slots);
+}
+
+ShardedSharedMutex::~ShardedSharedMutex() = default;
+
+void ShardedSharedMutex::lock() {
+  const auto ok = try_lock_until(Deadline{});
+  UASSERT(ok);
+}
+
+void ShardedSharedMutex::unlock() {
+  gate_.unlock();
+  ReleaseWriter();
+}
+
+bool ShardedSharedMutex::try_lock() {
+  return try_lock_until(Deadline::Passed());
+}
+
+bool ShardedSharedMutex::try_lock_until(Deadline deadline) {
+  /* Closes the fast path for new readers. Paired with the fetch_add+load in
+   * TryLockSharedFast(): either the reader sees the writer, or the writer sees
+   * the reader in the slot.
+   */
+  writers_count_.fetch_add(1, std::memory_order_seq_cst);
+
+  if (!gate_.try_lock_until(deadline)) {
+    ReleaseWriter();
+    return false;
+  }
+  if (!WaitForReaders(deadline)) {
+    gate_.unlock();
+    ReleaseWriter();
+    return false;
+  }
+  return true;
+}
+
+void ShardedSharedMutex::lock_shared() {
+  if (TryLockSharedFast()) return;
+
+  gate_.lock_shared();
+  AddReaderUnderGate();
+  gate_.unlock_shared();
+}
+
+void ShardedSharedMutex::unlock_shared() {
+  GetReaderCounter().fetch_sub(1, std::memory_order_seq_cst);
+  if (writers_count_.load(std::memory_order_seq_cst) != 0) {
+    readers_left_event_.Send();
+  }
+}
+
+bool ShardedSharedMutex::try_lock_shared() {
+  if (TryLockSharedFast()) return true;
+
+  if (!gate_.try_lock_shared()) return false;
+  AddReaderUnderGate();
+  gate_.unlock_shared();
+  return true;
+}
+
+bool ShardedSharedMutex::try_lock_shared_until(Deadline deadline) {
+  if (TryLockSharedFast()) return true;
+
+  if (!gate_.try_lock_shared_until(deadline)) return false;
+  AddReaderUnderGate();
+  gate_.unlock_shared();
+  return true;
+}
+
+// Threads get sequential indexes, so up to 'hardware_concurrency' threads
+// never share a slot.
+std::atomic<std::int64_t>& ShardedSharedMutex::GetReaderCounter() noexcept {
+  return slots_[concurrent::impl::GetCurrentThreadIndex() & slot_mask_]
+      .readers;
+}
+
+bool ShardedSharedMutex::TryLockSharedFast() {
+  auto& counter = GetReaderCounter();
+  counter.fetch_add(1, std::memory_order_seq_cst);
+  if (writers_count_.load(std::memory_order_seq_cst) == 0) return true;
+
+  /* A writer has come, step back and queue on the gate behind it. The
+   * writer might have already seen us in the slot, so wake it up.
+   */
+  counter.fetch_sub(1, std::memory_order_seq_cst);
+  readers_left_event_.Send();
+  return false;
+}
+
+void ShardedSharedMutex::AddReaderUnderGate() noexcept {
+  /* No writer holds the gate, so the next one to take it sees the reader */
+  GetReaderCounter().fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool ShardedSharedMutex::WaitForReaders(Deadline deadline) {
+  engine::TaskCancellationBlocker blocker;
+  while (HasReaders()) {
+    if (!readers_left_event_.WaitForEventUntil(deadline)) {
+      return !HasReaders();
+    }
+  }
+  return true;
+}
+
+bool ShardedSharedMutex::HasReaders() const noexcept {
+  std::int64_t readers = 0;
+  for (std::size_t i = 0; i <= slot_mask_; ++i) {
+    readers += slots_[i].readers.load(std::memory_order_seq_cst);
+  }
+  UASSERT_MSG(readers >= 0, "unlock_shared without lock_shared");
+  return readers != 0;
+}
+
+void ShardedSharedMutex::ReleaseWriter() noexcept {
+  [[maybe_unused]] const auto writers_left =
+      writers_count_.fetch_sub(1, std::memory_order_seq_cst);
+  UASSERT_MSG(writers_left > 0, "unlock without lock");
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,169 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <shared_mutex>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sharded_shared_mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ShardedSharedMutex, SharedLockUnlockDouble) {
+  engine::ShardedSharedMutex mutex;
+  mutex.lock_shared();
+  mutex.unlock_shared();
+
+  mutex.lock_shared();
+  mutex.unlock_shared();
+}
+
+UTEST(ShardedSharedMutex, SharedAndUniqueLock) {
+  engine::ShardedSharedMutex mutex;
+
+  std::unique_lock lock(mutex);
+  auto reader =
+      utils::Async("", [&mutex] { std::shared_lock shared_lock(mutex); });
+
+  reader.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(reader.IsFinished());
+
+  lock.unlock();
+
+  reader.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_TRUE(reader.IsFinished());
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST(ShardedSharedMutex, UniqueAndSharedLock) {
+  engine::ShardedSharedMutex mutex;
+
+  std::shared_lock lock(mutex);
+  auto writer =
+      utils::Async("", [&mutex] { std::unique_lock unique_lock(mutex); });
+
+  writer.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(writer.IsFinished());
+
+  lock.unlock();
+
+  writer.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_TRUE(writer.IsFinished());
+  UEXPECT_NO_THROW(writer.Get());
+}
+
+UTEST_MT(ShardedSharedMutex, WritersDontStarve, 2) {
+  engine::ShardedSharedMutex mutex;
+  std::atomic<int> counter{0};
+  std::atomic<int> loaded{-1};
+
+  std::shared_lock lock(mutex);
+  auto writer = utils::Async("", [&mutex, &counter, &loaded] {
+    std::unique_lock unique_lock(mutex);
+    loaded = counter.load();
+  });
+
+  writer.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(writer.IsFinished());
+
+  std::vector<engine::TaskWithResult<void>> readers;
+  readers.reserve(10);
+  for (int i = 0; i < 10; i++) {
+    readers.push_back(utils::Async("", [&counter, &mutex] {
+      std::shared_lock shared_lock(mutex);
+      counter++;
+    }));
+  }
+
+  writer.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(writer.IsFinished());
+
+  lock.unlock();
+
+  writer.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_TRUE(writer.IsFinished());
+  EXPECT_EQ(loaded.load(), 0);
+
+  for (auto& reader : readers) reader.Get();
+  EXPECT_EQ(counter.load(), 10);
+}
+
+UTEST(ShardedSharedMutex, TryLock) {
+  engine::ShardedSharedMutex mutex;
+
+  {
+    std::shared_lock lock(mutex);
+    auto task = utils::Async("", [&mutex] { return mutex.try_lock(); });
+    EXPECT_FALSE(task.Get());
+    EXPECT_TRUE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+  }
+
+  ASSERT_TRUE(mutex.try_lock());
+  auto task = utils::Async("", [&mutex] { return mutex.try_lock_shared(); });
+  EXPECT_FALSE(task.Get());
+  mutex.unlock();
+
+  // the failed attempts must leave the mutex free
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+UTEST(ShardedSharedMutex, TryLockForWithReader) {
+  engine::ShardedSharedMutex mutex;
+
+  std::shared_lock lock(mutex);
+  EXPECT_FALSE(utils::Async("", [&mutex] {
+                 return mutex.try_lock_for(std::chrono::milliseconds(10));
+               }).Get());
+
+  auto writer = utils::Async("", [&mutex] {
+    return mutex.try_lock_for(utest::kMaxTestWaitTime);
+  });
+  engine::SleepFor(std::chrono::milliseconds(10));
+  lock.unlock();
+  ASSERT_TRUE(writer.Get());
+  mutex.unlock();
+}
+
+UTEST_MT(ShardedSharedMutex, ReadersAndWriters, 4) {
+  constexpr int kReaders = 8;
+  constexpr int kWriters = 2;
+  constexpr int kIterations = 1000;
+
+  engine::ShardedSharedMutex mutex;
+  // Written under a unique lock only, both values must always match
+  int first = 0;
+  int second = 0;
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kReaders + kWriters);
+  for (int i = 0; i < kWriters; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (int j = 0; j < kIterations; ++j) {
+        std::unique_lock lock(mutex);
+        ++first;
+        engine::Yield();
+        ++second;
+      }
+    }));
+  }
+  for (int i = 0; i < kReaders; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (int j = 0; j < kIterations; ++j) {
+        std::shared_lock lock(mutex);
+        // the coroutine may continue on another thread
+        if (j % 16 == 0) engine::Yield();
+        ASSERT_EQ(first, second);
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(first, kWriters * kIterations);
+  EXPECT_EQ(second, kWriters * kIterations);
+}
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/sharded_shared_mutex.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -46,4 +47,58 @@ void shared_mutex_benchmark(benchmark::State& state) {
 }
 BENCHMARK(shared_mutex_benchmark)->DenseRange(1, 6);
 
+
+namespace {
+
+constexpr std::size_t kWriteEvery = 1000;
+
+}  // namespace
+
+// `state.range(0)` threads take shared locks, the measured one also takes
+// a unique lock once in kWriteEvery iterations.
+template <typename Mutex>
+void shared_mutex_read_heavy(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    int variable = 0;
+    Mutex mutex;
+    std::atomic<bool> is_running(true);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0) - 1);
+    for (int i = 0; i < state.range(0) - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (is_running) {
+          std::shared_lock lock(mutex);
+          benchmark::DoNotOptimize(variable);
+        }
+      }));
+    }
+
+    std::size_t iteration = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      if (++iteration % kWriteEvery == 0) {
+        std::unique_lock lock(mutex);
+        ++variable;
+      } else {
+        std::shared_lock lock(mutex);
+        benchmark::DoNotOptimize(variable);
+      }
+    }
+
+    is_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+BENCHMARK_TEMPLATE(shared_mutex_read_heavy, engine::SharedMutex)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(shared_mutex_read_heavy, engine::ShardedSharedMutex)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
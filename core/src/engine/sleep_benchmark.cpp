@@ -9,8 +9,18 @@ using namespace std::chrono_literals;
 
 USERVER_NAMESPACE_BEGIN
 
-void sleep_benchmark_us(benchmark::State& state) {
-  engine::RunStandalone([&] {
+namespace {
+
+engine::TaskProcessorPoolsConfig MakePoolsConfig(bool timer_wheel_enabled) {
+  engine::TaskProcessorPoolsConfig config;
+  config.timer_wheel_enabled = timer_wheel_enabled;
+  return config;
+}
+
+}  // namespace
+
+void sleep_benchmark_us(benchmark::State& state, bool timer_wheel_enabled) {
+  engine::RunStandalone(1, MakePoolsConfig(timer_wheel_enabled), [&] {
     const std::chrono::microseconds sleep_duration{state.range(0)};
     for ([[maybe_unused]] auto _ : state) {
       const auto deadline = engine::Deadline::FromDuration(sleep_duration);
@@ -18,7 +28,11 @@ void sleep_benchmark_us(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(sleep_benchmark_us)
+BENCHMARK_CAPTURE(sleep_benchmark_us, ev_timers, false)
+    ->RangeMultiplier(2)
+    ->Range(1, 1024 * 128)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(sleep_benchmark_us, timer_wheel, true)
     ->RangeMultiplier(2)
     ->Range(1, 1024 * 128)
     ->Unit(benchmark::kMicrosecond);
@@ -46,8 +60,9 @@ BENCHMARK(run_in_ev_loop_benchmark);
 BENCHMARK(successful_wait_for_benchmark);
 
 void unreached_task_deadline_benchmark(benchmark::State& state,
-                                       bool has_task_deadline) {
-  engine::RunStandalone([&] {
+                                       bool has_task_deadline,
+                                       bool timer_wheel_enabled) {
+  engine::RunStandalone(1, MakePoolsConfig(timer_wheel_enabled), [&] {
     for ([[maybe_unused]] auto _ : state) {
       const auto sleep_deadline = engine::Deadline::FromDuration(20s);
       const auto task_deadline_raw = engine::Deadline::FromDuration(40s);
@@ -63,8 +78,13 @@ void unreached_task_deadline_benchmark(benchmark::State& state,
     }
   });
 }
-BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, no_task_deadline, false);
+BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, no_task_deadline, false,
+                  false);
 BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, unreached_task_deadline,
-                  true);
+                  true, false);
+BENCHMARK_CAPTURE(unreached_task_deadline_benchmark,
+                  no_task_deadline_timer_wheel, false, true);
+BENCHMARK_CAPTURE(unreached_task_deadline_benchmark,
+                  unreached_task_deadline_timer_wheel, true, true);
 
 USERVER_NAMESPACE_END
@@ -8,6 +8,7 @@
 
 #include <engine/ev/data_pipe_to_ev.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/timer_wheel.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,6 +19,50 @@ enum class Action {
   kWakeupByEpoch,
 };
 
+namespace {
+
+struct TimerParams final {
+  Action action{};
+  SleepState::Epoch sleep_epoch{};
+  Deadline deadline{};
+};
+
+void InvokeTimerFunction(const TimerParams& params, TaskContext& context) {
+  UASSERT(params.action == Action::kCancel ||
+          params.action == Action::kWakeupByEpoch);
+  switch (params.action) {
+    case Action::kCancel:
+      context.RequestCancel(TaskCancellationReason::kDeadline);
+      break;
+    case Action::kWakeupByEpoch:
+      context.Wakeup(TaskContext::WakeupSource::kDeadlineTimer,
+                     params.sleep_epoch);
+      break;
+  }
+}
+
+// Timer of a task that lives in the TimerWheel of a TaskProcessor worker
+class WheelTimerEntry final : public TimerWheel::Entry {
+ public:
+  explicit WheelTimerEntry(TaskContext& context) : context_(context) {}
+
+  void SetParams(const TimerParams& params) noexcept { params_ = params; }
+
+ private:
+  void Fire() noexcept override {
+    try {
+      InvokeTimerFunction(params_, context_);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "exception in WheelTimerEntry::Fire(): " << ex;
+    }
+  }
+
+  TaskContext& context_;
+  TimerParams params_;
+};
+
+}  // namespace
+
 template <class Derived>
 class Finalizer : public ev::SingleShotAsyncPayload<Finalizer<Derived>> {
  public:
@@ -40,11 +85,7 @@ class TimerArmer : public ev::MultiShotAsyncPayload<TimerArmer<Derived>> {
 class ContextTimer::Impl final : public TimerArmer<Impl>,
                                  public Finalizer<Impl> {
  public:
-  struct Params {
-    Action action{};
-    SleepState::Epoch sleep_epoch{};
-    Deadline deadline{};
-  };
+  using Params = TimerParams;
 
   Impl();
   ~Impl();
@@ -65,11 +106,16 @@ class ContextTimer::Impl final : public TimerArmer<Impl>,
   void StopTimerInEvThread() noexcept;
 
   static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
-  static void InvokeTimerFunction(const Params& params, TaskContext& context);
   void DoOnTimer();
 
+  void RestartInWheel(Params params);
+  bool DisarmWheelEntry() noexcept;
+  void FinalizeInWheel() noexcept;
+
   boost::intrusive_ptr<TaskContext> context_;
   ev::TimerThreadControl* thread_control_ = nullptr;
+  WheelTimerEntry* wheel_entry_ = nullptr;
+  bool use_wheel_ = false;
   Params params_;
   ev_timer timer_{};
   ev::DataPipeToEv<Params> params_pipe_to_ev_;
@@ -84,6 +130,7 @@ ContextTimer::Impl::Impl() {
 ContextTimer::Impl::~Impl() {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
   UASSERT(!ev_is_active(&timer_));
+  UASSERT(!wheel_entry_);
 }
 
 bool ContextTimer::Impl::WasStarted() const noexcept {
@@ -97,6 +144,9 @@ void ContextTimer::Impl::Start(boost::intrusive_ptr<TaskContext>&& context,
   UASSERT(!thread_control_);
   context_ = std::move(context);
   thread_control_ = &thread_control;
+  // A task never leaves its TaskProcessor, so either all the workers it runs
+  // on have a wheel, or none of them
+  use_wheel_ = TimerWheel::GetForCurrentThread() != nullptr;
 
   Restart(std::move(params));
 }
@@ -104,6 +154,11 @@ void ContextTimer::Impl::Start(boost::intrusive_ptr<TaskContext>&& context,
 void ContextTimer::Impl::Restart(Params params) {
   UASSERT(WasStarted());
   UASSERT(params.deadline.IsReachable());
+  if (use_wheel_) {
+    RestartInWheel(params);
+    return;
+  }
+
   if (params.deadline.IsReached()) {
     InvokeTimerFunction(params, *context_);
     return;
@@ -119,6 +174,11 @@ void ContextTimer::Impl::Restart(Params params) {
 void ContextTimer::Impl::Finalize() {
   if (!WasStarted()) return;
 
+  if (use_wheel_) {
+    FinalizeInWheel();
+    return;
+  }
+
   // We cannot use *this as payload here, because with MultiShotAsyncPayload,
   // two ev runs with the same data can happen. The first run would drop
   // 'context_', potentially destroying *this. The second run would
@@ -153,21 +213,6 @@ void ContextTimer::Impl::DoArmTimerInEvThread() {
   thread_control_->Again(timer_);
 }
 
-void ContextTimer::Impl::InvokeTimerFunction(const Params& params,
-                                             TaskContext& context) {
-  UASSERT(params.action == Action::kCancel ||
-          params.action == Action::kWakeupByEpoch);
-  switch (params.action) {
-    case Action::kCancel:
-      context.RequestCancel(TaskCancellationReason::kDeadline);
-      break;
-    case Action::kWakeupByEpoch:
-      context.Wakeup(TaskContext::WakeupSource::kDeadlineTimer,
-                     params.sleep_epoch);
-      break;
-  }
-}
-
 void ContextTimer::Impl::StopTimerInEvThread() noexcept {
   UASSERT(!engine::current_task::IsTaskProcessorThread());
   thread_control_->Stop(timer_);
@@ -204,6 +249,56 @@ void ContextTimer::Impl::DoOnTimer() {
   StopTimerInEvThread();
 }
 
+void ContextTimer::Impl::RestartInWheel(Params params) {
+  auto* wheel = TimerWheel::GetForCurrentThread();
+  UASSERT(wheel);
+
+  const auto now = Deadline::Clock::now();
+  const auto expiration = now + params.deadline.TimeLeft();
+  if (expiration <= now) {
+    InvokeTimerFunction(params, *context_);
+    return;
+  }
+
+  if (wheel_entry_ && !DisarmWheelEntry()) {
+    // The old entry is owned by the wheel of another worker now
+    wheel_entry_ = nullptr;
+  }
+  if (!wheel_entry_) wheel_entry_ = new WheelTimerEntry(*context_);
+
+  wheel_entry_->SetParams(params);
+  wheel->Add(*wheel_entry_, expiration);
+}
+
+// Returns false if the entry was left to the wheel of another worker, in which
+// case it can't be reused.
+bool ContextTimer::Impl::DisarmWheelEntry() noexcept {
+  UASSERT(wheel_entry_);
+
+  auto* wheel = TimerWheel::GetForCurrentThread();
+  if (wheel_entry_->GetWheel() == wheel) {
+    // The task has not migrated since the entry was armed, so the entry can't
+    // be fired concurrently
+    if (wheel_entry_->IsArmed()) wheel->Remove(*wheel_entry_);
+    return true;
+  }
+
+  return !wheel_entry_->Abandon();
+}
+
+void ContextTimer::Impl::FinalizeInWheel() noexcept {
+  if (wheel_entry_) {
+    if (DisarmWheelEntry()) delete wheel_entry_;
+    wheel_entry_ = nullptr;
+  }
+
+  // The entry can't touch the context anymore, so it's safe to release it
+  // synchronously, unlike with ev timers
+  thread_control_ = nullptr;
+  context_.reset();
+  // ContextTimer may be destroyed at this point
+}
+
 ContextTimer::ContextTimer() = default;
 
 ContextTimer::~ContextTimer() = default;
@@ -2,6 +2,7 @@
 
 #include <sys/types.h>
 #include <csignal>
+#include <optional>
 
 #include <fmt/format.h>
 
@@ -17,6 +18,7 @@
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
+#include <engine/task/timer_wheel.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -248,8 +250,25 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
 }
 
 void TaskProcessor::ProcessTasks() noexcept {
+  std::optional<impl::TimerWheel> timer_wheel;
+  if (config_.timer_wheel_enabled) {
+    timer_wheel.emplace();
+    impl::TimerWheel::SetForCurrentThread(&*timer_wheel);
+  }
+
   while (true) {
-    auto context = task_queue_.PopBlocking();
+    boost::intrusive_ptr<impl::TaskContext> context;
+    if (timer_wheel && !timer_wheel->IsEmpty()) {
+      timer_wheel->Advance(std::chrono::steady_clock::now());
+      const auto next_wakeup = timer_wheel->GetNextWakeup();
+      if (next_wakeup) {
+        if (!task_queue_.PopBlockingUntil(*next_wakeup, context)) continue;
+      } else {
+        context = task_queue_.PopBlocking();
+      }
+    } else {
+      context = task_queue_.PopBlocking();
+    }
     if (!context) break;
 
     GetTaskCounter().AccountTaskSwitchSlow();
@@ -267,6 +286,8 @@ void TaskProcessor::ProcessTasks() noexcept {
       context->FinishDetached();
     }
   }
+
+  if (timer_wheel) impl::TimerWheel::SetForCurrentThread(nullptr);
 }
 
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
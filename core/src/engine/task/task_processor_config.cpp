@@ -56,6 +56,8 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
   config.spinning_iterations =
       value["spinning-iterations"].As<int>(config.spinning_iterations);
+  config.timer_wheel_enabled =
+      value["timer-wheel"].As<bool>(config.timer_wheel_enabled);
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
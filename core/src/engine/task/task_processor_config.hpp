@@ -29,6 +29,7 @@ struct TaskProcessorConfig {
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{10000};
+  bool timer_wheel_enabled{false};
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
@@ -1,5 +1,8 @@
 #include <engine/task/task_queue.hpp>
 
+#include <algorithm>
+#include <cstdint>
+
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -20,12 +23,9 @@ void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
 }
 
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
-  // Current thread handles only a single TaskProcessor, so it's safe to store
-  // a token for the task processor in a thread-local variable.
-  thread_local moodycamel::ConsumerToken token(queue_);
-
-  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(token),
-                                                  /* add_ref= */ false};
+  boost::intrusive_ptr<impl::TaskContext> context{
+      DoPopBlocking(GetConsumerToken()),
+      /* add_ref= */ false};
 
   if (!context) {
     // return "stop" token back
@@ -35,6 +35,27 @@ boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
   return context;
 }
 
+bool TaskQueue::PopBlockingUntil(
+    std::chrono::steady_clock::time_point until,
+    boost::intrusive_ptr<impl::TaskContext>& context) {
+  const auto timeout = std::chrono::ceil<std::chrono::microseconds>(
+      until - std::chrono::steady_clock::now());
+  if (!queue_semaphore_.wait(std::max(timeout.count(), std::int64_t{0}))) {
+    return false;
+  }
+
+  context = boost::intrusive_ptr<impl::TaskContext>{
+      DoPopAfterWait(GetConsumerToken()),
+      /* add_ref= */ false};
+
+  if (!context) {
+    // return "stop" token back
+    DoPush(nullptr);
+  }
+
+  return true;
+}
+
 void TaskQueue::StopProcessing() { DoPush(nullptr); }
 
 std::size_t TaskQueue::GetSizeApproximate() const noexcept {
@@ -49,11 +70,16 @@ void TaskQueue::DoPush(impl::TaskContext* context) {
 }
 
 impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
-  impl::TaskContext* context{};
-
   // This piece of code is copy-pasted from
   // moodycamel::BlockingConcurrentQueue::wait_dequeue
   queue_semaphore_.wait();
+  return DoPopAfterWait(token);
+}
+
+impl::TaskContext* TaskQueue::DoPopAfterWait(
+    moodycamel::ConsumerToken& token) {
+  impl::TaskContext* context{};
+
   while (!queue_.try_dequeue(token, context)) {
     // Can happen when another consumer steals our item in exchange for another
     // item in a Moodycamel sub-queue that we have already passed.
@@ -62,6 +88,13 @@ impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
   return context;
 }
 
+moodycamel::ConsumerToken& TaskQueue::GetConsumerToken() {
+  // Current thread handles only a single TaskProcessor, so it's safe to store
+  // a token for the task processor in a thread-local variable.
+  thread_local moodycamel::ConsumerToken token(queue_);
+  return token;
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include <moodycamel/blockingconcurrentqueue.h>
 #include <moodycamel/lightweightsemaphore.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
@@ -23,6 +25,10 @@ class TaskQueue final {
   // Returns nullptr as a stop signal
   boost::intrusive_ptr<impl::TaskContext> PopBlocking();
 
+  // Returns false on timeout, sets `context` to nullptr as a stop signal
+  bool PopBlockingUntil(std::chrono::steady_clock::time_point until,
+                        boost::intrusive_ptr<impl::TaskContext>& context);
+
   void StopProcessing();
 
   std::size_t GetSizeApproximate() const noexcept;
@@ -32,6 +38,10 @@ class TaskQueue final {
 
   impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
 
+  impl::TaskContext* DoPopAfterWait(moodycamel::ConsumerToken& token);
+
+  moodycamel::ConsumerToken& GetConsumerToken();
+
   moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
   moodycamel::LightweightSemaphore queue_semaphore_;
 };
@@ -0,0 +1,254 @@
+#include <engine/task/timer_wheel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+using TickDuration = std::chrono::milliseconds;
+
+compiler::ThreadLocal local_timer_wheel = [] {
+  return static_cast<TimerWheel*>(nullptr);
+};
+
+int CountTrailingZeros(std::uint64_t value) noexcept {
+  UASSERT(value != 0);
+  return __builtin_ctzll(value);
+}
+
+}  // namespace
+
+TimerWheelEntry::~TimerWheelEntry() {
+  UASSERT_MSG(!is_linked(), "Destroying an entry that is still in the wheel");
+}
+
+bool TimerWheelEntry::IsArmed() const noexcept {
+  return state_.load(std::memory_order_relaxed) == State::kArmed;
+}
+
+bool TimerWheelEntry::Abandon() noexcept {
+  auto state = state_.load(std::memory_order_acquire);
+  while (true) {
+    switch (state) {
+      case State::kIdle:
+        return false;
+      case State::kArmed:
+        if (state_.compare_exchange_weak(state, State::kAbandoned,
+                                         std::memory_order_acq_rel)) {
+          return true;
+        }
+        break;
+      case State::kFiring:
+        // Fire() is short, it only schedules a wakeup of a task
+        std::this_thread::yield();
+        state = state_.load(std::memory_order_acquire);
+        break;
+      case State::kAbandoned:
+        UASSERT_MSG(false, "Entry is abandoned twice");
+        return true;
+    }
+  }
+}
+
+TimerWheel::TimerWheel(Clock::time_point now) : epoch_(now) {}
+
+TimerWheel::~TimerWheel() {
+  const auto dispose = [](Entry* entry) {
+    // All the tasks are finished at this point, so their timers are abandoned
+    UASSERT(entry->state_.load() == Entry::State::kAbandoned);
+    if (entry->state_.load() == Entry::State::kAbandoned) delete entry;
+  };
+
+  for (auto& level : levels_) {
+    for (auto& slot : level.slots) slot.clear_and_dispose(dispose);
+  }
+  overflow_.clear_and_dispose(dispose);
+}
+
+void TimerWheel::Add(Entry& entry, Clock::time_point expiration) noexcept {
+  UASSERT(entry.state_.load() == Entry::State::kIdle);
+  UASSERT(!entry.is_linked());
+
+  entry.wheel_ = this;
+  entry.expiration_ = ToTickCeil(expiration);
+  entry.state_.store(Entry::State::kArmed, std::memory_order_release);
+  Link(entry);
+  ++size_;
+}
+
+void TimerWheel::Remove(Entry& entry) noexcept {
+  UASSERT(entry.wheel_ == this);
+  UASSERT(entry.IsArmed());
+
+  Unlink(entry);
+  --size_;
+  entry.state_.store(Entry::State::kIdle, std::memory_order_relaxed);
+}
+
+void TimerWheel::Advance(Clock::time_point now) noexcept {
+  const auto now_tick = ToTickFloor(now);
+
+  while (true) {
+    const auto next_tick = GetNextEventTick();
+    if (!next_tick || *next_tick > now_tick) break;
+
+    current_ = *next_tick;
+    ProcessCurrentTick();
+  }
+
+  // Nothing is scheduled up to `now_tick`, so moving there keeps all the
+  // entries in their slots.
+  current_ = std::max(current_, now_tick);
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::GetNextWakeup()
+    const noexcept {
+  const auto next_tick = GetNextEventTick();
+  if (!next_tick) return std::nullopt;
+
+  return epoch_ + TickDuration{*next_tick};
+}
+
+TimerWheel* TimerWheel::GetForCurrentThread() noexcept {
+  auto wheel = local_timer_wheel.Use();
+  return *wheel;
+}
+
+void TimerWheel::SetForCurrentThread(TimerWheel* wheel) noexcept {
+  auto local_wheel = local_timer_wheel.Use();
+  *local_wheel = wheel;
+}
+
+TimerWheel::Tick TimerWheel::ToTickCeil(Clock::time_point tp) const noexcept {
+  if (tp <= epoch_) return 0;
+  return std::chrono::ceil<TickDuration>(tp - epoch_).count();
+}
+
+TimerWheel::Tick TimerWheel::ToTickFloor(Clock::time_point tp) const noexcept {
+  if (tp <= epoch_) return 0;
+  return std::chrono::floor<TickDuration>(tp - epoch_).count();
+}
+
+// An entry is stored at the level of the highest group of kSlotBits bits in
+// which its expiration differs from the current tick, at the slot equal to
+// that group of its expiration. Such entries get cascaded to the lower levels
+// once the current tick reaches their slot.
+void TimerWheel::Link(Entry& entry) noexcept {
+  const auto expiration = std::max(entry.expiration_, current_);
+  const auto diff = expiration ^ current_;
+
+  std::size_t level = 0;
+  while (level < kLevelsCount && (diff >> (kSlotBits * (level + 1))) != 0) {
+    ++level;
+  }
+
+  entry.level_ = static_cast<std::uint8_t>(level);
+  if (level == kLevelsCount) {
+    overflow_.push_back(entry);
+    return;
+  }
+
+  const auto slot = (expiration >> (kSlotBits * level)) & (kSlotsCount - 1);
+  entry.slot_ = static_cast<std::uint8_t>(slot);
+  levels_[level].slots[slot].push_back(entry);
+  levels_[level].occupied |= std::uint64_t{1} << slot;
+}
+
+void TimerWheel::Unlink(Entry& entry) noexcept {
+  UASSERT(entry.is_linked());
+
+  if (entry.level_ == kLevelsCount) {
+    overflow_.erase(overflow_.iterator_to(entry));
+    return;
+  }
+
+  auto& level = levels_[entry.level_];
+  auto& slot = level.slots[entry.slot_];
+  slot.erase(slot.iterator_to(entry));
+  if (slot.empty()) level.occupied &= ~(std::uint64_t{1} << entry.slot_);
+}
+
+// Slots of a level are never behind the current tick, and all the events of
+// a level happen before the events of the next level.
+std::optional<TimerWheel::Tick> TimerWheel::GetNextEventTick() const noexcept {
+  for (std::size_t level = 0; level < kLevelsCount; ++level) {
+    const auto occupied = levels_[level].occupied;
+    if (!occupied) continue;
+
+    const auto shift = kSlotBits * level;
+    const auto base = (current_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+    return base | (static_cast<Tick>(CountTrailingZeros(occupied)) << shift);
+  }
+
+  if (!overflow_.empty()) {
+    const auto shift = kSlotBits * kLevelsCount;
+    return ((current_ >> shift) + 1) << shift;
+  }
+
+  return std::nullopt;
+}
+
+void TimerWheel::ProcessCurrentTick() noexcept {
+  for (std::size_t level = 0; level < kLevelsCount; ++level) {
+    if (!levels_[level].occupied) continue;
+
+    const auto slot_index =
+        (current_ >> (kSlotBits * level)) & (kSlotsCount - 1);
+    UASSERT(levels_[level].occupied & (std::uint64_t{1} << slot_index));
+
+    Slot slot;
+    slot.swap(levels_[level].slots[slot_index]);
+    levels_[level].occupied &= ~(std::uint64_t{1} << slot_index);
+
+    while (!slot.empty()) {
+      auto& entry = slot.front();
+      slot.pop_front();
+
+      if (level == 0) {
+        Expire(entry);
+      } else if (entry.state_.load(std::memory_order_acquire) ==
+                 Entry::State::kAbandoned) {
+        --size_;
+        delete &entry;
+      } else {
+        Link(entry);
+      }
+    }
+    return;
+  }
+
+  Slot overflow;
+  overflow.swap(overflow_);
+  while (!overflow.empty()) {
+    auto& entry = overflow.front();
+    overflow.pop_front();
+    Link(entry);
+  }
+}
+
+void TimerWheel::Expire(Entry& entry) noexcept {
+  --size_;
+
+  auto expected = Entry::State::kArmed;
+  if (entry.state_.compare_exchange_strong(expected, Entry::State::kFiring,
+                                           std::memory_order_acq_rel)) {
+    entry.Fire();
+    // The entry may be reused or destroyed by its owner right after this store
+    entry.state_.store(Entry::State::kIdle, std::memory_order_release);
+  } else {
+    UASSERT(expected == Entry::State::kAbandoned);
+    delete &entry;
+  }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <boost/intrusive/list.hpp>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TimerWheel;
+
+// An entry to be fired by a TimerWheel. Entries are allocated with `new`:
+// an abandoned entry is deleted by the wheel.
+class TimerWheelEntry : public boost::intrusive::list_base_hook<> {
+ public:
+  TimerWheelEntry() = default;
+  TimerWheelEntry(const TimerWheelEntry&) = delete;
+  TimerWheelEntry& operator=(const TimerWheelEntry&) = delete;
+  virtual ~TimerWheelEntry();
+
+  /// The wheel the entry was added to last time.
+  TimerWheel* GetWheel() const noexcept { return wheel_; }
+
+  /// May be called only from the thread of GetWheel().
+  bool IsArmed() const noexcept;
+
+  /// Prevents the entry from being fired, may be called from any thread.
+  /// Waits for a concurrent Fire() to finish.
+  ///
+  /// Returns true if the entry is still in the wheel: the wheel takes the
+  /// ownership of the entry and deletes it eventually. Otherwise the entry
+  /// is idle and stays owned by the caller.
+  bool Abandon() noexcept;
+
+ protected:
+  /// Called by the wheel on the wheel thread.
+  virtual void Fire() noexcept = 0;
+
+ private:
+  friend class TimerWheel;
+
+  enum class State : std::uint8_t {
+    kIdle,
+    kArmed,
+    kFiring,
+    kAbandoned,
+  };
+
+  std::atomic<State> state_{State::kIdle};
+  std::uint8_t level_{0};
+  std::uint8_t slot_{0};
+  TimerWheel* wheel_{nullptr};
+  std::uint64_t expiration_{0};
+};
+
+// Hierarchical timing wheel with a 1ms tick, which is the resolution the ev
+// loop timers effectively have.
+//
+// A wheel is owned by a single TaskProcessor worker thread: arming, disarming
+// and firing of entries happen on that thread without any synchronization or
+// cross-thread hops. The only operation allowed from other threads is
+// Entry::Abandon().
+class TimerWheel final {
+ public:
+  using Clock = Deadline::Clock;
+  using Tick = std::uint64_t;
+  using Entry = TimerWheelEntry;
+
+  explicit TimerWheel(Clock::time_point now = Clock::now());
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /// Arms an idle entry. The entry is fired by Advance() once `expiration` is
+  /// reached, never earlier.
+  void Add(Entry& entry, Clock::time_point expiration) noexcept;
+
+  /// Disarms an entry armed in this wheel without firing it.
+  void Remove(Entry& entry) noexcept;
+
+  /// Fires all the entries that have expired by `now`.
+  void Advance(Clock::time_point now) noexcept;
+
+  /// Returns the time point before which Advance() does nothing, or
+  /// std::nullopt if there are no entries in the wheel.
+  std::optional<Clock::time_point> GetNextWakeup() const noexcept;
+
+  bool IsEmpty() const noexcept { return size_ == 0; }
+
+  /// Wheel of the current TaskProcessor worker thread, if any.
+  static TimerWheel* GetForCurrentThread() noexcept;
+
+  static void SetForCurrentThread(TimerWheel* wheel) noexcept;
+
+ private:
+  static constexpr std::size_t kSlotBits = 6;
+  static constexpr std::size_t kSlotsCount = 1 << kSlotBits;
+  // 2^30 ticks ~ 12 days, farther entries are kept in the overflow list
+  static constexpr std::size_t kLevelsCount = 5;
+
+  using Slot = boost::intrusive::list<
+      Entry, boost::intrusive::constant_time_size<false>>;
+
+  struct Level final {
+    std::array<Slot, kSlotsCount> slots;
+    std::uint64_t occupied{0};
+  };
+
+  Tick ToTickCeil(Clock::time_point tp) const noexcept;
+  Tick ToTickFloor(Clock::time_point tp) const noexcept;
+
+  void Link(Entry& entry) noexcept;
+  void Unlink(Entry& entry) noexcept;
+
+  std::optional<Tick> GetNextEventTick() const noexcept;
+  void ProcessCurrentTick() noexcept;
+  void Expire(Entry& entry) noexcept;
+
+  const Clock::time_point epoch_;
+  Tick current_{0};
+  std::size_t size_{0};
+  std::array<Level, kLevelsCount> levels_;
+  Slot overflow_;
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
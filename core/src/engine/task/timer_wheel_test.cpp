@@ -0,0 +1,222 @@
+#include <engine/task/timer_wheel.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::impl::TimerWheel;
+using Clock = TimerWheel::Clock;
+
+using namespace std::chrono_literals;
+
+class TestEntry final : public TimerWheel::Entry {
+ public:
+  explicit TestEntry(std::size_t& fired, std::size_t* destroyed = nullptr)
+      : fired_(fired), destroyed_(destroyed) {}
+
+  ~TestEntry() override {
+    if (destroyed_) ++*destroyed_;
+  }
+
+ private:
+  void Fire() noexcept override { ++fired_; }
+
+  std::size_t& fired_;
+  std::size_t* destroyed_;
+};
+
+engine::TaskProcessorPoolsConfig MakeTimerWheelConfig() {
+  engine::TaskProcessorPoolsConfig config;
+  config.timer_wheel_enabled = true;
+  return config;
+}
+
+}  // namespace
+
+TEST(TimerWheel, FiresOnExpiration) {
+  const auto start = Clock::now();
+  TimerWheel wheel{start};
+  EXPECT_TRUE(wheel.IsEmpty());
+  EXPECT_FALSE(wheel.GetNextWakeup().has_value());
+
+  std::size_t fired = 0;
+  TestEntry entry{fired};
+  wheel.Add(entry, start + 10ms);
+  EXPECT_FALSE(wheel.IsEmpty());
+  EXPECT_TRUE(entry.IsArmed());
+  EXPECT_EQ(wheel.GetNextWakeup(), start + 10ms);
+
+  wheel.Advance(start + 9ms);
+  EXPECT_EQ(fired, 0);
+
+  wheel.Advance(start + 10ms);
+  EXPECT_EQ(fired, 1);
+  EXPECT_FALSE(entry.IsArmed());
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimerWheel, NeverFiresEarly) {
+  const auto start = Clock::now();
+  TimerWheel wheel{start};
+
+  std::size_t fired = 0;
+  TestEntry entry{fired};
+  wheel.Add(entry, start + 5ms + 1us);
+
+  wheel.Advance(start + 5ms);
+  EXPECT_EQ(fired, 0);
+
+  wheel.Advance(start + 6ms);
+  EXPECT_EQ(fired, 1);
+}
+
+TEST(TimerWheel, CascadesFromUpperLevels) {
+  const auto start = Clock::now();
+  TimerWheel wheel{start};
+
+  const std::vector<std::chrono::milliseconds> timeouts{
+      1ms, 63ms, 64ms, 65ms, 4095ms, 4096ms, 300s, 5h, 20 * 24h};
+
+  std::size_t fired = 0;
+  std::vector<std::unique_ptr<TestEntry>> entries;
+  for (const auto timeout : timeouts) {
+    entries.push_back(std::make_unique<TestEntry>(fired));
+    wheel.Add(*entries.back(), start + timeout);
+  }
+
+  std::size_t expected_fired = 0;
+  for (const auto timeout : timeouts) {
+    wheel.Advance(start + timeout - 1ms);
+    EXPECT_EQ(fired, expected_fired) << timeout.count();
+
+    const auto next_wakeup = wheel.GetNextWakeup();
+    ASSERT_TRUE(next_wakeup.has_value());
+    EXPECT_LE(*next_wakeup, start + timeout);
+
+    wheel.Advance(start + timeout);
+    EXPECT_EQ(fired, ++expected_fired) << timeout.count();
+  }
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimerWheel, Remove) {
+  const auto start = Clock::now();
+  TimerWheel wheel{start};
+
+  std::size_t fired = 0;
+  TestEntry entry{fired};
+  wheel.Add(entry, start + 100ms);
+  wheel.Remove(entry);
+  EXPECT_FALSE(entry.IsArmed());
+  EXPECT_TRUE(wheel.IsEmpty());
+
+  wheel.Advance(start + 1s);
+  EXPECT_EQ(fired, 0);
+
+  wheel.Add(entry, start + 2s);
+  wheel.Advance(start + 2s);
+  EXPECT_EQ(fired, 1);
+}
+
+TEST(TimerWheel, Abandon) {
+  const auto start = Clock::now();
+  TimerWheel wheel{start};
+
+  std::size_t fired = 0;
+  std::size_t destroyed = 0;
+
+  auto* entry = new TestEntry{fired, &destroyed};
+  wheel.Add(*entry, start + 100s);
+  EXPECT_TRUE(entry->Abandon());
+
+  wheel.Advance(start + 100s);
+  EXPECT_EQ(fired, 0);
+  EXPECT_EQ(destroyed, 1);
+  EXPECT_TRUE(wheel.IsEmpty());
+
+  TestEntry idle_entry{fired, &destroyed};
+  wheel.Add(idle_entry, start + 101s);
+  wheel.Advance(start + 101s);
+  EXPECT_EQ(fired, 1);
+  EXPECT_FALSE(idle_entry.Abandon());
+}
+
+TEST(TimerWheel, DestroysAbandonedEntries) {
+  const auto start = Clock::now();
+  std::size_t fired = 0;
+  std::size_t destroyed = 0;
+
+  {
+    TimerWheel wheel{start};
+    auto* entry = new TestEntry{fired, &destroyed};
+    wheel.Add(*entry, start + 1h);
+    EXPECT_TRUE(entry->Abandon());
+  }
+
+  EXPECT_EQ(fired, 0);
+  EXPECT_EQ(destroyed, 1);
+}
+
+TEST(TimerWheel, EngineSleep) {
+  engine::RunStandalone(1, MakeTimerWheelConfig(), [] {
+    const auto start = Clock::now();
+    engine::SleepFor(20ms);
+    EXPECT_GE(Clock::now() - start, 20ms);
+  });
+}
+
+TEST(TimerWheel, EngineWaitTimeout) {
+  engine::RunStandalone(1, MakeTimerWheelConfig(), [] {
+    engine::SingleConsumerEvent event;
+    EXPECT_FALSE(event.WaitForEventFor(10ms));
+
+    auto task = engine::AsyncNoSpan([&event] { event.Send(); });
+    EXPECT_TRUE(event.WaitForEventFor(10s));
+  });
+}
+
+TEST(TimerWheel, EngineTaskDeadline) {
+  engine::RunStandalone(1, MakeTimerWheelConfig(), [] {
+    auto task = engine::AsyncNoSpan(engine::Deadline::FromDuration(10ms), [] {
+      engine::InterruptibleSleepFor(10s);
+    });
+    task.Wait();
+    EXPECT_EQ(task.CancellationReason(),
+              engine::TaskCancellationReason::kDeadline);
+  });
+}
+
+TEST(TimerWheel, EngineTaskMigration) {
+  engine::RunStandalone(4, MakeTimerWheelConfig(), [] {
+    constexpr std::size_t kTasksCount = 100;
+    std::atomic<std::size_t> timeouts{0};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasksCount);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&timeouts] {
+        engine::SingleConsumerEvent event;
+        for (int j = 0; j < 10; ++j) {
+          // Armed on one worker, re-armed on another one after the Yield
+          if (!event.WaitForEventFor(1ms)) ++timeouts;
+          engine::Yield();
+        }
+      }));
+    }
+
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(timeouts, kTasksCount * 10);
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <server/server_config.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,7 +27,10 @@ Server::Server(const components::ComponentConfig& component_config,
     : LoggableComponentBase(component_config, component_context),
       server_(std::make_unique<server::Server>(
           component_config.As<server::ServerConfig>(),
-          GetSecdist(component_context), component_context)) {
+          GetSecdist(component_context), component_context)),
+      signal_processor_(
+          component_context.FindComponent<os_signals::ProcessorComponent>()
+              .Get()) {
   auto& statistics_storage =
       component_context.FindComponent<StatisticsStorage>().GetStorage();
   server_statistics_holder_ = statistics_storage.RegisterWriter(
@@ -43,9 +47,15 @@ Server::~Server() {
   handler_statistics_holder_.Unregister();
 }
 
-void Server::OnAllComponentsLoaded() { server_->Start(); }
+void Server::OnAllComponentsLoaded() {
+  server_->Start();
+  signal_subscriber_ = signal_processor_.AddListener(
+      this, kName, os_signals::kSigUsr1, &Server::OnTlsReload);
+}
 
 void Server::OnAllComponentsAreStopping() {
+  signal_subscriber_.Unsubscribe();
+
   /* components::Server has to stop all Listeners before unloading components
    * as handlers have no ability to call smth like RemoveHandler() from
    * server::Server. Without such server stop before unloading a new request may
@@ -63,6 +73,16 @@ void Server::AddHandler(const server::handlers::HttpHandlerBase& handler,
   server_->AddHandler(handler, task_processor);
 }
 
+void Server::OnTlsReload() {
+  try {
+    server_->ReloadTls();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to reload the TLS certificates, new connections "
+                   "use the previous ones: "
+                << ex;
+  }
+}
+
 void Server::WriteStatistics(utils::statistics::Writer& writer) {
   server_->WriteMonitorData(writer);
 }
@@ -130,6 +150,10 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    kernel-offload:
+                        type: boolean
+                        description: offload the encryption of responses to the kernel TLS after the handshake, if supported
+                        defaultDescription: false
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -180,9 +204,27 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    zero_copy_body_threshold:
+                        type: integer
+                        description: request bodies larger than this value are kept as views into the receive buffers instead of being copied, the URL and the headers are always copied; 0 to always copy
+                        defaultDescription: 0
+                        minimum: 0
+                    out_buffer_size:
+                        type: integer
+                        description: max size of the responses of the pipelined requests and of the body chunks that are coalesced into a single write; 0 to write each of them separately
+                        defaultDescription: 65536
+                        minimum: 0
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+            steering:
+                type: string
+                description: how the kernel distributes new connections between the shards
+                defaultDescription: none
+                enum:
+                  - none
+                  - incoming-cpu
+                  - cpu-bpf
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -459,6 +459,17 @@ std::string CutTrailingSlash(
   return std::move(meta_type);
 }
 
+// A body received without copying is not concatenated just for logging, only
+// the part of it that fits into the log limit is
+std::string GetRequestBodyPrefixForLogging(const http::HttpRequestImpl& request,
+                                           std::size_t limit) {
+  auto prefix = request.RequestBodyPrefix(limit);
+  if (prefix.size() < request.RequestBodySize()) {
+    utils::text::utf8::TrimTruncatedEnding(prefix);
+  }
+  return prefix;
+}
+
 // Separate function to avoid heavy computations when the result is not going
 // to be logged
 logging::LogExtra LogRequestExtra(bool need_log_request_headers,
@@ -694,12 +705,20 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     if (request_processor.GetInitialDynamicConfig()[kLogRequest]) {
       const bool need_log_request_headers =
           request_processor.GetInitialDynamicConfig()[kLogRequestHeaders];
+      const bool is_body_zero_copy = http_request_impl.IsRequestBodyZeroCopy();
+      const auto body_prefix =
+          is_body_zero_copy
+              ? GetRequestBodyPrefixForLogging(
+                    http_request_impl, GetConfig().request_body_size_log_limit)
+              : std::string{};
       LOG_INFO() << "start handling"
                  << LogRequestExtra(
                         need_log_request_headers, http_request, meta_type,
                         GetRequestBodyForLoggingChecked(
-                            http_request, context, http_request.RequestBody()),
-                        http_request.RequestBody().length());
+                            http_request, context,
+                            is_body_zero_copy ? body_prefix
+                                              : http_request.RequestBody()),
+                        http_request_impl.RequestBodySize());
     }
 
     {
@@ -887,7 +906,7 @@ void HttpHandlerBase::DecompressRequestBody(
     if (content_encoding == "gzip") {
       http_request.RemoveHeader("Content-Encoding");
       auto body = compression::gzip::Decompress(
-          http_request.RequestBody(),
+          http_request.RequestBodyPieces(),
           GetConfig().request_config.max_request_size);
       http_request.SetRequestBody(std::move(body));
       if (GetConfig().request_config.parse_args_from_body) {
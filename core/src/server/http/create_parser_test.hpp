@@ -15,7 +15,8 @@ USERVER_NAMESPACE_BEGIN
 namespace server {
 
 inline server::http::HttpRequestParser CreateTestParser(
-    server::http::HttpRequestParser::OnNewRequestCb&& cb) {
+    server::http::HttpRequestParser::OnNewRequestCb&& cb,
+    std::size_t zero_copy_body_threshold = 0) {
   static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
   static constexpr server::request::HttpRequestConfig kTestRequestConfig{
       /*.max_url_size = */ 8192,
@@ -29,7 +30,8 @@ inline server::http::HttpRequestParser CreateTestParser(
   static server::request::ResponseDataAccounter test_accounter;
   return server::http::HttpRequestParser(kTestHandlerInfoIndex,
                                          kTestRequestConfig, std::move(cb),
-                                         test_stats, test_accounter);
+                                         test_stats, test_accounter,
+                                         zero_copy_body_threshold);
 }
 
 }  // namespace server
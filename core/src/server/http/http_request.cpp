@@ -164,6 +164,10 @@ const std::string& HttpRequest::RequestBody() const {
   return impl_.RequestBody();
 }
 
+std::vector<std::string_view> HttpRequest::RequestBodyPieces() const {
+  return impl_.RequestBodyPieces();
+}
+
 const HttpRequest::HeadersMap& HttpRequest::RequestHeaders() const {
   return impl_.GetHeaders();
 }
@@ -172,6 +176,10 @@ const HttpRequest::CookiesMap& HttpRequest::RequestCookies() const {
   return impl_.GetCookies();
 }
 
+std::pmr::memory_resource& HttpRequest::GetArena() const {
+  return impl_.GetArena();
+}
+
 void HttpRequest::SetRequestBody(std::string body) {
   impl_.SetRequestBody(std::move(body));
 }  // namespace server::http
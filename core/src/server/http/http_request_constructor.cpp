@@ -43,10 +43,13 @@ void StripDuplicateStartingSlashes(std::string& s) {
 
 HttpRequestConstructor::HttpRequestConstructor(
     Config config, const HandlerInfoIndex& handler_info_index,
-    request::ResponseDataAccounter& data_accounter)
+    request::ResponseDataAccounter& data_accounter, RequestArenaPtr arena,
+    std::size_t zero_copy_body_threshold)
     : config_(config),
       handler_info_index_(handler_info_index),
-      request_(std::make_shared<HttpRequestImpl>(data_accounter)) {}
+      zero_copy_body_threshold_(zero_copy_body_threshold),
+      request_(std::make_shared<HttpRequestImpl>(data_accounter,
+                                                 std::move(arena))) {}
 
 void HttpRequestConstructor::SetMethod(HttpMethod method) {
   request_->method_ = method;
@@ -161,6 +164,17 @@ void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   request_->request_body_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendBody(const char* data, size_t size,
+                                        const InputChunkPtr& chunk) {
+  if (!zero_copy_body_threshold_) {
+    AppendBody(data, size);
+    return;
+  }
+
+  AccountRequestSize(size);
+  request_->body_rope_.Append(std::string_view{data, size}, chunk);
+}
+
 void HttpRequestConstructor::SetIsFinal(bool is_final) {
   request_->is_final_ = is_final;
 }
@@ -168,6 +182,14 @@ void HttpRequestConstructor::SetIsFinal(bool is_final) {
 std::shared_ptr<request::RequestBase> HttpRequestConstructor::Finalize() {
   LOG_TRACE() << "method=" << request_->GetMethodStr();
 
+  // Small bodies are not worth keeping the receive buffers alive
+  auto& body_rope = request_->body_rope_;
+  if (!body_rope.IsEmpty() &&
+      body_rope.GetSize() <= zero_copy_body_threshold_) {
+    request_->request_body_ = body_rope.Flatten();
+    body_rope.Clear();
+  }
+
   FinalizeImpl();
 
   CheckStatus();
@@ -190,8 +212,8 @@ void HttpRequestConstructor::FinalizeImpl() {
     ParseArgs(parsed_url_);
     if (config_.parse_args_from_body) {
       if (!config_.decompress_request || !request_->IsBodyCompressed())
-        ParseArgs(request_->request_body_.data(),
-                  request_->request_body_.size());
+        ParseArgs(request_->RequestBody().data(),
+                  request_->RequestBody().size());
     }
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't parse args: " << ex;
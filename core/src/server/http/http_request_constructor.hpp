@@ -12,6 +12,7 @@
 
 #include "handler_info_index.hpp"
 #include "http_request_impl.hpp"
+#include "input_chunk.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -37,7 +38,9 @@ class HttpRequestConstructor final : public request::RequestConstructor {
 
   HttpRequestConstructor(Config config,
                          const HandlerInfoIndex& handler_info_index,
-                         request::ResponseDataAccounter& data_accounter);
+                         request::ResponseDataAccounter& data_accounter,
+                         RequestArenaPtr arena,
+                         std::size_t zero_copy_body_threshold = 0);
 
   HttpRequestConstructor(HttpRequestConstructor&&) = delete;
   HttpRequestConstructor& operator=(HttpRequestConstructor&&) = delete;
@@ -51,6 +54,9 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
   void AppendBody(const char* data, size_t size);
+  // Keeps a view into `chunk` instead of copying if zero_copy_body_threshold
+  // is set, see HttpRequestParser
+  void AppendBody(const char* data, size_t size, const InputChunkPtr& chunk);
 
   void SetIsFinal(bool is_final);
 
@@ -73,6 +79,7 @@ class HttpRequestConstructor final : public request::RequestConstructor {
 
   Config config_;
   const HandlerInfoIndex& handler_info_index_;
+  const std::size_t zero_copy_body_threshold_;
 
   http_parser_url parsed_url_{};
   std::string header_field_;
@@ -1,6 +1,11 @@
 #include <benchmark/benchmark.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/request_arena.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,9 +21,51 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+template <typename ArenaFactory>
+void FillRequestArgs(benchmark::State& state, ArenaFactory arena_factory) {
+  server::request::ResponseDataAccounter accounter;
+
+  std::string body;
+  std::vector<std::pair<std::string, std::string>> path_args;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    if (!body.empty()) body += '&';
+    body += "argument_name_" + std::to_string(i) + "=value";
+    path_args.emplace_back("path_arg_name_" + std::to_string(i), "value");
+  }
+
+  for ([[maybe_unused]] auto _ : state) {
+    server::http::HttpRequestImpl request{accounter, arena_factory()};
+    request.SetRequestBody(body);
+    request.ParseArgsFromBody();
+    request.SetPathArgs(path_args);
+    benchmark::DoNotOptimize(request.ArgCount());
+  }
+}
+
+void http_request_constructor_args_new_arena(benchmark::State& state) {
+  FillRequestArgs(state, [] {
+    return server::http::MakeStandaloneRequestArena();
+  });
+}
+
+// Keep-alive connection: the arena of the previous request is reused
+void http_request_constructor_args_reused_arena(benchmark::State& state) {
+  const auto pool = std::make_shared<server::http::RequestArenaPool>();
+  FillRequestArgs(state, [&pool] { return pool->Acquire(); });
+}
+
 }  // namespace
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
 
+BENCHMARK(http_request_constructor_args_new_arena)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+
+BENCHMARK(http_request_constructor_args_reused_arena)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include "http_request_impl.hpp"
 
+#include <algorithm>
+
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/task/task.hpp>
@@ -64,6 +66,18 @@ std::string EscapeForAccessTskvLog(const std::string& str) {
   return encoded_str;
 }
 
+// Does not concatenate a body received without copying
+std::string EscapeForAccessTskvLog(
+    const std::vector<std::string_view>& pieces) {
+  if (pieces.empty()) return "-";
+
+  std::string encoded_str;
+  for (const auto piece : pieces) {
+    EncodeTskv(encoded_str, piece, utils::encoding::EncodeTskvMode::kValue);
+  }
+  return encoded_str;
+}
+
 const std::string kEmptyString{};
 const std::vector<std::string> kEmptyVector{};
 
@@ -74,11 +88,17 @@ namespace server::http {
 // Use hash_function() magic to pass out the same RNG seed among all
 // unordered_maps because we don't need different seeds and want to avoid its
 // overhead.
-HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter)
-    : form_data_args_(kZeroAllocationBucketCount,
+HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter,
+                                 RequestArenaPtr arena)
+    : arena_(std::move(arena)),
+      request_args_(kZeroAllocationBucketCount, utils::StrCaseHash{},
+                    std::equal_to<>{}, &arena_->GetResource()),
+      form_data_args_(kZeroAllocationBucketCount,
                       request_args_.hash_function()),
+      path_args_(&arena_->GetResource()),
       path_args_by_name_index_(kZeroAllocationBucketCount,
-                               request_args_.hash_function()),
+                               request_args_.hash_function(),
+                               std::equal_to<>{}, &arena_->GetResource()),
       headers_(kBucketCount),
       cookies_(kZeroAllocationBucketCount, request_args_.hash_function()),
       response_(*this, data_accounter) {}
@@ -253,8 +273,38 @@ const HttpRequest::CookiesMap& HttpRequestImpl::GetCookies() const {
   return cookies_;
 }
 
+const std::string& HttpRequestImpl::RequestBody() const {
+  std::call_once(request_body_flatten_once_, [this] {
+    if (!body_rope_.IsEmpty()) request_body_ = body_rope_.Flatten();
+  });
+  return request_body_;
+}
+
+std::vector<std::string_view> HttpRequestImpl::RequestBodyPieces() const {
+  if (!body_rope_.IsEmpty()) return body_rope_.GetPieces();
+  if (request_body_.empty()) return {};
+  return {request_body_};
+}
+
+std::size_t HttpRequestImpl::RequestBodySize() const noexcept {
+  return body_rope_.IsEmpty() ? request_body_.size() : body_rope_.GetSize();
+}
+
+std::string HttpRequestImpl::RequestBodyPrefix(std::size_t max_size) const {
+  if (body_rope_.IsEmpty()) return request_body_.substr(0, max_size);
+
+  std::string result;
+  result.reserve(std::min(max_size, body_rope_.GetSize()));
+  for (const auto piece : body_rope_.GetPieces()) {
+    if (result.size() == max_size) break;
+    result.append(piece.substr(0, max_size - result.size()));
+  }
+  return result;
+}
+
 void HttpRequestImpl::SetRequestBody(std::string body) {
   request_body_ = std::move(body);
+  body_rope_.Clear();
 }
 
 void HttpRequestImpl::ParseArgsFromBody() {
@@ -262,7 +312,7 @@ void HttpRequestImpl::ParseArgsFromBody() {
       request_args_.empty(),
       "References to arguments could be invalidated by ParseArgsFromBody()");
   USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
-      request_body_, [this](std::string&& key, std::string&& value) {
+      RequestBody(), [this](std::string&& key, std::string&& value) {
         request_args_[std::move(key)].push_back(std::move(value));
       });
 }
@@ -407,7 +457,7 @@ void HttpRequestImpl::WriteAccessTskvLog(
                   EscapeForAccessTskvLog(GetHost()),
                   EscapeForAccessTskvLog(remote_address),
                   GetRequestTime().count(), GetResponseTime().count(),
-                  EscapeForAccessTskvLog(RequestBody())));
+                  EscapeForAccessTskvLog(RequestBodyPieces())));
 }
 
 }  // namespace server::http
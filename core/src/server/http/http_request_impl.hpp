@@ -2,7 +2,10 @@
 
 #include <chrono>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +19,9 @@
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include <server/http/request_arena.hpp>
+#include <server/http/request_body_rope.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -28,7 +34,8 @@ namespace http {
 
 class HttpRequestImpl final : public request::RequestBase {
  public:
-  HttpRequestImpl(request::ResponseDataAccounter& data_accounter);
+  HttpRequestImpl(request::ResponseDataAccounter& data_accounter,
+                  RequestArenaPtr arena = MakeStandaloneRequestArena());
   ~HttpRequestImpl() override;
 
   const HttpMethod& GetMethod() const { return method_; }
@@ -82,7 +89,16 @@ class HttpRequestImpl final : public request::RequestBase {
   HttpRequest::CookiesMapKeys GetCookieNames() const;
   const HttpRequest::CookiesMap& GetCookies() const;
 
-  const std::string& RequestBody() const { return request_body_; }
+  std::pmr::memory_resource& GetArena() const {
+    return arena_->GetResource();
+  }
+
+  const std::string& RequestBody() const;
+  std::vector<std::string_view> RequestBodyPieces() const;
+  // The following do not concatenate a body received without copying
+  bool IsRequestBodyZeroCopy() const noexcept { return !body_rope_.IsEmpty(); }
+  std::size_t RequestBodySize() const noexcept;
+  std::string RequestBodyPrefix(std::size_t max_size) const;
   void SetRequestBody(std::string body);
   void ParseArgsFromBody();
   void SetResponseStatus(HttpStatus status) const {
@@ -139,22 +155,37 @@ class HttpRequestImpl final : public request::RequestBase {
   friend class HttpRequestConstructor;
 
  private:
+  template <typename T>
+  using ArenaAllocator = std::pmr::polymorphic_allocator<T>;
+
+  // Only the nodes and the vectors are in the arena: the strings are returned
+  // by reference as std::string through the HttpRequest API
+  template <typename Value>
+  using ArgsMap = utils::impl::TransparentMap<
+      std::string, Value, utils::StrCaseHash, std::equal_to<>,
+      ArenaAllocator<std::pair<const std::string, Value>>>;
+
+  // Destroyed last, after all the containers that allocate from it
+  RequestArenaPtr arena_;
+
   HttpMethod method_{HttpMethod::kUnknown};
   unsigned short http_major_{1};
   unsigned short http_minor_{1};
   std::string url_;
   std::string request_path_;
-  std::string request_body_;
+  // Concatenated from body_rope_ on the first RequestBody() call. The rope
+  // is kept intact, so that RequestBodyPieces() stays valid.
+  mutable std::string request_body_;
+  mutable std::once_flag request_body_flatten_once_;
+  RequestBodyRope body_rope_;
   std::string path_suffix_;
-  utils::impl::TransparentMap<std::string, std::vector<std::string>,
-                              utils::StrCaseHash>
-      request_args_;
+  ArgsMap<std::vector<std::string>> request_args_;
+  // Filled by the multipart parser, so not in the arena
   utils::impl::TransparentMap<std::string, std::vector<FormDataArg>,
                               utils::StrCaseHash>
       form_data_args_;
-  std::vector<std::string> path_args_;
-  utils::impl::TransparentMap<std::string, size_t, utils::StrCaseHash>
-      path_args_by_name_index_;
+  std::vector<std::string, ArenaAllocator<std::string>> path_args_;
+  ArgsMap<size_t> path_args_by_name_index_;
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
@@ -4,6 +4,7 @@
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -52,9 +53,11 @@ HttpRequestParser::HttpRequestParser(
     const HandlerInfoIndex& handler_info_index,
     const request::HttpRequestConfig& request_config,
     OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
-    request::ResponseDataAccounter& data_accounter)
+    request::ResponseDataAccounter& data_accounter,
+    std::size_t zero_copy_body_threshold)
     : handler_info_index_(handler_info_index),
       request_constructor_config_{request_config},
+      zero_copy_body_threshold_(zero_copy_body_threshold),
       on_new_request_cb_(std::move(on_new_request_cb)),
       stats_(stats),
       data_accounter_(data_accounter) {
@@ -78,6 +81,16 @@ bool HttpRequestParser::Parse(const char* data, size_t size) {
   return true;
 }
 
+bool HttpRequestParser::Parse(const InputChunkPtr& chunk, size_t offset,
+                              size_t size) {
+  UASSERT(chunk);
+  UASSERT(offset + size <= chunk->Capacity());
+  current_chunk_ = &chunk;
+  const utils::FastScopeGuard chunk_reset{
+      [this]() noexcept { current_chunk_ = nullptr; }};
+  return Parse(chunk->Data() + offset, size);
+}
+
 int HttpRequestParser::OnMessageBegin(http_parser* p) {
   auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
   UASSERT(http_request_parser != nullptr);
@@ -190,7 +203,11 @@ int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "body: '" << std::string_view(data, size) << "'";
   try {
-    request_constructor_->AppendBody(data, size);
+    if (current_chunk_) {
+      request_constructor_->AppendBody(data, size, *current_chunk_);
+    } else {
+      request_constructor_->AppendBody(data, size);
+    }
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't append body: " << ex;
     return -1;
@@ -213,7 +230,8 @@ int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
 void HttpRequestParser::CreateRequestConstructor() {
   ++stats_.parsing_request_count;
   request_constructor_.emplace(request_constructor_config_, handler_info_index_,
-                               data_accounter_);
+                               data_accounter_, arena_pool_->Acquire(),
+                               zero_copy_body_threshold_);
   url_complete_ = false;
 }
 
@@ -13,6 +13,8 @@
 #include <userver/server/request/request_config.hpp>
 
 #include "http_request_constructor.hpp"
+#include "input_chunk.hpp"
+#include "request_arena.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,13 +28,20 @@ class HttpRequestParser final : public request::RequestParser {
   HttpRequestParser(const HandlerInfoIndex& handler_info_index,
                     const request::HttpRequestConfig& request_config,
                     OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
-                    request::ResponseDataAccounter& data_accounter);
+                    request::ResponseDataAccounter& data_accounter,
+                    std::size_t zero_copy_body_threshold = 0);
 
   HttpRequestParser(HttpRequestParser&&) = delete;
   HttpRequestParser& operator=(HttpRequestParser&&) = delete;
 
   bool Parse(const char* data, size_t size) override;
 
+  // Parses `size` bytes of the chunk starting at `offset`. Bodies of the
+  // requests larger than zero_copy_body_threshold keep views into the chunk
+  // instead of copying the data, the parsed part of the chunk must not be
+  // modified while the chunk is referenced by someone else.
+  bool Parse(const InputChunkPtr& chunk, size_t offset, size_t size);
+
  private:
   static int OnMessageBegin(http_parser* p);
   static int OnUrl(http_parser* p, const char* data, size_t size);
@@ -59,6 +68,7 @@ class HttpRequestParser final : public request::RequestParser {
 
   const HandlerInfoIndex& handler_info_index_;
   const HttpRequestConstructor::Config request_constructor_config_;
+  const std::size_t zero_copy_body_threshold_;
 
   bool url_complete_ = false;
 
@@ -66,6 +76,11 @@ class HttpRequestParser final : public request::RequestParser {
 
   http_parser parser_{};
   std::optional<HttpRequestConstructor> request_constructor_;
+  // Set for the duration of Parse(const InputChunkPtr&, size_t, size_t)
+  const InputChunkPtr* current_chunk_{nullptr};
+  // Arenas are reused by the subsequent requests of the connection
+  const std::shared_ptr<RequestArenaPool> arena_pool_{
+      std::make_shared<RequestArenaPool>()};
 
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
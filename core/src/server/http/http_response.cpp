@@ -352,9 +352,17 @@ std::size_t HttpResponse::SetBodyStreamed(
   header.clear();
   header.shrink_to_fit();  // free memory before time-consuming operation
 
+  // Chunks that are ready are coalesced, the buffered data is flushed before
+  // waiting for the handler to produce more
+  const auto pop_body_part = [this, &socket](std::string& body_part) {
+    if (body_stream_->PopNoblock(body_part)) return true;
+    socket.Flush();
+    return body_stream_->Pop(body_part);
+  };
+
   // Transmit HTTP response body
   std::string body_part;
-  while (body_stream_->Pop(body_part)) {
+  while (pop_body_part(body_part)) {
     if (body_part.empty()) {
       LOG_DEBUG() << "Zero size body_part in http_response.cpp";
       continue;
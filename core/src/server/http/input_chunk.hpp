@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+// Piece of the connection receive buffer. Shared with the requests that keep
+// views into it, the connection reads into a new chunk while the previous one
+// is referenced by a request.
+class InputChunk final {
+ public:
+  explicit InputChunk(std::size_t capacity)
+      : data_(new char[capacity]), capacity_(capacity) {}
+
+  char* Data() noexcept { return data_.get(); }
+  const char* Data() const noexcept { return data_.get(); }
+  std::size_t Capacity() const noexcept { return capacity_; }
+
+ private:
+  const std::unique_ptr<char[]> data_;
+  const std::size_t capacity_;
+};
+
+using InputChunkPtr = std::shared_ptr<InputChunk>;
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
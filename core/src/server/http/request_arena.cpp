@@ -0,0 +1,41 @@
+#include <server/http/request_arena.hpp>
+
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+RequestArena::RequestArena()
+    : resource_(buffer_.data(), buffer_.size(),
+                std::pmr::new_delete_resource()) {}
+
+void RequestArenaDeleter::operator()(RequestArena* arena) const noexcept {
+  if (pool) {
+    pool->Release(arena);
+  } else {
+    delete arena;
+  }
+}
+
+RequestArenaPool::~RequestArenaPool() { delete cached_.load(); }
+
+RequestArenaPtr RequestArenaPool::Acquire() {
+  auto* arena = cached_.exchange(nullptr, std::memory_order_acquire);
+  if (!arena) arena = new RequestArena();
+  return RequestArenaPtr{arena, RequestArenaDeleter{shared_from_this()}};
+}
+
+void RequestArenaPool::Release(RequestArena* arena) noexcept {
+  arena->Reset();
+  // Pipelined requests may return their arenas concurrently, keep the last one
+  delete cached_.exchange(arena, std::memory_order_acq_rel);
+}
+
+RequestArenaPtr MakeStandaloneRequestArena() {
+  return RequestArenaPtr{new RequestArena(), RequestArenaDeleter{}};
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
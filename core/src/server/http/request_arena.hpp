@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+// Monotonic memory resource for the allocations of a single request. The
+// memory is released all at once, the first kInitialBufferSize bytes come from
+// the arena itself and do not touch the heap at all.
+//
+// Not thread-safe.
+class RequestArena final {
+ public:
+  static constexpr std::size_t kInitialBufferSize = 4096;
+
+  RequestArena();
+
+  RequestArena(const RequestArena&) = delete;
+  RequestArena& operator=(const RequestArena&) = delete;
+
+  std::pmr::memory_resource& GetResource() noexcept { return resource_; }
+
+  // Frees all the allocations, only the initial buffer is kept
+  void Reset() noexcept { resource_.release(); }
+
+ private:
+  alignas(std::max_align_t) std::array<std::byte, kInitialBufferSize> buffer_;
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+class RequestArenaPool;
+
+struct RequestArenaDeleter final {
+  void operator()(RequestArena* arena) const noexcept;
+
+  std::shared_ptr<RequestArenaPool> pool;
+};
+
+using RequestArenaPtr = std::unique_ptr<RequestArena, RequestArenaDeleter>;
+
+// Keeps the arena of a finished request for the next one. A pool is owned by
+// a connection: requests of a keep-alive connection go one after another, so
+// a single cached arena is enough. Requests may outlive the connection and be
+// destroyed on any thread.
+class RequestArenaPool final
+    : public std::enable_shared_from_this<RequestArenaPool> {
+ public:
+  RequestArenaPool() = default;
+  ~RequestArenaPool();
+
+  RequestArenaPool(const RequestArenaPool&) = delete;
+  RequestArenaPool& operator=(const RequestArenaPool&) = delete;
+
+  // Returns the cached arena or a new one if there is none. The arena returns
+  // to the pool on destruction.
+  RequestArenaPtr Acquire();
+
+ private:
+  friend struct RequestArenaDeleter;
+
+  void Release(RequestArena* arena) noexcept;
+
+  std::atomic<RequestArena*> cached_{nullptr};
+};
+
+// Arena that is not returned to any pool
+RequestArenaPtr MakeStandaloneRequestArena();
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,48 @@
+#include <userver/utest/utest.hpp>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <server/http/request_arena.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(RequestArena, ReusedByPool) {
+  const auto pool = std::make_shared<server::http::RequestArenaPool>();
+
+  auto arena = pool->Acquire();
+  const auto* first_arena = arena.get();
+  {
+    std::pmr::vector<std::pmr::string> values{&arena->GetResource()};
+    for (int i = 0; i < 1000; ++i) {
+      values.emplace_back("some value long enough to skip SSO");
+    }
+  }
+  arena.reset();
+
+  auto next_arena = pool->Acquire();
+  EXPECT_EQ(next_arena.get(), first_arena);
+
+  auto concurrent_arena = pool->Acquire();
+  EXPECT_NE(concurrent_arena.get(), next_arena.get());
+}
+
+TEST(RequestArena, OutlivesPool) {
+  auto pool = std::make_shared<server::http::RequestArenaPool>();
+  auto arena = pool->Acquire();
+  pool.reset();
+
+  std::pmr::string value{"some value long enough to skip SSO",
+                         &arena->GetResource()};
+  EXPECT_EQ(value.size(), 34);
+}
+
+TEST(RequestArena, Standalone) {
+  auto arena = server::http::MakeStandaloneRequestArena();
+  std::pmr::vector<int> values{&arena->GetResource()};
+  values.resize(server::http::RequestArena::kInitialBufferSize);
+  EXPECT_EQ(values.size(), server::http::RequestArena::kInitialBufferSize);
+}
+
+USERVER_NAMESPACE_END
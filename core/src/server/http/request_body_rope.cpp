@@ -0,0 +1,45 @@
+#include <server/http/request_body_rope.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+void RequestBodyRope::Append(std::string_view piece,
+                             const InputChunkPtr& chunk) {
+  UASSERT(chunk);
+  UASSERT(piece.data() >= chunk->Data() &&
+          piece.data() + piece.size() <= chunk->Data() + chunk->Capacity());
+  if (piece.empty()) return;
+
+  const bool same_chunk = !chunks_.empty() && chunks_.back() == chunk;
+  if (!same_chunk) chunks_.push_back(chunk);
+
+  // http_parser may report adjacent pieces of a chunk separately
+  if (same_chunk && !pieces_.empty() &&
+      pieces_.back().data() + pieces_.back().size() == piece.data()) {
+    pieces_.back() = std::string_view{pieces_.back().data(),
+                                      pieces_.back().size() + piece.size()};
+  } else {
+    pieces_.push_back(piece);
+  }
+  size_ += piece.size();
+}
+
+void RequestBodyRope::Clear() noexcept {
+  pieces_.clear();
+  chunks_.clear();
+  size_ = 0;
+}
+
+std::string RequestBodyRope::Flatten() const {
+  std::string result;
+  result.reserve(size_);
+  for (const auto piece : pieces_) result.append(piece);
+  return result;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <server/http/input_chunk.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+// Request body assembled from views into the receive buffer chunks instead of
+// being concatenated. Keeps the chunks alive.
+class RequestBodyRope final {
+ public:
+  // `piece` must point into `chunk`
+  void Append(std::string_view piece, const InputChunkPtr& chunk);
+
+  void Clear() noexcept;
+
+  bool IsEmpty() const noexcept { return size_ == 0; }
+  std::size_t GetSize() const noexcept { return size_; }
+
+  const std::vector<std::string_view>& GetPieces() const noexcept {
+    return pieces_;
+  }
+
+  std::string Flatten() const;
+
+ private:
+  std::vector<std::string_view> pieces_;
+  std::vector<InputChunkPtr> chunks_;
+  std::size_t size_{0};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,144 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <userver/server/http/http_request.hpp>
+
+#include <server/http/http_request_parser.hpp>
+#include <server/http/input_chunk.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kHeaders =
+    "POST / HTTP/1.1\r\nContent-Length: 20\r\n\r\n";
+constexpr std::string_view kBodyBegin = "0123456789";
+constexpr std::string_view kBodyEnd = "abcdefghij";
+
+server::http::InputChunkPtr MakeChunk(std::string_view data) {
+  auto chunk = std::make_shared<server::http::InputChunk>(data.size());
+  std::copy(data.begin(), data.end(), chunk->Data());
+  return chunk;
+}
+
+}  // namespace
+
+UTEST(RequestBodyRope, LargeBodyIsNotCopied) {
+  std::shared_ptr<server::request::RequestBase> request;
+  auto parser = server::CreateTestParser(
+      [&request](std::shared_ptr<server::request::RequestBase>&& parsed) {
+        request = std::move(parsed);
+      },
+      /*zero_copy_body_threshold=*/10);
+
+  const auto first = MakeChunk(std::string{kHeaders} + std::string{kBodyBegin});
+  const auto second = MakeChunk(kBodyEnd);
+  ASSERT_TRUE(parser.Parse(first, 0, kHeaders.size() + kBodyBegin.size()));
+  ASSERT_TRUE(parser.Parse(second, 0, kBodyEnd.size()));
+  ASSERT_TRUE(request);
+
+  // Both chunks are kept alive by the request
+  EXPECT_EQ(first.use_count(), 2);
+  EXPECT_EQ(second.use_count(), 2);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  const server::http::HttpRequest http_request(http_request_impl);
+
+  const auto pieces = http_request.RequestBodyPieces();
+  ASSERT_EQ(pieces.size(), 2);
+  EXPECT_EQ(pieces[0], kBodyBegin);
+  EXPECT_EQ(pieces[0].data(), first->Data() + kHeaders.size());
+  EXPECT_EQ(pieces[1], kBodyEnd);
+  EXPECT_EQ(pieces[1].data(), second->Data());
+
+  EXPECT_EQ(http_request.RequestBody(), "0123456789abcdefghij");
+  EXPECT_EQ(http_request.RequestBodyPieces().size(), 2);
+
+  request.reset();
+  EXPECT_EQ(first.use_count(), 1);
+  EXPECT_EQ(second.use_count(), 1);
+}
+
+UTEST(RequestBodyRope, ReadsIntoSameChunk) {
+  std::shared_ptr<server::request::RequestBase> request;
+  auto parser = server::CreateTestParser(
+      [&request](std::shared_ptr<server::request::RequestBase>&& parsed) {
+        request = std::move(parsed);
+      },
+      /*zero_copy_body_threshold=*/10);
+
+  const auto chunk = MakeChunk(std::string{kHeaders} + std::string{kBodyBegin} +
+                               std::string{kBodyEnd});
+  const auto first_read_size = kHeaders.size() + kBodyBegin.size();
+  ASSERT_TRUE(parser.Parse(chunk, 0, first_read_size));
+  ASSERT_TRUE(parser.Parse(chunk, first_read_size, kBodyEnd.size()));
+  ASSERT_TRUE(request);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  EXPECT_TRUE(http_request_impl.IsRequestBodyZeroCopy());
+  EXPECT_EQ(http_request_impl.RequestBodySize(), 20);
+  EXPECT_EQ(http_request_impl.RequestBodyPrefix(15), "0123456789abcde");
+  EXPECT_EQ(http_request_impl.RequestBodyPrefix(100), "0123456789abcdefghij");
+
+  // Adjacent reads are merged into a single piece
+  const auto pieces = http_request_impl.RequestBodyPieces();
+  ASSERT_EQ(pieces.size(), 1);
+  EXPECT_EQ(pieces[0], "0123456789abcdefghij");
+  EXPECT_EQ(pieces[0].data(), chunk->Data() + kHeaders.size());
+}
+
+UTEST(RequestBodyRope, SmallBodyIsCopied) {
+  std::shared_ptr<server::request::RequestBase> request;
+  auto parser = server::CreateTestParser(
+      [&request](std::shared_ptr<server::request::RequestBase>&& parsed) {
+        request = std::move(parsed);
+      },
+      /*zero_copy_body_threshold=*/100);
+
+  const auto chunk = MakeChunk(std::string{kHeaders} + std::string{kBodyBegin} +
+                               std::string{kBodyEnd});
+  ASSERT_TRUE(parser.Parse(chunk, 0, chunk->Capacity()));
+  ASSERT_TRUE(request);
+  EXPECT_EQ(chunk.use_count(), 1);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  const server::http::HttpRequest http_request(http_request_impl);
+  EXPECT_FALSE(http_request_impl.IsRequestBodyZeroCopy());
+  EXPECT_EQ(http_request_impl.RequestBodySize(), 20);
+  EXPECT_EQ(http_request_impl.RequestBodyPrefix(5), "01234");
+  EXPECT_EQ(http_request.RequestBodyPieces().size(), 1);
+  EXPECT_EQ(http_request.RequestBody(), "0123456789abcdefghij");
+}
+
+UTEST(RequestBodyRope, SetRequestBody) {
+  std::shared_ptr<server::request::RequestBase> request;
+  auto parser = server::CreateTestParser(
+      [&request](std::shared_ptr<server::request::RequestBase>&& parsed) {
+        request = std::move(parsed);
+      },
+      /*zero_copy_body_threshold=*/1);
+
+  const auto chunk = MakeChunk(std::string{kHeaders} + std::string{kBodyBegin} +
+                               std::string{kBodyEnd});
+  ASSERT_TRUE(parser.Parse(chunk, 0, chunk->Capacity()));
+  ASSERT_TRUE(request);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  server::http::HttpRequest http_request(http_request_impl);
+  http_request.SetRequestBody("decompressed");
+  EXPECT_EQ(chunk.use_count(), 1);
+  EXPECT_EQ(http_request.RequestBody(), "decompressed");
+  ASSERT_EQ(http_request.RequestBodyPieces().size(), 1);
+  EXPECT_EQ(http_request.RequestBodyPieces()[0], "decompressed");
+}
+
+USERVER_NAMESPACE_END
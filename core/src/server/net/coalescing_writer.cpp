@@ -0,0 +1,114 @@
+#include <server/net/coalescing_writer.hpp>
+
+#include <userver/engine/io/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+namespace {
+
+// The larger pieces are not worth copying, a vector write is cheaper
+constexpr std::size_t kLargePieceFraction = 4;
+
+}  // namespace
+
+CoalescingWriter::CoalescingWriter(engine::io::RwBase& socket,
+                                   std::size_t buffer_size)
+    : socket_(socket), buffer_size_(buffer_size) {}
+
+bool CoalescingWriter::IsValid() const { return socket_.IsValid(); }
+
+bool CoalescingWriter::WaitReadable(engine::Deadline deadline) {
+  return socket_.WaitReadable(deadline);
+}
+
+size_t CoalescingWriter::ReadSome(void* buf, size_t len,
+                                  engine::Deadline deadline) {
+  return socket_.ReadSome(buf, len, deadline);
+}
+
+size_t CoalescingWriter::ReadAll(void* buf, size_t len,
+                                 engine::Deadline deadline) {
+  return socket_.ReadAll(buf, len, deadline);
+}
+
+bool CoalescingWriter::WaitWriteable(engine::Deadline deadline) {
+  return socket_.WaitWriteable(deadline);
+}
+
+size_t CoalescingWriter::WriteAll(const void* buf, size_t len,
+                                  engine::Deadline deadline) {
+  if (len == 0) return 0;
+
+  if (!IsLarge(len)) {
+    if (buffer_.size() + len > buffer_size_) Flush();
+    buffer_.append(static_cast<const char*>(buf), len);
+    written_size_ += len;
+    return len;
+  }
+
+  if (buffer_.empty()) {
+    const auto sent = socket_.WriteAll(buf, len, deadline);
+    written_size_ += sent;
+    sent_size_ += sent;
+    return sent;
+  }
+
+  const auto buffered = buffer_.size();
+  const auto sent =
+      socket_.WriteAll({{buffer_.data(), buffered}, {buf, len}}, deadline);
+  buffer_.clear();
+  sent_size_ += sent;
+  if (sent < buffered) {
+    throw engine::io::IoException()
+        << "Failed to send the buffered responses, sent " << sent << " of "
+        << buffered << " bytes";
+  }
+  written_size_ += sent - buffered;
+  return sent - buffered;
+}
+
+size_t CoalescingWriter::WriteAll(
+    std::initializer_list<engine::io::IoData> list, engine::Deadline deadline) {
+  if (buffer_size_ == 0) {
+    const auto sent = socket_.WriteAll(list, deadline);
+    written_size_ += sent;
+    sent_size_ += sent;
+    return sent;
+  }
+
+  size_t result{0};
+  for (const auto& io_data : list) {
+    const auto sent = WriteAll(io_data.data, io_data.len, deadline);
+    result += sent;
+    if (sent < io_data.len) break;
+  }
+  return result;
+}
+
+void CoalescingWriter::Flush() {
+  if (buffer_.empty()) return;
+
+  const auto buffered = buffer_.size();
+  const auto sent = socket_.WriteAll(buffer_.data(), buffered, {});
+  buffer_.clear();
+  sent_size_ += sent;
+  if (sent < buffered) {
+    throw engine::io::IoException()
+        << "Failed to send the buffered responses, sent " << sent << " of "
+        << buffered << " bytes";
+  }
+}
+
+void CoalescingWriter::ReleaseBuffer() noexcept {
+  if (buffer_.empty()) std::string{}.swap(buffer_);
+}
+
+bool CoalescingWriter::IsLarge(std::size_t len) const noexcept {
+  return len > buffer_size_ / kLargePieceFraction;
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
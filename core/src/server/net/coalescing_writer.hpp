@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+#include <userver/engine/io/common.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// @brief Coalesces the small writes of the responses into a single write.
+///
+/// Small pieces are copied into the buffer until Flush() or until the buffer is
+/// full. Large pieces are not copied, they are written together with the
+/// buffered data by a single vector write. Writes report the bytes accepted
+/// into the buffer, so the errors of the buffered data are thrown by the write
+/// that sends it. Compare GetWrittenSize() and GetSentSize() to find out
+/// whether the data of a write has left the buffer.
+///
+/// With zero `buffer_size` all the writes go directly to the socket.
+class CoalescingWriter final : public engine::io::RwBase {
+ public:
+  CoalescingWriter(engine::io::RwBase& socket, std::size_t buffer_size);
+
+  bool IsValid() const override;
+
+  [[nodiscard]] bool WaitReadable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadSome(void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadAll(void* buf, size_t len,
+                               engine::Deadline deadline) override;
+
+  [[nodiscard]] bool WaitWriteable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(const void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(std::initializer_list<engine::io::IoData> list,
+                                engine::Deadline deadline) override;
+
+  /// Sends the buffered data
+  void Flush() override;
+
+  /// Frees the memory of the empty buffer, e.g. when the connection goes idle
+  void ReleaseBuffer() noexcept;
+
+  std::size_t GetBufferedSize() const noexcept { return buffer_.size(); }
+
+  /// Total size of the data accepted by the writes
+  std::size_t GetWrittenSize() const noexcept { return written_size_; }
+
+  /// Total size of the data sent to the socket. The data written after it is
+  /// either buffered or lost by a failed write.
+  std::size_t GetSentSize() const noexcept { return sent_size_; }
+
+ private:
+  bool IsLarge(std::size_t len) const noexcept;
+
+  engine::io::RwBase& socket_;
+  const std::size_t buffer_size_;
+  std::string buffer_;
+  std::size_t written_size_{0};
+  std::size_t sent_size_{0};
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,138 @@
+#include <server/net/coalescing_writer.hpp>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kShortWait = std::chrono::milliseconds{100};
+constexpr std::size_t kBufferSize = 1024;
+
+std::string RecvExactly(engine::io::Socket& socket, std::size_t size) {
+  std::string result(size, '\0');
+  const auto received = socket.RecvAll(
+      result.data(), result.size(),
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+  result.resize(received);
+  return result;
+}
+
+}  // namespace
+
+UTEST(CoalescingWriter, SmallWritesAreBuffered) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  server::net::CoalescingWriter writer{server, kBufferSize};
+
+  constexpr std::string_view kFirst = "first";
+  constexpr std::string_view kSecond = "second";
+  EXPECT_EQ(writer.WriteAll(kFirst.data(), kFirst.size(), test_deadline),
+            kFirst.size());
+  EXPECT_EQ(writer.WriteAll({{kSecond.data(), kSecond.size()},
+                             {kFirst.data(), kFirst.size()}},
+                            test_deadline),
+            kSecond.size() + kFirst.size());
+  EXPECT_EQ(writer.GetBufferedSize(), 2 * kFirst.size() + kSecond.size());
+  EXPECT_FALSE(
+      client.WaitReadable(engine::Deadline::FromDuration(kShortWait)));
+
+  writer.Flush();
+  EXPECT_EQ(writer.GetBufferedSize(), 0);
+  EXPECT_EQ(RecvExactly(client, 2 * kFirst.size() + kSecond.size()),
+            "firstsecondfirst");
+}
+
+UTEST(CoalescingWriter, OverflowFlushes) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  server::net::CoalescingWriter writer{server, kBufferSize};
+
+  const std::string piece(kBufferSize / 4, 'a');
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(writer.WriteAll(piece.data(), piece.size(), test_deadline),
+              piece.size());
+  }
+  EXPECT_EQ(writer.GetBufferedSize(), piece.size());
+  EXPECT_EQ(RecvExactly(client, kBufferSize), std::string(kBufferSize, 'a'));
+
+  writer.Flush();
+  EXPECT_EQ(RecvExactly(client, piece.size()), piece);
+}
+
+UTEST(CoalescingWriter, LargeWriteSendsBuffered) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  server::net::CoalescingWriter writer{server, kBufferSize};
+
+  constexpr std::string_view kSmall = "small";
+  const std::string large(kBufferSize * 2, 'b');
+  EXPECT_EQ(writer.WriteAll(kSmall.data(), kSmall.size(), test_deadline),
+            kSmall.size());
+  EXPECT_EQ(writer.WriteAll(large.data(), large.size(), test_deadline),
+            large.size());
+  EXPECT_EQ(writer.GetBufferedSize(), 0);
+  EXPECT_EQ(RecvExactly(client, kSmall.size() + large.size()),
+            std::string{kSmall} + large);
+}
+
+UTEST(CoalescingWriter, SentSize) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  server::net::CoalescingWriter writer{server, kBufferSize};
+
+  constexpr std::string_view kSmall = "small";
+  const std::string large(kBufferSize * 2, 'c');
+  EXPECT_EQ(writer.WriteAll(kSmall.data(), kSmall.size(), test_deadline),
+            kSmall.size());
+  EXPECT_EQ(writer.GetWrittenSize(), kSmall.size());
+  EXPECT_EQ(writer.GetSentSize(), 0);
+
+  EXPECT_EQ(writer.WriteAll(large.data(), large.size(), test_deadline),
+            large.size());
+  EXPECT_EQ(writer.GetWrittenSize(), kSmall.size() + large.size());
+  EXPECT_EQ(writer.GetSentSize(), kSmall.size() + large.size());
+
+  EXPECT_EQ(writer.WriteAll(kSmall.data(), kSmall.size(), test_deadline),
+            kSmall.size());
+  EXPECT_EQ(writer.GetSentSize(), kSmall.size() + large.size());
+
+  // Only the memory of an empty buffer is released
+  writer.ReleaseBuffer();
+  EXPECT_EQ(writer.GetBufferedSize(), kSmall.size());
+
+  writer.Flush();
+  writer.ReleaseBuffer();
+  EXPECT_EQ(writer.GetSentSize(), writer.GetWrittenSize());
+  EXPECT_EQ(RecvExactly(client, 2 * kSmall.size() + large.size()),
+            std::string{kSmall} + large + std::string{kSmall});
+}
+
+UTEST(CoalescingWriter, ZeroBufferWritesThrough) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  server::net::CoalescingWriter writer{server, 0};
+
+  constexpr std::string_view kData = "data";
+  EXPECT_EQ(writer.WriteAll(kData.data(), kData.size(), test_deadline),
+            kData.size());
+  EXPECT_EQ(writer.GetBufferedSize(), 0);
+  EXPECT_EQ(RecvExactly(client, kData.size()), kData);
+}
+
+USERVER_NAMESPACE_END
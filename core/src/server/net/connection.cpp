@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <server/http/http_request_parser.hpp>
+#include <server/http/input_chunk.hpp>
 #include <server/http/request_handler_base.hpp>
 
 #include <userver/engine/async.hpp>
@@ -23,6 +24,16 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+// A receive chunk is replaced once less than a quarter of it is left, so the
+// chunks pinned by the request bodies are mostly filled with data.
+std::size_t GetMinChunkReadSize(const ConnectionConfig& config) {
+  return std::max<std::size_t>(config.in_buffer_size / 4, 1);
+}
+
+}  // namespace
+
 Connection::Connection(
     const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
@@ -34,6 +45,7 @@ Connection::Connection(
     : config_(config),
       handler_defaults_config_(handler_defaults_config),
       peer_socket_(std::move(peer_socket)),
+      response_writer_(*peer_socket_, config_.out_buffer_size),
       request_handler_(request_handler),
       stats_(std::move(stats)),
       data_accounter_(data_accounter),
@@ -109,9 +121,14 @@ void Connection::ListenForRequests(
             is_accepting_requests_ = false;
           }
         },
-        stats_->parser_stats, data_accounter_);
-
-    std::vector<char> buf(config_.in_buffer_size);
+        stats_->parser_stats, data_accounter_,
+        config_.zero_copy_body_threshold);
+
+    const bool zero_copy_body = config_.zero_copy_body_threshold > 0;
+    std::vector<char> buf(zero_copy_body ? 0 : config_.in_buffer_size);
+    http::InputChunkPtr chunk;
+    std::size_t chunk_offset = 0;
+    std::size_t read_size = config_.in_buffer_size;
     std::size_t last_bytes_read = 0;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
@@ -127,13 +144,29 @@ void Connection::ListenForRequests(
       // 3. recv (return some data)
       //
       // So instead we just do 2. and 3., shaving off a whole recv syscall
-      if (last_bytes_read != buf.size()) {
+      if (last_bytes_read != read_size) {
         is_readable = peer_socket_->WaitReadable(deadline);
       }
 
+      char* read_buffer = buf.data();
+      if (zero_copy_body) {
+        // Requests with large bodies keep views into the chunk. The chunk is
+        // filled up before moving to a new one, otherwise a client sending its
+        // body in small pieces would pin a whole chunk per read.
+        if (chunk.use_count() == 1) chunk_offset = 0;
+        if (!chunk ||
+            chunk->Capacity() - chunk_offset < GetMinChunkReadSize(config_)) {
+          chunk = std::make_shared<http::InputChunk>(config_.in_buffer_size);
+          chunk_offset = 0;
+        }
+        read_buffer = chunk->Data() + chunk_offset;
+        read_size = chunk->Capacity() - chunk_offset;
+      }
+
       last_bytes_read =
-          is_readable ? peer_socket_->ReadSome(buf.data(), buf.size(), deadline)
-                      : 0;
+          is_readable
+              ? peer_socket_->ReadSome(read_buffer, read_size, deadline)
+              : 0;
       if (!last_bytes_read) {
         LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
                     << " closed connection or the connection timed out";
@@ -150,7 +183,12 @@ void Connection::ListenForRequests(
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
                   << Getpeername() << " on fd " << Fd();
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
+      const bool parsed =
+          zero_copy_body
+              ? request_parser.Parse(chunk, chunk_offset, last_bytes_read)
+              : request_parser.Parse(buf.data(), last_bytes_read);
+      if (zero_copy_body) chunk_offset += last_bytes_read;
+      if (!parsed) {
         LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
                     << Fd();
 
@@ -204,6 +242,8 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
     QueueItem item;
     while (consumer.Pop(item)) {
+      // Do not hold the ready responses while waiting for the handler
+      if (!item.second.IsFinished()) FlushResponses();
       HandleQueueItem(item);
 
       // now we must complete processing
@@ -212,7 +252,7 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
       /* In stream case we don't want a user task to exit
        * until SendResponse() as the task produces body chunks.
        */
-      SendResponse(*item.first);
+      SendResponse(item.first);
       if (item.first->IsUpgradeWebsocket())
         item.first->DoUpgrade(std::move(peer_socket_),
                               std::move(remote_address_));
@@ -222,6 +262,7 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
+  FlushResponses();
 }
 
 void Connection::HandleQueueItem(QueueItem& item) noexcept {
@@ -262,14 +303,25 @@ void Connection::HandleQueueItem(QueueItem& item) noexcept {
   }
 }
 
-void Connection::SendResponse(request::RequestBase& request) {
+void Connection::SendResponse(
+    std::shared_ptr<request::RequestBase> request_ptr) {
+  auto& request = *request_ptr;
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
+  bool write_failed = false;
   if (is_response_chain_valid_ && peer_socket_) {
     try {
       // Might be a stream reading or a fully constructed response
-      response.SendResponse(*peer_socket_);
+      response.SendResponse(response_writer_);
+
+      // Responses of the pipelined requests that are already queued are
+      // coalesced with this one
+      if (IsRequestTasksEmpty() || request.IsUpgradeWebsocket()) {
+        response_writer_.Flush();
+        // The connection goes idle, do not keep the buffer memory
+        response_writer_.ReleaseBuffer();
+      }
     } catch (const engine::io::IoSystemError& ex) {
       // working with raw values because std::errc compares error_category
       // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
@@ -279,19 +331,64 @@ void Connection::SendResponse(request::RequestBase& request) {
               : logging::Level::kError;
       LOG(log_level) << "I/O error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
+      write_failed = true;
     } catch (const std::exception& ex) {
       LOG_ERROR() << "Error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
+      write_failed = true;
     }
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
-  request.SetFinishSendResponseTime();
-  --stats_->active_request_count;
-  ++stats_->requests_processed_count;
 
-  request.WriteAccessLogs(request_handler_.LoggerAccess(),
-                          request_handler_.LoggerAccessTskv(), peer_name_);
+  buffered_responses_.push_back(
+      {std::move(request_ptr), response_writer_.GetWrittenSize()});
+  FinishSentResponses(write_failed);
+}
+
+void Connection::FlushResponses() noexcept {
+  // Without the socket the buffered data is never sent
+  bool write_failed = !peer_socket_;
+  if (peer_socket_) {
+    try {
+      response_writer_.Flush();
+      response_writer_.ReleaseBuffer();
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+      is_response_chain_valid_ = false;
+      write_failed = true;
+    }
+  }
+
+  try {
+    FinishSentResponses(write_failed);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to finish the sent responses: " << ex;
+  }
+}
+
+void Connection::FinishSentResponses(bool write_failed) {
+  // A failed write loses all the data that has not been sent yet
+  const auto sent_size = response_writer_.GetSentSize();
+  std::size_t finished = 0;
+  for (auto& [request_ptr, written_size] : buffered_responses_) {
+    if (written_size > sent_size) {
+      if (!write_failed) break;
+      request_ptr->GetResponse().SetSendFailed(
+          std::chrono::steady_clock::now());
+    }
+
+    request_ptr->SetFinishSendResponseTime();
+    --stats_->active_request_count;
+    ++stats_->requests_processed_count;
+
+    request_ptr->WriteAccessLogs(request_handler_.LoggerAccess(),
+                                 request_handler_.LoggerAccessTskv(),
+                                 peer_name_);
+    ++finished;
+  }
+  buffered_responses_.erase(buffered_responses_.begin(),
+                            buffered_responses_.begin() + finished);
 }
 
 std::string Connection::Getpeername() const { return peer_name_; }
@@ -3,8 +3,10 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <server/http/request_handler_base.hpp>
+#include <server/net/coalescing_writer.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
@@ -50,13 +52,16 @@ class Connection final {
 
   void ProcessResponses(Queue::Consumer&) noexcept;
   void HandleQueueItem(QueueItem& item) noexcept;
-  void SendResponse(request::RequestBase& request);
+  void SendResponse(std::shared_ptr<request::RequestBase> request_ptr);
+  void FlushResponses() noexcept;
+  void FinishSentResponses(bool write_failed);
 
   std::string Getpeername() const;
 
   const ConnectionConfig& config_;
   const request::HttpRequestConfig& handler_defaults_config_;
   std::unique_ptr<engine::io::RwBase> peer_socket_;
+  CoalescingWriter response_writer_;
   const http::RequestHandlerBase& request_handler_;
   const std::shared_ptr<Stats> stats_;
   request::ResponseDataAccounter& data_accounter_;
@@ -66,6 +71,15 @@ class Connection final {
 
   std::shared_ptr<Queue> request_tasks_;
 
+  struct BufferedResponse {
+    std::shared_ptr<request::RequestBase> request;
+    // The response has left the buffer once the writer has sent this much
+    std::size_t written_size;
+  };
+  // The requests are finished and access logged once their responses leave
+  // the response_writer_ buffer, so that a failed flush is attributed to them
+  std::vector<BufferedResponse> buffered_responses_;
+
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
 };
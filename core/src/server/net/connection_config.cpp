@@ -18,6 +18,11 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.zero_copy_body_threshold =
+      value["zero_copy_body_threshold"].As<size_t>(
+          config.zero_copy_body_threshold);
+  config.out_buffer_size =
+      value["out_buffer_size"].As<size_t>(config.out_buffer_size);
 
   return config;
 }
@@ -13,6 +13,11 @@ struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  size_t zero_copy_body_threshold = 0;
+  // The largest TCP segmentation offload unit: a bigger write saves neither
+  // syscalls nor packets. The buffer is allocated while the responses are
+  // sent and released when the connection goes idle.
+  size_t out_buffer_size = 65536;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
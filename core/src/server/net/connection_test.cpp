@@ -1,5 +1,9 @@
 #include <server/net/connection.hpp>
 
+#include <netinet/in.h>
+
+#include <vector>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -20,6 +24,7 @@ using engine::Deadline;
 
 namespace {
 constexpr auto kAcceptTimeout = utest::kMaxTestWaitTime;
+constexpr auto kShortWait = std::chrono::milliseconds{100};
 
 class TestHttprequestHandler : public server::http::RequestHandlerBase {
  public:
@@ -323,4 +328,72 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+namespace {
+
+void TestSteering(net::ListenerSteering steering) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  net::ListenerConfig config = CreateConfig();
+  config.steering = steering;
+
+  // The shards share the port picked for the first one
+  std::vector<engine::io::Socket> shards;
+  shards.push_back(net::CreateSocket(config, 0, 2));
+  config.port = shards[0].Getsockname().Port();
+  shards.push_back(net::CreateSocket(config, 1, 2));
+  EXPECT_EQ(config.port, shards[1].Getsockname().Port());
+
+  engine::io::Sockaddr addr;
+  auto* sa = addr.As<struct sockaddr_in6>();
+  sa->sin6_family = AF_INET6;
+  sa->sin6_addr = in6addr_loopback;
+  // NOLINTNEXTLINE(hicpp-no-assembler, readability-isolate-declaration)
+  sa->sin6_port = htons(config.port);
+  engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+  client.Connect(addr, deadline);
+
+  // Exactly one of the shards gets the connection
+  std::size_t accepted = 0;
+  for (std::size_t shard_index = 0; shard_index < shards.size();
+       ++shard_index) {
+    auto& shard = shards[shard_index];
+    if (!shard.WaitReadable(Deadline::FromDuration(kShortWait))) continue;
+
+    auto peer = shard.Accept(deadline);
+    ASSERT_TRUE(peer.IsValid());
+    ++accepted;
+
+    // The loopback connection is received by the CPU that runs connect()
+    const auto incoming_cpu = net::GetIncomingCpu(peer);
+    if (!incoming_cpu) continue;
+    const auto expected_shard =
+        net::GetSteeringShard(steering, *incoming_cpu, shards.size());
+    if (expected_shard) {
+      EXPECT_EQ(shard_index, *expected_shard)
+          << "incoming_cpu=" << *incoming_cpu;
+    }
+  }
+  EXPECT_EQ(accepted, 1);
+}
+
+}  // namespace
+
+UTEST(ServerNetConnection, SteeringNone) {
+  TestSteering(net::ListenerSteering::kNone);
+}
+
+UTEST(ServerNetConnection, SteeringIncomingCpu) {
+  if (!net::IsSteeringSupported(net::ListenerSteering::kIncomingCpu)) {
+    GTEST_SKIP() << "SO_INCOMING_CPU steering is not supported by the kernel";
+  }
+  TestSteering(net::ListenerSteering::kIncomingCpu);
+}
+
+UTEST(ServerNetConnection, SteeringCpuBpf) {
+  if (!net::IsSteeringSupported(net::ListenerSteering::kCpuBpf)) {
+    GTEST_SKIP() << "SO_ATTACH_REUSEPORT_CBPF is not supported by the kernel";
+  }
+  TestSteering(net::ListenerSteering::kCpuBpf);
+}
+
 USERVER_NAMESPACE_END
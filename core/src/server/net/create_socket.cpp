@@ -1,14 +1,20 @@
 #include "create_socket.hpp"
 
 #include <arpa/inet.h>
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/utsname.h>
 #include <unistd.h>
 
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -22,6 +28,10 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -48,7 +58,64 @@ engine::io::Socket CreateUnixSocket(const std::string& path, int backlog) {
   return socket;
 }
 
-engine::io::Socket CreateIpv6Socket(uint16_t port, int backlog) {
+void SetIncomingCpu(engine::io::Socket& socket, std::size_t cpu) {
+#ifdef SO_INCOMING_CPU
+  socket.SetOption(SOL_SOCKET, SO_INCOMING_CPU, static_cast<int>(cpu));
+#else
+  (void)socket;
+  throw std::runtime_error(fmt::format(
+      "SO_INCOMING_CPU is not supported, can not steer to cpu {}", cpu));
+#endif
+}
+
+// The index of a socket in the SO_REUSEPORT group is the order of listen(), so
+// the program selects the shard `cpu % shards_count`
+void AttachCpuBpf(engine::io::Socket& socket, std::size_t shards_count) {
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  struct sock_filter code[] = {
+      // A = current cpu
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      // A = A % shards_count
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0,
+       static_cast<std::uint32_t>(shards_count)},
+      // return A
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  struct sock_fprog program {};
+  program.len = std::size(code);
+  program.filter = code;
+
+  utils::CheckSyscallCustomException<engine::io::IoSystemError>(
+      ::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program,
+                   sizeof(program)),
+      "attaching SO_REUSEPORT BPF program, fd={}", socket.Fd());
+#else
+  (void)socket;
+  throw std::runtime_error(fmt::format(
+      "SO_ATTACH_REUSEPORT_CBPF is not supported, can not steer to {} shards",
+      shards_count));
+#endif
+}
+
+#ifdef __linux__
+bool IsKernelAtLeast(int major, int minor) {
+  struct utsname name {};
+  int kernel_major = 0;
+  int kernel_minor = 0;
+  if (::uname(&name) != 0 ||
+      std::sscanf(name.release, "%d.%d", &kernel_major, &kernel_minor) != 2) {
+    return false;
+  }
+  return kernel_major > major ||
+         (kernel_major == major && kernel_minor >= minor);
+}
+#endif
+
+engine::io::Socket CreateIpv6Socket(uint16_t port, int backlog,
+                                    ListenerSteering steering,
+                                    std::size_t shard_index,
+                                    std::size_t shards_count) {
   engine::io::Sockaddr addr;
   auto* sa = addr.As<struct sockaddr_in6>();
   sa->sin6_family = AF_INET6;
@@ -57,21 +124,96 @@ engine::io::Socket CreateIpv6Socket(uint16_t port, int backlog) {
   sa->sin6_port = htons(port);
   sa->sin6_addr = in6addr_any;
 
+  if (shard_index == 0 && !IsSteeringSupported(steering)) {
+    LOG_WARNING() << "The kernel does not steer the connections by the CPU, "
+                     "they are distributed by the address hash";
+  }
+
   engine::io::Socket socket{addr.Domain(), engine::io::SocketType::kStream};
   socket.Bind(addr);
+  if (steering == ListenerSteering::kIncomingCpu) {
+    SetIncomingCpu(socket, shard_index);
+  }
   socket.Listen(backlog);
+  if (steering == ListenerSteering::kCpuBpf) {
+    // The program is shared by the group, the last attached one is used
+    AttachCpuBpf(socket, shards_count);
+  }
   return socket;
 }
 
 }  // namespace
 
 engine::io::Socket CreateSocket(const ListenerConfig& config) {
+  return CreateSocket(config, 0, 1);
+}
+
+engine::io::Socket CreateSocket(const ListenerConfig& config,
+                                std::size_t shard_index,
+                                std::size_t shards_count) {
+  UASSERT(shard_index < shards_count);
   if (config.unix_socket_path.empty())
-    return CreateIpv6Socket(config.port, config.backlog);
+    return CreateIpv6Socket(config.port, config.backlog, config.steering,
+                            shard_index, shards_count);
   else
     return CreateUnixSocket(config.unix_socket_path, config.backlog);
 }
 
+bool IsSteeringSupported(ListenerSteering steering) {
+  switch (steering) {
+    case ListenerSteering::kNone:
+      return true;
+    case ListenerSteering::kIncomingCpu:
+      // Older kernels accept SO_INCOMING_CPU on listeners, but ignore it
+      // for the SO_REUSEPORT groups
+#if defined(__linux__) && defined(SO_INCOMING_CPU)
+      return IsKernelAtLeast(6, 2);
+#else
+      return false;
+#endif
+    case ListenerSteering::kCpuBpf:
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+      return IsKernelAtLeast(4, 5);
+#else
+      return false;
+#endif
+  }
+  UINVARIANT(false, "Unexpected listener steering");
+}
+
+std::optional<std::size_t> GetSteeringShard(ListenerSteering steering,
+                                            std::size_t cpu,
+                                            std::size_t shards_count) {
+  UASSERT(shards_count > 0);
+  switch (steering) {
+    case ListenerSteering::kNone:
+      return std::nullopt;
+    case ListenerSteering::kIncomingCpu:
+      // Other CPUs fall back to the address hash
+      if (cpu < shards_count) return cpu;
+      return std::nullopt;
+    case ListenerSteering::kCpuBpf:
+      return cpu % shards_count;
+  }
+  UINVARIANT(false, "Unexpected listener steering");
+}
+
+std::optional<std::size_t> GetIncomingCpu(const engine::io::Socket& socket) {
+#if defined(__linux__) && defined(SO_INCOMING_CPU)
+  int incoming_cpu = -1;
+  socklen_t len = sizeof(incoming_cpu);
+  if (::getsockopt(socket.Fd(), SOL_SOCKET, SO_INCOMING_CPU, &incoming_cpu,
+                   &len) != 0 ||
+      incoming_cpu < 0) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(incoming_cpu);
+#else
+  (void)socket;
+  return std::nullopt;
+#endif
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
+
 #include <server/net/listener_config.hpp>
 #include <userver/engine/io/socket.hpp>
 
@@ -9,6 +12,24 @@ namespace server::net {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config);
 
+/// Creates the socket of the listener shard `shard_index` of `shards_count`
+/// that listen on the same port, with the `config.steering` applied
+engine::io::Socket CreateSocket(const ListenerConfig& config,
+                                std::size_t shard_index,
+                                std::size_t shards_count);
+
+/// Whether the kernel steers the connections as the `steering` says
+bool IsSteeringSupported(ListenerSteering steering);
+
+/// The shard that the `steering` directs the connections received by the
+/// `cpu` to, std::nullopt if it does not select a specific shard
+std::optional<std::size_t> GetSteeringShard(ListenerSteering steering,
+                                            std::size_t cpu,
+                                            std::size_t shards_count);
+
+/// The CPU that has received the packets of the accepted connection, if known
+std::optional<std::size_t> GetIncomingCpu(const engine::io::Socket& socket);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
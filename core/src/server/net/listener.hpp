@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -16,7 +17,8 @@ class Listener final {
  public:
   Listener(std::shared_ptr<EndpointInfo> endpoint_info,
            engine::TaskProcessor& task_processor,
-           request::ResponseDataAccounter& data_accounter);
+           request::ResponseDataAccounter& data_accounter,
+           std::size_t shard_index = 0, std::size_t shards_count = 1);
   ~Listener();
 
   Listener(const Listener&) = delete;
@@ -28,10 +30,17 @@ class Listener final {
 
   Stats GetStats() const;
 
+  // New connections use the new certificate, key and CAs, does nothing for
+  // a listener without TLS or that is not started
+  void ReloadTls(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+                 const std::vector<crypto::Certificate>& cert_authorities);
+
  private:
   engine::TaskProcessor* task_processor_;
   std::shared_ptr<EndpointInfo> endpoint_info_;
   request::ResponseDataAccounter* data_accounter_;
+  std::size_t shard_index_;
+  std::size_t shards_count_;
 
   std::unique_ptr<ListenerImpl> impl_;
 };
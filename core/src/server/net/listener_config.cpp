@@ -5,11 +5,28 @@
 
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/fs/blocking/read.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+constexpr utils::TrivialBiMap kListenerSteeringMap([](auto selector) {
+  return selector()
+      .Case(ListenerSteering::kNone, "none")
+      .Case(ListenerSteering::kIncomingCpu, "incoming-cpu")
+      .Case(ListenerSteering::kCpuBpf, "cpu-bpf");
+});
+
+}  // namespace
+
+ListenerSteering Parse(const yaml_config::YamlConfig& value,
+                       formats::parse::To<ListenerSteering>) {
+  return utils::ParseFromValueString(value, kListenerSteeringMap);
+}
+
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
                      formats::parse::To<ListenerConfig>) {
   ListenerConfig config;
@@ -22,6 +39,7 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   config.max_connections =
       value["max_connections"].As<size_t>(config.max_connections);
   config.shards = value["shards"].As<std::optional<size_t>>(config.shards);
+  config.steering = value["steering"].As<ListenerSteering>(config.steering);
   config.task_processor = value["task_processor"].As<std::string>();
   config.backlog = value["backlog"].As<int>(config.backlog);
 
@@ -33,6 +51,12 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
     throw std::runtime_error(
         "Either non-zero 'port' or non-empty 'unix-socket' fields must be set");
 
+  if (config.steering != ListenerSteering::kNone &&
+      !config.unix_socket_path.empty()) {
+    throw std::runtime_error(
+        "'steering' is not supported for 'unix-socket' in " + value.GetPath());
+  }
+
   if (config.backlog <= 0) {
     throw std::runtime_error("Invalid backlog value in " + value.GetPath());
   }
@@ -47,6 +71,7 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   }
   if (!cert_path.empty()) {
     auto contents = fs::blocking::ReadFileContents(cert_path);
+    config.tls_cert_path = cert_path;
     config.tls_cert = crypto::Certificate::LoadFromString(contents);
     config.tls = true;
   }
@@ -56,12 +81,15 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   if (!pkey_pass_name.empty()) {
     config.tls_private_key_passphrase_name = pkey_pass_name;
   }
-  auto ca_paths = value["tls"]["ca"].As<std::vector<std::string>>({});
-  for (const auto& ca_path : ca_paths) {
+  config.tls_certificate_authorities_paths =
+      value["tls"]["ca"].As<std::vector<std::string>>({});
+  for (const auto& ca_path : config.tls_certificate_authorities_paths) {
     auto contents = fs::blocking::ReadFileContents(ca_path);
     config.tls_certificate_authorities.push_back(
         crypto::Certificate::LoadFromString(contents));
   }
+  config.tls_kernel_offload =
+      value["tls"]["kernel-offload"].As<bool>(config.tls_kernel_offload);
 
   return config;
 }
@@ -14,6 +14,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+/// @brief How the kernel distributes new connections between the listener
+/// shards
+///
+/// Steering is best-effort: the tasks of the shards are not pinned to CPUs,
+/// so a connection is processed by whatever thread of the task processor
+/// runs its shard. It still keeps the connections of a CPU in one shard.
+enum class ListenerSteering {
+  /// By the hash of the connection addresses
+  kNone,
+  /// To the shard with the index of the CPU that has received the connection,
+  /// via SO_INCOMING_CPU; Linux 6.2+
+  kIncomingCpu,
+  /// To the shard `cpu % shards` by a BPF program attached to the sockets
+  kCpuBpf,
+};
+
 struct ListenerConfig {
   ConnectionConfig connection_config;
   request::HttpRequestConfig handler_defaults;
@@ -22,16 +38,23 @@ struct ListenerConfig {
   int backlog = 1024;  // truncated to net.core.somaxconn
   size_t max_connections = 32768;
   std::optional<size_t> shards;
+  ListenerSteering steering{ListenerSteering::kNone};
   std::string task_processor;
 
   bool tls{false};
+  std::string tls_cert_path;
   crypto::Certificate tls_cert;
   std::string tls_private_key_path;
   std::string tls_private_key_passphrase_name;
   crypto::PrivateKey tls_private_key;
+  std::vector<std::string> tls_certificate_authorities_paths;
   std::vector<crypto::Certificate> tls_certificate_authorities;
+  bool tls_kernel_offload{false};
 };
 
+ListenerSteering Parse(const yaml_config::YamlConfig& value,
+                       formats::parse::To<ListenerSteering>);
+
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
                      formats::parse::To<ListenerConfig>);
 
@@ -1,9 +1,11 @@
 #include "listener_impl.hpp"
 
 #include <netinet/tcp.h>
+#include <sys/socket.h>
 
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -24,13 +26,31 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+std::optional<engine::io::TlsServerContext> MakeTlsContext(
+    const ListenerConfig& config) {
+  if (!config.tls) return std::nullopt;
+  engine::io::TlsServerSessionSettings settings;
+  settings.kernel_tls_offload = config.tls_kernel_offload;
+  return engine::io::TlsServerContext{config.tls_cert, config.tls_private_key,
+                                      config.tls_certificate_authorities,
+                                      settings};
+}
+
+}  // namespace
+
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
-                           request::ResponseDataAccounter& data_accounter)
+                           request::ResponseDataAccounter& data_accounter,
+                           std::size_t shard_index, std::size_t shards_count)
     : task_processor_(task_processor),
       endpoint_info_(std::move(endpoint_info)),
       stats_(std::make_shared<Stats>()),
       data_accounter_(data_accounter),
+      shard_index_(shard_index),
+      shards_count_(shards_count),
+      tls_context_(MakeTlsContext(endpoint_info_->listener_config)),
       socket_listener_task_(engine::CriticalAsyncNoSpan(
           task_processor_,
           [this](engine::io::Socket&& request_socket) {
@@ -48,7 +68,8 @@ ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
               }
             }
           },
-          CreateSocket(endpoint_info_->listener_config))) {}
+          CreateSocket(endpoint_info_->listener_config, shard_index,
+                       shards_count))) {}
 
 ListenerImpl::~ListenerImpl() {
   LOG_TRACE() << "Stopping socket listener task";
@@ -58,11 +79,35 @@ ListenerImpl::~ListenerImpl() {
   connections_.CancelAndWait();
 }
 
-Stats ListenerImpl::GetStats() const { return *stats_; }
+Stats ListenerImpl::GetStats() const {
+  Stats stats = *stats_;
+  stats.max_listener_connections_accepted = stats.connections_accepted;
+  return stats;
+}
+
+void ListenerImpl::ReloadTls(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  if (!tls_context_) return;
+  tls_context_->Reload(cert, key, cert_authorities);
+}
+
+bool ListenerImpl::IsMisrouted(const engine::io::Socket& peer_socket) const {
+  const auto incoming_cpu = GetIncomingCpu(peer_socket);
+  if (!incoming_cpu) return false;
+
+  const auto target_shard =
+      GetSteeringShard(endpoint_info_->listener_config.steering, *incoming_cpu,
+                       shards_count_);
+  return target_shard && *target_shard != shard_index_;
+}
 
 void ListenerImpl::AcceptConnection(engine::io::Socket& request_socket) {
   auto peer_socket = request_socket.Accept({});
 
+  ++stats_->connections_accepted;
+  if (IsMisrouted(peer_socket)) ++stats_->connections_accepted_misrouted;
+
   const auto new_connection_count = ++endpoint_info_->connection_count;
   utils::FastScopeGuard guard{
       [this]() noexcept { --endpoint_info_->connection_count; }};
@@ -98,12 +143,10 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
   LOG_TRACE() << "Creating connection for fd " << fd;
   std::unique_ptr<engine::io::RwBase> socket;
   auto remote_address = peer_socket.Getpeername();
-  if (endpoint_info_->listener_config.tls) {
-    const auto& config = endpoint_info_->listener_config;
+  if (tls_context_) {
     socket = std::make_unique<engine::io::TlsWrapper>(
-        engine::io::TlsWrapper::StartTlsServer(
-            std::move(peer_socket), config.tls_cert, config.tls_private_key, {},
-            config.tls_certificate_authorities));
+        engine::io::TlsWrapper::StartTlsServer(std::move(peer_socket),
+                                               *tls_context_, {}));
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <userver/concurrent/background_task_storage.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_context.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
@@ -19,20 +23,33 @@ class ListenerImpl final {
  public:
   ListenerImpl(engine::TaskProcessor& task_processor,
                std::shared_ptr<EndpointInfo> endpoint_info,
-               request::ResponseDataAccounter& data_accounter);
+               request::ResponseDataAccounter& data_accounter,
+               std::size_t shard_index, std::size_t shards_count);
   ~ListenerImpl();
 
   Stats GetStats() const;
 
+  void ReloadTls(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+                 const std::vector<crypto::Certificate>& cert_authorities);
+
  private:
   void AcceptConnection(engine::io::Socket& request_socket);
   void ProcessConnection(engine::io::Socket peer_socket);
+  // Whether the connection was accepted by another shard than the one the
+  // steering directs it to
+  bool IsMisrouted(const engine::io::Socket& peer_socket) const;
 
   engine::TaskProcessor& task_processor_;
   std::shared_ptr<EndpointInfo> endpoint_info_;
 
   std::shared_ptr<Stats> stats_;
   request::ResponseDataAccounter& data_accounter_;
+  const std::size_t shard_index_;
+  const std::size_t shards_count_;
+
+  // Shared by all the connections, so that they skip the context setup and
+  // could resume the sessions
+  std::optional<engine::io::TlsServerContext> tls_context_;
 
   concurrent::BackgroundTaskStorageCore connections_;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <vector>
@@ -27,6 +28,11 @@ struct Stats {
       : active_connections(other.active_connections.load()),
         connections_created(other.connections_created.load()),
         connections_closed(other.connections_closed.load()),
+        connections_accepted(other.connections_accepted.load()),
+        connections_accepted_misrouted(
+            other.connections_accepted_misrouted.load()),
+        max_listener_connections_accepted(
+            other.max_listener_connections_accepted),
         parser_stats(other.parser_stats),
         active_request_count(other.active_request_count.load()),
         requests_processed_count(other.requests_processed_count.load()) {}
@@ -37,6 +43,13 @@ struct Stats {
   std::atomic<size_t> active_connections{0};
   std::atomic<size_t> connections_created{0};
   std::atomic<size_t> connections_closed{0};
+  std::atomic<size_t> connections_accepted{0};
+  // accepted by another listener shard than the steering target of the CPU
+  // that received the connection packets
+  std::atomic<size_t> connections_accepted_misrouted{0};
+
+  // the most loaded listener shard, for the accept fairness
+  size_t max_listener_connections_accepted{0};
 
   // per connection
   ParserStats parser_stats;
@@ -48,6 +61,11 @@ inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
   lhs.active_connections += rhs.active_connections;
   lhs.connections_created += rhs.connections_created;
   lhs.connections_closed += rhs.connections_closed;
+  lhs.connections_accepted += rhs.connections_accepted;
+  lhs.connections_accepted_misrouted += rhs.connections_accepted_misrouted;
+  lhs.max_listener_connections_accepted =
+      std::max(lhs.max_listener_connections_accepted,
+               rhs.max_listener_connections_accepted);
 
   lhs.parser_stats += rhs.parser_stats;
   lhs.active_request_count += rhs.active_request_count;
@@ -73,6 +73,13 @@ bool ResponseBase::IsLimitReached() const {
 
 void ResponseBase::SetSendFailed(
     std::chrono::steady_clock::time_point failure_time) {
+  if (is_sent_) {
+    // The response was accepted by the buffer of the connection, and the
+    // buffer has failed to be sent later
+    bytes_sent_ = 0;
+    sent_time_ = failure_time;
+    return;
+  }
   SetSent(0, failure_time);
 }
 
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <shared_mutex>
 #include <stdexcept>
+#include <vector>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -26,6 +27,16 @@ namespace server {
 
 namespace {
 
+crypto::PrivateKey LoadTlsPrivateKey(
+    const net::ListenerConfig& listener_config,
+    const storages::secdist::SecdistConfig& secdist) {
+  auto contents =
+      fs::blocking::ReadFileContents(listener_config.tls_private_key_path);
+  auto pph = secdist.Get<PassphraseConfig>().GetPassphrase(
+      listener_config.tls_private_key_passphrase_name);
+  return crypto::PrivateKey::LoadFromString(contents, pph.GetUnderlying());
+}
+
 struct PortInfo final {
   void Init(const ServerConfig& config,
             const net::ListenerConfig& listener_config,
@@ -65,8 +76,9 @@ void PortInfo::Init(const ServerConfig& config,
                                                   : event_thread_pool.GetSize();
 
   listeners_.reserve(listener_shards);
-  while (listener_shards--) {
-    listeners_.emplace_back(endpoint_info_, task_processor, data_accounter_);
+  for (size_t shard = 0; shard < listener_shards; ++shard) {
+    listeners_.emplace_back(endpoint_info_, task_processor, data_accounter_,
+                            shard, listener_shards);
   }
 }
 
@@ -124,6 +136,8 @@ class ServerImpl final {
   void SetRpsRatelimitStatusCode(http::HttpStatus status_code);
   void SetRpsRatelimit(std::optional<size_t> rps);
 
+  void ReloadTls();
+
  private:
   PortInfo main_port_info_;
   PortInfo monitor_port_info_;
@@ -137,21 +151,18 @@ class ServerImpl final {
   RequestsView requests_view_{};
 
   ServerConfig config_;
+  const storages::secdist::SecdistConfig& secdist_;
 };
 
 ServerImpl::ServerImpl(ServerConfig config,
                        const storages::secdist::SecdistConfig& secdist,
                        const components::ComponentContext& component_context)
-    : config_(std::move(config)) {
+    : config_(std::move(config)), secdist_(secdist) {
   LOG_DEBUG() << "Creating server";
 
   if (config_.listener.tls) {
-    auto contents =
-        fs::blocking::ReadFileContents(config_.listener.tls_private_key_path);
-    auto pph = secdist.Get<PassphraseConfig>().GetPassphrase(
-        config_.listener.tls_private_key_passphrase_name);
     config_.listener.tls_private_key =
-        crypto::PrivateKey::LoadFromString(contents, pph.GetUnderlying());
+        LoadTlsPrivateKey(config_.listener, secdist_);
   }
 
   main_port_info_.Init(config_, config_.listener, component_context, false);
@@ -311,6 +322,28 @@ void ServerImpl::SetRpsRatelimit(std::optional<size_t> rps) {
   main_port_info_.request_handler_->SetRpsRatelimit(rps);
 }
 
+void ServerImpl::ReloadTls() {
+  const auto& listener_config = config_.listener;
+  if (!listener_config.tls) return;
+
+  const auto cert = crypto::Certificate::LoadFromString(
+      fs::blocking::ReadFileContents(listener_config.tls_cert_path));
+  const auto key = LoadTlsPrivateKey(listener_config, secdist_);
+  std::vector<crypto::Certificate> cert_authorities;
+  for (const auto& ca_path :
+       listener_config.tls_certificate_authorities_paths) {
+    cert_authorities.push_back(crypto::Certificate::LoadFromString(
+        fs::blocking::ReadFileContents(ca_path)));
+  }
+
+  std::shared_lock lock{on_stop_mutex_};
+  if (is_stopping_) return;
+  for (auto& listener : main_port_info_.listeners_) {
+    listener.ReloadTls(cert, key, cert_authorities);
+  }
+  LOG_INFO() << "Reloaded the TLS certificates";
+}
+
 Server::Server(ServerConfig config,
                const storages::secdist::SecdistConfig& secdist,
                const components::ComponentContext& component_context)
@@ -329,6 +362,11 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
     conn_stats["active"] = server_stats.active_connections;
     conn_stats["opened"] = server_stats.connections_created;
     conn_stats["closed"] = server_stats.connections_closed;
+    conn_stats["accepted"] = server_stats.connections_accepted;
+    conn_stats["accepted-misrouted"] =
+        server_stats.connections_accepted_misrouted;
+    conn_stats["accepted-max-per-listener"] =
+        server_stats.max_listener_connections_accepted;
   }
 
   if (auto request_stats = writer["requests"]) {
@@ -374,6 +412,8 @@ void Server::SetRpsRatelimit(std::optional<size_t> rps) {
   pimpl->SetRpsRatelimit(rps);
 }
 
+void Server::ReloadTls() { pimpl->ReloadTls(); }
+
 void Server::SetRpsRatelimitStatusCode(http::HttpStatus status_code) {
   pimpl->SetRpsRatelimitStatusCode(status_code);
 }
@@ -0,0 +1,241 @@
+#include <server/websocket/permessage_deflate.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <new>
+
+#include <fmt/format.h>
+
+#include <compression/error.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+constexpr std::string_view kExtensionName = "permessage-deflate";
+
+// Removed by the sender and appended by the receiver of each message
+constexpr std::array<unsigned char, 4> kSyncFlushTail{0x00, 0x00, 0xff, 0xff};
+
+// zlib can not produce the raw deflate streams with 256 byte window
+constexpr unsigned kMinWindowBits = 9;
+constexpr unsigned kMaxWindowBits = 15;
+
+constexpr std::size_t kDecompressStep = 4096;
+
+std::string_view Trim(std::string_view str) {
+  constexpr std::string_view kSpaces = " \t";
+  const auto begin = str.find_first_not_of(kSpaces);
+  if (begin == std::string_view::npos) return {};
+  const auto end = str.find_last_not_of(kSpaces);
+  return str.substr(begin, end - begin + 1);
+}
+
+std::optional<unsigned> ParseWindowBits(std::string_view value) {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+  if (value.empty() || value.size() > 2) return std::nullopt;
+
+  unsigned bits = 0;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return std::nullopt;
+    bits = bits * 10 + (c - '0');
+  }
+  if (bits < 8 || bits > kMaxWindowBits) return std::nullopt;
+  return bits;
+}
+
+// Returns the parameters of the connection if the offer is acceptable
+std::optional<DeflateConfig> AcceptOffer(std::string_view offer,
+                                         const DeflateConfig& config) {
+  auto result = config;
+  bool has_server_no_context_takeover = false;
+  bool has_client_no_context_takeover = false;
+  bool has_server_max_window_bits = false;
+  bool has_client_max_window_bits = false;
+
+  bool is_name = true;
+  while (!offer.empty()) {
+    const auto param_end = offer.find(';');
+    const auto param = Trim(offer.substr(0, param_end));
+    offer = param_end == std::string_view::npos ? std::string_view{}
+                                                : offer.substr(param_end + 1);
+
+    if (is_name) {
+      if (param != kExtensionName) return std::nullopt;
+      is_name = false;
+      continue;
+    }
+
+    const auto value_pos = param.find('=');
+    const auto name = Trim(param.substr(0, value_pos));
+    const auto value = value_pos == std::string_view::npos
+                           ? std::string_view{}
+                           : Trim(param.substr(value_pos + 1));
+    const bool has_value = value_pos != std::string_view::npos;
+
+    // Duplicate parameters and parameters with invalid values decline the offer
+    if (name == "server_no_context_takeover") {
+      if (has_server_no_context_takeover || has_value) return std::nullopt;
+      has_server_no_context_takeover = true;
+      result.server_no_context_takeover = true;
+    } else if (name == "client_no_context_takeover") {
+      if (has_client_no_context_takeover || has_value) return std::nullopt;
+      has_client_no_context_takeover = true;
+      result.client_no_context_takeover = true;
+    } else if (name == "server_max_window_bits") {
+      if (has_server_max_window_bits) return std::nullopt;
+      has_server_max_window_bits = true;
+      const auto bits = ParseWindowBits(value);
+      if (!bits || *bits < kMinWindowBits) return std::nullopt;
+      result.server_max_window_bits =
+          std::min(result.server_max_window_bits, *bits);
+    } else if (name == "client_max_window_bits") {
+      // The messages of the client are decompressed with the max window, so
+      // any value fits
+      if (has_client_max_window_bits) return std::nullopt;
+      has_client_max_window_bits = true;
+      if (has_value && !ParseWindowBits(value)) return std::nullopt;
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (is_name) return std::nullopt;
+
+  result.enabled = true;
+  return result;
+}
+
+}  // namespace
+
+std::optional<DeflateConfig> NegotiatePerMessageDeflate(
+    std::string_view extensions, const DeflateConfig& config,
+    std::string& response) {
+  UASSERT(config.server_max_window_bits >= kMinWindowBits &&
+          config.server_max_window_bits <= kMaxWindowBits);
+
+  while (!extensions.empty()) {
+    const auto offer_end = extensions.find(',');
+    const auto offer = extensions.substr(0, offer_end);
+    extensions = offer_end == std::string_view::npos
+                     ? std::string_view{}
+                     : extensions.substr(offer_end + 1);
+
+    auto result = AcceptOffer(offer, config);
+    if (!result) continue;
+
+    response = kExtensionName;
+    if (result->server_no_context_takeover) {
+      response += "; server_no_context_takeover";
+    }
+    if (result->client_no_context_takeover) {
+      response += "; client_no_context_takeover";
+    }
+    if (result->server_max_window_bits != kMaxWindowBits) {
+      response += fmt::format("; server_max_window_bits={}",
+                              result->server_max_window_bits);
+    }
+    return result;
+  }
+  return std::nullopt;
+}
+
+PerMessageDeflate::PerMessageDeflate(const DeflateConfig& config)
+    : server_no_context_takeover_(config.server_no_context_takeover) {
+  UASSERT(config.enabled);
+  UASSERT(config.server_max_window_bits >= kMinWindowBits &&
+          config.server_max_window_bits <= kMaxWindowBits);
+
+  // Negative window bits select the raw deflate stream without a header
+  if (deflateInit2(&deflate_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   -static_cast<int>(config.server_max_window_bits),
+                   /*memLevel=*/8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::bad_alloc();
+  }
+  if (inflateInit2(&inflate_, -static_cast<int>(kMaxWindowBits)) != Z_OK) {
+    deflateEnd(&deflate_);
+    throw std::bad_alloc();
+  }
+}
+
+PerMessageDeflate::~PerMessageDeflate() {
+  deflateEnd(&deflate_);
+  inflateEnd(&inflate_);
+}
+
+void PerMessageDeflate::Compress(utils::span<const std::byte> message,
+                                 std::string& output) {
+  UASSERT(message.size() <= std::numeric_limits<uInt>::max());
+
+  // The whole capacity of the reused buffer is available. The bound is only
+  // a guess, as it does not account for the sync flush
+  output.resize(std::max<std::size_t>(
+      output.capacity(), deflateBound(&deflate_, message.size())));
+
+  deflate_.next_in =
+      reinterpret_cast<Bytef*>(const_cast<std::byte*>(message.data()));
+  deflate_.avail_in = message.size();
+  std::size_t size = 0;
+  while (true) {
+    deflate_.next_out = reinterpret_cast<Bytef*>(output.data() + size);
+    deflate_.avail_out = output.size() - size;
+    const auto ret = deflate(&deflate_, Z_SYNC_FLUSH);
+    UASSERT_MSG(ret == Z_OK || ret == Z_BUF_ERROR, "Unexpected deflate error");
+    size = output.size() - deflate_.avail_out;
+
+    // The flush is complete if there is some space left in the output
+    if (deflate_.avail_in == 0 && deflate_.avail_out != 0) break;
+    output.resize(output.size() * 2);
+  }
+
+  UASSERT(size >= kSyncFlushTail.size());
+  output.resize(size - kSyncFlushTail.size());
+
+  if (server_no_context_takeover_) deflateReset(&deflate_);
+}
+
+void PerMessageDeflate::Decompress(std::string_view message,
+                                   std::string& output, std::size_t max_size) {
+  const auto inflate_input = [&](const void* data, std::size_t len) {
+    inflate_.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(data));
+    inflate_.avail_in = len;
+    do {
+      const auto offset = output.size();
+      output.resize(offset + kDecompressStep);
+      inflate_.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+      inflate_.avail_out = kDecompressStep;
+
+      const auto ret = inflate(&inflate_, Z_SYNC_FLUSH);
+      output.resize(output.size() - inflate_.avail_out);
+      if (ret != Z_OK && ret != Z_BUF_ERROR && ret != Z_STREAM_END) {
+        inflateReset(&inflate_);
+        throw compression::DecompressionError(
+            "failed to decompress websocket message");
+      }
+      if (output.size() > max_size) {
+        inflateReset(&inflate_);
+        throw compression::TooBigError();
+      }
+      if (ret == Z_STREAM_END) {
+        // The final block of the deflate stream, the next message starts
+        // a new one
+        inflateReset(&inflate_);
+        inflate_.avail_in = 0;
+        break;
+      }
+      if (ret == Z_BUF_ERROR && inflate_.avail_out != 0) break;
+    } while (inflate_.avail_in != 0 || inflate_.avail_out == 0);
+  };
+
+  inflate_input(message.data(), message.size());
+  inflate_input(kSyncFlushTail.data(), kSyncFlushTail.size());
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
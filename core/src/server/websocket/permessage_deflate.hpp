@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+/// Accepts the first permessage-deflate offer from the `extensions` header
+/// that fits the `config`. Returns the parameters of the connection and fills
+/// the `response` header, or returns std::nullopt if there is no such offer.
+std::optional<DeflateConfig> NegotiatePerMessageDeflate(
+    std::string_view extensions, const DeflateConfig& config,
+    std::string& response);
+
+/// @brief Compression contexts of a connection with the negotiated
+/// permessage-deflate extension (RFC 7692).
+///
+/// The contexts are kept between the messages unless the no context takeover
+/// is negotiated.
+class PerMessageDeflate final {
+ public:
+  explicit PerMessageDeflate(const DeflateConfig& config);
+  ~PerMessageDeflate();
+
+  PerMessageDeflate(PerMessageDeflate&&) = delete;
+  PerMessageDeflate& operator=(PerMessageDeflate&&) = delete;
+
+  /// Replaces the `output` with the compressed message, without the trailing
+  /// 0x00 0x00 0xff 0xff of the sync flush
+  void Compress(utils::span<const std::byte> message, std::string& output);
+
+  /// Appends the decompressed message to the `output`
+  /// @throws compression::TooBigError if the `output` exceeds `max_size`
+  /// @throws compression::DecompressionError on broken data
+  void Decompress(std::string_view message, std::string& output,
+                  std::size_t max_size);
+
+ private:
+  const bool server_no_context_takeover_;
+  z_stream deflate_{};
+  z_stream inflate_{};
+};
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
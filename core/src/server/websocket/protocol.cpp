@@ -1,5 +1,14 @@
 #include <server/websocket/protocol.hpp>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -39,15 +48,7 @@ union Mask32 {
   uint8_t mask8[4];
 };
 
-void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) {
-  auto* dest32 = reinterpret_cast<uint32_t*>(dest);
-  while (len >= sizeof(uint32_t)) {
-    *(dest32++) ^= mask.mask32;
-    len -= sizeof(uint32_t);
-  }
-  auto* dest8 = reinterpret_cast<uint8_t*>(dest32);
-  for (unsigned i = 0; i < len; ++i) *(dest8++) ^= mask.mask8[i];
-}
+bool IsControlFrame(unsigned char opcode) noexcept { return opcode & 0x8; }
 
 template <class T, class V>
 void PushRaw(const T& value, V& data) {
@@ -61,7 +62,7 @@ namespace frames {
 
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final) {
+    Continuation is_continuation, Final is_final, Compressed is_compressed) {
   boost::container::small_vector<char, impl::kMaxFrameHeaderSize> frame;
 
   frame.resize(sizeof(WSHeader));
@@ -74,6 +75,11 @@ boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
   hdr->bits.fin = is_final == Final::kYes ? 1 : 0;
   hdr->bits.opcode = is_text ? kText : kBinary;
   if (is_continuation == Continuation::kYes) hdr->bits.opcode = kContinuation;
+  // RSV1 is set on the first frame of a compressed message only
+  if (is_compressed == Compressed::kYes &&
+      is_continuation == Continuation::kNo) {
+    hdr->bits.reserved = kReservedCompressed;
+  }
 
   if (data.size() <= 125) {
     hdr->bits.payloadLen = data.size();
@@ -151,14 +157,101 @@ std::string WebsocketSecAnswer(std::string_view sec_key) {
                        sizeof(webSocketRespKeySHA1)));
 }
 
+void XorMaskInplace(char* data, std::size_t len, std::uint32_t mask) noexcept {
+  // All the blocks are multiples of 4 bytes long, so each of them starts with
+  // the first byte of the key
+#if defined(__AVX2__)
+  const auto mask256 = _mm256_set1_epi32(static_cast<int>(mask));
+  for (; len >= sizeof(__m256i); len -= sizeof(__m256i)) {
+    auto* block = reinterpret_cast<__m256i*>(data);
+    _mm256_storeu_si256(
+        block, _mm256_xor_si256(_mm256_loadu_si256(block), mask256));
+    data += sizeof(__m256i);
+  }
+#endif
+#if defined(__SSE2__)
+  const auto mask128 = _mm_set1_epi32(static_cast<int>(mask));
+  for (; len >= sizeof(__m128i); len -= sizeof(__m128i)) {
+    auto* block = reinterpret_cast<__m128i*>(data);
+    _mm_storeu_si128(block, _mm_xor_si128(_mm_loadu_si128(block), mask128));
+    data += sizeof(__m128i);
+  }
+#elif defined(__ARM_NEON)
+  const auto mask128 = vreinterpretq_u8_u32(vdupq_n_u32(mask));
+  for (; len >= sizeof(uint8x16_t); len -= sizeof(uint8x16_t)) {
+    auto* block = reinterpret_cast<uint8_t*>(data);
+    vst1q_u8(block, veorq_u8(vld1q_u8(block), mask128));
+    data += sizeof(uint8x16_t);
+  }
+#endif
+
+  const auto mask64 = (std::uint64_t{mask} << 32) | mask;
+  for (; len >= sizeof(std::uint64_t); len -= sizeof(std::uint64_t)) {
+    std::uint64_t block = 0;
+    std::memcpy(&block, data, sizeof(block));
+    block ^= mask64;
+    std::memcpy(data, &block, sizeof(block));
+    data += sizeof(std::uint64_t);
+  }
+
+  Mask32 mask_bytes;
+  mask_bytes.mask32 = mask;
+  for (std::size_t i = 0; i < len; ++i) data[i] ^= mask_bytes.mask8[i % 4];
+}
+
+FrameReader::FrameReader(engine::io::ReadableBase& io, std::size_t buffer_size)
+    : io_(io), buffer_(buffer_size) {}
+
+bool FrameReader::IsValid() const { return io_.IsValid(); }
+
+bool FrameReader::WaitReadable(engine::Deadline deadline) {
+  return begin_ != end_ || io_.WaitReadable(deadline);
+}
+
+size_t FrameReader::ReadSome(void* buf, size_t len,
+                             engine::Deadline deadline) {
+  auto* dest = static_cast<char*>(buf);
+  if (begin_ != end_) return TakeBuffered(dest, len);
+  if (len >= buffer_.size()) return io_.ReadSome(dest, len, deadline);
+
+  end_ = io_.ReadSome(buffer_.data(), buffer_.size(), deadline);
+  begin_ = 0;
+  return TakeBuffered(dest, len);
+}
+
+size_t FrameReader::ReadAll(void* buf, size_t len, engine::Deadline deadline) {
+  auto* dest = static_cast<char*>(buf);
+  auto done = TakeBuffered(dest, len);
+  if (done == len) return done;
+
+  if (len - done >= buffer_.size()) {
+    return done + io_.ReadAll(dest + done, len - done, deadline);
+  }
+
+  while (done < len) {
+    end_ = io_.ReadSome(buffer_.data(), buffer_.size(), deadline);
+    begin_ = 0;
+    if (end_ == 0) break;  // closed by peer
+    done += TakeBuffered(dest + done, len - done);
+  }
+  return done;
+}
+
+size_t FrameReader::TakeBuffered(char* dest, size_t len) noexcept {
+  const auto size = std::min(len, end_ - begin_);
+  if (size != 0) std::memcpy(dest, buffer_.data() + begin_, size);
+  begin_ += size;
+  return size;
+}
+
 CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
                         unsigned max_payload_size, std::size_t& payload_len) {
   WSHeader hdr;
   RecvExactly(io, AsWritableBytes(MakeSpan(&hdr, 1)), {});
   if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
-  const bool isDataFrame =
-      (hdr.bits.opcode & (kText | kBinary)) || hdr.bits.opcode == kContinuation;
+  const unsigned char opcode = hdr.bits.opcode;
+  const bool is_control_frame = IsControlFrame(opcode);
   if (hdr.bits.payloadLen <= 125) {
     payload_len = hdr.bits.payloadLen;
   } else if (hdr.bits.payloadLen == 126) {
@@ -173,12 +266,39 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
   }
   if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
-  if (!isDataFrame && hdr.bits.payloadLen > 125) {
-    // control frame should not have extended payload
+  if (is_control_frame && (hdr.bits.payloadLen > 125 || !hdr.bits.fin)) {
+    // control frame should not have extended payload and be fragmented
     return CloseStatus::kProtocolError;
   }
 
-  if (payload_len + frame.payload->size() > max_payload_size)
+  if (hdr.bits.reserved & ~kReservedCompressed) {
+    return CloseStatus::kProtocolError;
+  }
+  const bool rsv_compressed = hdr.bits.reserved & kReservedCompressed;
+  if (rsv_compressed && (!frame.compression_enabled || is_control_frame ||
+                         opcode == kContinuation)) {
+    return CloseStatus::kProtocolError;
+  }
+
+  if (!is_control_frame) {
+    if (frame.waiting_continuation != (opcode == kContinuation)) {
+      // non-continuation opcode while waiting continuation or vice versa
+      return CloseStatus::kProtocolError;
+    }
+    if (opcode != kContinuation) frame.is_compressed = rsv_compressed;
+  }
+
+  std::string* payload = nullptr;
+  if (is_control_frame) {
+    payload = &frame.control_payload;
+    payload->resize(0);
+  } else if (frame.is_compressed) {
+    payload = &frame.compressed_payload;
+  } else {
+    payload = frame.payload;
+  }
+
+  if (payload_len + payload->size() > max_payload_size)
     return CloseStatus::kTooBigData;
 
   Mask32 mask;
@@ -186,26 +306,18 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
   if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
   if (payload_len > 0) {
-    if (isDataFrame) {
-      if (!frame.payload->empty() && hdr.bits.opcode != kContinuation) {
-        // non-continuation opcode while waiting continuation
-        return CloseStatus::kProtocolError;
-      }
-    }
-
-    size_t newPayloadOffset = frame.payload->size();
-    frame.payload->resize(frame.payload->size() + payload_len);
-    RecvExactly(io,
-                MakeSpan(frame.payload->data() + newPayloadOffset, payload_len),
+    const auto new_payload_offset = payload->size();
+    payload->resize(new_payload_offset + payload_len);
+    RecvExactly(io, MakeSpan(payload->data() + new_payload_offset, payload_len),
                 {});
     if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
-    if (mask.mask32)
-      XorMaskInplace(reinterpret_cast<uint8_t*>(frame.payload->data()),
-                     frame.payload->size(), mask);
+    if (mask.mask32) {
+      XorMaskInplace(payload->data() + new_payload_offset, payload_len,
+                     mask.mask32);
+    }
   }
-  char opcode = hdr.bits.opcode;
-  char fin = hdr.bits.fin;
+  const bool fin = hdr.bits.fin;
 
   switch (opcode) {
     case kPing:
@@ -216,14 +328,14 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
       break;
     case kClose:
       frame.closed = true;
-      if (frame.payload->size() >= 2)
+      if (payload->size() >= 2)
         frame.remote_close_status = boost::endian::big_to_native(
-            *(reinterpret_cast<CloseStatusInt const*>(frame.payload->data())));
+            *(reinterpret_cast<CloseStatusInt const*>(payload->data())));
       break;
     case kText:
-      frame.is_text = true;
-      [[fallthrough]];
     case kBinary:
+      frame.is_text = opcode == kText;
+      [[fallthrough]];
     case kContinuation:
       frame.waiting_continuation = !fin;
       break;
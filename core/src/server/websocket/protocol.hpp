@@ -2,7 +2,9 @@
 
 #include <userver/server/websocket/server.hpp>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <boost/container/small_vector.hpp>
 
@@ -63,6 +65,9 @@ static_assert(sizeof(WSHeader) == 2);
 constexpr inline unsigned int kMaxFrameHeaderSize =
     sizeof(WSHeader) + sizeof(uint64_t);
 
+// RSV1 bit of WSHeader::bits::reserved, marks the compressed messages
+constexpr inline unsigned char kReservedCompressed = 0x4;
+
 namespace frames {
 
 enum class Continuation {
@@ -75,9 +80,15 @@ enum class Final {
   kNo,
 };
 
+enum class Compressed {
+  kYes,
+  kNo,
+};
+
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final);
+    Continuation is_continuation, Final is_final,
+    Compressed is_compressed = Compressed::kNo);
 std::array<char, sizeof(WSHeader)> MakeControlFrame(
     WSOpcodes opcode, utils::span<const std::byte> data = {});
 std::string CloseFrame(CloseStatusInt status_code);
@@ -88,15 +99,54 @@ const std::array<char, sizeof(WSHeader)>& CloseFrame();
 
 std::string WebsocketSecAnswer(std::string_view sec_key);
 
+/// Applies the masking key to the data, the first byte of the data is masked
+/// by the first byte of the key
+void XorMaskInplace(char* data, std::size_t len, std::uint32_t mask) noexcept;
+
+/// @brief Reads the socket by large chunks.
+///
+/// The frame headers and the payloads of the small frames are taken from the
+/// buffer without a syscall each. Reads larger than the buffer go directly into
+/// the destination.
+class FrameReader final : public engine::io::ReadableBase {
+ public:
+  FrameReader(engine::io::ReadableBase& io, std::size_t buffer_size);
+
+  bool IsValid() const override;
+
+  [[nodiscard]] bool WaitReadable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadSome(void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadAll(void* buf, size_t len,
+                               engine::Deadline deadline) override;
+
+ private:
+  size_t TakeBuffered(char* dest, size_t len) noexcept;
+
+  engine::io::ReadableBase& io_;
+  std::vector<char> buffer_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+};
+
 struct FrameParserState {
   bool closed = false;
   bool ping_received = false;
   bool pong_received = false;
   bool waiting_continuation = false;
   bool is_text = false;
+  bool is_compressed = false;
+  bool compression_enabled = false;
   CloseStatusInt remote_close_status = 0;
 
+  // Data of the uncompressed messages
   std::string* payload = nullptr;
+  // Data of the compressed messages and of the control frames, the buffers are
+  // reused for all the frames of the connection
+  std::string compressed_payload;
+  std::string control_payload;
 };
 
 CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
@@ -0,0 +1,244 @@
+#include <server/websocket/protocol.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <boost/endian/conversion.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <compression/error.hpp>
+#include <server/websocket/permessage_deflate.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ws = server::websocket;
+
+namespace {
+
+constexpr std::uint32_t kMask = 0x12345678;
+
+utils::span<const std::byte> AsBytes(std::string_view data) {
+  return utils::as_bytes(utils::span<const char>(data));
+}
+
+// Frame of a client: the payload is always masked
+std::string ClientFrame(ws::impl::WSOpcodes opcode, std::string_view payload,
+                        bool fin = true, bool compressed = false) {
+  std::string frame;
+  frame += static_cast<char>((fin ? 0x80 : 0) | (compressed ? 0x40 : 0) |
+                             opcode);
+  if (payload.size() <= 125) {
+    frame += static_cast<char>(0x80 | payload.size());
+  } else {
+    UASSERT(payload.size() <= UINT16_MAX);
+    frame += static_cast<char>(0x80 | 126);
+    const auto len = boost::endian::native_to_big(
+        static_cast<std::uint16_t>(payload.size()));
+    frame.append(reinterpret_cast<const char*>(&len), sizeof(len));
+  }
+  frame.append(reinterpret_cast<const char*>(&kMask), sizeof(kMask));
+
+  std::string masked{payload};
+  ws::impl::XorMaskInplace(masked.data(), masked.size(), kMask);
+  return frame + masked;
+}
+
+}  // namespace
+
+TEST(WebsocketProtocol, XorMask) {
+  std::string data;
+  for (std::size_t i = 0; i < 100; ++i) data += static_cast<char>(i * 7);
+
+  std::uint8_t mask_bytes[4];
+  std::memcpy(mask_bytes, &kMask, sizeof(kMask));
+
+  for (std::size_t offset = 0; offset < 4; ++offset) {
+    for (std::size_t len = 0; len + offset <= data.size(); ++len) {
+      auto masked = data;
+      ws::impl::XorMaskInplace(masked.data() + offset, len, kMask);
+      for (std::size_t i = 0; i < data.size(); ++i) {
+        auto expected = data[i];
+        if (i >= offset && i < offset + len) {
+          expected ^= mask_bytes[(i - offset) % 4];
+        }
+        ASSERT_EQ(masked[i], expected)
+            << "offset=" << offset << " len=" << len;
+      }
+    }
+  }
+}
+
+TEST(WebsocketProtocol, NegotiateDeflate) {
+  ws::DeflateConfig config;
+  config.enabled = true;
+  std::string response;
+
+  auto result = ws::impl::NegotiatePerMessageDeflate(
+      "permessage-deflate; client_max_window_bits", config, response);
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->enabled);
+  EXPECT_FALSE(result->server_no_context_takeover);
+  EXPECT_EQ(response, "permessage-deflate");
+
+  // The first acceptable offer is chosen
+  result = ws::impl::NegotiatePerMessageDeflate(
+      "x-unknown, permessage-deflate; server_max_window_bits=8, "
+      "permessage-deflate; server_max_window_bits=\"10\"; "
+      "server_no_context_takeover",
+      config, response);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->server_max_window_bits, 10);
+  EXPECT_TRUE(result->server_no_context_takeover);
+  EXPECT_EQ(response,
+            "permessage-deflate; server_no_context_takeover; "
+            "server_max_window_bits=10");
+
+  config.client_no_context_takeover = true;
+  result = ws::impl::NegotiatePerMessageDeflate("permessage-deflate", config,
+                                                response);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(response, "permessage-deflate; client_no_context_takeover");
+
+  EXPECT_FALSE(ws::impl::NegotiatePerMessageDeflate("", config, response));
+  EXPECT_FALSE(ws::impl::NegotiatePerMessageDeflate(
+      "permessage-deflate; unknown_param", config, response));
+  EXPECT_FALSE(ws::impl::NegotiatePerMessageDeflate(
+      "permessage-deflate; server_no_context_takeover; "
+      "server_no_context_takeover",
+      config, response));
+  EXPECT_FALSE(ws::impl::NegotiatePerMessageDeflate(
+      "permessage-deflate; client_max_window_bits=16", config, response));
+}
+
+TEST(WebsocketProtocol, DeflateRoundTrip) {
+  for (const bool no_context_takeover : {false, true}) {
+    ws::DeflateConfig config;
+    config.enabled = true;
+    config.server_no_context_takeover = no_context_takeover;
+    ws::impl::PerMessageDeflate sender{config};
+    ws::impl::PerMessageDeflate receiver{config};
+
+    std::string compressed;
+    for (std::size_t i = 0; i < 10; ++i) {
+      const std::string message(1000 * i, static_cast<char>('a' + i));
+      sender.Compress(AsBytes(message), compressed);
+
+      std::string decompressed = "prefix";
+      receiver.Decompress(compressed, decompressed, 1'000'000);
+      EXPECT_EQ(decompressed, "prefix" + message);
+    }
+  }
+}
+
+TEST(WebsocketProtocol, DeflateErrors) {
+  ws::DeflateConfig config;
+  config.enabled = true;
+  ws::impl::PerMessageDeflate deflate{config};
+
+  const std::string message(10'000, 'a');
+  std::string compressed;
+  deflate.Compress(AsBytes(message), compressed);
+  EXPECT_LT(compressed.size(), message.size());
+
+  std::string output;
+  EXPECT_THROW(deflate.Decompress(compressed, output, message.size() - 1),
+               compression::TooBigError);
+
+  output.clear();
+  EXPECT_THROW(deflate.Decompress("\xff\xff\xff\xff", output, 1000),
+               compression::DecompressionError);
+}
+
+UTEST(WebsocketProtocol, ReadFrames) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+
+  const std::string large(1000, 'x');
+  // A ping in the middle of a fragmented message, then a large message
+  const auto frames = ClientFrame(ws::impl::kText, "hello ", false) +
+                      ClientFrame(ws::impl::kPing, "ping") +
+                      ClientFrame(ws::impl::kContinuation, "world") +
+                      ClientFrame(ws::impl::kBinary, large);
+  ASSERT_EQ(client.SendAll(frames.data(), frames.size(), test_deadline),
+            frames.size());
+
+  ws::impl::FrameReader reader{server, 64};
+  ws::impl::FrameParserState state;
+  std::string payload;
+  state.payload = &payload;
+  std::size_t payload_len = 0;
+
+  ASSERT_EQ(ws::impl::ReadWSFrame(state, reader, 10'000, payload_len),
+            ws::CloseStatus::kNone);
+  EXPECT_TRUE(state.waiting_continuation);
+  EXPECT_EQ(payload, "hello ");
+
+  ASSERT_EQ(ws::impl::ReadWSFrame(state, reader, 10'000, payload_len),
+            ws::CloseStatus::kNone);
+  EXPECT_TRUE(state.ping_received);
+  EXPECT_EQ(state.control_payload, "ping");
+  state.ping_received = false;
+
+  ASSERT_EQ(ws::impl::ReadWSFrame(state, reader, 10'000, payload_len),
+            ws::CloseStatus::kNone);
+  EXPECT_FALSE(state.waiting_continuation);
+  EXPECT_TRUE(state.is_text);
+  EXPECT_EQ(payload, "hello world");
+
+  payload.clear();
+  ASSERT_EQ(ws::impl::ReadWSFrame(state, reader, 10'000, payload_len),
+            ws::CloseStatus::kNone);
+  EXPECT_FALSE(state.is_text);
+  EXPECT_EQ(payload, large);
+}
+
+UTEST(WebsocketProtocol, ReadCompressedFrames) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+
+  ws::DeflateConfig config;
+  config.enabled = true;
+  ws::impl::PerMessageDeflate deflate{config};
+  const std::string message(500, 'z');
+  std::string compressed;
+  deflate.Compress(AsBytes(message), compressed);
+
+  const auto frames =
+      ClientFrame(ws::impl::kText, compressed, true, true) +
+      ClientFrame(ws::impl::kText, compressed, true, true);
+  ASSERT_EQ(client.SendAll(frames.data(), frames.size(), test_deadline),
+            frames.size());
+
+  ws::impl::FrameReader reader{server, 1024};
+  ws::impl::FrameParserState state;
+  std::string payload;
+  state.payload = &payload;
+  std::size_t payload_len = 0;
+
+  state.compression_enabled = true;
+  ASSERT_EQ(ws::impl::ReadWSFrame(state, reader, 10'000, payload_len),
+            ws::CloseStatus::kNone);
+  EXPECT_TRUE(state.is_compressed);
+  EXPECT_TRUE(payload.empty());
+
+  ws::impl::PerMessageDeflate inflate{config};
+  inflate.Decompress(state.compressed_payload, payload, 10'000);
+  EXPECT_EQ(payload, message);
+
+  // RSV1 is a protocol error unless the extension is negotiated
+  state.compression_enabled = false;
+  EXPECT_EQ(ws::impl::ReadWSFrame(state, reader, 10'000, payload_len),
+            ws::CloseStatus::kProtocolError);
+}
+
+USERVER_NAMESPACE_END
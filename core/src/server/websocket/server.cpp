@@ -1,5 +1,6 @@
 #include <userver/server/websocket/server.hpp>
 
+#include <compression/error.hpp>
 #include <userver/components/component.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
@@ -7,6 +8,7 @@
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include "permessage_deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -14,6 +16,9 @@ USERVER_NAMESPACE_BEGIN
 namespace server::websocket {
 
 namespace {
+
+constexpr std::size_t kReadBufferSize = 16 * 1024;
+
 inline void SendExactly(engine::io::WritableBase& writable,
                         utils::span<const char> data1,
                         utils::span<const std::byte> data2) {
@@ -31,11 +36,29 @@ utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) {
 
 }  // namespace
 
+DeflateConfig Parse(const yaml_config::YamlConfig& config,
+                    formats::parse::To<DeflateConfig>) {
+  DeflateConfig result;
+  result.enabled = config["enabled"].As<bool>(result.enabled);
+  result.server_no_context_takeover =
+      config["server-no-context-takeover"].As<bool>(
+          result.server_no_context_takeover);
+  result.client_no_context_takeover =
+      config["client-no-context-takeover"].As<bool>(
+          result.client_no_context_takeover);
+  result.server_max_window_bits = config["server-max-window-bits"].As<unsigned>(
+      result.server_max_window_bits);
+  result.min_compress_size =
+      config["min-compress-size"].As<unsigned>(result.min_compress_size);
+  return result;
+}
+
 Config Parse(const yaml_config::YamlConfig& config,
              formats::parse::To<Config>) {
   return {
       config["max-remote-payload"].As<unsigned>(65536),
       config["fragment-size"].As<unsigned>(65536),
+      config["deflate"].As<DeflateConfig>(DeflateConfig{}),
   };
 }
 
@@ -43,6 +66,7 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
  public:
  private:
   std::unique_ptr<engine::io::RwBase> io;
+  impl::FrameReader reader_;
 
   struct MessageExtended final {
     utils::span<const std::byte> data;
@@ -64,11 +88,24 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
 
   Config config;
 
+  // Present if the permessage-deflate extension is negotiated. The output
+  // buffer of the compression is guarded by write_mutex_.
+  std::optional<impl::PerMessageDeflate> deflate_;
+  std::string deflate_output_;
+
  public:
   WebSocketConnectionImpl(std::unique_ptr<engine::io::RwBase> io_,
                           const engine::io::Sockaddr& remote_addr,
                           const Config& server_config)
-      : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {}
+      : io(std::move(io_)),
+        reader_(*io, kReadBufferSize),
+        remote_addr_(remote_addr),
+        config(server_config) {
+    if (config.deflate.enabled) {
+      deflate_.emplace(config.deflate);
+      frame_.compression_enabled = true;
+    }
+  }
 
   ~WebSocketConnectionImpl() override {
     LOG_TRACE() << "Websocket connection closed";
@@ -93,13 +130,20 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       SendExactly(*io, close_frame, {});
     } else if (!message.data.empty()) {
       utils::span<const std::byte> data_to_send{message.data};
+      auto compressed = impl::frames::Compressed::kNo;
+      if (deflate_ && data_to_send.size() >= config.deflate.min_compress_size) {
+        deflate_->Compress(data_to_send, deflate_output_);
+        data_to_send = MakeBinarySpan(deflate_output_);
+        compressed = impl::frames::Compressed::kYes;
+      }
+
       auto continuation = impl::frames::Continuation::kNo;
       while (data_to_send.size() > config.fragment_size &&
              config.fragment_size > 0) {
         const auto data_frame_header = impl::frames::DataFrameHeader(
             data_to_send.first(config.fragment_size),
             message.opcode == impl::WSOpcodes::kText, continuation,
-            impl::frames::Final::kNo);
+            impl::frames::Final::kNo, compressed);
         SendExactly(*io, data_frame_header,
                     data_to_send.first(config.fragment_size));
         continuation = impl::frames::Continuation::kYes;
@@ -108,7 +152,7 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       }
       const auto data_frame_header = impl::frames::DataFrameHeader(
           data_to_send, message.opcode == impl::WSOpcodes::kText, continuation,
-          impl::frames::Final::kYes);
+          impl::frames::Final::kYes, compressed);
       SendExactly(*io, data_frame_header, data_to_send);
     }
   }
@@ -134,20 +178,21 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
   void Recv(Message& msg) override {
     msg.data.resize(0);  // do not call .clear() to keep the allocated memory
     frame_.payload = &msg.data;
-    frame_.payload->resize(0);
+    frame_.compressed_payload.resize(0);
 
     try {
       while (true) {
         size_t payload_len = 0;
         // ReadWSFrame() returns kGoingAway in case of task cancellation
         CloseStatus status_raw =
-            ReadWSFrame(frame_, *io, config.max_remote_payload, payload_len);
+            ReadWSFrame(frame_, reader_, config.max_remote_payload,
+                        payload_len);
 
         auto status = static_cast<CloseStatusInt>(status_raw);
         LOG_TRACE() << fmt::format(
             "Read frame is_text {}, closed {}, data size {} status {} "
             "waitCont {}",
-            frame_.is_text, frame_.closed, frame_.payload->size(), status,
+            frame_.is_text, frame_.closed, payload_len, status,
             frame_.waiting_continuation);
         if (status != 0) {
           MessageExtended close_msg{{}, impl::WSOpcodes::kClose, status_raw};
@@ -163,10 +208,10 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
         }
 
         if (frame_.ping_received) {
-          MessageExtended pongMsg{
-              MakeBinarySpan(*frame_.payload), impl::WSOpcodes::kPong, {}};
+          MessageExtended pongMsg{MakeBinarySpan(frame_.control_payload),
+                                  impl::WSOpcodes::kPong,
+                                  {}};
           SendExtended(pongMsg);
-          frame_.payload->resize(frame_.payload->size() - payload_len);
           frame_.ping_received = false;
           continue;
         }
@@ -176,6 +221,17 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
         }
         if (frame_.waiting_continuation) continue;
 
+        if (frame_.is_compressed) {
+          const auto decompress_status = Decompress(msg.data);
+          if (decompress_status != CloseStatus::kNone) {
+            MessageExtended close_msg{
+                {}, impl::WSOpcodes::kClose, decompress_status};
+            SendExtended(close_msg);
+            msg = CloseMessage(decompress_status);
+            return;
+          }
+        }
+
         msg.is_text = frame_.is_text;
         stats_.msg_recv++;
         stats_.bytes_recv += msg.data.size();
@@ -209,6 +265,21 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
     stats.bytes_sent += stats_.bytes_sent;
     stats.bytes_recv += stats_.bytes_recv;
   }
+
+ private:
+  CloseStatus Decompress(std::string& data) {
+    UASSERT(deflate_);
+    try {
+      deflate_->Decompress(frame_.compressed_payload, data,
+                           config.max_remote_payload);
+      return CloseStatus::kNone;
+    } catch (const compression::TooBigError&) {
+      return CloseStatus::kTooBigData;
+    } catch (const compression::DecompressionError& e) {
+      LOG_TRACE() << "Failed to decompress the message: " << e;
+      return CloseStatus::kBadMessageData;
+    }
+  }
 };
 
 WebSocketConnection::WebSocketConnection() = default;
@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <boost/endian/conversion.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <server/websocket/permessage_deflate.hpp>
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ws = server::websocket;
+
+namespace {
+
+constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
+constexpr std::uint32_t kMask = 0x12345678;
+
+std::string MakeMessage(std::size_t size) {
+  // Compressible, like the usual JSON messages
+  std::string message;
+  while (message.size() < size) {
+    message += R"({"id":)" + std::to_string(message.size()) + R"(,"ok":true})";
+  }
+  message.resize(size);
+  return message;
+}
+
+std::string ClientFrame(ws::impl::WSOpcodes opcode, std::string payload,
+                        bool compressed) {
+  std::string frame;
+  frame += static_cast<char>(0x80 | (compressed ? 0x40 : 0) | opcode);
+  if (payload.size() <= 125) {
+    frame += static_cast<char>(0x80 | payload.size());
+  } else if (payload.size() <= UINT16_MAX) {
+    frame += static_cast<char>(0x80 | 126);
+    const auto len = boost::endian::native_to_big(
+        static_cast<std::uint16_t>(payload.size()));
+    frame.append(reinterpret_cast<const char*>(&len), sizeof(len));
+  } else {
+    frame += static_cast<char>(0x80 | 127);
+    const auto len = boost::endian::native_to_big(
+        static_cast<std::uint64_t>(payload.size()));
+    frame.append(reinterpret_cast<const char*>(&len), sizeof(len));
+  }
+  frame.append(reinterpret_cast<const char*>(&kMask), sizeof(kMask));
+
+  ws::impl::XorMaskInplace(payload.data(), payload.size(), kMask);
+  return frame + payload;
+}
+
+// Reads a single unfragmented unmasked frame of the server
+std::size_t RecvServerFrame(engine::io::Socket& socket, std::string& buffer,
+                            engine::Deadline deadline) {
+  unsigned char header[2];
+  UINVARIANT(socket.RecvAll(header, sizeof(header), deadline) == 2,
+             "Connection closed");
+  std::uint64_t len = header[1] & 0x7f;
+  if (len == 126) {
+    std::uint16_t len16 = 0;
+    UINVARIANT(socket.RecvAll(&len16, sizeof(len16), deadline) == 2,
+               "Connection closed");
+    len = boost::endian::big_to_native(len16);
+  } else if (len == 127) {
+    UINVARIANT(socket.RecvAll(&len, sizeof(len), deadline) == 8,
+               "Connection closed");
+    len = boost::endian::big_to_native(len);
+  }
+  buffer.resize(len);
+  UINVARIANT(socket.RecvAll(buffer.data(), len, deadline) == len,
+             "Connection closed");
+  return len;
+}
+
+}  // namespace
+
+void websocket_echo(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+    auto [server, client] =
+        internal::net::TcpListener{}.MakeSocketPair(deadline);
+
+    const auto message = MakeMessage(state.range(0));
+    const bool compressed = state.range(1);
+
+    ws::Config config;
+    config.fragment_size = 0;
+    config.deflate.enabled = compressed;
+    config.deflate.server_no_context_takeover = true;
+    config.deflate.min_compress_size = 0;
+
+    // Without the context takeover all the compressed frames are the same
+    std::string payload = message;
+    if (compressed) {
+      ws::impl::PerMessageDeflate deflate{config.deflate};
+      deflate.Compress(utils::as_bytes(utils::span<const char>(message)),
+                       payload);
+    }
+    const auto frame =
+        ClientFrame(ws::impl::kBinary, std::move(payload), compressed);
+
+    auto echo_task = engine::AsyncNoSpan(
+        [&config](auto&& socket) {
+          auto connection = ws::MakeWebSocket(
+              std::make_unique<engine::io::Socket>(std::move(socket)),
+              engine::io::Sockaddr{}, config);
+          ws::Message message;
+          while (true) {
+            connection->Recv(message);
+            if (message.close_status) break;
+            connection->Send(message);
+          }
+        },
+        std::move(server));
+
+    std::string reply;
+    for ([[maybe_unused]] auto _ : state) {
+      UINVARIANT(client.SendAll(frame.data(), frame.size(), deadline) ==
+                     frame.size(),
+                 "Connection closed");
+      benchmark::DoNotOptimize(RecvServerFrame(client, reply, deadline));
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+
+    const auto close = ClientFrame(ws::impl::kClose, "\x03\xe8", false);
+    UINVARIANT(client.SendAll(close.data(), close.size(), deadline) ==
+                   close.size(),
+               "Connection closed");
+    echo_task.Get();
+  });
+}
+BENCHMARK(websocket_echo)
+    ->ArgsProduct({{16, 1024, 64 * 1024}, {0, 1}})
+    ->ArgNames({"size", "deflate"});
+
+void websocket_unmask(benchmark::State& state) {
+  std::string data(state.range(0), 'a');
+  for ([[maybe_unused]] auto _ : state) {
+    ws::impl::XorMaskInplace(data.data(), data.size(), kMask);
+    benchmark::DoNotOptimize(data.data());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(websocket_unmask)->RangeMultiplier(16)->Range(16, 1024 * 1024);
+
+USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/server/websocket/server.hpp>
+#include "permessage_deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -63,6 +64,21 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
 
   if (!HandleHandshake(request, response, context)) return "";
 
+  auto connection_config = config_;
+  connection_config.deflate.enabled = false;
+  if (config_.deflate.enabled) {
+    std::string extensions_answer;
+    auto deflate = websocket::impl::NegotiatePerMessageDeflate(
+        request.GetHeader(
+            USERVER_NAMESPACE::http::headers::kWebsocketExtensions),
+        config_.deflate, extensions_answer);
+    if (deflate) {
+      connection_config.deflate = *deflate;
+      response.SetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions,
+                         std::move(extensions_answer));
+    }
+  }
+
   response.SetStatus(server::http::HttpStatus::kSwitchingProtocols);
   response.SetHeader(USERVER_NAMESPACE::http::headers::kConnection, "Upgrade");
   response.SetHeader(USERVER_NAMESPACE::http::headers::kUpgrade, "websocket");
@@ -72,11 +88,12 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
   request.SetUpgradeWebsocket(
       [context = std::make_shared<server::request::RequestContext>(
            std::move(context)),
+       connection_config,
        this](std::unique_ptr<engine::io::RwBase> socket,
              engine::io::Sockaddr&& peer_name) {
         tracing::Span span("ws/" + HandlerName());
-        auto ws = websocket::MakeWebSocket(std::move(socket),
-                                           std::move(peer_name), config_);
+        auto ws = websocket::MakeWebSocket(
+            std::move(socket), std::move(peer_name), connection_config);
         try {
           Handle(*ws, *context);
         } catch (const std::exception& e) {
@@ -112,6 +129,34 @@ properties:
         type: integer
         description: max output fragment size
         defaultDescription: 65536
+    deflate:
+        type: object
+        description: permessage-deflate extension (RFC 7692) options
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: compress the messages if the client offers the extension
+                defaultDescription: false
+            server-no-context-takeover:
+                type: boolean
+                description: reset the compression context after each sent message, uses less memory and compresses worse
+                defaultDescription: false
+            client-no-context-takeover:
+                type: boolean
+                description: ask the client to reset its compression context after each message
+                defaultDescription: false
+            server-max-window-bits:
+                type: integer
+                description: LZ77 window size of the compression of the sent messages as a power of 2
+                defaultDescription: 15
+                minimum: 9
+                maximum: 15
+            min-compress-size:
+                type: integer
+                description: messages smaller than this value are sent uncompressed
+                defaultDescription: 64
+                minimum: 0
 )");
 }
 
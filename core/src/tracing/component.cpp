@@ -1,18 +1,41 @@
 #include <userver/tracing/component.hpp>
 
 #include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/tracing/tracer.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <tracing/tail_sampler.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
 
 namespace {
+
 constexpr std::string_view kNativeTrace = "native";
+
+tracing::impl::TailSamplingSettings ParseTailSamplingSettings(
+    const yaml_config::YamlConfig& config) {
+  tracing::impl::TailSamplingSettings settings;
+  settings.slow_threshold =
+      config["slow-threshold"].As<std::chrono::milliseconds>(
+          settings.slow_threshold);
+  settings.sample_rate = config["sample-rate"].As<double>(settings.sample_rate);
+  settings.max_spans_per_trace = config["max-spans-per-trace"].As<std::size_t>(
+      settings.max_spans_per_trace);
+  settings.max_buffered_bytes = config["max-buffered-bytes"].As<std::size_t>(
+      settings.max_buffered_bytes);
+  settings.max_trace_age =
+      config["max-trace-age"].As<std::chrono::milliseconds>(
+          settings.max_trace_age);
+  return settings;
 }
 
+}  // namespace
+
 Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
   auto& logging_component = context.FindComponent<Logging>();
   auto opentracing_logger = logging_component.GetLoggerOptional("opentracing");
@@ -31,13 +54,35 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
       LOG_INFO() << "Opentracing logger is not registered";
     }
 
-    tracing::Tracer::SetTracer(tracing::MakeTracer(
-        std::move(service_name), std::move(opentracing_logger), tracer_type));
+    auto tracer = tracing::MakeTracer(
+        std::move(service_name), std::move(opentracing_logger), tracer_type);
+
+    const auto tail_sampling = config["tail-sampling"];
+    if (tail_sampling["enabled"].As<bool>(false)) {
+      LOG_INFO() << "Tail-based trace sampling enabled.";
+      auto tail_sampler = std::make_shared<tracing::impl::TailSampler>(
+          ParseTailSamplingSettings(tail_sampling));
+      tracer->SetTailSampler(tail_sampler);
+
+      auto* statistics_storage =
+          context.FindComponentOptional<components::StatisticsStorage>();
+      if (statistics_storage) {
+        statistics_holder_ = statistics_storage->GetStorage().RegisterWriter(
+            "tracing.tail_sampling",
+            [tail_sampler](utils::statistics::Writer& writer) {
+              writer = tail_sampler->GetStatistics();
+            });
+      }
+    }
+
+    tracing::Tracer::SetTracer(std::move(tracer));
   } else {
     throw std::runtime_error("Tracer type is not supported: " + tracer_type);
   }
 }
 
+Tracer::~Tracer() { statistics_holder_.Unregister(); }
+
 yaml_config::Schema Tracer::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<impl::ComponentBase>(R"(
 type: object
@@ -52,6 +97,39 @@ properties:
         type: string
         description: type of the tracer to trace, currently supported only 'native'
         defaultDescription: 'native'
+    tail-sampling:
+        type: object
+        description: buffer spans of each trace until its local root span finishes and write out only slow, failed or sampled traces
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: enable tail-based sampling
+                defaultDescription: false
+            slow-threshold:
+                type: string
+                description: traces with a longer local root span are always written
+                defaultDescription: 1s
+            sample-rate:
+                type: number
+                description: fraction of traces to write regardless of duration and errors
+                defaultDescription: 0
+                minimum: 0
+                maximum: 1
+            max-spans-per-trace:
+                type: integer
+                description: spans of a trace over this limit are discarded
+                defaultDescription: 1000
+                minimum: 1
+            max-buffered-bytes:
+                type: integer
+                description: memory limit for all the buffered spans, spans over this limit are discarded
+                defaultDescription: 67108864
+                minimum: 1
+            max-trace-age:
+                type: string
+                description: buffered traces without a finished local root span are discarded after this time
+                defaultDescription: 1m
 )");
 }
 
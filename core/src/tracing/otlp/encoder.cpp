@@ -0,0 +1,231 @@
+#include <tracing/otlp/encoder.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <variant>
+
+#include <userver/utils/encoding/hex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::otlp {
+
+namespace {
+
+// Field numbers from opentelemetry/proto/{collector/trace,trace,common,
+// resource}/v1/*.proto
+namespace fields {
+
+constexpr int kRequestResourceSpans = 1;
+
+constexpr int kResourceSpansResource = 1;
+constexpr int kResourceSpansScopeSpans = 2;
+
+constexpr int kResourceAttributes = 1;
+
+constexpr int kScopeSpansScope = 1;
+constexpr int kScopeSpansSpans = 2;
+
+constexpr int kScopeName = 1;
+
+constexpr int kSpanTraceId = 1;
+constexpr int kSpanSpanId = 2;
+constexpr int kSpanParentSpanId = 4;
+constexpr int kSpanName = 5;
+constexpr int kSpanKind = 6;
+constexpr int kSpanStartTime = 7;
+constexpr int kSpanEndTime = 8;
+constexpr int kSpanAttributes = 9;
+constexpr int kSpanStatus = 15;
+
+constexpr int kStatusCode = 3;
+
+constexpr int kKeyValueKey = 1;
+constexpr int kKeyValueValue = 2;
+
+constexpr int kAnyValueString = 1;
+constexpr int kAnyValueInt = 3;
+constexpr int kAnyValueDouble = 4;
+
+}  // namespace fields
+
+constexpr std::uint64_t kSpanKindInternal = 1;
+constexpr std::uint64_t kStatusCodeError = 2;
+
+constexpr std::size_t kTraceIdSize = 16;
+constexpr std::size_t kSpanIdSize = 8;
+
+constexpr std::string_view kScopeNameValue = "userver";
+constexpr std::string_view kServiceNameKey = "service.name";
+
+enum class WireType : std::uint32_t {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+};
+
+class ProtoWriter final {
+ public:
+  explicit ProtoWriter(std::string& out) : out_(out) {}
+
+  void Varint(int field, std::uint64_t value) {
+    Tag(field, WireType::kVarint);
+    RawVarint(value);
+  }
+
+  void Fixed64(int field, std::uint64_t value) {
+    Tag(field, WireType::kFixed64);
+    for (int i = 0; i < 8; ++i) {
+      out_.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+  }
+
+  void Double(int field, double value) {
+    static_assert(sizeof(double) == sizeof(std::uint64_t));
+    std::uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    Fixed64(field, bits);
+  }
+
+  void Bytes(int field, std::string_view value) {
+    Tag(field, WireType::kLengthDelimited);
+    RawVarint(value.size());
+    out_.append(value);
+  }
+
+  // Writes a nested message, `func` is called with a ProtoWriter for it
+  template <typename Func>
+  void Message(int field, Func&& func) {
+    std::string nested;
+    ProtoWriter nested_writer{nested};
+    std::forward<Func>(func)(nested_writer);
+    Bytes(field, nested);
+  }
+
+ private:
+  void Tag(int field, WireType type) {
+    RawVarint((static_cast<std::uint64_t>(field) << 3) |
+              static_cast<std::uint64_t>(type));
+  }
+
+  void RawVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+      out_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    out_.push_back(static_cast<char>(value));
+  }
+
+  std::string& out_;
+};
+
+// userver ids are hex strings, but may come from foreign tracing headers with
+// an unexpected length. OTLP requires ids of a fixed size, so such ids are
+// hashed to keep spans of a single trace together.
+std::string ToFixedSizeId(std::string_view id, std::size_t size) {
+  if (id.size() == size * 2 && utils::encoding::IsHexData(id)) {
+    return utils::encoding::FromHex(id);
+  }
+
+  std::string result;
+  result.reserve(size);
+  std::uint64_t state = std::hash<std::string_view>{}(id);
+  while (result.size() < size) {
+    const auto chunk = std::min(sizeof(state), size - result.size());
+    result.append(reinterpret_cast<const char*>(&state), chunk);
+    // LCG step to get the next bytes deterministically
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  return result;
+}
+
+std::uint64_t ToUnixNanoseconds(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+void WriteAnyValue(ProtoWriter& writer, const logging::LogExtra::Value& value) {
+  std::visit(
+      [&writer](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          writer.Bytes(fields::kAnyValueString, v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+          writer.Double(fields::kAnyValueDouble, v);
+        } else {
+          writer.Varint(fields::kAnyValueInt, static_cast<std::uint64_t>(v));
+        }
+      },
+      value);
+}
+
+void WriteKeyValue(ProtoWriter& writer, int field, std::string_view key,
+                   const logging::LogExtra::Value& value) {
+  writer.Message(field, [&](ProtoWriter& kv) {
+    kv.Bytes(fields::kKeyValueKey, key);
+    kv.Message(fields::kKeyValueValue,
+               [&](ProtoWriter& any) { WriteAnyValue(any, value); });
+  });
+}
+
+void WriteSpan(ProtoWriter& writer, const impl::SpanRecord& span) {
+  writer.Bytes(fields::kSpanTraceId,
+               ToFixedSizeId(span.trace_id, kTraceIdSize));
+  writer.Bytes(fields::kSpanSpanId, ToFixedSizeId(span.span_id, kSpanIdSize));
+  if (!span.parent_id.empty()) {
+    writer.Bytes(fields::kSpanParentSpanId,
+                 ToFixedSizeId(span.parent_id, kSpanIdSize));
+  }
+  writer.Bytes(fields::kSpanName, span.name);
+  writer.Varint(fields::kSpanKind, kSpanKindInternal);
+  writer.Fixed64(fields::kSpanStartTime, ToUnixNanoseconds(span.start_time));
+  writer.Fixed64(fields::kSpanEndTime, ToUnixNanoseconds(span.end_time));
+
+  for (const auto& [key, value] : span.tags) {
+    WriteKeyValue(writer, fields::kSpanAttributes, key, value);
+  }
+
+  if (span.is_error) {
+    writer.Message(fields::kSpanStatus, [](ProtoWriter& status) {
+      status.Varint(fields::kStatusCode, kStatusCodeError);
+    });
+  }
+}
+
+void WriteResourceSpans(ProtoWriter& writer, std::string_view service_name,
+                        const std::vector<impl::SpanRecord>& spans) {
+  writer.Message(fields::kResourceSpansResource, [&](ProtoWriter& resource) {
+    WriteKeyValue(resource, fields::kResourceAttributes, kServiceNameKey,
+                  std::string{service_name});
+  });
+
+  writer.Message(fields::kResourceSpansScopeSpans, [&](ProtoWriter& scope) {
+    scope.Message(fields::kScopeSpansScope, [](ProtoWriter& scope_info) {
+      scope_info.Bytes(fields::kScopeName, kScopeNameValue);
+    });
+    for (const auto& span : spans) {
+      scope.Message(fields::kScopeSpansSpans,
+                    [&span](ProtoWriter& out) { WriteSpan(out, span); });
+    }
+  });
+}
+
+}  // namespace
+
+std::string EncodeExportTraceServiceRequest(
+    std::string_view service_name, const std::vector<impl::SpanRecord>& spans) {
+  std::string result;
+  ProtoWriter request{result};
+  request.Message(fields::kRequestResourceSpans, [&](ProtoWriter& writer) {
+    WriteResourceSpans(writer, service_name, spans);
+  });
+  return result;
+}
+
+}  // namespace tracing::otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tracing/span_record.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::otlp {
+
+/// @brief Serializes spans into a binary protobuf
+/// `opentelemetry.proto.collector.trace.v1.ExportTraceServiceRequest`.
+///
+/// All the spans are placed into a single ResourceSpans with the
+/// `service.name` resource attribute set to `service_name`.
+std::string EncodeExportTraceServiceRequest(
+    std::string_view service_name, const std::vector<impl::SpanRecord>& spans);
+
+}  // namespace tracing::otlp
+
+USERVER_NAMESPACE_END
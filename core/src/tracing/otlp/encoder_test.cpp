@@ -0,0 +1,85 @@
+#include <tracing/otlp/encoder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/encoding/hex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kTraceId = "0123456789abcdef0123456789abcdef";
+constexpr std::string_view kSpanId = "0011223344556677";
+
+tracing::impl::SpanRecord MakeRecord(std::string name) {
+  tracing::impl::SpanRecord record;
+  record.name = std::move(name);
+  record.trace_id = std::string{kTraceId};
+  record.span_id = std::string{kSpanId};
+  record.start_time = std::chrono::system_clock::time_point{};
+  record.end_time = record.start_time + std::chrono::milliseconds{5};
+  return record;
+}
+
+bool Contains(std::string_view haystack, std::string_view needle) {
+  return haystack.find(needle) != std::string_view::npos;
+}
+
+}  // namespace
+
+TEST(OtlpEncoder, Basic) {
+  auto record = MakeRecord("my_span");
+  record.tags.emplace_back("http.method", std::string{"GET"});
+  record.tags.emplace_back("http.status_code", 200);
+
+  const auto encoded = tracing::otlp::EncodeExportTraceServiceRequest(
+      "my-service", {std::move(record)});
+
+  // resource_spans: field 1, length delimited
+  ASSERT_FALSE(encoded.empty());
+  EXPECT_EQ(encoded[0], '\x0A');
+
+  EXPECT_TRUE(Contains(encoded, "service.name"));
+  EXPECT_TRUE(Contains(encoded, "my-service"));
+  EXPECT_TRUE(Contains(encoded, "my_span"));
+  EXPECT_TRUE(Contains(encoded, "http.method"));
+  EXPECT_TRUE(Contains(encoded, "GET"));
+
+  // ids are sent as raw bytes, not as hex
+  EXPECT_TRUE(Contains(encoded, utils::encoding::FromHex(kTraceId)));
+  EXPECT_TRUE(Contains(encoded, utils::encoding::FromHex(kSpanId)));
+  EXPECT_FALSE(Contains(encoded, kTraceId));
+}
+
+TEST(OtlpEncoder, ErrorStatus) {
+  auto ok_record = MakeRecord("span");
+  auto error_record = MakeRecord("span");
+  error_record.is_error = true;
+
+  const auto ok = tracing::otlp::EncodeExportTraceServiceRequest(
+      "service", {std::move(ok_record)});
+  const auto error = tracing::otlp::EncodeExportTraceServiceRequest(
+      "service", {std::move(error_record)});
+
+  // Span.status { code: STATUS_CODE_ERROR }
+  constexpr std::string_view kErrorStatus = "\x7A\x02\x18\x02";
+  EXPECT_FALSE(Contains(ok, kErrorStatus));
+  EXPECT_TRUE(Contains(error, kErrorStatus));
+}
+
+TEST(OtlpEncoder, NonHexIds) {
+  auto record = MakeRecord("span");
+  record.trace_id = "not-a-hex-trace-id";
+  record.span_id = "short";
+  record.parent_id = "another-parent";
+
+  const auto first = tracing::otlp::EncodeExportTraceServiceRequest(
+      "service", {MakeRecord("span"), record});
+  const auto second = tracing::otlp::EncodeExportTraceServiceRequest(
+      "service", {MakeRecord("span"), record});
+
+  EXPECT_EQ(first, second);
+  EXPECT_FALSE(Contains(first, "not-a-hex-trace-id"));
+}
+
+USERVER_NAMESPACE_END
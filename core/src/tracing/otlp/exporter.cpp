@@ -0,0 +1,145 @@
+#include <tracing/otlp/exporter.hpp>
+
+#include <array>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <tracing/otlp/encoder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::otlp {
+
+namespace {
+
+constexpr std::array<double, 12> kBatchLatencyBoundsMs{
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+}  // namespace
+
+ExporterStatistics::ExporterStatistics()
+    : batch_latency_ms(kBatchLatencyBoundsMs) {}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ExporterStatistics& stats) {
+  if (auto spans = writer["spans"]) {
+    spans["exported"] = stats.exported;
+    spans["dropped"] = stats.dropped;
+  }
+  if (auto batches = writer["batches"]) {
+    batches["sent"] = stats.batches;
+    batches["errors"] = stats.send_errors;
+    batches["latency_ms"] = stats.batch_latency_ms;
+  }
+}
+
+Exporter::Exporter(clients::http::Client& http_client,
+                   ExporterSettings settings)
+    : http_client_(http_client),
+      settings_(std::move(settings)),
+      queue_(Queue::Create(settings_.max_queue_size)),
+      producer_(queue_->GetMultiProducer()),
+      consumer_(queue_->GetConsumer()) {
+  UINVARIANT(settings_.max_batch_size > 0, "max batch size must be positive");
+}
+
+Exporter::~Exporter() { Stop(); }
+
+void Exporter::Start(engine::TaskProcessor& task_processor) {
+  UASSERT(!processing_task_.IsValid());
+  processing_task_ = engine::CriticalAsyncNoSpan(
+      task_processor, [this] { ProcessingLoop(); });
+}
+
+void Exporter::Stop() noexcept {
+  if (processing_task_.IsValid()) {
+    processing_task_.SyncCancel();
+    processing_task_ = {};
+  }
+}
+
+void Exporter::Export(impl::SpanRecord&& record) noexcept {
+  try {
+    if (producer_.PushNoblock(
+            std::make_unique<impl::SpanRecord>(std::move(record)))) {
+      return;
+    }
+  } catch (const std::exception&) {
+    // account as dropped below
+  }
+  ++stats_.dropped;
+}
+
+void Exporter::ProcessingLoop() {
+  std::vector<impl::SpanRecord> batch;
+  batch.reserve(settings_.max_batch_size);
+
+  std::unique_ptr<impl::SpanRecord> record;
+  while (consumer_.Pop(record)) {
+    batch.push_back(std::move(*record));
+
+    const auto deadline =
+        engine::Deadline::FromDuration(settings_.max_batch_delay);
+    while (batch.size() < settings_.max_batch_size &&
+           consumer_.Pop(record, deadline)) {
+      batch.push_back(std::move(*record));
+    }
+
+    if (engine::current_task::ShouldCancel()) break;
+
+    SendBatch(batch);
+    batch.clear();
+  }
+
+  // Discard whatever was left on shutdown
+  std::size_t discarded = batch.size();
+  while (consumer_.PopNoblock(record)) ++discarded;
+  stats_.dropped += utils::statistics::Rate{discarded};
+}
+
+void Exporter::SendBatch(const std::vector<impl::SpanRecord>& batch) {
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    // Spans of the HTTP client must not be exported, otherwise each batch
+    // produces a span for the next one. Only the request is silenced, the
+    // failures are logged outside of the span.
+    tracing::Span span{"otlp_export"};
+    span.SetLocalLogLevel(logging::Level::kNone);
+
+    auto response =
+        http_client_.CreateRequest()
+            .post(settings_.endpoint,
+                  EncodeExportTraceServiceRequest(settings_.service_name,
+                                                  batch))
+            .headers({{http::headers::kContentType, "application/x-protobuf"}})
+            .timeout(settings_.http_timeout)
+            .perform();
+    response->raise_for_status();
+
+    ++stats_.batches;
+    stats_.exported += utils::statistics::Rate{batch.size()};
+  } catch (const std::exception& e) {
+    if (engine::current_task::ShouldCancel()) throw;
+
+    LOG_LIMITED_WARNING() << "Failed to export " << batch.size()
+                          << " spans to '" << settings_.endpoint
+                          << "': " << e;
+    ++stats_.send_errors;
+    stats_.dropped += utils::statistics::Rate{batch.size()};
+  }
+
+  stats_.batch_latency_ms.Account(
+      std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+}
+
+}  // namespace tracing::otlp
+
+USERVER_NAMESPACE_END
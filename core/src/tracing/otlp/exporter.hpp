@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/mpsc_queue.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+#include <tracing/span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+class Client;
+}  // namespace clients::http
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace tracing::otlp {
+
+struct ExporterSettings final {
+  /// OTLP/HTTP traces endpoint, e.g. http://localhost:4318/v1/traces
+  std::string endpoint;
+  std::string service_name;
+
+  std::size_t max_queue_size{65536};
+  std::size_t max_batch_size{512};
+  std::chrono::milliseconds max_batch_delay{100};
+  std::chrono::milliseconds http_timeout{1000};
+};
+
+struct ExporterStatistics final {
+  ExporterStatistics();
+
+  utils::statistics::RateCounter exported{};
+  utils::statistics::RateCounter dropped{};
+  utils::statistics::RateCounter batches{};
+  utils::statistics::RateCounter send_errors{};
+  utils::statistics::Histogram batch_latency_ms;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ExporterStatistics& stats);
+
+/// @brief Batches finished spans in a lock-free queue and sends them to an
+/// OpenTelemetry collector in OTLP/HTTP protobuf encoding.
+///
+/// Export() never blocks: if the queue is full, the span is dropped and
+/// accounted in statistics.
+class Exporter final : public impl::SpanExporterBase {
+ public:
+  Exporter(clients::http::Client& http_client, ExporterSettings settings);
+  ~Exporter() override;
+
+  /// Starts the background task that sends batches
+  void Start(engine::TaskProcessor& task_processor);
+
+  /// Stops the background task, spans that were not sent yet are dropped
+  void Stop() noexcept;
+
+  void Export(impl::SpanRecord&& record) noexcept override;
+
+  const ExporterStatistics& GetStatistics() const noexcept { return stats_; }
+
+ private:
+  using Queue = concurrent::MpscQueue<std::unique_ptr<impl::SpanRecord>>;
+
+  void ProcessingLoop();
+  void SendBatch(const std::vector<impl::SpanRecord>& batch);
+
+  clients::http::Client& http_client_;
+  const ExporterSettings settings_;
+  ExporterStatistics stats_;
+
+  std::shared_ptr<Queue> queue_;
+  Queue::MultiProducer producer_;
+  Queue::Consumer consumer_;
+  engine::Task processing_task_;
+};
+
+}  // namespace tracing::otlp
+
+USERVER_NAMESPACE_END
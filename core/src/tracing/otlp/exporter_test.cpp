@@ -0,0 +1,136 @@
+#include <tracing/otlp/exporter.hpp>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/http_server_mock.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <logging/logging_test.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class FakeCollector final {
+ public:
+  utest::HttpServerMock::HttpResponse operator()(
+      const utest::HttpServerMock::HttpRequest& request) {
+    EXPECT_EQ(request.path, "/v1/traces");
+    EXPECT_EQ(request.headers.at(http::headers::kContentType),
+              "application/x-protobuf");
+
+    const std::lock_guard lock{mutex_};
+    bodies_.push_back(request.body);
+    return {200, {}, {}};
+  }
+
+  std::vector<std::string> GetBodies() {
+    const std::lock_guard lock{mutex_};
+    return bodies_;
+  }
+
+ private:
+  engine::Mutex mutex_;
+  std::vector<std::string> bodies_;
+};
+
+class OtlpExporter : public LoggingTest {
+ protected:
+  std::shared_ptr<tracing::otlp::Exporter> MakeExporter(
+      std::string endpoint, std::size_t max_queue_size = 1000) {
+    tracing::otlp::ExporterSettings settings;
+    settings.endpoint = std::move(endpoint);
+    settings.service_name = "test-service";
+    settings.max_queue_size = max_queue_size;
+    settings.max_batch_size = 10;
+    settings.max_batch_delay = 10ms;
+    return std::make_shared<tracing::otlp::Exporter>(*http_client_,
+                                                     std::move(settings));
+  }
+
+ private:
+  const std::shared_ptr<clients::http::Client> http_client_ =
+      utest::CreateHttpClient();
+};
+
+void WaitForExported(const tracing::otlp::Exporter& exporter,
+                     std::uint64_t count) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (exporter.GetStatistics().exported.Load().value < count &&
+         !deadline.IsReached()) {
+    engine::SleepFor(1ms);
+  }
+}
+
+}  // namespace
+
+UTEST_F(OtlpExporter, SendsSpansInsteadOfLogging) {
+  FakeCollector collector;
+  const utest::HttpServerMock server{std::ref(collector)};
+
+  auto exporter = MakeExporter(server.GetBaseUrl() + "/v1/traces");
+  exporter->Start(engine::current_task::GetTaskProcessor());
+  tracing::impl::SetSpanExporter(exporter);
+
+  {
+    tracing::Span parent{"parent_span"};
+    tracing::Span child{"child_span"};
+  }
+  tracing::impl::SetSpanExporter(nullptr);
+
+  WaitForExported(*exporter, 2);
+  exporter->Stop();
+
+  EXPECT_EQ(exporter->GetStatistics().exported.Load().value, 2);
+  EXPECT_EQ(exporter->GetStatistics().dropped.Load().value, 0);
+  EXPECT_EQ(GetStreamString().find("parent_span"), std::string::npos);
+
+  std::string all_bodies;
+  for (const auto& body : collector.GetBodies()) all_bodies += body;
+  EXPECT_NE(all_bodies.find("parent_span"), std::string::npos);
+  EXPECT_NE(all_bodies.find("child_span"), std::string::npos);
+  EXPECT_NE(all_bodies.find("test-service"), std::string::npos);
+}
+
+UTEST_F(OtlpExporter, LogsExportFailures) {
+  const utest::HttpServerMock server{
+      [](const utest::HttpServerMock::HttpRequest&) {
+        return utest::HttpServerMock::HttpResponse{500, {}, {}};
+      }};
+
+  auto exporter = MakeExporter(server.GetBaseUrl() + "/v1/traces");
+  exporter->Start(engine::current_task::GetTaskProcessor());
+  tracing::impl::SetSpanExporter(exporter);
+  { tracing::Span span{"failed_span"}; }
+  tracing::impl::SetSpanExporter(nullptr);
+
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (exporter->GetStatistics().send_errors.Load().value == 0 &&
+         !deadline.IsReached()) {
+    engine::SleepFor(1ms);
+  }
+  exporter->Stop();
+
+  EXPECT_EQ(exporter->GetStatistics().send_errors.Load().value, 1);
+  EXPECT_NE(GetStreamString().find("Failed to export 1 spans"),
+            std::string::npos);
+}
+
+UTEST_F(OtlpExporter, DropsOnQueueOverflow) {
+  // Not started, so nothing is consumed from the queue
+  auto exporter = MakeExporter("http://localhost:1/v1/traces", 2);
+
+  for (int i = 0; i < 5; ++i) {
+    exporter->Export(tracing::impl::SpanRecord{});
+  }
+
+  EXPECT_EQ(exporter->GetStatistics().dropped.Load().value, 3);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#include <userver/tracing/otlp_exporter_component.hpp>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/tracing/component.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <tracing/otlp/exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+OtlpExporterComponent::OtlpExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : components::LoggableComponentBase(config, context) {
+  // The tracer component sets up the service name
+  context.FindComponent<components::Tracer>();
+
+  otlp::ExporterSettings settings;
+  settings.endpoint = config["endpoint"].As<std::string>();
+  settings.service_name = tracing::Tracer::GetTracer()->GetServiceName();
+  settings.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(settings.max_queue_size);
+  settings.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(settings.max_batch_size);
+  settings.max_batch_delay =
+      config["max-batch-delay"].As<std::chrono::milliseconds>(
+          settings.max_batch_delay);
+  settings.http_timeout = config["http-timeout"].As<std::chrono::milliseconds>(
+      settings.http_timeout);
+
+  auto& http_client =
+      context.FindComponent<components::HttpClient>().GetHttpClient();
+  exporter_ =
+      std::make_shared<otlp::Exporter>(http_client, std::move(settings));
+  exporter_->Start(engine::current_task::GetTaskProcessor());
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      "tracing.otlp", [this](utils::statistics::Writer& writer) {
+        writer = exporter_->GetStatistics();
+      });
+
+  impl::SetSpanExporter(exporter_);
+}
+
+OtlpExporterComponent::~OtlpExporterComponent() {
+  impl::SetSpanExporter(nullptr);
+  statistics_holder_.Unregister();
+  exporter_->Stop();
+}
+
+yaml_config::Schema OtlpExporterComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Component that sends finished spans to an OpenTelemetry collector
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: URL of the OTLP/HTTP traces receiver
+    max-queue-size:
+        type: integer
+        description: max amount of spans waiting for the send
+        defaultDescription: 65536
+        minimum: 1
+    max-batch-size:
+        type: integer
+        description: max amount of spans in a single request to the collector
+        defaultDescription: 512
+        minimum: 1
+    max-batch-delay:
+        type: string
+        description: max time to wait for the batch to fill up
+        defaultDescription: 100ms
+    http-timeout:
+        type: string
+        description: timeout of a single request to the collector
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -7,10 +7,12 @@
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <tracing/span_exporter.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
@@ -70,6 +72,40 @@ std::string GenerateSpanId() {
   return utils::encoding::ToHex(&random_value, 8);
 }
 
+// Collects a formatted log record instead of writing it
+class CapturingLogger final : public logging::impl::LoggerBase {
+ public:
+  explicit CapturingLogger(const logging::impl::LoggerBase& target)
+      : LoggerBase(target.GetFormat()), target_(target) {
+    SetLevel(logging::Level::kTrace);
+  }
+
+  void Log(logging::Level, std::string_view msg) override { text_.append(msg); }
+
+  void PrependCommonTags(logging::impl::TagWriter writer) const override {
+    target_.PrependCommonTags(writer);
+  }
+
+  std::string Extract() && { return std::move(text_); }
+
+ private:
+  const logging::impl::LoggerBase& target_;
+  std::string text_;
+};
+
+bool IsErrorTagValue(const logging::LogExtra::Value& value) {
+  return std::visit(
+      [](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          return !v.empty() && v != "false" && v != "0";
+        } else {
+          return v != 0;
+        }
+      },
+      value);
+}
+
 }  // namespace
 
 Span::Impl::Impl(std::string name, ReferenceType reference_type,
@@ -83,6 +119,7 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
                  utils::impl::SourceLocation source_location)
     : name_(std::move(name)),
       is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
+      is_local_root_(parent == nullptr),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
@@ -100,7 +137,20 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
 }
 
 Span::Impl::~Impl() {
+  auto* tail_sampler = tracer_ ? tracer_->GetTailSampler() : nullptr;
   if (!ShouldLog()) {
+    // Otherwise the buffered spans of the trace wait for the expiration
+    if (tail_sampler && is_local_root_) tail_sampler->DiscardTrace(trace_id_);
+    return;
+  }
+
+  if (tail_sampler) {
+    tail_sampler->OnSpanFinished(std::move(*this).CaptureForTailSampling());
+    return;
+  }
+
+  if (auto exporter = impl::GetSpanExporter()) {
+    exporter->Export(std::move(*this).ExtractRecord());
     return;
   }
 
@@ -110,6 +160,8 @@ Span::Impl::~Impl() {
                           source_location_};
     std::move(*this).PutIntoLogger(lh.GetTagWriterAfterText({}));
   }
+
+  LogOpenTracing();
 }
 
 void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
@@ -137,8 +189,42 @@ void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
     log_extra_inheritable_.Extend(std::move(*log_extra_local_));
   }
   writer.PutLogExtra(log_extra_inheritable_);
+}
 
-  LogOpenTracing();
+impl::FinishedSpan Span::Impl::CaptureForTailSampling() && {
+  impl::FinishedSpan span;
+  span.trace_id = trace_id_;
+  span.is_local_root = is_local_root_;
+  span.is_error = HasErrorTag();
+  span.duration = std::chrono::steady_clock::now() - start_steady_time_;
+
+  if (impl::GetSpanExporter()) {
+    span.record = std::move(*this).ExtractRecord();
+    return span;
+  }
+
+  const DetachLocalSpansScope ignore_local_span;
+  {
+    CapturingLogger capture{logging::GetDefaultLogger()};
+    {
+      logging::LogHelper lh{capture, log_level_, source_location_};
+      std::move(*this).PutIntoLogger(lh.GetTagWriterAfterText({}));
+    }
+    span.logs.push_back({nullptr, log_level_, std::move(capture).Extract()});
+  }
+
+  auto opentracing_logger = tracer_ ? tracer_->GetOptionalLogger() : nullptr;
+  if (opentracing_logger) {
+    CapturingLogger capture{*opentracing_logger};
+    {
+      logging::LogHelper lh{capture, log_level_};
+      DoLogOpenTracing(lh.GetTagWriterAfterText({}));
+    }
+    span.logs.push_back({std::move(opentracing_logger), log_level_,
+                         std::move(capture).Extract()});
+  }
+
+  return span;
 }
 
 void Span::Impl::LogTo(logging::impl::TagWriter writer) {
@@ -189,6 +275,16 @@ bool Span::Impl::ShouldLog() const {
          local_log_level_.value_or(logging::Level::kTrace) <= log_level_;
 }
 
+bool Span::Impl::HasErrorTag() const {
+  if (log_extra_local_) {
+    if (const auto* error = log_extra_local_->Find(kErrorFlag)) {
+      return IsErrorTagValue(error->second.GetValue());
+    }
+  }
+  const auto* error = log_extra_inheritable_.Find(kErrorFlag);
+  return error && IsErrorTagValue(error->second.GetValue());
+}
+
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
   if (do_delete) {
     std::default_delete<Impl>{}(impl);
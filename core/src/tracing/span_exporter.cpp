@@ -0,0 +1,37 @@
+#include <tracing/span_exporter.hpp>
+
+#include <atomic>
+
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+std::atomic<bool> has_exporter{false};
+
+auto& GlobalExporter() {
+  static rcu::Variable<SpanExporterPtr> exporter{};
+  return exporter;
+}
+
+}  // namespace
+
+SpanExporterBase::~SpanExporterBase() = default;
+
+void SetSpanExporter(SpanExporterPtr exporter) {
+  const bool enabled = static_cast<bool>(exporter);
+  GlobalExporter().Assign(std::move(exporter));
+  has_exporter.store(enabled, std::memory_order_release);
+}
+
+SpanExporterPtr GetSpanExporter() noexcept {
+  if (!has_exporter.load(std::memory_order_acquire)) return {};
+  return GlobalExporter().ReadCopy();
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include <tracing/span_record.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// @brief Receives finished spans instead of the default logger.
+///
+/// Export() is called from the destructor of a span, possibly from a
+/// non-coroutine thread, so it must not block.
+class SpanExporterBase {
+ public:
+  virtual ~SpanExporterBase();
+
+  virtual void Export(SpanRecord&& record) noexcept = 0;
+};
+
+using SpanExporterPtr = std::shared_ptr<SpanExporterBase>;
+
+/// Installs the global exporter. Pass nullptr to go back to span logging.
+void SetSpanExporter(SpanExporterPtr exporter);
+
+/// Returns the global exporter or nullptr, cheap if there is no exporter.
+SpanExporterPtr GetSpanExporter() noexcept;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
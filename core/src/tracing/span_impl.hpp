@@ -18,6 +18,8 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/impl/source_location.hpp>
 
+#include <tracing/span_record.hpp>
+#include <tracing/tail_sampler.hpp>
 #include <tracing/time_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -51,6 +53,12 @@ class Span::Impl
   // Log this Span specifically
   void PutIntoLogger(logging::impl::TagWriter writer) &&;
 
+  // Move the data of this Span out for a SpanExporterBase
+  impl::SpanRecord ExtractRecord() &&;
+
+  // Format this Span without writing it for the impl::TailSampler
+  impl::FinishedSpan CaptureForTailSampling() &&;
+
   // Add the context of this Span a non-Span-specific log record
   void LogTo(logging::impl::TagWriter writer);
 
@@ -79,9 +87,11 @@ class Span::Impl
 
   static std::string GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
+  bool HasErrorTag() const;
 
   const std::string name_;
   const bool is_no_log_span_;
+  const bool is_local_root_;
   logging::Level log_level_;
   std::optional<logging::Level> local_log_level_;
 
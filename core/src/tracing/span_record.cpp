@@ -0,0 +1,40 @@
+#include "span_impl.hpp"
+
+#include <boost/container/small_vector.hpp>
+
+#include <tracing/span_record.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+impl::SpanRecord Span::Impl::ExtractRecord() && {
+  const auto duration = std::chrono::steady_clock::now() - start_steady_time_;
+
+  impl::SpanRecord record;
+  record.name = name_;
+  record.trace_id = std::move(trace_id_);
+  record.span_id = std::move(span_id_);
+  record.parent_id = std::move(parent_id_);
+  record.start_time = start_system_time_;
+  record.end_time =
+      start_system_time_ +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(duration);
+  record.log_level = log_level_;
+  record.reference_type = reference_type_;
+  record.is_error = HasErrorTag();
+
+  if (log_extra_local_) {
+    log_extra_inheritable_.Extend(std::move(*log_extra_local_));
+  }
+  record.tags.reserve(log_extra_inheritable_.extra_->size());
+  for (auto& [key, value] : *log_extra_inheritable_.extra_) {
+    record.tags.emplace_back(std::move(key), std::move(value.GetValue()));
+  }
+
+  return record;
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <userver/logging/level.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// A finished span detached from the coroutine span stack, ready to be handed
+/// over to a SpanExporterBase.
+struct SpanRecord final {
+  std::string name;
+  std::string trace_id;
+  std::string span_id;
+  std::string parent_id;
+
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::system_clock::time_point end_time;
+
+  logging::Level log_level{logging::Level::kInfo};
+  ReferenceType reference_type{ReferenceType::kChild};
+  bool is_error{false};
+
+  std::vector<logging::LogExtra::Pair> tags;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,237 @@
+#include <tracing/tail_sampler.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <tracing/span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+constexpr std::size_t kSamplingResolution = 1'000'000;
+
+// Rough estimate of the per-tag overhead of a SpanRecord
+constexpr std::size_t kTagOverhead = 64;
+
+// FNV-1a, unlike std::hash it is the same for all the processes and builds
+std::uint64_t HashTraceId(std::string_view trace_id) noexcept {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const char c : trace_id) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::size_t FinishedSpan::GetApproximateSize() const noexcept {
+  std::size_t size = sizeof(FinishedSpan) + trace_id.size();
+  for (const auto& log : logs) {
+    size += sizeof(CapturedLog) + log.text.size();
+  }
+  if (record) {
+    size += record->name.size() + record->trace_id.size() +
+            record->span_id.size() + record->parent_id.size();
+    for (const auto& [key, value] : record->tags) {
+      size += kTagOverhead + key.size();
+      if (const auto* str = std::get_if<std::string>(&value)) {
+        size += str->size();
+      }
+    }
+  }
+  return size;
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const TailSamplerStatistics& stats) {
+  if (auto traces = writer["traces"]) {
+    traces["kept"] = stats.traces_kept;
+    traces["discarded"] = stats.traces_discarded;
+    traces["expired"] = stats.traces_expired;
+  }
+  writer["spans"]["overflow"] = stats.spans_overflow;
+  writer["buffered_bytes"] = stats.buffered_bytes.load();
+}
+
+TailSampler::TailSampler(TailSamplingSettings settings)
+    : settings_(settings) {}
+
+TailSampler::~TailSampler() = default;
+
+void TailSampler::OnSpanFinished(FinishedSpan&& span) {
+  auto& shard = GetShard(span.trace_id);
+  if (span.is_local_root) {
+    FinishTrace(shard, std::move(span));
+  } else {
+    BufferSpan(shard, std::move(span));
+  }
+}
+
+TailSampler::Shard& TailSampler::GetShard(
+    const std::string& trace_id) noexcept {
+  return shards_[std::hash<std::string>{}(trace_id) % kShardsCount];
+}
+
+void TailSampler::BufferSpan(Shard& shard, FinishedSpan&& span) {
+  const auto now = std::chrono::steady_clock::now();
+  const auto size = span.GetApproximateSize();
+
+  std::unique_lock lock{shard.mutex};
+  ExpireTraces(shard, now);
+
+  const auto verdict_it = shard.verdicts.find(span.trace_id);
+  if (verdict_it != shard.verdicts.end()) {
+    const bool keep = verdict_it->second;
+    lock.unlock();
+    if (keep) Emit(std::move(span));
+    return;
+  }
+
+  auto it = shard.traces.find(span.trace_id);
+  if (it != shard.traces.end()) {
+    it->second.has_error |= span.is_error;
+    if (it->second.spans.size() >= settings_.max_spans_per_trace) {
+      ++stats_.spans_overflow;
+      return;
+    }
+  }
+
+  // Nothing is added to the shard for a span that does not fit
+  if (!TryReserveBytes(size)) {
+    ++stats_.spans_overflow;
+    return;
+  }
+
+  if (it == shard.traces.end()) {
+    it = shard.traces.try_emplace(span.trace_id).first;
+    it->second.created = now;
+    it->second.has_error = span.is_error;
+    shard.traces_by_age.emplace_back(now, span.trace_id);
+  }
+  it->second.bytes += size;
+  it->second.spans.push_back(std::move(span));
+}
+
+void TailSampler::DiscardTrace(const std::string& trace_id) {
+  auto& shard = GetShard(trace_id);
+  {
+    const std::lock_guard lock{shard.mutex};
+    const auto it = shard.traces.find(trace_id);
+    if (it == shard.traces.end()) return;
+
+    ReleaseBytes(it->second.bytes);
+    shard.traces.erase(it);
+    RememberVerdict(shard, trace_id, false);
+  }
+  ++stats_.traces_discarded;
+}
+
+void TailSampler::FinishTrace(Shard& shard, FinishedSpan&& root) {
+  std::vector<FinishedSpan> spans;
+  bool keep = root.is_error || root.duration >= settings_.slow_threshold ||
+              IsSampledByRate(root.trace_id);
+
+  {
+    const std::lock_guard lock{shard.mutex};
+    const auto it = shard.traces.find(root.trace_id);
+    if (it != shard.traces.end()) {
+      keep |= it->second.has_error;
+      spans = std::move(it->second.spans);
+      ReleaseBytes(it->second.bytes);
+      shard.traces.erase(it);
+    }
+
+    // Another local root of the same trace may have been kept already
+    const auto verdict_it = shard.verdicts.find(root.trace_id);
+    if (verdict_it != shard.verdicts.end()) keep |= verdict_it->second;
+
+    RememberVerdict(shard, root.trace_id, keep);
+  }
+
+  if (!keep) {
+    ++stats_.traces_discarded;
+    return;
+  }
+
+  ++stats_.traces_kept;
+  for (auto& span : spans) Emit(std::move(span));
+  Emit(std::move(root));
+}
+
+void TailSampler::ExpireTraces(Shard& shard, TimePoint now) {
+  while (!shard.traces_by_age.empty() &&
+         now - shard.traces_by_age.front().first > settings_.max_trace_age) {
+    const auto& [created, trace_id] = shard.traces_by_age.front();
+    const auto it = shard.traces.find(trace_id);
+    // The trace could have been finished and started again
+    if (it != shard.traces.end() && it->second.created == created) {
+      ReleaseBytes(it->second.bytes);
+      shard.traces.erase(it);
+      ++stats_.traces_expired;
+    }
+    shard.traces_by_age.pop_front();
+  }
+}
+
+void TailSampler::RememberVerdict(Shard& shard, const std::string& trace_id,
+                                  bool keep) {
+  const auto [it, inserted] = shard.verdicts.insert_or_assign(trace_id, keep);
+  if (!inserted) return;
+
+  shard.verdicts_order.push_back(trace_id);
+  if (shard.verdicts_order.size() > kMaxVerdictsPerShard) {
+    shard.verdicts.erase(shard.verdicts_order.front());
+    shard.verdicts_order.pop_front();
+  }
+}
+
+bool TailSampler::TryReserveBytes(std::size_t bytes) noexcept {
+  auto buffered = stats_.buffered_bytes.load(std::memory_order_relaxed);
+  do {
+    if (buffered + bytes > settings_.max_buffered_bytes) return false;
+  } while (!stats_.buffered_bytes.compare_exchange_weak(
+      buffered, buffered + bytes, std::memory_order_relaxed));
+  return true;
+}
+
+void TailSampler::ReleaseBytes(std::size_t bytes) noexcept {
+  stats_.buffered_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+bool TailSampler::IsSampledByRate(const std::string& trace_id) const noexcept {
+  if (settings_.sample_rate <= 0.0) return false;
+  // Hash of trace id, so that all the processes make the same decision
+  const auto bucket = HashTraceId(trace_id) % kSamplingResolution;
+  return bucket < settings_.sample_rate * kSamplingResolution;
+}
+
+void TailSampler::Emit(FinishedSpan&& span) noexcept {
+  if (span.record) {
+    if (auto exporter = GetSpanExporter()) {
+      exporter->Export(std::move(*span.record));
+    }
+    return;
+  }
+
+  for (const auto& log : span.logs) {
+    try {
+      auto& logger = log.logger ? *log.logger : logging::GetDefaultLogger();
+      logger.Log(log.level, log.text);
+    } catch (const std::exception&) {
+      // same as LogHelper, logging errors are not propagated
+    }
+  }
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
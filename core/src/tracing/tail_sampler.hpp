@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/logging/fwd.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+#include <tracing/span_record.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace tracing::impl {
+
+struct TailSamplingSettings final {
+  /// Traces with a local root span longer than this are always kept
+  std::chrono::milliseconds slow_threshold{1000};
+
+  /// Fraction of traces to keep regardless of their duration and errors
+  double sample_rate{0.0};
+
+  std::size_t max_spans_per_trace{1000};
+  std::size_t max_buffered_bytes{64 * 1024 * 1024};
+
+  /// Traces without a finished local root are discarded after this time
+  std::chrono::milliseconds max_trace_age{60'000};
+};
+
+/// A log record of a span that is not yet written into the logger
+struct CapturedLog final {
+  /// nullptr stands for the default logger
+  logging::LoggerPtr logger;
+  logging::Level level{logging::Level::kInfo};
+  std::string text;
+};
+
+struct FinishedSpan final {
+  std::size_t GetApproximateSize() const noexcept;
+
+  std::string trace_id;
+  bool is_local_root{false};
+  bool is_error{false};
+  std::chrono::steady_clock::duration duration{};
+
+  std::vector<CapturedLog> logs;
+  /// Set instead of logs if spans are sent into a SpanExporterBase
+  std::optional<SpanRecord> record;
+};
+
+struct TailSamplerStatistics final {
+  utils::statistics::RateCounter traces_kept{};
+  utils::statistics::RateCounter traces_discarded{};
+  utils::statistics::RateCounter traces_expired{};
+  utils::statistics::RateCounter spans_overflow{};
+  std::atomic<std::size_t> buffered_bytes{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const TailSamplerStatistics& stats);
+
+/// @brief Buffers finished spans of each trace in memory until the local root
+/// span of the trace finishes, then writes out the whole trace only if it was
+/// slow, had errors or was randomly sampled.
+///
+/// Spans that finish after their local root are written out or discarded
+/// according to the verdict made for the trace.
+class TailSampler final {
+ public:
+  explicit TailSampler(TailSamplingSettings settings);
+  ~TailSampler();
+
+  void OnSpanFinished(FinishedSpan&& span);
+
+  /// Discards the buffered spans of the trace whose local root span is not
+  /// logged, and the spans of the trace that finish later
+  void DiscardTrace(const std::string& trace_id);
+
+  const TailSamplerStatistics& GetStatistics() const noexcept {
+    return stats_;
+  }
+
+ private:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  struct TraceBuffer final {
+    std::vector<FinishedSpan> spans;
+    std::size_t bytes{0};
+    bool has_error{false};
+    TimePoint created;
+  };
+
+  struct Shard final {
+    std::mutex mutex;
+    std::unordered_map<std::string, TraceBuffer> traces;
+    std::deque<std::pair<TimePoint, std::string>> traces_by_age;
+    std::unordered_map<std::string, bool> verdicts;
+    std::deque<std::string> verdicts_order;
+  };
+
+  static constexpr std::size_t kShardsCount = 32;
+  static constexpr std::size_t kMaxVerdictsPerShard = 1024;
+
+  Shard& GetShard(const std::string& trace_id) noexcept;
+  void BufferSpan(Shard& shard, FinishedSpan&& span);
+  void FinishTrace(Shard& shard, FinishedSpan&& root);
+  void ExpireTraces(Shard& shard, TimePoint now);
+  void RememberVerdict(Shard& shard, const std::string& trace_id, bool keep);
+  bool TryReserveBytes(std::size_t bytes) noexcept;
+  void ReleaseBytes(std::size_t bytes) noexcept;
+  bool IsSampledByRate(const std::string& trace_id) const noexcept;
+
+  static void Emit(FinishedSpan&& span) noexcept;
+
+  const TailSamplingSettings settings_;
+  std::array<Shard, kShardsCount> shards_;
+  TailSamplerStatistics stats_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
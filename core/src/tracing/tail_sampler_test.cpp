@@ -0,0 +1,162 @@
+#include <tracing/tail_sampler.hpp>
+
+#include <logging/logging_test.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/utest/utest.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class TailSampling : public LoggingTest {
+ protected:
+  std::shared_ptr<tracing::impl::TailSampler> SetSampler(
+      tracing::impl::TailSamplingSettings settings) {
+    auto sampler = std::make_shared<tracing::impl::TailSampler>(settings);
+    auto tracer = tracing::MakeTracer("test-service", {});
+    tracer->SetTailSampler(sampler);
+    tracing::Tracer::SetTracer(std::move(tracer));
+    return sampler;
+  }
+
+  ~TailSampling() override {
+    tracing::Tracer::SetTracer(tracing::MakeTracer({}, {}));
+  }
+
+  bool LogContains(std::string_view str) {
+    logging::LogFlush();
+    return GetStreamString().find(str) != std::string::npos;
+  }
+};
+
+tracing::impl::TailSamplingSettings MakeSettings() {
+  tracing::impl::TailSamplingSettings settings;
+  settings.slow_threshold = 50ms;
+  return settings;
+}
+
+}  // namespace
+
+UTEST_F(TailSampling, FastTraceIsDiscarded) {
+  const auto sampler = SetSampler(MakeSettings());
+
+  {
+    tracing::Span root{"root_span"};
+    tracing::Span child{"child_span"};
+  }
+
+  EXPECT_FALSE(LogContains("root_span"));
+  EXPECT_FALSE(LogContains("child_span"));
+  EXPECT_EQ(sampler->GetStatistics().traces_discarded.Load().value, 1);
+  EXPECT_EQ(sampler->GetStatistics().buffered_bytes.load(), 0);
+}
+
+UTEST_F(TailSampling, SlowTraceIsKept) {
+  const auto sampler = SetSampler(MakeSettings());
+
+  {
+    tracing::Span root{"root_span"};
+    { tracing::Span child{"child_span"}; }
+    engine::SleepFor(60ms);
+  }
+
+  EXPECT_TRUE(LogContains("stopwatch_name=root_span"));
+  EXPECT_TRUE(LogContains("stopwatch_name=child_span"));
+  EXPECT_EQ(sampler->GetStatistics().traces_kept.Load().value, 1);
+}
+
+UTEST_F(TailSampling, TraceWithErrorIsKept) {
+  const auto sampler = SetSampler(MakeSettings());
+
+  {
+    tracing::Span root{"root_span"};
+    tracing::Span child{"child_span"};
+    child.AddNonInheritableTag(tracing::kErrorFlag, true);
+  }
+
+  EXPECT_TRUE(LogContains("stopwatch_name=root_span"));
+  EXPECT_TRUE(LogContains("stopwatch_name=child_span"));
+}
+
+UTEST_F(TailSampling, SampleRate) {
+  auto settings = MakeSettings();
+  settings.sample_rate = 1.0;
+  const auto sampler = SetSampler(settings);
+
+  { tracing::Span root{"root_span"}; }
+
+  EXPECT_TRUE(LogContains("stopwatch_name=root_span"));
+}
+
+UTEST_F(TailSampling, LateSpansFollowVerdict) {
+  const auto sampler = SetSampler(MakeSettings());
+
+  std::optional<tracing::Span> root{std::in_place, "root_span"};
+  std::optional<tracing::Span> late_child{root->CreateChild("late_child")};
+  root.reset();
+  EXPECT_EQ(sampler->GetStatistics().traces_discarded.Load().value, 1);
+
+  late_child.reset();
+  EXPECT_FALSE(LogContains("late_child"));
+  EXPECT_EQ(sampler->GetStatistics().buffered_bytes.load(), 0);
+}
+
+UTEST_F(TailSampling, MaxSpansPerTrace) {
+  auto settings = MakeSettings();
+  settings.max_spans_per_trace = 2;
+  const auto sampler = SetSampler(settings);
+
+  {
+    tracing::Span root{"root_span"};
+    for (int i = 0; i < 5; ++i) {
+      tracing::Span child{"child_span"};
+    }
+    engine::SleepFor(60ms);
+  }
+
+  EXPECT_EQ(sampler->GetStatistics().spans_overflow.Load().value, 3);
+  EXPECT_EQ(sampler->GetStatistics().traces_kept.Load().value, 1);
+
+  logging::LogFlush();
+  EXPECT_EQ(GetRecordsCount(), 3);
+}
+
+UTEST_F(TailSampling, MaxBufferedBytes) {
+  auto settings = MakeSettings();
+  settings.max_buffered_bytes = 1;
+  const auto sampler = SetSampler(settings);
+
+  {
+    tracing::Span root{"root_span"};
+    { tracing::Span child{"child_span"}; }
+    EXPECT_EQ(sampler->GetStatistics().buffered_bytes.load(), 0);
+    engine::SleepFor(60ms);
+  }
+
+  EXPECT_EQ(sampler->GetStatistics().spans_overflow.Load().value, 1);
+  EXPECT_EQ(sampler->GetStatistics().traces_kept.Load().value, 1);
+  EXPECT_TRUE(LogContains("stopwatch_name=root_span"));
+  EXPECT_FALSE(LogContains("child_span"));
+}
+
+UTEST_F(TailSampling, NotLoggedRootDiscardsTrace) {
+  const auto sampler = SetSampler(MakeSettings());
+
+  {
+    tracing::Span root{"root_span"};
+    { tracing::Span child{"child_span"}; }
+    EXPECT_GT(sampler->GetStatistics().buffered_bytes.load(), 0);
+    root.SetLocalLogLevel(logging::Level::kNone);
+  }
+
+  EXPECT_EQ(sampler->GetStatistics().traces_discarded.Load().value, 1);
+  EXPECT_EQ(sampler->GetStatistics().buffered_bytes.load(), 0);
+  EXPECT_FALSE(LogContains("child_span"));
+}
+
+USERVER_NAMESPACE_END
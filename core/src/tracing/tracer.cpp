@@ -8,6 +8,7 @@
 
 #include <tracing/no_log_spans.hpp>
 #include <tracing/span_impl.hpp>
+#include <tracing/tail_sampler.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -99,6 +100,10 @@ const std::string& Tracer::GetServiceName() const {
   return service_name_;
 }
 
+void Tracer::SetTailSampler(std::shared_ptr<impl::TailSampler> tail_sampler) {
+  tail_sampler_ = std::move(tail_sampler);
+}
+
 Span Tracer::CreateSpanWithoutParent(std::string name) {
   auto span =
       Span(shared_from_this(), std::move(name), nullptr, ReferenceType::kChild);
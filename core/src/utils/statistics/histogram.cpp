@@ -108,7 +108,8 @@ void Histogram::UpdateBounds() {
 
 Histogram::Histogram(utils::span<const double> upper_bounds)
     : buckets_(
-          std::make_unique<impl::histogram::Bucket[]>(upper_bounds.size() + 1)),
+          std::make_unique<impl::histogram::Bucket[]>(
+              impl::histogram::GetBucketArraySize(upper_bounds.size()))),
       bucket_count_(upper_bounds.size()) {
   impl::histogram::CopyBounds(buckets_.get(), upper_bounds);
   UpdateBounds();
@@ -116,7 +117,7 @@ Histogram::Histogram(utils::span<const double> upper_bounds)
 
 Histogram::Histogram(HistogramView other)
     : buckets_(std::make_unique<impl::histogram::Bucket[]>(
-          other.GetBucketCount() + 1)),
+          impl::histogram::GetBucketArraySize(other.GetBucketCount()))),
       bucket_count_(other.GetBucketCount()) {
   impl::histogram::CopyBoundsAndValues(buckets_.get(), other);
   UpdateBounds();
@@ -154,6 +155,9 @@ void Histogram::Account(double value, std::uint64_t count) noexcept {
       pre_bucket_index + 1 > bucket_count_ ? 0 : pre_bucket_index + 1;
   auto& bucket = buckets_[bucket_index];
   bucket.counter.fetch_add(count, std::memory_order_relaxed);
+  // The sum is the last bucket, see impl::histogram::Bucket
+  impl::histogram::AddToSumAtomic(buckets_[bucket_count_ + 1].counter,
+                                  value * static_cast<double>(count));
 }
 
 void ResetMetric(Histogram& histogram) noexcept {
@@ -9,8 +9,8 @@ USERVER_NAMESPACE_BEGIN
 namespace utils::statistics {
 
 HistogramAggregator::HistogramAggregator(utils::span<const double> upper_bounds)
-    : buckets_(std::make_unique<impl::histogram::Bucket[]>(upper_bounds.size() +
-                                                           1)) {
+    : buckets_(std::make_unique<impl::histogram::Bucket[]>(
+          impl::histogram::GetBucketArraySize(upper_bounds.size()))) {
   impl::histogram::CopyBounds(buckets_.get(), upper_bounds);
 }
 
@@ -32,6 +32,10 @@ HistogramView HistogramAggregator::GetView() const& noexcept {
   return impl::histogram::MakeView(buckets_.get());
 }
 
+void DumpMetric(Writer& writer, const HistogramAggregator& histogram) {
+  writer = histogram.GetView();
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
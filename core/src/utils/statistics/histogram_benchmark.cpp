@@ -1,4 +1,5 @@
 #include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 
 #include <benchmark/benchmark.h>
 #include <boost/range/irange.hpp>
@@ -35,4 +36,52 @@ void HistogramAccount(benchmark::State& state) {
 // poorly (fixed).
 BENCHMARK(HistogramAccount)->DenseRange(10, 50, 10);
 
+namespace {
+
+constexpr std::size_t kMaxThreads = 32;
+
+auto MakeValues(double max_value) {
+  auto values = std::vector<double>(1024);
+  for (auto& value : values) {
+    value = utils::RandRange(0.0, max_value);
+  }
+  return Launder(std::move(values));
+}
+
+}  // namespace
+
+// All the threads account into a single histogram.
+void HistogramAccountContended(benchmark::State& state) {
+  static utils::statistics::Histogram histogram{
+      utils::AsContainer<std::vector<double>>(
+          boost::irange(std::int64_t{1}, std::int64_t{21}))};
+  const auto values = MakeValues(21.0);
+
+  while (state.KeepRunningBatch(values.size())) {
+    for (const auto value : values) {
+      histogram.Account(value);
+    }
+  }
+}
+BENCHMARK(HistogramAccountContended)->ThreadRange(1, kMaxThreads);
+
+void LogLinearHistogramAccount(benchmark::State& state) {
+  static utils::statistics::LogLinearHistogram histogram{[] {
+    utils::statistics::LogLinearHistogramSettings settings;
+    settings.lowest_bound = 1;
+    settings.highest_bound = 1000;
+    settings.relative_precision = 0.01;
+    settings.shards = kMaxThreads;
+    return settings;
+  }()};
+  const auto values = MakeValues(1001.0);
+
+  while (state.KeepRunningBatch(values.size())) {
+    for (const auto value : values) {
+      histogram.Account(value);
+    }
+  }
+}
+BENCHMARK(LogLinearHistogramAccount)->ThreadRange(1, kMaxThreads);
+
 USERVER_NAMESPACE_END
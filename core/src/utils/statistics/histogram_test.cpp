@@ -49,6 +49,8 @@ UTEST(StatisticsHistogram, Account) {
   EXPECT_EQ(view.GetValueAt(2), 5);
   EXPECT_EQ(view.GetUpperBoundAt(3), 60);
   EXPECT_EQ(view.GetValueAt(3), 0);
+
+  EXPECT_EQ(view.GetSum(), 233);
 }
 
 UTEST(StatisticsHistogram, ValueOnBucketBorder) {
@@ -290,18 +292,28 @@ UTEST_F(StatisticsHistogramFormat, PrettyFormat) {
             "test:\tHIST_RATE\t[1.5]=1,[5]=1,[42]=5,[60]=0,[inf]=1\n");
 }
 
-// TODO support HistogramView in Prometheus metrics
-UTEST_F_DEATH(StatisticsHistogramFormatDeathTest, Prometheus) {
-  EXPECT_DEBUG_DEATH(
-      EXPECT_EQ(utils::statistics::ToPrometheusFormat(GetStorage()), ""),
-      "not supported");
+UTEST_F(StatisticsHistogramFormat, PrometheusFormat) {
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(GetStorage()),
+            "# TYPE test histogram\n"
+            "test_bucket{le=\"1.5\"} 1\n"
+            "test_bucket{le=\"5\"} 2\n"
+            "test_bucket{le=\"42\"} 7\n"
+            "test_bucket{le=\"60\"} 7\n"
+            "test_bucket{le=\"+Inf\"} 8\n"
+            "test_sum 233\n"
+            "test_count 8\n");
 }
 
-// TODO support HistogramView in PrometheusUntyped metrics
-UTEST_F_DEATH(StatisticsHistogramFormatDeathTest, PrometheusUntyped) {
-  EXPECT_DEBUG_DEATH(
-      EXPECT_EQ(utils::statistics::ToPrometheusFormatUntyped(GetStorage()), ""),
-      "not supported");
+UTEST_F(StatisticsHistogramFormat, PrometheusUntypedFormat) {
+  EXPECT_EQ(utils::statistics::ToPrometheusFormatUntyped(GetStorage()),
+            "# TYPE test histogram\n"
+            "test_bucket{le=\"1.5\"} 1\n"
+            "test_bucket{le=\"5\"} 2\n"
+            "test_bucket{le=\"42\"} 7\n"
+            "test_bucket{le=\"60\"} 7\n"
+            "test_bucket{le=\"+Inf\"} 8\n"
+            "test_sum 233\n"
+            "test_count 8\n");
 }
 
 // TODO support HistogramView in Graphite metrics
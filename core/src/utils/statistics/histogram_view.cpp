@@ -43,6 +43,12 @@ std::uint64_t HistogramView::GetValueAtInf() const noexcept {
   return buckets_[0].counter.load(std::memory_order_relaxed);
 }
 
+double HistogramView::GetSum() const noexcept {
+  UASSERT(buckets_);
+  return impl::histogram::SumFromBits(
+      impl::histogram::Access::Sum(*this).load(std::memory_order_relaxed));
+}
+
 void DumpMetric(Writer& writer, HistogramView histogram) { writer = histogram; }
 
 bool operator==(HistogramView lhs, HistogramView rhs) noexcept {
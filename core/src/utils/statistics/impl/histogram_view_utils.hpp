@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/copy.hpp>
@@ -38,6 +39,13 @@ struct Access final {
     return Buckets(view) | boost::adaptors::transformed(bound_ref_getter);
   }
 
+  // Bits of the double sum of the values, see Bucket
+  template <typename AnyHistogramView>
+  static auto& Sum(AnyHistogramView view) noexcept {
+    const auto size = HistogramView{view}.GetBucketCount();
+    return view.buckets_[size + 1].counter;
+  }
+
   template <typename AnyHistogramView>
   static auto Values(AnyHistogramView view) noexcept {
     return Buckets(view) | boost::adaptors::transformed([&](auto&& bucket) {
@@ -50,6 +58,30 @@ inline void AddNonAtomic(std::atomic<std::uint64_t>& to, std::uint64_t x) {
   to.store(to.load(std::memory_order_relaxed) + x, std::memory_order_relaxed);
 }
 
+inline double SumFromBits(std::uint64_t bits) noexcept {
+  double sum{};
+  std::memcpy(&sum, &bits, sizeof(sum));
+  return sum;
+}
+
+inline std::uint64_t SumToBits(double sum) noexcept {
+  std::uint64_t bits{};
+  std::memcpy(&bits, &sum, sizeof(bits));
+  return bits;
+}
+
+inline void AddToSumNonAtomic(std::atomic<std::uint64_t>& to, double x) {
+  to.store(SumToBits(SumFromBits(to.load(std::memory_order_relaxed)) + x),
+           std::memory_order_relaxed);
+}
+
+inline void AddToSumAtomic(std::atomic<std::uint64_t>& to, double x) noexcept {
+  auto bits = to.load(std::memory_order_relaxed);
+  while (!to.compare_exchange_weak(bits, SumToBits(SumFromBits(bits) + x),
+                                   std::memory_order_relaxed)) {
+  }
+}
+
 inline bool IsBoundPositive(double x) noexcept {
   return std::isnormal(x) && x > 0;
 }
@@ -98,6 +130,7 @@ class MutableView final {
     }
     buckets_[0].upper_bound.size = std::size(upper_bounds);
     boost::copy(upper_bounds, Access::Bounds(*this).begin());
+    Access::Sum(*this).store(SumToBits(0.0), std::memory_order_relaxed);
   }
 
   // Atomic for 'other', non-atomic for 'this'
@@ -105,6 +138,8 @@ class MutableView final {
     buckets_[0].upper_bound.size = other.GetBucketCount();
     buckets_[0].counter.store(other.GetValueAtInf(), std::memory_order_relaxed);
     boost::copy(Access::Buckets(other), Access::Buckets(*this).begin());
+    Access::Sum(*this).store(Access::Sum(other).load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
   }
 
   // Atomic
@@ -114,6 +149,7 @@ class MutableView final {
         boost::upper_bound(bounds_view, value, std::less_equal<>{});
     auto& bucket = (iter == bounds_view.end()) ? buckets_[0] : *iter.base();
     bucket.counter.fetch_add(count, std::memory_order_relaxed);
+    AddToSumAtomic(Access::Sum(*this), value * static_cast<double>(count));
   }
 
   // Atomic
@@ -122,6 +158,7 @@ class MutableView final {
     for (auto& bucket : Access::Buckets(*this)) {
       bucket.counter.store(0, std::memory_order_relaxed);
     }
+    Access::Sum(*this).store(SumToBits(0.0), std::memory_order_relaxed);
   }
 
   // Non-atomic
@@ -130,6 +167,7 @@ class MutableView final {
         boost::range::includes(Access::Bounds(other), Access::Bounds(*this)),
         "Buckets can be merged, but not added during Histogram conversion.");
     AddNonAtomic(buckets_[0].counter, other.GetValueAtInf());
+    AddToSumNonAtomic(Access::Sum(*this), other.GetSum());
     const auto self_bounds = Access::Bounds(*this);
     auto current_self_bound = self_bounds.begin();
     for (const auto& other_bucket : Access::Buckets(other)) {
@@ -0,0 +1,193 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/impl/histogram_bucket.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <concurrent/impl/thread_index.hpp>
+#include <utils/statistics/impl/histogram_view_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+constexpr double kMinRelativePrecision = 0.001;
+constexpr double kMaxRelativePrecision = 0.5;
+
+// IEEE 754 binary64 layout
+constexpr int kMantissaBits = 52;
+constexpr std::uint64_t kExponentBias = 1023;
+constexpr std::uint64_t kMantissaMask = (std::uint64_t{1} << kMantissaBits) - 1;
+
+constexpr std::size_t kCountersPerLine =
+    concurrent::impl::kDestructiveInterferenceSize /
+    sizeof(std::atomic<std::uint64_t>);
+
+}  // namespace
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize)
+    LogLinearHistogram::CounterLine final {
+  std::atomic<std::uint64_t> counters[kCountersPerLine]{};
+};
+
+LogLinearHistogram::LogLinearHistogram(
+    const LogLinearHistogramSettings& settings)
+    : lowest_bound_(settings.lowest_bound) {
+  UINVARIANT(impl::histogram::IsBoundPositive(settings.lowest_bound),
+             "LogLinearHistogram lowest bound must be positive");
+  UINVARIANT(std::isfinite(settings.highest_bound) &&
+                 settings.highest_bound >= settings.lowest_bound,
+             "LogLinearHistogram highest bound must be finite and not less "
+             "than the lowest bound");
+  UINVARIANT(settings.relative_precision >= kMinRelativePrecision &&
+                 settings.relative_precision <= kMaxRelativePrecision,
+             "LogLinearHistogram relative precision must be in [0.001, 0.5]");
+
+  precision_bits_ =
+      static_cast<int>(std::ceil(-std::log2(settings.relative_precision)));
+  const auto octave_buckets = std::size_t{1} << precision_bits_;
+
+  const auto bucket_count = GetBucketIndex(settings.highest_bound) + 1;
+  bounds_.reserve(bucket_count);
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    // The bucket with index e * 2^k + c ends at 2^e * (1 + c / 2^k)
+    const auto linear_part =
+        1.0 + static_cast<double>(i % octave_buckets) / octave_buckets;
+    bounds_.push_back(std::ldexp(lowest_bound_ * linear_part,
+                                 static_cast<int>(i / octave_buckets)));
+  }
+
+  const auto shards = concurrent::impl::RoundUpToPowerOf2(std::max(
+      settings.shards ? settings.shards : std::thread::hardware_concurrency(),
+      std::size_t{1}));
+  shard_mask_ = shards - 1;
+  // 0th counter of a shard is the "infinity" bucket and the last one is
+  // the sum, like in Histogram
+  const auto counters_per_shard =
+      impl::histogram::GetBucketArraySize(bounds_.size());
+  lines_per_shard_ =
+      (counters_per_shard + kCountersPerLine - 1) / kCountersPerLine;
+  lines_ = std::make_unique<CounterLine[]>(shards * lines_per_shard_);
+}
+
+LogLinearHistogram::LogLinearHistogram(LogLinearHistogram&&) noexcept =
+    default;
+
+LogLinearHistogram& LogLinearHistogram::operator=(
+    LogLinearHistogram&&) noexcept = default;
+
+LogLinearHistogram::~LogLinearHistogram() = default;
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void LogLinearHistogram::Account(double value, std::uint64_t count) noexcept {
+  UASSERT(lines_);
+  auto index = GetBucketIndex(value) + 1;
+  if (index > bounds_.size()) index = 0;
+
+  const auto shard = GetShardIndex();
+  GetCounter(shard, index).fetch_add(count, std::memory_order_relaxed);
+  impl::histogram::AddToSumAtomic(GetCounter(shard, bounds_.size() + 1),
+                                  value * static_cast<double>(count));
+}
+
+void ResetMetric(LogLinearHistogram& histogram) noexcept {
+  const auto lines_count =
+      (histogram.shard_mask_ + 1) * histogram.lines_per_shard_;
+  for (std::size_t i = 0; i < lines_count; ++i) {
+    for (auto& counter : histogram.lines_[i].counters) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+HistogramAggregator LogLinearHistogram::GetSnapshot() const {
+  UASSERT(lines_);
+  auto buckets = std::make_unique<impl::histogram::Bucket[]>(
+      impl::histogram::GetBucketArraySize(bounds_.size()));
+  impl::histogram::CopyBounds(buckets.get(), bounds_);
+  const auto sum_index = bounds_.size() + 1;
+  for (std::size_t shard = 0; shard <= shard_mask_; ++shard) {
+    for (std::size_t i = 0; i < sum_index; ++i) {
+      impl::histogram::AddNonAtomic(buckets[i].counter, LoadCounter(shard, i));
+    }
+    impl::histogram::AddToSumNonAtomic(
+        buckets[sum_index].counter,
+        impl::histogram::SumFromBits(LoadCounter(shard, sum_index)));
+  }
+
+  HistogramAggregator snapshot{bounds_};
+  snapshot.Add(impl::histogram::MakeView(buckets.get()));
+  return snapshot;
+}
+
+// Values in (2^e * (1 + (c - 1) / 2^k), 2^e * (1 + c / 2^k)] of lowest_bound_
+// go to the bucket e * 2^k + c. The exponent and the top k bits of the
+// mantissa of a double are exactly e and c - 1, up to the rounding.
+std::size_t LogLinearHistogram::GetBucketIndex(double value) const noexcept {
+  if (value <= lowest_bound_) return 0;
+
+  // NaN and infinities end up in the "infinity" bucket with a huge exponent
+  const double scaled = value / lowest_bound_;
+  std::uint64_t bits{};
+  std::memcpy(&bits, &scaled, sizeof(bits));
+
+  const auto exponent = (bits >> kMantissaBits) - kExponentBias;
+  const auto mantissa = bits & kMantissaMask;
+  const auto shift = kMantissaBits - precision_bits_;
+  const auto linear_part =
+      (mantissa >> shift) +
+      ((mantissa & ((std::uint64_t{1} << shift) - 1)) != 0 ? 1 : 0);
+  return (exponent << precision_bits_) + linear_part;
+}
+
+// Threads get sequential indexes, so up to 'shards' threads never share
+// a shard. A coroutine may migrate to another thread between the calls, which
+// only affects the contention, as the counters are atomic anyway.
+std::size_t LogLinearHistogram::GetShardIndex() const noexcept {
+  return concurrent::impl::GetCurrentThreadIndex() & shard_mask_;
+}
+
+std::atomic<std::uint64_t>& LogLinearHistogram::GetCounter(
+    std::size_t shard, std::size_t index) const noexcept {
+  auto& line = lines_[shard * lines_per_shard_ + index / kCountersPerLine];
+  return line.counters[index % kCountersPerLine];
+}
+
+std::uint64_t LogLinearHistogram::LoadCounter(
+    std::size_t shard, std::size_t index) const noexcept {
+  return GetCounter(shard, index).load(std::memory_order_relaxed);
+}
+
+void DumpMetric(Writer& writer, const LogLinearHistogram& histogram) {
+  const auto& bounds = histogram.GetBounds();
+  const auto lowest_bound = bounds.front();
+
+  // Octave bounds are lowest_bound * 2^e exactly, see the constructor
+  std::vector<double> octave_bounds;
+  for (const auto bound : bounds) {
+    int exponent = 0;
+    if (std::frexp(bound / lowest_bound, &exponent) == 0.5) {
+      octave_bounds.push_back(bound);
+    }
+  }
+  if (octave_bounds.back() != bounds.back()) {
+    octave_bounds.push_back(bounds.back());
+  }
+
+  const auto snapshot = histogram.GetSnapshot();
+  HistogramAggregator octaves{octave_bounds};
+  octaves.Add(snapshot.GetView());
+  writer = octaves.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,200 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+utils::statistics::LogLinearHistogramSettings QuarterSettings() {
+  utils::statistics::LogLinearHistogramSettings settings;
+  settings.lowest_bound = 1;
+  settings.highest_bound = 4;
+  settings.relative_precision = 0.25;
+  settings.shards = 4;
+  return settings;
+}
+
+std::uint64_t TotalCount(utils::statistics::HistogramView view) {
+  std::uint64_t total = view.GetValueAtInf();
+  for (std::size_t i = 0; i < view.GetBucketCount(); ++i) {
+    total += view.GetValueAt(i);
+  }
+  return total;
+}
+
+}  // namespace
+
+UTEST(StatisticsLogLinearHistogram, Bounds) {
+  const utils::statistics::LogLinearHistogram histogram{QuarterSettings()};
+  EXPECT_EQ(histogram.GetBounds(),
+            (std::vector<double>{1, 1.25, 1.5, 1.75, 2, 2.5, 3, 3.5, 4}));
+}
+
+UTEST(StatisticsLogLinearHistogram, Account) {
+  utils::statistics::LogLinearHistogram histogram{QuarterSettings()};
+  histogram.Account(0.5);
+  histogram.Account(1.1);
+  histogram.Account(1.25);  // falls into the lower bucket
+  histogram.Account(2.1, 3);
+  histogram.Account(3.9);
+  histogram.Account(4.1);
+  histogram.Account(100);
+
+  const auto snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(fmt::to_string(snapshot.GetView()),
+            "[1]=1,[1.25]=2,[1.5]=0,[1.75]=0,[2]=0,[2.5]=3,[3]=0,[3.5]=0,"
+            "[4]=1,[inf]=2");
+  EXPECT_DOUBLE_EQ(snapshot.GetView().GetSum(),
+                   0.5 + 1.1 + 1.25 + 2.1 * 3 + 3.9 + 4.1 + 100);
+}
+
+UTEST(StatisticsLogLinearHistogram, RelativePrecision) {
+  utils::statistics::LogLinearHistogramSettings settings;
+  settings.lowest_bound = 0.001;
+  settings.highest_bound = 1e6;
+  settings.relative_precision = 0.01;
+
+  const utils::statistics::LogLinearHistogram histogram{settings};
+  const auto& bounds = histogram.GetBounds();
+  ASSERT_GE(bounds.size(), 2);
+  EXPECT_EQ(bounds.front(), 0.001);
+  EXPECT_GE(bounds.back(), 1e6);
+  for (std::size_t i = 1; i < bounds.size(); ++i) {
+    EXPECT_LE(bounds[i] / bounds[i - 1], 1.01) << bounds[i];
+  }
+}
+
+UTEST(StatisticsLogLinearHistogram, Sample) {
+  /// [sample]
+  utils::statistics::Storage storage;
+
+  utils::statistics::LogLinearHistogramSettings settings;
+  settings.lowest_bound = 1;
+  settings.highest_bound = 1000;
+  settings.relative_precision = 0.1;
+  utils::statistics::LogLinearHistogram histogram{settings};
+
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  histogram.Account(10);
+  histogram.Account(0.5);
+  histogram.Account(10.2, 4);  // Account 4 times
+  histogram.Account(5000);
+
+  // The octave buckets are written
+  const utils::statistics::Snapshot snapshot{storage};
+  EXPECT_EQ(fmt::to_string(snapshot.SingleMetric("test")),
+            "[1]=1,[2]=0,[4]=0,[8]=0,[16]=5,[32]=0,[64]=0,[128]=0,[256]=0,"
+            "[512]=0,[1024]=0,[inf]=1");
+  /// [sample]
+}
+
+UTEST(StatisticsLogLinearHistogram, PrometheusFormat) {
+  utils::statistics::Storage storage;
+  utils::statistics::LogLinearHistogram histogram{QuarterSettings()};
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  histogram.Account(1.1);
+  histogram.Account(3, 2);
+  histogram.Account(10);
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "# TYPE test histogram\n"
+            "test_bucket{le=\"1\"} 0\n"
+            "test_bucket{le=\"2\"} 1\n"
+            "test_bucket{le=\"4\"} 3\n"
+            "test_bucket{le=\"+Inf\"} 4\n"
+            "test_sum 17.1\n"
+            "test_count 4\n");
+}
+
+UTEST(StatisticsLogLinearHistogram, StableDumpedBuckets) {
+  const utils::statistics::LogLinearHistogram histogram{QuarterSettings()};
+  utils::statistics::Storage storage;
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  // The buckets do not depend on the accounted values
+  const utils::statistics::Snapshot snapshot{storage};
+  EXPECT_EQ(fmt::to_string(snapshot.SingleMetric("test")),
+            "[1]=0,[2]=0,[4]=0,[inf]=0");
+}
+
+UTEST(StatisticsLogLinearHistogram, MergeSnapshots) {
+  utils::statistics::LogLinearHistogram first{QuarterSettings()};
+  utils::statistics::LogLinearHistogram second{QuarterSettings()};
+  first.Account(1.1);
+  first.Account(10);
+  second.Account(1.2, 2);
+  second.Account(3.5);
+
+  auto snapshot = first.GetSnapshot();
+  const auto second_snapshot = second.GetSnapshot();
+  snapshot.Add(second_snapshot.GetView());
+  EXPECT_EQ(fmt::to_string(snapshot.GetView()),
+            "[1]=0,[1.25]=3,[1.5]=0,[1.75]=0,[2]=0,[2.5]=0,[3]=0,[3.5]=1,"
+            "[4]=0,[inf]=1");
+}
+
+UTEST(StatisticsLogLinearHistogram, Reset) {
+  utils::statistics::LogLinearHistogram histogram{QuarterSettings()};
+  histogram.Account(1.1);
+  histogram.Account(10);
+  ResetMetric(histogram);
+  const auto snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(TotalCount(snapshot.GetView()), 0);
+  EXPECT_EQ(snapshot.GetView().GetSum(), 0);
+}
+
+UTEST_MT(StatisticsLogLinearHistogram, ConcurrentAccount, 4) {
+  constexpr std::size_t kTasks = 16;
+  constexpr std::size_t kIterations = 1000;
+  utils::statistics::LogLinearHistogram histogram{QuarterSettings()};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&histogram, i] {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        histogram.Account(static_cast<double>(i + j % 5));
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  const auto snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(TotalCount(snapshot.GetView()), kTasks * kIterations);
+}
+
+UTEST_DEATH(StatisticsLogLinearHistogramDeathTest, InvalidSettings) {
+  auto settings = QuarterSettings();
+  settings.lowest_bound = 0;
+  EXPECT_UINVARIANT_FAILURE_MSG(
+      utils::statistics::LogLinearHistogram{settings},
+      "LogLinearHistogram lowest bound must be positive");
+
+  settings = QuarterSettings();
+  settings.highest_bound = 0.5;
+  EXPECT_UINVARIANT_FAILURE_MSG(
+      utils::statistics::LogLinearHistogram{settings},
+      "LogLinearHistogram highest bound must be finite and not less than "
+      "the lowest bound");
+
+  settings = QuarterSettings();
+  settings.relative_precision = 0.0001;
+  EXPECT_UINVARIANT_FAILURE_MSG(
+      utils::statistics::LogLinearHistogram{settings},
+      "LogLinearHistogram relative precision must be in [0.001, 0.5]");
+}
+
+USERVER_NAMESPACE_END
@@ -2,11 +2,15 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/utils/assert.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
@@ -22,21 +26,77 @@ namespace {
 
 enum class Typed { kYes, kNo };
 
+// Output of a single cached writer, see Storage::RegisterCachedWriter
+struct CachedOutput final : public CachedFormatOutput {
+  std::string text;
+  // Metric path -> Prometheus name, for metrics with a '# TYPE' in `text`
+  utils::impl::TransparentMap<std::string, std::string> declared;
+  // Paths of the metrics that were declared before `text`
+  std::vector<std::string> used;
+};
+
 template <Typed IsTyped>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
  public:
   explicit FormatBuilder() = default;
 
+  std::string_view GetCachedFormatId() const noexcept override {
+    return IsTyped == Typed::kYes ? "prometheus" : "prometheus-untyped";
+  }
+
+  void BeginCachedOutput(const CachedFormatOutput* previous) override {
+    UASSERT(!recording_);
+    UASSERT(!previous || dynamic_cast<const CachedOutput*>(previous));
+    recording_ = std::make_shared<CachedOutput>();
+    recording_start_ = buf_.size();
+    previous_ = static_cast<const CachedOutput*>(previous);
+  }
+
+  std::shared_ptr<const CachedFormatOutput> EndCachedOutput() override {
+    UASSERT(recording_);
+    recording_->text.assign(buf_.data() + recording_start_,
+                            buf_.size() - recording_start_);
+
+    auto& used = recording_->used;
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+    used.erase(std::remove_if(used.begin(), used.end(),
+                              [this](const std::string& path) {
+                                return recording_->declared.count(path) != 0;
+                              }),
+               used.end());
+
+    previous_ = nullptr;
+    return std::move(recording_);
+  }
+
+  bool AppendCachedOutput(const CachedFormatOutput& output) override {
+    UASSERT(dynamic_cast<const CachedOutput*>(&output));
+    const auto& cached = static_cast<const CachedOutput&>(output);
+
+    // '# TYPE' lines must stay unique and precede the metrics
+    for (const auto& path : cached.used) {
+      if (!utils::impl::FindTransparentOrNullptr(metrics_, path)) return false;
+    }
+    for (const auto& [path, name] : cached.declared) {
+      if (utils::impl::FindTransparentOrNullptr(metrics_, path)) return false;
+    }
+
+    buf_.append(cached.text);
+    for (const auto& [path, name] : cached.declared) {
+      metrics_.emplace(path, name);
+    }
+    return true;
+  }
+
   void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
                     const MetricValue& value) override {
+    const auto prometheus_name = GetMetricNameAndDumpType(path, value);
     if (value.IsHistogram()) {
-      // TODO support histogram metrics using 'le', or better yet,
-      //  using Prometheus native histograms.
-      UASSERT_MSG(false,
-                  "Histogram metrics are not supported for Prometheus yet");
+      DumpHistogram(prometheus_name, labels, value.AsHistogram());
       return;
     }
-    DumpMetricNameAndType(path, value);
+    buf_.append(prometheus_name);
     DumpLabels(labels);
     fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
   }
@@ -44,17 +104,53 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
   std::string Release() { return fmt::to_string(buf_); }
 
  private:
-  void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
+  std::string_view GetMetricNameAndDumpType(std::string_view name,
+                                            const MetricValue& value) {
     if (const auto* const converted =
             utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-      buf_.append(*converted);
-      return;
+      if (recording_ &&
+          (recording_->used.empty() || recording_->used.back() != name)) {
+        recording_->used.emplace_back(name);
+      }
+      return *converted;
     }
 
-    auto prometheus_name = impl::ToPrometheusName(name);
+    const auto* const previous_name =
+        previous_ ? utils::impl::FindTransparentOrNullptr(previous_->declared,
+                                                          name)
+                  : nullptr;
+    auto prometheus_name =
+        previous_name ? *previous_name : impl::ToPrometheusName(name);
     DumpMetricType(prometheus_name, value);
-    buf_.append(prometheus_name);
-    metrics_.emplace(name, std::move(prometheus_name));
+    if (recording_) {
+      recording_->declared.emplace(name, prometheus_name);
+    }
+    return metrics_.emplace(name, std::move(prometheus_name)).first->second;
+  }
+
+  // Classic Prometheus histogram with cumulative 'le' buckets
+  void DumpHistogram(std::string_view prometheus_name,
+                     utils::statistics::LabelsSpan labels,
+                     HistogramView histogram) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < histogram.GetBucketCount(); ++i) {
+      total += histogram.GetValueAt(i);
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_bucket"),
+                     prometheus_name);
+      DumpLabels(labels, fmt::to_string(histogram.GetUpperBoundAt(i)));
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+    }
+    total += histogram.GetValueAtInf();
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_bucket"),
+                   prometheus_name);
+    DumpLabels(labels, "+Inf");
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n{}_sum"),
+                   total, prometheus_name);
+    if (!labels.empty()) DumpLabels(labels);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n{}_count"),
+                   histogram.GetSum(), prometheus_name);
+    if (!labels.empty()) DumpLabels(labels);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
   }
 
   void DumpMetricType([[maybe_unused]] std::string_view prometheus_name,
@@ -73,16 +169,14 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
         [](std::int64_t) -> std::string_view { return "gauge"; },
         [](double) -> std::string_view { return "gauge"; },
         [](Rate) -> std::string_view { return "counter"; },
-        [](HistogramView) -> std::string_view {
-          UINVARIANT(false,
-                     "Histogram metrics are not supported for Prometheus yet");
-        },
+        [](HistogramView) -> std::string_view { return "histogram"; },
     });
     fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("# TYPE {} {}\n"),
                    prometheus_name, type);
   }
 
-  void DumpLabels(utils::statistics::LabelsSpan labels) {
+  void DumpLabels(utils::statistics::LabelsSpan labels,
+                  std::optional<std::string_view> bucket_bound = {}) {
     buf_.push_back('{');
     bool sep = false;
     for (const auto& label : labels) {
@@ -97,11 +191,22 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
       buf_.push_back('"');
       sep = true;
     }
+    if (bucket_bound) {
+      if (sep) {
+        buf_.push_back(',');
+      }
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("le=\"{}\""),
+                     *bucket_bound);
+    }
     buf_.push_back('}');
   }
 
   fmt::memory_buffer buf_;
   utils::impl::TransparentMap<std::string, std::string> metrics_;
+
+  std::shared_ptr<CachedOutput> recording_;
+  std::size_t recording_start_{0};
+  const CachedOutput* previous_{nullptr};
 };
 
 }  // namespace
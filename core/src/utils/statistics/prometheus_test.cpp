@@ -409,6 +409,87 @@ child{application="processing"} 8
   }
 }
 
+UTEST(MetricsPrometheus, CachedWriter) {
+  utils::statistics::Storage statistics_storage;
+  std::size_t writer_calls = 0;
+  std::uint64_t generation = 1;
+  int value = 42;
+  auto statistics_holder = statistics_storage.RegisterCachedWriter(
+      "cached",
+      [&](utils::statistics::Writer& writer) {
+        ++writer_calls;
+        writer["value"] = value;
+      },
+      [&] { return generation; });
+
+  TestToMetricsPrometheus(statistics_storage,
+                          "# TYPE cached_value gauge\n"
+                          "cached_value{application=\"processing\"} 42\n");
+  EXPECT_EQ(writer_calls, 1);
+
+  // The writer is not called again while the generation is the same
+  value = 0;
+  TestToMetricsPrometheus(statistics_storage,
+                          "# TYPE cached_value gauge\n"
+                          "cached_value{application=\"processing\"} 42\n");
+  EXPECT_EQ(writer_calls, 1);
+
+  ++generation;
+  TestToMetricsPrometheus(statistics_storage,
+                          "# TYPE cached_value gauge\n"
+                          "cached_value{application=\"processing\"} 0\n");
+  EXPECT_EQ(writer_calls, 2);
+
+  // Requests for a part of the metrics are not cached
+  EXPECT_EQ(ToPrometheusFormat(
+                statistics_storage,
+                utils::statistics::Request::MakeWithPath("cached.value")),
+            "# TYPE cached_value gauge\ncached_value{} 0\n");
+  EXPECT_EQ(writer_calls, 3);
+}
+
+UTEST(MetricsPrometheus, CachedWriterSharedMetricName) {
+  constexpr std::string_view expected =
+      "# TYPE shared_value gauge\n"
+      "shared_value{application=\"processing\",instance=\"first\"} 1\n"
+      "shared_value{application=\"processing\",instance=\"second\"} 2\n";
+
+  utils::statistics::Storage statistics_storage;
+  bool first_enabled = true;
+  std::uint64_t generation = 1;
+  std::size_t writer_calls = 0;
+  auto first_holder = statistics_storage.RegisterWriter(
+      "shared",
+      [&](utils::statistics::Writer& writer) {
+        if (first_enabled) writer["value"] = 1;
+      },
+      {{"instance", "first"}});
+  auto second_holder = statistics_storage.RegisterCachedWriter(
+      "shared",
+      [&](utils::statistics::Writer& writer) {
+        ++writer_calls;
+        writer["value"] = 2;
+      },
+      [&] { return generation; }, {{"instance", "second"}});
+
+  TestToMetricsPrometheus(statistics_storage, expected);
+  TestToMetricsPrometheus(statistics_storage, expected);
+  EXPECT_EQ(writer_calls, 1);
+
+  // The cached output relies on the '# TYPE' line of the first writer
+  first_enabled = false;
+  TestToMetricsPrometheus(
+      statistics_storage,
+      "# TYPE shared_value gauge\n"
+      "shared_value{application=\"processing\",instance=\"second\"} 2\n");
+  EXPECT_EQ(writer_calls, 2);
+
+  // ... and now the first writer must not repeat the '# TYPE' line
+  first_enabled = true;
+  TestToMetricsPrometheus(statistics_storage, expected);
+  EXPECT_EQ(writer_calls, 3);
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
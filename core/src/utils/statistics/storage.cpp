@@ -4,9 +4,11 @@
 
 #include <boost/container/small_vector.hpp>
 
+#include <userver/engine/mutex.hpp>
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/text_light.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
 
@@ -18,6 +20,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics {
 
+namespace impl {
+
+// Outputs of a cached writer in different formats
+struct WriterCache final {
+  struct FormatEntry final {
+    std::uint64_t generation{0};
+    Request::AddLabels add_labels;
+    std::shared_ptr<const CachedFormatOutput> output;
+  };
+
+  engine::Mutex mutex;
+  utils::impl::TransparentMap<std::string, FormatEntry> formats;
+};
+
+}  // namespace impl
+
 namespace {
 
 const std::string kVersionField = "$version";
@@ -92,8 +110,24 @@ Request::Request(std::string prefix_in, PrefixMatch path_match_type_in,
       require_labels(std::move(require_labels_in)),
       add_labels(std::move(add_labels_in)) {}
 
+CachedFormatOutput::~CachedFormatOutput() = default;
+
 BaseFormatBuilder::~BaseFormatBuilder() = default;
 
+std::string_view BaseFormatBuilder::GetCachedFormatId() const noexcept {
+  return {};
+}
+
+void BaseFormatBuilder::BeginCachedOutput(const CachedFormatOutput*) {}
+
+std::shared_ptr<const CachedFormatOutput> BaseFormatBuilder::EndCachedOutput() {
+  return nullptr;
+}
+
+bool BaseFormatBuilder::AppendCachedOutput(const CachedFormatOutput&) {
+  return false;
+}
+
 Storage::Storage() : may_register_extenders_(true) {}
 
 formats::json::Value Storage::GetAsJson() const {
@@ -123,7 +157,12 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
       state.add_labels.emplace_back(name, value);
     }
 
-    boost::container::small_vector<LabelView, 16> labels_vector;
+    // Cached outputs are only valid for the full set of metrics
+    const auto cached_format_id =
+        (request.prefix_match_type == Request::PrefixMatch::kNoop &&
+         request.require_labels.empty())
+            ? out.GetCachedFormatId()
+            : std::string_view{};
 
     std::shared_lock lock(mutex_);
     for (const auto& entry : metrics_sources_) {
@@ -131,32 +170,81 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
         continue;
       }
 
-      labels_vector.clear();
-      labels_vector.reserve(entry.writer_labels.size());
-      for (const auto& l : entry.writer_labels) {
-        labels_vector.emplace_back(l);
+      if (entry.generation && !cached_format_id.empty()) {
+        VisitCachedWriter(entry, state, cached_format_id);
+      } else {
+        VisitWriter(entry, state);
       }
+    }
+  }
+
+  statistics::VisitMetrics(out, GetAsJson(), request);
+}
+
+bool Storage::VisitWriter(const impl::MetricsSource& entry,
+                          impl::WriterState& state) {
+  boost::container::small_vector<LabelView, 16> labels_vector;
+  labels_vector.reserve(entry.writer_labels.size());
+  for (const auto& l : entry.writer_labels) {
+    labels_vector.emplace_back(l);
+  }
+
+  try {
+    auto writer =
+        (entry.prefix_path.empty()
+             ? Writer{state, LabelsSpan{labels_vector}}
+             : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
+    if (writer) {
+      LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
+      entry.writer(writer);
+    }
+    return true;
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false,
+                fmt::format("Failed to write metrics for prefix '{}': {}",
+                            entry.prefix_path, e.what()));
+    LOG_ERROR() << "Failed to write metrics for prefix '" << entry.prefix_path
+                << "': " << e;
+    return false;
+  }
+}
 
-      try {
-        auto writer =
-            (entry.prefix_path.empty()
-                 ? Writer{state, LabelsSpan{labels_vector}}
-                 : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
-        if (writer) {
-          LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
-          entry.writer(writer);
-        }
-      } catch (const std::exception& e) {
-        UASSERT_MSG(false,
-                    fmt::format("Failed to write metrics for prefix '{}': {}",
-                                entry.prefix_path, e.what()));
-        LOG_ERROR() << "Failed to write metrics for prefix '"
-                    << entry.prefix_path << "': " << e;
+void Storage::VisitCachedWriter(const impl::MetricsSource& entry,
+                                impl::WriterState& state,
+                                std::string_view format_id) {
+  UASSERT(entry.cache);
+  auto& cache = *entry.cache;
+  const auto generation = entry.generation();
+
+  std::shared_ptr<const CachedFormatOutput> previous;
+  {
+    std::lock_guard cache_lock(cache.mutex);
+    const auto* const cached =
+        utils::impl::FindTransparentOrNullptr(cache.formats, format_id);
+    if (cached && cached->add_labels == state.request.add_labels) {
+      // An outdated output is still useful for its rendered names
+      previous = cached->output;
+      if (cached->generation == generation && previous &&
+          state.builder.AppendCachedOutput(*previous)) {
+        return;
       }
     }
   }
 
-  statistics::VisitMetrics(out, GetAsJson(), request);
+  state.builder.BeginCachedOutput(previous.get());
+  const bool is_complete = VisitWriter(entry, state);
+  auto output = state.builder.EndCachedOutput();
+
+  std::lock_guard cache_lock(cache.mutex);
+  if (!is_complete) {
+    // Do not reuse a partial output, call the writer again next time
+    cache.formats.erase(std::string{format_id});
+    return;
+  }
+  auto& cached = cache.formats[std::string{format_id}];
+  cached.generation = generation;
+  cached.add_labels = state.request.add_labels;
+  cached.output = std::move(output);
 }
 
 void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
@@ -164,13 +252,24 @@ void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
 Entry Storage::RegisterWriter(std::string prefix, WriterFunc func,
                               std::vector<Label> add_labels) {
   return DoRegisterExtender(impl::MetricsSource{
-      std::move(prefix), {}, {}, std::move(func), std::move(add_labels)});
+      std::move(prefix), {}, {}, std::move(func), std::move(add_labels), {},
+      {}});
+}
+
+Entry Storage::RegisterCachedWriter(std::string prefix, WriterFunc func,
+                                   WriterGenerationFunc generation,
+                                   std::vector<Label> add_labels) {
+  UASSERT(generation);
+  return DoRegisterExtender(impl::MetricsSource{
+      std::move(prefix), {}, {}, std::move(func), std::move(add_labels),
+      std::move(generation), std::make_shared<impl::WriterCache>()});
 }
 
 Entry Storage::RegisterExtender(std::string prefix, ExtenderFunc func) {
   auto prefix_split = formats::common::SplitPathString(prefix);
   return DoRegisterExtender(impl::MetricsSource{
-      std::move(prefix), std::move(prefix_split), std::move(func), {}, {}});
+      std::move(prefix), std::move(prefix_split), std::move(func), {}, {}, {},
+      {}});
 }
 
 Entry Storage::DoRegisterExtender(impl::MetricsSource&& source) {
@@ -0,0 +1,63 @@
+#include <userver/utils/statistics/storage.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kMetricsPerWriter = 200;
+
+enum class WriterKind { kPlain, kCached };
+
+}  // namespace
+
+// A full scrape of `state.range(0) * kMetricsPerWriter` series, each writer
+// writes a single metric with many label values.
+void StatisticsFullScrape(benchmark::State& state, WriterKind kind) {
+  engine::RunStandalone([&] {
+    std::vector<std::string> label_values;
+    for (std::size_t i = 0; i < kMetricsPerWriter; ++i) {
+      label_values.push_back("endpoint-" + std::to_string(i));
+    }
+
+    const auto writer_func = [&label_values](
+                                 utils::statistics::Writer& writer) {
+      for (std::size_t i = 0; i < label_values.size(); ++i) {
+        writer["requests"]["count"].ValueWithLabels(
+            i, {{"endpoint", label_values[i]}, {"status", "ok"}});
+      }
+    };
+
+    utils::statistics::Storage storage;
+    std::vector<utils::statistics::Entry> holders;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      auto prefix = "component-" + std::to_string(i);
+      holders.push_back(
+          kind == WriterKind::kCached
+              ? storage.RegisterCachedWriter(std::move(prefix), writer_func,
+                                             [] { return std::uint64_t{1}; })
+              : storage.RegisterWriter(std::move(prefix), writer_func));
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) *
+                            kMetricsPerWriter);
+  });
+}
+BENCHMARK_CAPTURE(StatisticsFullScrape, plain, WriterKind::kPlain)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_CAPTURE(StatisticsFullScrape, cached, WriterKind::kCached)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+USERVER_NAMESPACE_END
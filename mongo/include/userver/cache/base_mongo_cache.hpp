@@ -4,6 +4,9 @@
 /// @brief @copybrief components::MongoCache
 
 #include <chrono>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,13 +14,18 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
 #include <userver/formats/bson/value_builder.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
 #include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -30,10 +38,23 @@ inline const std::string kFetchAndParseStage = "fetch_and_parse";
 inline constexpr std::chrono::milliseconds kCpuRelaxThreshold{10};
 inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
 
+inline constexpr std::chrono::milliseconds kChangeStreamMaxAwaitTime{100};
+inline constexpr std::chrono::milliseconds kChangeStreamMaxDrainTime{1000};
+
+inline constexpr std::size_t kPartitionMergeBatchSize = 1000;
+
 namespace impl {
 
+// Documents parsed by a full update partition and the time it took
+struct PartitionParseStats {
+  std::size_t doc_count{0};
+  tracing::ScopeTime::DurationMillis elapsed{0};
+};
+
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 
+bool IsMongoCacheChangeStreamEnabled(const ComponentConfig&);
+
 }
 
 // clang-format off
@@ -52,6 +73,26 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// update-correction | adjusts incremental updates window to overlap with previous update | 0
+/// change-stream | use a change stream instead of polling for incremental updates | false
+///
+/// ## Change stream mode
+/// With `change-stream: true` a full update opens a change stream before
+/// reading the collection, and incremental updates apply the collected
+/// insert, update and replace events instead of querying
+/// `kMongoUpdateFieldName`. Deletions, collection drops and a lost resume
+/// token (e.g. after an oplog rollover) fall back to a full update.
+///
+/// The mode requires a replica set, incremental updates allowed in config and
+/// the default find operation. The stream keeps one pool connection busy.
+///
+/// ## Partitioned full updates
+/// Traits may split full updates into `kFullUpdatePartitions` ranges of the
+/// `kFullUpdatePartitionFieldName` field. The range bounds are looked up by
+/// skipping through the sorted field values, so the field must be indexed and
+/// present in every document with values of a single BSON type, `_id` is a
+/// good choice. The ranges are loaded in parallel, each on its own connection,
+/// and merged into the cache in batches of kPartitionMergeBatchSize documents.
+/// Partitioning requires the default find operation.
 ///
 /// ## Traits example:
 /// All fields below (except for function overrides) are mandatory.
@@ -89,6 +130,11 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   static ObjectType DeserializeObject(const formats::bson::Document& doc) {
 ///     return doc["value"].As<ObjectType>();
 ///   }
+///   // or, to skip building of formats::bson::Value, with a SAX parser
+///   static ObjectType DeserializeObject(const formats::bson::Document& doc) {
+///     return formats::bson::parser::ParseToType<ObjectType,
+///                                               CachedObjectParser>(doc);
+///   }
 ///   // (default implementation calls doc.As<ObjectType>())
 ///   // For using default implementation
 ///   static constexpr bool kUseDefaultDeserializeObject = true;
@@ -111,6 +157,11 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   // Whether update part of the cache even if failed to parse some documents
 ///   static constexpr bool kAreInvalidDocumentsSkipped = false;
 ///
+///   // Optional number of ranges to load in parallel on full updates
+///   static constexpr std::size_t kFullUpdatePartitions = 4;
+///   // Field to split full updates by, required with kFullUpdatePartitions
+///   static constexpr std::string_view kFullUpdatePartitionFieldName = "_id";
+///
 ///   // Component to get the collections
 ///   using MongoCollectionsComponent = components::MongoCollections;
 /// };
@@ -126,6 +177,8 @@ class MongoCache
 
  public:
   static constexpr std::string_view kName = MongoCacheTraits::kName;
+  static constexpr std::size_t kFullUpdatePartitions =
+      mongo_cache::impl::GetFullUpdatePartitions<MongoCacheTraits>();
 
   MongoCache(const ComponentConfig&, const ComponentContext&);
 
@@ -151,10 +204,30 @@ class MongoCache
   std::unique_ptr<typename MongoCacheTraits::DataType> GetData(
       cache::UpdateType type);
 
+  void UpdateCpuRelaxIterations(
+      std::size_t doc_count, tracing::ScopeTime::DurationMillis elapsed_time);
+
+  std::vector<formats::bson::Document> GetPartitionFilters() const;
+
+  std::unique_ptr<typename MongoCacheTraits::DataType> LoadPartitioned(
+      cache::UpdateStatisticsScope& stats_scope);
+
+  void SetData(std::unique_ptr<typename MongoCacheTraits::DataType> new_cache,
+               std::optional<storages::mongo::ChangeStream> full_update_stream,
+               cache::UpdateStatisticsScope& stats_scope);
+
+  storages::mongo::ChangeStream OpenChangeStream() const;
+
+  // Returns false if a full update is required
+  bool UpdateFromChangeStream(cache::UpdateStatisticsScope& stats_scope);
+
   const std::shared_ptr<CollectionsType> mongo_collections_;
   const storages::mongo::Collection* const mongo_collection_;
   const std::chrono::system_clock::duration correction_;
+  const bool change_stream_enabled_;
   std::size_t cpu_relax_iterations_{0};
+  std::optional<storages::mongo::ChangeStream> change_stream_;
+  std::optional<formats::bson::Document> resume_token_;
 };
 
 template <class MongoCacheTraits>
@@ -172,13 +245,15 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
               .template GetCollectionForLibrary<CollectionsType>()),
       mongo_collection_(std::addressof(
           mongo_collections_.get()->*MongoCacheTraits::kMongoCollectionsField)),
-      correction_(impl::GetMongoCacheUpdateCorrection(config)) {
+      correction_(impl::GetMongoCacheUpdateCorrection(config)),
+      change_stream_enabled_(impl::IsMongoCacheChangeStreamEnabled(config)) {
   [[maybe_unused]] mongo_cache::impl::CheckTraits<MongoCacheTraits>
       check_traits;
 
   if (CachingComponentBase<
           typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
+      !change_stream_enabled_ &&
       !mongo_cache::impl::kHasUpdateFieldName<MongoCacheTraits> &&
       !mongo_cache::impl::kHasFindOperation<MongoCacheTraits>) {
     throw std::logic_error(
@@ -186,6 +261,23 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
         "name is specified in traits of '" +
         components::GetCurrentComponentName(config) + "' cache");
   }
+  if (change_stream_enabled_) {
+    if (CachingComponentBase<
+            typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes() ==
+        cache::AllowedUpdateTypes::kOnlyFull) {
+      throw std::logic_error(
+          "Change stream is requested in config but incremental updates are "
+          "disabled for '" +
+          components::GetCurrentComponentName(config) + "' cache");
+    }
+    if (mongo_cache::impl::kHasFindOperation<MongoCacheTraits>) {
+      throw std::logic_error(
+          "Change stream is requested in config but traits of '" +
+          components::GetCurrentComponentName(config) +
+          "' cache override the find operation, which the change stream "
+          "cannot follow");
+    }
+  }
   if (correction_.count() < 0) {
     throw std::logic_error(
         "Refusing to set forward (negative) update correction requested in "
@@ -209,6 +301,29 @@ void MongoCache<MongoCacheTraits>::Update(
     cache::UpdateStatisticsScope& stats_scope) {
   namespace sm = storages::mongo;
 
+  std::optional<sm::ChangeStream> full_update_stream;
+  if (change_stream_enabled_) {
+    if (type == cache::UpdateType::kIncremental &&
+        UpdateFromChangeStream(stats_scope)) {
+      return;
+    }
+
+    // The stream is opened before reading the collection, so the events that
+    // happen during the full update are applied once again afterwards
+    type = cache::UpdateType::kFull;
+    change_stream_.reset();
+    resume_token_.reset();
+    full_update_stream.emplace(OpenChangeStream());
+  }
+
+  if constexpr (kFullUpdatePartitions > 1) {
+    if (type == cache::UpdateType::kFull) {
+      SetData(LoadPartitioned(stats_scope), std::move(full_update_stream),
+              stats_scope);
+      return;
+    }
+  }
+
   const auto* collection = mongo_collection_;
   auto find_op = GetFindOperation(type, last_update, now, correction_);
   auto cursor = collection->Execute(find_op);
@@ -257,18 +372,23 @@ void MongoCache<MongoCacheTraits>::Update(
     }
   }
 
-  const auto elapsed_time = scope.ElapsedTotal(kFetchAndParseStage);
-  if (elapsed_time > kCpuRelaxThreshold) {
-    cpu_relax_iterations_ = static_cast<std::size_t>(
-        static_cast<double>(doc_count) / (elapsed_time / kCpuRelaxInterval));
-    LOG_TRACE() << fmt::format(
-        "Elapsed time for updating {} {} for {} data items is over threshold. "
-        "Will relax CPU every {} iterations",
-        kName, elapsed_time.count(), doc_count, cpu_relax_iterations_);
-  }
+  UpdateCpuRelaxIterations(doc_count, scope.ElapsedTotal(kFetchAndParseStage));
 
   scope.Reset();
 
+  SetData(std::move(new_cache), std::move(full_update_stream), stats_scope);
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::SetData(
+    std::unique_ptr<typename MongoCacheTraits::DataType> new_cache,
+    std::optional<storages::mongo::ChangeStream> full_update_stream,
+    cache::UpdateStatisticsScope& stats_scope) {
+  if (full_update_stream) {
+    resume_token_ = full_update_stream->GetResumeToken();
+    change_stream_ = std::move(full_update_stream);
+  }
+
   const auto size = new_cache->size();
   this->Set(std::move(new_cache));
   stats_scope.Finish(size);
@@ -336,6 +456,257 @@ MongoCache<MongoCacheTraits>::GetData(cache::UpdateType type) {
   }
 }
 
+template <class MongoCacheTraits>
+std::vector<formats::bson::Document>
+MongoCache<MongoCacheTraits>::GetPartitionFilters() const {
+  namespace bson = formats::bson;
+  namespace sm = storages::mongo;
+  const std::string field{
+      mongo_cache::impl::GetFullUpdatePartitionFieldName<MongoCacheTraits>()};
+
+  // Lower bounds of all the partitions except the first one
+  std::vector<bson::Value> bounds;
+  const auto count = mongo_collection_->CountApprox();
+  for (std::size_t i = 1; i < kFullUpdatePartitions; ++i) {
+    sm::operations::Find find_op({});
+    find_op.SetOption(
+        sm::options::Sort{{field, sm::options::Sort::kAscending}});
+    find_op.SetOption(sm::options::Skip{count * i / kFullUpdatePartitions});
+    find_op.SetOption(sm::options::Limit{1});
+    find_op.SetOption(sm::options::Projection{field});
+    if (MongoCacheTraits::kIsSecondaryPreferred) {
+      find_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+    }
+
+    auto cursor = mongo_collection_->Execute(find_op);
+    if (!cursor) break;
+    auto bound = (*cursor.begin())[field];
+    if (bounds.empty() || bounds.back() != bound) {
+      bounds.push_back(std::move(bound));
+    }
+  }
+
+  std::vector<bson::Document> filters;
+  filters.reserve(bounds.size() + 1);
+  for (std::size_t i = 0; i <= bounds.size(); ++i) {
+    bson::ValueBuilder range(bson::ValueBuilder::Type::kObject);
+    if (i > 0) range["$gte"] = bounds[i - 1];
+    if (i < bounds.size()) range["$lt"] = bounds[i];
+
+    bson::ValueBuilder filter(bson::ValueBuilder::Type::kObject);
+    if (!bounds.empty()) filter[field] = std::move(range);
+    filters.push_back(filter.ExtractValue());
+  }
+  return filters;
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::UpdateCpuRelaxIterations(
+    std::size_t doc_count, tracing::ScopeTime::DurationMillis elapsed_time) {
+  if (elapsed_time > kCpuRelaxThreshold) {
+    cpu_relax_iterations_ = static_cast<std::size_t>(
+        static_cast<double>(doc_count) / (elapsed_time / kCpuRelaxInterval));
+    LOG_TRACE() << fmt::format(
+        "Elapsed time for updating {} {} for {} data items is over threshold. "
+        "Will relax CPU every {} iterations",
+        kName, elapsed_time.count(), doc_count, cpu_relax_iterations_);
+  }
+}
+
+template <class MongoCacheTraits>
+std::unique_ptr<typename MongoCacheTraits::DataType>
+MongoCache<MongoCacheTraits>::LoadPartitioned(
+    cache::UpdateStatisticsScope& stats_scope) {
+  namespace sm = storages::mongo;
+
+  auto new_cache = GetData(cache::UpdateType::kFull);
+  engine::Mutex data_mutex;
+
+  const auto load_partition = [&](formats::bson::Document filter) {
+    const auto start = std::chrono::steady_clock::now();
+    auto scope =
+        tracing::Span::CurrentSpan().CreateScopeTime(kFetchAndParseStage);
+
+    sm::operations::Find find_op(std::move(filter));
+    if (MongoCacheTraits::kIsSecondaryPreferred) {
+      find_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+    }
+
+    utils::CpuRelax relax{cpu_relax_iterations_, &scope};
+    impl::PartitionParseStats parse_stats;
+
+    std::vector<typename MongoCacheTraits::ObjectType> batch;
+    batch.reserve(kPartitionMergeBatchSize);
+    const auto merge_batch = [&] {
+      std::lock_guard lock{data_mutex};
+      for (auto& object : batch) {
+        relax.Relax();
+        auto key = (object.*MongoCacheTraits::kKeyField);
+        if (new_cache->count(key) == 0) {
+          (*new_cache)[key] = std::move(object);
+        } else {
+          LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
+                              << MongoCacheTraits::kName << ", key=" << key;
+        }
+      }
+      batch.clear();
+    };
+
+    for (const auto& doc : mongo_collection_->Execute(find_op)) {
+      ++parse_stats.doc_count;
+
+      relax.Relax();
+
+      stats_scope.IncreaseDocumentsReadCount(1);
+
+      try {
+        batch.push_back(DeserializeObject(doc));
+      } catch (const std::exception& e) {
+        LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
+                            << MongoCacheTraits::kName << ", _id="
+                            << doc["_id"].template ConvertTo<std::string>()
+                            << ", what(): " << e;
+        stats_scope.IncreaseDocumentsParseFailures(1);
+
+        if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+      }
+
+      if (batch.size() >= kPartitionMergeBatchSize) merge_batch();
+    }
+    merge_batch();
+
+    scope.Reset();
+    parse_stats.elapsed = scope.ElapsedTotal(kFetchAndParseStage);
+    stats_scope.AccountPartitionDuration(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start));
+    return parse_stats;
+  };
+
+  std::vector<engine::TaskWithResult<impl::PartitionParseStats>> tasks;
+  tasks.reserve(kFullUpdatePartitions);
+  for (auto& filter : GetPartitionFilters()) {
+    tasks.push_back(utils::Async("mongo_cache_partition", load_partition,
+                                 std::move(filter)));
+  }
+
+  // Partitions are parsed in parallel, the per-task parse rate is what
+  // CpuRelax is tuned by
+  impl::PartitionParseStats parse_stats;
+  for (const auto& partition_stats : engine::GetAll(tasks)) {
+    parse_stats.doc_count += partition_stats.doc_count;
+    parse_stats.elapsed += partition_stats.elapsed;
+  }
+  UpdateCpuRelaxIterations(parse_stats.doc_count, parse_stats.elapsed);
+
+  return new_cache;
+}
+
+template <class MongoCacheTraits>
+storages::mongo::ChangeStream MongoCache<MongoCacheTraits>::OpenChangeStream()
+    const {
+  namespace sm = storages::mongo;
+
+  sm::operations::Watch watch_op;
+  watch_op.SetOption(sm::options::FullDocument::kUpdateLookup);
+  watch_op.SetOption(sm::options::MaxAwaitTime{kChangeStreamMaxAwaitTime});
+  if (resume_token_ && !resume_token_->IsEmpty()) {
+    watch_op.SetOption(sm::options::ResumeAfter{*resume_token_});
+  }
+  if (MongoCacheTraits::kIsSecondaryPreferred) {
+    watch_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+  }
+  return mongo_collection_->Execute(watch_op);
+}
+
+template <class MongoCacheTraits>
+bool MongoCache<MongoCacheTraits>::UpdateFromChangeStream(
+    cache::UpdateStatisticsScope& stats_scope) {
+  namespace sm = storages::mongo;
+
+  if (!change_stream_ && !resume_token_) return false;
+
+  std::unique_ptr<typename MongoCacheTraits::DataType> new_cache;
+  try {
+    if (!change_stream_) change_stream_.emplace(OpenChangeStream());
+
+    auto scope = tracing::Span::CurrentSpan().CreateScopeTime(
+        kFetchAndParseStage);
+    const auto drain_deadline =
+        std::chrono::steady_clock::now() + kChangeStreamMaxDrainTime;
+
+    while (auto event = change_stream_->Next()) {
+      const auto operation_type =
+          (*event)["operationType"].template As<std::string>();
+      if (operation_type == "insert" || operation_type == "update" ||
+          operation_type == "replace") {
+        stats_scope.IncreaseDocumentsReadCount(1);
+
+        const auto doc = (*event)["fullDocument"];
+        // The document was deleted before the update lookup
+        if (doc.IsMissing() || doc.IsNull()) {
+          change_stream_.reset();
+          resume_token_.reset();
+          return false;
+        }
+
+        if (!new_cache) new_cache = GetData(cache::UpdateType::kIncremental);
+        try {
+          auto object = DeserializeObject(doc);
+          auto key = (object.*MongoCacheTraits::kKeyField);
+          (*new_cache)[key] = std::move(object);
+        } catch (const std::exception& e) {
+          LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
+                              << MongoCacheTraits::kName << ", _id="
+                              << doc["_id"].template ConvertTo<std::string>()
+                              << ", what(): " << e;
+          stats_scope.IncreaseDocumentsParseFailures(1);
+
+          if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+        }
+      } else if (operation_type == "delete" || operation_type == "drop" ||
+                 operation_type == "rename" ||
+                 operation_type == "dropDatabase" ||
+                 operation_type == "invalidate") {
+        // Deletion events carry only _id, not the cache key
+        LOG_INFO() << "Got '" << operation_type << "' change event in cache "
+                   << MongoCacheTraits::kName << ", running a full update";
+        change_stream_.reset();
+        resume_token_.reset();
+        return false;
+      }
+
+      if (std::chrono::steady_clock::now() >= drain_deadline) break;
+    }
+
+    resume_token_ = change_stream_->GetResumeToken();
+  } catch (const sm::ServerException& ex) {
+    change_stream_.reset();
+    if (!sm::IsChangeStreamHistoryLost(ex)) throw;
+
+    LOG_WARNING() << "Cannot resume change stream of cache "
+                  << MongoCacheTraits::kName << ", running a full update: "
+                  << ex;
+    resume_token_.reset();
+    return false;
+  } catch (const std::exception&) {
+    // Resumed from the last applied event on the next update
+    change_stream_.reset();
+    throw;
+  }
+
+  if (!new_cache) {
+    LOG_INFO() << "No changes in cache " << MongoCacheTraits::kName;
+    stats_scope.FinishNoChanges();
+    return true;
+  }
+
+  const auto size = new_cache->size();
+  this->Set(std::move(new_cache));
+  stats_scope.Finish(size);
+  return true;
+}
+
 namespace impl {
 
 std::string GetMongoCacheSchema();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <string_view>
 #include <type_traits>
 
 #include <userver/cache/update_type.hpp>
@@ -100,6 +102,37 @@ template <typename T>
 inline constexpr bool kHasInvalidDocumentsSkipped =
     meta::kIsDetected<HasInvalidDocumentsSkipped, T>;
 
+template <typename T>
+using FullUpdatePartitions = decltype(T::kFullUpdatePartitions);
+template <typename T>
+inline constexpr bool kHasFullUpdatePartitions =
+    meta::kIsDetected<FullUpdatePartitions, T>;
+
+template <typename T>
+using FullUpdatePartitionFieldName =
+    decltype(T::kFullUpdatePartitionFieldName);
+template <typename T>
+inline constexpr bool kHasFullUpdatePartitionFieldName =
+    meta::kIsDetected<FullUpdatePartitionFieldName, T>;
+
+template <typename T>
+constexpr std::size_t GetFullUpdatePartitions() {
+  if constexpr (kHasFullUpdatePartitions<T>) {
+    return T::kFullUpdatePartitions;
+  } else {
+    return 1;
+  }
+}
+
+template <typename T>
+constexpr std::string_view GetFullUpdatePartitionFieldName() {
+  if constexpr (kHasFullUpdatePartitionFieldName<T>) {
+    return T::kFullUpdatePartitionFieldName;
+  } else {
+    return {};
+  }
+}
+
 template <typename>
 struct ClassByMemberPointer {};
 template <typename T, typename C>
@@ -168,6 +201,18 @@ struct CheckTraits {
                 "const std::chrono::system_clock::time_point& now, "
                 "const std::chrono::system_clock::duration& correction)");
 
+  static_assert(GetFullUpdatePartitions<MongoCacheTraits>() > 0,
+                "Mongo cache traits must specify a positive number of full "
+                "update partitions");
+  static_assert(GetFullUpdatePartitions<MongoCacheTraits>() == 1 ||
+                    kHasFullUpdatePartitionFieldName<MongoCacheTraits>,
+                "Mongo cache traits must specify the field to split full "
+                "updates by");
+  static_assert(GetFullUpdatePartitions<MongoCacheTraits>() == 1 ||
+                    !kHasFindOperation<MongoCacheTraits>,
+                "Mongo cache traits cannot split full updates with a custom "
+                "find operation");
+
   static_assert(kHasDeserializeObject<MongoCacheTraits> ||
                     kHasDefaultDeserializeObject<MongoCacheTraits>,
                 "Mongo cache traits must specify deserialize object");
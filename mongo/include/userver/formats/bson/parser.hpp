@@ -0,0 +1,56 @@
+#pragma once
+
+/// @file userver/formats/bson/parser.hpp
+/// @brief SAX parsing of BSON documents into user types
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/json/parser/parser_state.hpp>
+#include <userver/formats/json/parser/typed_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// SAX parsing of BSON with formats::json::parser parsers
+namespace formats::bson::parser {
+
+/// @brief Feeds the elements of a document to the parsers of `state`
+///
+/// Walks the raw document bytes without building a formats::bson::Value tree,
+/// so the typed parsers of formats::json::parser (and the user ones built on
+/// top of them) fill C++ structs directly.
+///
+/// BSON types are reported as the following parser events:
+/// - double as Double();
+/// - int32, int64 and UTC datetime (milliseconds since epoch) as Int64();
+/// - timestamp as Uint64() with seconds in high 32 bits;
+/// - string and symbol as String();
+/// - ObjectId as String() with 24 hex digits;
+/// - binary as String() with raw bytes;
+/// - decimal128 as String() with its textual representation;
+/// - null and undefined as Null();
+/// - documents and arrays as the usual object and array events.
+///
+/// Other types are reported as parse errors.
+///
+/// @throws ParseException with the path of the failed element
+void ProcessDocument(const Document& doc, json::parser::ParserState& state);
+
+/// @brief Parses a document into `T` with a SAX `Parser`
+/// @see formats::json::parser::ParseToType
+template <typename T, typename Parser>
+T ParseToType(const Document& doc) {
+  T result{};
+  Parser parser;
+  parser.Reset();
+  json::parser::SubscriberSink<T> sink(result);
+  parser.Subscribe(sink);
+
+  json::parser::ParserState state;
+  state.PushParser(parser.GetParser());
+  ProcessDocument(doc, state);
+
+  return result;
+}
+
+}  // namespace formats::bson::parser
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,50 @@
+#pragma once
+
+/// @file userver/storages/mongo/change_stream.hpp
+/// @brief @copybrief storages::mongo::ChangeStream
+
+#include <memory>
+#include <optional>
+
+#include <userver/formats/bson/document.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+namespace impl {
+class ChangeStreamImpl;
+}  // namespace impl
+
+class ServerException;
+
+/// @brief MongoDB change stream, returned by Collection::Watch
+///
+/// Keeps a pool connection for the whole lifetime of the stream.
+class ChangeStream {
+ public:
+  explicit ChangeStream(std::unique_ptr<impl::ChangeStreamImpl>&&);
+  ~ChangeStream();
+
+  ChangeStream(ChangeStream&&) noexcept;
+  ChangeStream& operator=(ChangeStream&&) noexcept;
+
+  /// @brief Returns the next change event, waits for it for up to
+  /// options::MaxAwaitTime
+  /// @returns std::nullopt if no events arrived in time
+  std::optional<formats::bson::Document> Next();
+
+  /// @brief Returns the token of the last returned event, or the one of the
+  /// last seen server batch, to pass in options::ResumeAfter
+  formats::bson::Document GetResumeToken() const;
+
+ private:
+  std::unique_ptr<impl::ChangeStreamImpl> impl_;
+};
+
+/// @brief Checks whether the change stream cannot be resumed and the watched
+/// data has to be reloaded, e.g. due to the oplog rollover
+bool IsChangeStreamHistoryLost(const ServerException&);
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
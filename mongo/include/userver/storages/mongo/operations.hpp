@@ -362,6 +362,41 @@ class Drop {
   utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
 };
 
+/// @brief Opens a change stream over the collection
+/// @see https://docs.mongodb.com/manual/changeStreams/
+class Watch {
+ public:
+  /// Watches all the changes of the collection
+  Watch();
+
+  /// @brief Watches changes passing through the pipeline
+  /// @param pipeline an array of aggregation stages applied to change events
+  explicit Watch(formats::bson::Value pipeline);
+  ~Watch();
+
+  Watch(const Watch&);
+  Watch(Watch&&) noexcept;
+  Watch& operator=(const Watch&);
+  Watch& operator=(Watch&&) noexcept;
+
+  void SetOption(const options::ReadPreference&);
+  void SetOption(options::ReadPreference::Mode);
+  void SetOption(options::ReadConcern);
+  void SetOption(const options::ResumeAfter&);
+  void SetOption(options::FullDocument);
+  void SetOption(const options::MaxAwaitTime&);
+  void SetOption(const options::Comment&);
+
+ private:
+  friend class storages::mongo::impl::cdriver::CDriverCollectionImpl;
+
+  class Impl;
+  static constexpr size_t kSize = 120;
+  static constexpr size_t kAlignment = 8;
+  // MAC_COMPAT: std::string size differs
+  utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
+};
+
 }  // namespace storages::mongo::operations
 
 USERVER_NAMESPACE_END
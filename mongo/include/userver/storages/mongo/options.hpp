@@ -300,6 +300,41 @@ class MaxServerTime {
   std::chrono::milliseconds value_;
 };
 
+/// @brief Resumes a change stream after the event with the specified token
+/// @see ChangeStream::GetResumeToken
+class ResumeAfter {
+ public:
+  explicit ResumeAfter(formats::bson::Document resume_token)
+      : value_(std::move(resume_token)) {}
+
+  const formats::bson::Document& Value() const { return value_; }
+
+ private:
+  formats::bson::Document value_;
+};
+
+/// @brief Specifies whether change stream update events contain the current
+/// version of the whole document in the `fullDocument` field
+enum class FullDocument {
+  /// only the delta is returned for updates, default mode
+  kDefault,
+  /// the current version of the document is looked up on update
+  kUpdateLookup,
+};
+
+/// @brief Specifies the maximum time the server waits for new change stream
+/// events before returning an empty batch
+class MaxAwaitTime {
+ public:
+  explicit MaxAwaitTime(const std::chrono::milliseconds& value)
+      : value_(value) {}
+
+  const std::chrono::milliseconds& Value() const { return value_; }
+
+ private:
+  std::chrono::milliseconds value_;
+};
+
 }  // namespace storages::mongo::options
 
 USERVER_NAMESPACE_END
@@ -1,10 +1,13 @@
 #include <benchmark/benchmark.h>
 
 #include <userver/formats/bson.hpp>
+#include <userver/formats/bson/parser.hpp>
 #include <userver/formats/bson/serialize.hpp>
 #include <userver/formats/json.hpp>
+#include <userver/formats/json/parser/parser.hpp>
 
 #include <array>
+#include <optional>
 
 // Test inspired by internal candidates service.
 // Data was taken from the DB and personal data was removed.
@@ -210,6 +213,164 @@ models::Profile Parse(const formats::bson::Value& val, To<models::Profile>) {
 
 }  // namespace models
 
+namespace sax {
+
+namespace fjp = formats::json::parser;
+
+template <typename T, typename Field = T>
+class FieldSink final : public fjp::Subscriber<T> {
+ public:
+  explicit FieldSink(Field& field) : field_(field) {}
+
+  void OnSend(T&& value) override { field_ = static_cast<Field>(value); }
+
+ private:
+  Field& field_;
+};
+
+// Pushes field parsers by keys, values of unknown keys are skipped
+template <typename T>
+class ObjectParser : public fjp::TypedParser<T> {
+ public:
+  void Reset() override { result_ = T{}; }
+
+ protected:
+  void StartObject() override {}
+
+  void EndObject() override { this->SetResult(std::move(result_)); }
+
+  std::string Expected() const override { return "object"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+  template <typename Parser, typename Subscriber>
+  void Push(Parser& parser, Subscriber& subscriber) {
+    parser.Reset();
+    parser.Subscribe(subscriber);
+    this->parser_state_->PushParser(parser.GetParser());
+  }
+
+  void Skip() {
+    skip_parser_.Reset();
+    this->parser_state_->PushParser(skip_parser_);
+  }
+
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  T result_;
+
+ private:
+  fjp::SkipParser skip_parser_;
+};
+
+class ProfileCarParser final : public ObjectParser<models::ProfileCar> {
+ protected:
+  void Key(std::string_view key) override {
+    if (key == names::car::kNumber) {
+      Push(string_parser_, number_sink_);
+    } else if (key == names::car::kModel) {
+      Push(string_parser_, model_sink_);
+    } else if (key == names::car::kMarkCode) {
+      Push(string_parser_, mark_code_sink_);
+    } else if (key == names::car::kAge) {
+      Push(int_parser_, age_sink_);
+    } else if (key == names::car::kPrice) {
+      Push(double_parser_, price_sink_);
+    } else {
+      Skip();
+    }
+  }
+
+ private:
+  fjp::StringParser string_parser_;
+  fjp::Int64Parser int_parser_;
+  fjp::DoubleParser double_parser_;
+  FieldSink<std::string> number_sink_{result_.number};
+  FieldSink<std::string> model_sink_{result_.model};
+  FieldSink<std::string> mark_code_sink_{result_.mark_code};
+  FieldSink<std::int64_t, short> age_sink_{result_.age};
+  FieldSink<double, uint32_t> price_sink_{result_.price};
+};
+
+// Only booleans and integers are requirements, other scalars are ignored
+class RequirementParser final
+    : public fjp::TypedParser<std::optional<models::Requirements::Value>> {
+ protected:
+  void Bool(bool value) override {
+    SetResult(models::Requirements::Value{value});
+  }
+
+  void Int64(int64_t value) override {
+    SetResult(models::Requirements::Value{static_cast<short>(value)});
+  }
+
+  void Double(double) override { SetResult(std::nullopt); }
+
+  void String(std::string_view) override { SetResult(std::nullopt); }
+
+  std::string Expected() const override { return "requirement"; }
+
+  std::string GetPathItem() const override { return {}; }
+};
+
+class RequirementsParser final
+    : public ObjectParser<models::Requirements>,
+      public fjp::Subscriber<std::optional<models::Requirements::Value>> {
+ protected:
+  void Key(std::string_view key) override {
+    // child seats are not present in the benchmark data
+    if (key == names::requirements::kChildSeats) {
+      Skip();
+      return;
+    }
+
+    name_ = key;
+    Push(value_parser_, *this);
+  }
+
+  void OnSend(std::optional<models::Requirements::Value>&& value) override {
+    if (value) result_.Add(name_, *std::move(value));
+  }
+
+ private:
+  RequirementParser value_parser_;
+  std::string name_;
+};
+
+class ProfileParser final : public ObjectParser<models::Profile>,
+                            public fjp::Subscriber<std::string> {
+ protected:
+  void Key(std::string_view key) override {
+    if (key == names::kUuid) {
+      Push(string_parser_, static_cast<fjp::Subscriber<std::string>&>(*this));
+    } else if (key == names::kLicense) {
+      Push(string_parser_, license_sink_);
+    } else if (key == names::kCar) {
+      Push(car_parser_, car_sink_);
+    } else if (key == names::kRequirements) {
+      Push(requirements_parser_, requirements_sink_);
+    } else {
+      // grades are not present in the benchmark data
+      Skip();
+    }
+  }
+
+  void OnSend(std::string&& uuid) override {
+    result_.driver_id.dbid = uuid;  // changed
+    result_.driver_id.uuid = std::move(uuid);
+  }
+
+ private:
+  fjp::StringParser string_parser_;
+  ProfileCarParser car_parser_;
+  RequirementsParser requirements_parser_;
+  FieldSink<std::string> license_sink_{result_.license};
+  FieldSink<models::ProfileCar> car_sink_{result_.car};
+  FieldSink<models::Requirements> requirements_sink_{
+      result_.available_requirements};
+};
+
+}  // namespace sax
+
 }  // anonymous namespace
 
 void bson_parse_full(benchmark::State& state) {
@@ -239,4 +400,18 @@ void bson_parse_access(benchmark::State& state) {
 }
 BENCHMARK(bson_parse_access);
 
+void bson_parse_sax(benchmark::State& state) {
+  static unsigned i = 0;
+
+  for (auto _ : state) {
+    auto bson = formats::bson::Document(bench_bson_data[++i % kBenchRows]);
+
+    const auto res = formats::bson::parser::ParseToType<models::Profile,
+                                                        sax::ProfileParser>(
+        bson);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(bson_parse_sax);
+
 USERVER_NAMESPACE_END
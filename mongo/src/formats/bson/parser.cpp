@@ -0,0 +1,189 @@
+#include <userver/formats/bson/parser.hpp>
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <bson/bson.h>
+#include <fmt/format.h>
+
+#include <userver/formats/bson/exception.hpp>
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/parser/exception.hpp>
+#include <userver/formats/json/parser/parser_handler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson::parser {
+
+namespace {
+
+using json::parser::InternalParseError;
+using json::parser::ParserHandler;
+using json::parser::ParserState;
+
+// Path items live on the stack of the walker and are only turned into a
+// string when an error is reported.
+struct PathItem final {
+  const PathItem* parent;
+  std::string_view key;
+  std::size_t index;
+  bool is_index;
+};
+
+std::string ToString(const PathItem* item) {
+  std::vector<const PathItem*> items;
+  for (; item; item = item->parent) items.push_back(item);
+
+  std::string path;
+  for (auto it = items.rbegin(); it != items.rend(); ++it) {
+    if ((*it)->is_index) {
+      common::AppendPath(path, (*it)->index);
+    } else {
+      common::AppendPath(path, (*it)->key);
+    }
+  }
+  return path;
+}
+
+[[noreturn]] void ThrowParseError(const PathItem* path, std::string_view what) {
+  throw ParseException(
+      fmt::format("Parse error at path '{}': {}", ToString(path), what));
+}
+
+class DocumentWalker final {
+ public:
+  explicit DocumentWalker(ParserState& state) : state_(state) {}
+
+  void WalkDocument(const uint8_t* data, std::size_t length,
+                    const PathItem* path, bool is_array) {
+    bson_iter_t it;
+    if (!bson_iter_init_from_data(&it, data, length)) {
+      throw InternalParseError("malformed BSON");
+    }
+
+    if (is_array) {
+      Top().StartArray();
+    } else {
+      Top().StartObject();
+    }
+
+    std::size_t count = 0;
+    while (bson_iter_next(&it)) {
+      const std::string_view key(bson_iter_key(&it), bson_iter_key_len(&it));
+      const PathItem item{path, key, count, is_array};
+      ++count;
+
+      try {
+        if (!is_array) Top().Key(key.data(), key.size(), true);
+
+        const bson_value_t* value = bson_iter_value(&it);
+        if (!value) throw InternalParseError("malformed BSON element");
+        WalkValue(*value, item);
+      } catch (const ParseException&) {
+        throw;
+      } catch (const std::exception& e) {
+        ThrowParseError(&item, e.what());
+      }
+    }
+
+    if (is_array) {
+      Top().EndArray(count);
+    } else {
+      Top().EndObject(count);
+    }
+  }
+
+ private:
+  void WalkValue(const bson_value_t& value, const PathItem& path) {
+    switch (value.value_type) {
+      case BSON_TYPE_DOUBLE:
+        Top().Double(value.value.v_double);
+        break;
+      case BSON_TYPE_UTF8:
+        Top().String(value.value.v_utf8.str, value.value.v_utf8.len, true);
+        break;
+      case BSON_TYPE_SYMBOL:
+        Top().String(value.value.v_symbol.symbol, value.value.v_symbol.len,
+                     true);
+        break;
+      case BSON_TYPE_DOCUMENT:
+      case BSON_TYPE_ARRAY:
+        WalkDocument(value.value.v_doc.data, value.value.v_doc.data_len, &path,
+                     value.value_type == BSON_TYPE_ARRAY);
+        break;
+      case BSON_TYPE_BINARY:
+        Top().String(reinterpret_cast<const char*>(value.value.v_binary.data),
+                     value.value.v_binary.data_len, true);
+        break;
+      case BSON_TYPE_UNDEFINED:
+      case BSON_TYPE_NULL:
+        Top().Null();
+        break;
+      case BSON_TYPE_OID: {
+        char buffer[25];
+        bson_oid_to_string(&value.value.v_oid, buffer);
+        Top().String(buffer, 24, true);
+        break;
+      }
+      case BSON_TYPE_BOOL:
+        Top().Bool(value.value.v_bool);
+        break;
+      case BSON_TYPE_DATE_TIME:
+        Top().Int64(value.value.v_datetime);
+        break;
+      case BSON_TYPE_INT32:
+        Top().Int64(value.value.v_int32);
+        break;
+      case BSON_TYPE_TIMESTAMP:
+        Top().Uint64(
+            (std::uint64_t{value.value.v_timestamp.timestamp} << 32) |
+            value.value.v_timestamp.increment);
+        break;
+      case BSON_TYPE_INT64:
+        Top().Int64(value.value.v_int64);
+        break;
+      case BSON_TYPE_DECIMAL128: {
+        char buffer[BSON_DECIMAL128_STRING];
+        bson_decimal128_to_string(&value.value.v_decimal128, buffer);
+        Top().String(buffer, std::strlen(buffer), true);
+        break;
+      }
+      default:
+        throw InternalParseError(fmt::format(
+            "unsupported BSON type {}", static_cast<int>(value.value_type)));
+    }
+  }
+
+  ParserHandler Top() {
+    if (state_.IsEmpty()) {
+      throw InternalParseError("value after the end of parsing");
+    }
+    return ParserHandler(state_);
+  }
+
+  ParserState& state_;
+};
+
+}  // namespace
+
+void ProcessDocument(const Document& doc, ParserState& state) {
+  const auto& bson = doc.GetBson();
+
+  try {
+    DocumentWalker(state).WalkDocument(bson_get_data(bson.get()), bson->len,
+                                       nullptr, false);
+  } catch (const ParseException&) {
+    throw;
+  } catch (const std::exception& e) {
+    ThrowParseError(nullptr, e.what());
+  }
+
+  if (!state.IsEmpty()) {
+    ThrowParseError(nullptr, "document ended before the parser finished");
+  }
+}
+
+}  // namespace formats::bson::parser
+
+USERVER_NAMESPACE_END
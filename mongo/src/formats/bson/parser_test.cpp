@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/parser.hpp>
+#include <userver/formats/json/parser/parser.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+namespace fjp = formats::json::parser;
+
+namespace {
+
+struct Item final {
+  std::int64_t id{0};
+  std::string name;
+  std::vector<std::int64_t> values;
+};
+
+class ItemParser final : public fjp::TypedParser<Item> {
+ public:
+  void Reset() override { result_ = {}; }
+
+ protected:
+  void StartObject() override {}
+
+  void Key(std::string_view key) override {
+    if (key == "id") {
+      Push(id_parser_, id_sink_);
+    } else if (key == "name") {
+      Push(name_parser_, name_sink_);
+    } else if (key == "values") {
+      Push(values_parser_, values_sink_);
+    } else {
+      skip_parser_.Reset();
+      parser_state_->PushParser(skip_parser_);
+    }
+  }
+
+  void EndObject() override { SetResult(std::move(result_)); }
+
+  std::string Expected() const override { return "object"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  template <typename Parser, typename Sink>
+  void Push(Parser& parser, Sink& sink) {
+    parser.Reset();
+    parser.Subscribe(sink);
+    parser_state_->PushParser(parser.GetParser());
+  }
+
+  Item result_;
+  fjp::Int64Parser id_parser_;
+  fjp::StringParser name_parser_;
+  fjp::Int64Parser value_parser_;
+  fjp::ArrayParser<std::int64_t, fjp::Int64Parser> values_parser_{
+      value_parser_};
+  fjp::SkipParser skip_parser_;
+  fjp::SubscriberSink<std::int64_t> id_sink_{result_.id};
+  fjp::SubscriberSink<std::string> name_sink_{result_.name};
+  fjp::SubscriberSink<std::vector<std::int64_t>> values_sink_{result_.values};
+};
+
+}  // namespace
+
+TEST(BsonParser, Struct) {
+  const auto doc = fb::MakeDoc(
+      "_id", fb::Oid{}, "id", 42, "ignored", fb::MakeDoc("a", fb::MakeArray()),
+      "name", "item", "values", fb::MakeArray(1, std::int64_t{2}, 3.0));
+
+  const auto item = fb::parser::ParseToType<Item, ItemParser>(doc);
+  EXPECT_EQ(item.id, 42);
+  EXPECT_EQ(item.name, "item");
+  EXPECT_EQ(item.values, (std::vector<std::int64_t>{1, 2, 3}));
+}
+
+TEST(BsonParser, Types) {
+  using StringMap = std::unordered_map<std::string, std::string>;
+  const fb::Oid oid{"5b7a4ee2b3b4c72f9f3e8c1d"};
+  const fb::Decimal128 decimal{"1.5"};
+
+  fjp::StringParser string_parser;
+  fjp::MapParser<StringMap, fjp::StringParser> strings_parser(string_parser);
+  StringMap strings;
+  fjp::SubscriberSink<StringMap> strings_sink(strings);
+  strings_parser.Reset();
+  strings_parser.Subscribe(strings_sink);
+
+  fjp::ParserState strings_state;
+  strings_state.PushParser(strings_parser);
+  fb::parser::ProcessDocument(
+      fb::MakeDoc("oid", oid, "str", "s", "bin", fb::Binary{"b"}, "dec",
+                  decimal),
+      strings_state);
+  EXPECT_EQ(strings, (StringMap{{"oid", oid.ToString()},
+                                {"str", "s"},
+                                {"bin", "b"},
+                                {"dec", decimal.ToString()}}));
+
+  using IntMap = std::unordered_map<std::string, std::int64_t>;
+  fjp::Int64Parser int_parser;
+  fjp::MapParser<IntMap, fjp::Int64Parser> ints_parser(int_parser);
+  IntMap ints;
+  fjp::SubscriberSink<IntMap> ints_sink(ints);
+  ints_parser.Reset();
+  ints_parser.Subscribe(ints_sink);
+
+  fjp::ParserState ints_state;
+  ints_state.PushParser(ints_parser);
+  fb::parser::ProcessDocument(
+      fb::MakeDoc("i32", 1, "i64", std::int64_t{1} << 40, "date",
+                  std::chrono::system_clock::time_point{} +
+                      std::chrono::milliseconds{5}),
+      ints_state);
+  EXPECT_EQ(ints, (IntMap{{"i32", 1}, {"i64", std::int64_t{1} << 40},
+                          {"date", 5}}));
+}
+
+TEST(BsonParser, Errors) {
+  UEXPECT_THROW_MSG(
+      (fb::parser::ParseToType<Item, ItemParser>(
+          fb::MakeDoc("values", fb::MakeArray(1, "two")))),
+      fb::ParseException, "path 'values[1]'");
+  UEXPECT_THROW_MSG((fb::parser::ParseToType<Item, ItemParser>(
+                        fb::MakeDoc("id", fb::MakeDoc()))),
+                    fb::ParseException, "path 'id'");
+  UEXPECT_THROW((fb::parser::ParseToType<std::int64_t, fjp::Int64Parser>(
+                    fb::MakeDoc("id", 1))),
+                fb::ParseException);
+}
+
+USERVER_NAMESPACE_END
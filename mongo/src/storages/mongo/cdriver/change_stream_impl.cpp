@@ -0,0 +1,58 @@
+#include <storages/mongo/cdriver/change_stream_impl.hpp>
+
+#include <bson/bson.h>
+#include <mongoc/mongoc.h>
+
+#include <userver/storages/mongo/mongo_error.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+CDriverChangeStreamImpl::CDriverChangeStreamImpl(
+    cdriver::CDriverPoolImpl::BoundClientPtr client,
+    cdriver::ChangeStreamPtr stream,
+    std::shared_ptr<stats::OperationStatisticsItem> watch_stats)
+    : client_(std::move(client)),
+      stream_(std::move(stream)),
+      watch_stats_(std::move(watch_stats)) {
+  UASSERT(client_ && stream_);
+}
+
+std::optional<formats::bson::Document> CDriverChangeStreamImpl::Next() {
+  stats::OperationStopwatch watch_sw(watch_stats_, "watch");
+
+  const bson_t* event_bson = nullptr;
+  if (mongoc_change_stream_next(stream_.get(), &event_bson)) {
+    watch_sw.AccountSuccess();
+    return formats::bson::Document(
+        formats::bson::impl::MutableBson::CopyNative(event_bson).Extract());
+  }
+
+  MongoError error;
+  if (mongoc_change_stream_error_document(stream_.get(), error.GetNative(),
+                                          nullptr)) {
+    watch_sw.AccountError(error.GetKind());
+    error.Throw("Error iterating over change stream");
+  }
+
+  // No events within max await time, such waits would only skew the timings
+  watch_sw.Discard();
+  return std::nullopt;
+}
+
+formats::bson::Document CDriverChangeStreamImpl::GetResumeToken() const {
+  const bson_t* token_bson =
+      mongoc_change_stream_get_resume_token(stream_.get());
+  if (!token_bson) return {};
+
+  return formats::bson::Document(
+      formats::bson::impl::MutableBson::CopyNative(token_bson).Extract());
+}
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
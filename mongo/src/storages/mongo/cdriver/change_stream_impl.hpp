@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include <userver/formats/bson/document.hpp>
+
+#include <storages/mongo/cdriver/pool_impl.hpp>
+#include <storages/mongo/cdriver/wrappers.hpp>
+#include <storages/mongo/change_stream_impl.hpp>
+#include <storages/mongo/stats.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+class CDriverChangeStreamImpl final : public ChangeStreamImpl {
+ public:
+  CDriverChangeStreamImpl(
+      cdriver::CDriverPoolImpl::BoundClientPtr, cdriver::ChangeStreamPtr,
+      std::shared_ptr<stats::OperationStatisticsItem> watch_stats);
+
+  std::optional<formats::bson::Document> Next() override;
+  formats::bson::Document GetResumeToken() const override;
+
+ private:
+  cdriver::CDriverPoolImpl::BoundClientPtr client_;
+  cdriver::ChangeStreamPtr stream_;
+  const std::shared_ptr<stats::OperationStatisticsItem> watch_stats_;
+};
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,47 @@
+#include <userver/storages/mongo/change_stream.hpp>
+
+#include <userver/storages/mongo/exception.hpp>
+
+#include <storages/mongo/change_stream_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+namespace {
+
+// https://github.com/mongodb/mongo/blob/master/src/mongo/base/error_codes.yml
+constexpr int kInvalidResumeTokenCode = 260;
+constexpr int kChangeStreamFatalErrorCode = 280;
+constexpr int kChangeStreamHistoryLostCode = 286;
+
+}  // namespace
+
+ChangeStream::ChangeStream(std::unique_ptr<impl::ChangeStreamImpl>&& impl)
+    : impl_(std::move(impl)) {}
+
+ChangeStream::~ChangeStream() = default;
+ChangeStream::ChangeStream(ChangeStream&&) noexcept = default;
+ChangeStream& ChangeStream::operator=(ChangeStream&&) noexcept = default;
+
+std::optional<formats::bson::Document> ChangeStream::Next() {
+  return impl_->Next();
+}
+
+formats::bson::Document ChangeStream::GetResumeToken() const {
+  return impl_->GetResumeToken();
+}
+
+bool IsChangeStreamHistoryLost(const ServerException& ex) {
+  switch (ex.Code()) {
+    case kInvalidResumeTokenCode:
+    case kChangeStreamFatalErrorCode:
+    case kChangeStreamHistoryLostCode:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
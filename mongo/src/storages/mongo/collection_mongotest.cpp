@@ -546,6 +546,49 @@ UTEST_F(Collection, Drop) {
   }
 }
 
+UTEST_F(Collection, Watch) {
+  // https://github.com/mongodb/mongo/blob/master/src/mongo/base/error_codes.yml
+  constexpr int kChangeStreamsNotSupportedCode = 40573;
+  const mongo::options::MaxAwaitTime kMaxAwaitTime{
+      std::chrono::milliseconds{10}};
+
+  auto coll = GetDefaultPool().GetCollection("watch");
+  coll.InsertOne(bson::MakeDoc("_id", 1, "x", 1));
+
+  std::optional<mongo::ChangeStream> stream;
+  try {
+    stream.emplace(
+        coll.Watch(mongo::options::FullDocument::kUpdateLookup, kMaxAwaitTime));
+  } catch (const mongo::ServerException& ex) {
+    if (ex.Code() != kChangeStreamsNotSupportedCode) throw;
+    GTEST_SKIP() << "Change streams require a replica set";
+  }
+  EXPECT_FALSE(stream->Next());
+
+  coll.InsertOne(bson::MakeDoc("_id", 2, "x", 2));
+  coll.UpdateOne(bson::MakeDoc("_id", 1),
+                 bson::MakeDoc("$set", bson::MakeDoc("x", 3)));
+
+  auto insert_event = stream->Next();
+  ASSERT_TRUE(insert_event);
+  EXPECT_EQ("insert", (*insert_event)["operationType"].As<std::string>());
+  EXPECT_EQ(2, (*insert_event)["fullDocument"]["x"].As<int>());
+  const auto insert_token = stream->GetResumeToken();
+  EXPECT_FALSE(insert_token.IsEmpty());
+
+  auto update_event = stream->Next();
+  ASSERT_TRUE(update_event);
+  EXPECT_EQ("update", (*update_event)["operationType"].As<std::string>());
+  EXPECT_EQ(3, (*update_event)["fullDocument"]["x"].As<int>());
+
+  auto resumed_stream =
+      coll.Watch(mongo::options::ResumeAfter{insert_token}, kMaxAwaitTime);
+  auto resumed_event = resumed_stream.Next();
+  ASSERT_TRUE(resumed_event);
+  EXPECT_EQ("update", (*resumed_event)["operationType"].As<std::string>());
+  EXPECT_EQ(1, (*resumed_event)["documentKey"]["_id"].As<int>());
+}
+
 UTEST_F(Collection, LargeDocRoundtrip) {
   auto coll = GetDefaultPool().GetCollection("large_doc");
 
@@ -647,6 +647,63 @@ void Drop::SetOption(const options::WriteConcern& write_concern) {
   AppendWriteConcern(impl::EnsureBuilder(impl_->options), write_concern);
 }
 
+Watch::Watch() = default;
+
+Watch::Watch(formats::bson::Value pipeline) : impl_(std::move(pipeline)) {
+  if (!impl_->pipeline->IsArray()) {
+    throw InvalidQueryArgumentException(
+        "Change stream pipeline is not an array");
+  }
+}
+
+Watch::~Watch() = default;
+
+Watch::Watch(const Watch& other) = default;
+Watch::Watch(Watch&&) noexcept = default;
+Watch& Watch::operator=(const Watch& rhs) = default;
+Watch& Watch::operator=(Watch&&) noexcept = default;
+
+void Watch::SetOption(const options::ReadPreference& read_prefs) {
+  impl_->read_prefs = MakeCDriverReadPrefs(read_prefs);
+}
+
+void Watch::SetOption(options::ReadPreference::Mode mode) {
+  impl_->read_prefs = MakeCDriverReadPrefs(mode);
+}
+
+void Watch::SetOption(options::ReadConcern level) {
+  AppendReadConcern(impl::EnsureBuilder(impl_->options), level);
+}
+
+void Watch::SetOption(const options::ResumeAfter& resume_after) {
+  static const std::string kOptionName = "resumeAfter";
+  impl::EnsureBuilder(impl_->options)
+      .Append(kOptionName, resume_after.Value());
+}
+
+void Watch::SetOption(options::FullDocument full_document) {
+  if (full_document == options::FullDocument::kDefault) return;
+
+  static const std::string kOptionName = "fullDocument";
+  impl::EnsureBuilder(impl_->options).Append(kOptionName, "updateLookup");
+}
+
+void Watch::SetOption(const options::MaxAwaitTime& max_await_time) {
+  const auto value = max_await_time.Value().count();
+  if (value < 0) {
+    throw InvalidQueryArgumentException("Max await time is negative: ")
+        << value;
+  }
+
+  static const std::string kOptionName = "maxAwaitTimeMS";
+  impl::EnsureBuilder(impl_->options).Append(kOptionName, value);
+}
+
+void Watch::SetOption(const options::Comment& comment) {
+  AppendComment(impl::EnsureBuilder(impl_->options), impl_->has_comment_option,
+                comment);
+}
+
 }  // namespace storages::mongo::operations
 
 USERVER_NAMESPACE_END
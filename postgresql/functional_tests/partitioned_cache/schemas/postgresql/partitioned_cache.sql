@@ -0,0 +1,4 @@
+CREATE TABLE IF NOT EXISTS partitioned_table (
+  id BIGINT PRIMARY KEY,
+  value VARCHAR NOT NULL
+)
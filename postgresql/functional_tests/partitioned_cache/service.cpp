@@ -0,0 +1,79 @@
+#include <userver/clients/dns/component.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/minimal_server_component_list.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/server/handlers/http_handler_json_base.hpp>
+#include <userver/server/handlers/server_monitor.hpp>
+#include <userver/server/handlers/tests_control.hpp>
+#include <userver/utils/daemon_run.hpp>
+
+#include <userver/storages/postgres/component.hpp>
+
+#include <userver/cache/base_postgres_cache.hpp>
+
+namespace pg::partitioned_cache {
+
+struct KeyValue {
+  std::int64_t id;
+  std::string value;
+};
+
+struct PartitionedCachePolicy {
+  static constexpr std::string_view kName = "partitioned-pg-cache";
+
+  using ValueType = KeyValue;
+  static constexpr auto kKeyMember = &KeyValue::id;
+  static constexpr const char* kQuery =
+      "SELECT id, value FROM partitioned_table";
+  static constexpr const char* kUpdatedField = "";
+
+  static constexpr const char* kFullUpdatePartitionField = "id";
+  static constexpr std::size_t kFullUpdatePartitions = 3;
+};
+
+using PartitionedCache = components::PostgreCache<PartitionedCachePolicy>;
+
+class CacheHandler final : public server::handlers::HttpHandlerJsonBase {
+ public:
+  static constexpr std::string_view kName = "handler-partitioned-cache";
+
+  CacheHandler(const components::ComponentConfig& config,
+               const components::ComponentContext& context)
+      : HttpHandlerJsonBase(config, context),
+        cache_(context.FindComponent<PartitionedCache>()) {}
+
+  formats::json::Value HandleRequestJsonThrow(
+      const server::http::HttpRequest&, const formats::json::Value&,
+      server::request::RequestContext&) const override {
+    const auto data = cache_.Get();
+
+    formats::json::ValueBuilder values{formats::json::Type::kObject};
+    for (const auto& [id, key_value] : *data) {
+      values[std::to_string(id)] = key_value.value;
+    }
+    return values.ExtractValue();
+  }
+
+ private:
+  PartitionedCache& cache_;
+};
+
+}  // namespace pg::partitioned_cache
+
+int main(int argc, char* argv[]) {
+  const auto component_list =
+      components::MinimalServerComponentList()
+          .Append<server::handlers::ServerMonitor>()
+          .Append<pg::partitioned_cache::CacheHandler>()
+          .Append<pg::partitioned_cache::PartitionedCache>()
+          .Append<components::HttpClient>()
+          .Append<components::Postgres>("key-value-database")
+          .Append<components::TestsuiteSupport>()
+          .Append<server::handlers::TestsControl>()
+          .Append<clients::dns::Component>();
+  return utils::DaemonMain(argc, argv, component_list);
+}
@@ -0,0 +1,37 @@
+def _fill_table(pgsql, ids):
+    cursor = pgsql['partitioned_cache'].cursor()
+    cursor.execute('DELETE FROM partitioned_table')
+    for row_id in ids:
+        cursor.execute(
+            'INSERT INTO partitioned_table (id, value) VALUES (%s, %s)',
+            (row_id, f'value_{row_id}'),
+        )
+
+
+async def test_empty_table(service_client):
+    response = await service_client.get('/partitioned-cache')
+    assert response.status == 200
+    assert response.json() == {}
+
+
+async def test_full_update(service_client, pgsql):
+    # Uneven key ranges, a negative key and a gap between the partitions
+    ids = [-5, 1, 2, 3, 4, 5, 6, 7, 1000, 1001]
+    _fill_table(pgsql, ids)
+    await service_client.invalidate_caches()
+
+    response = await service_client.get('/partitioned-cache')
+    assert response.status == 200
+    assert response.json() == {str(i): f'value_{i}' for i in ids}
+
+
+async def test_full_update_drops_removed_rows(service_client, pgsql):
+    _fill_table(pgsql, range(20))
+    await service_client.invalidate_caches()
+
+    _fill_table(pgsql, [7])
+    await service_client.invalidate_caches()
+
+    response = await service_client.get('/partitioned-cache')
+    assert response.status == 200
+    assert response.json() == {'7': 'value_7'}
@@ -6,10 +6,14 @@
 #include <userver/cache/base_postgres_cache_fwd.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -23,9 +27,12 @@
 #include <userver/storages/postgres/io/chrono.hpp>
 
 #include <userver/compiler/demangle.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/void_t.hpp>
@@ -91,6 +98,20 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Updated Example
 ///
+/// Policy may split full updates into `kFullUpdatePartitions` ranges of the
+/// integer `kFullUpdatePartitionField` column of the query results. The ranges
+/// are loaded in parallel, each on its own connection, and merged into the
+/// cache container, so the memory overhead is bounded by `chunk-size` rows per
+/// range. The bounds of the ranges are looked up by `ORDER BY ... LIMIT 1`
+/// queries, so the column should be indexed for them to read a single index
+/// entry each.
+///
+/// @warning The partitioned full update is not a consistent snapshot: the
+/// bounds and every range are read in separate transactions, possibly on
+/// different hosts. Rows inserted beyond the bounds, moved between the ranges
+/// or deleted during the load may be missed or loaded stale; the policy should
+/// have `kUpdatedField` for the following incremental update to pick them up.
+///
 /// In case one provides a custom CacheContainer within Policy, it is notified
 /// of Update completion via its public member function OnWritesDone, if any.
 /// See the following code snippet for an example of usage:
@@ -285,6 +306,28 @@ constexpr bool CheckUpdatedFieldType() {
   return true;
 }
 
+// Full update partitioning
+template <typename T>
+using HasFullUpdatePartitionsImpl = decltype(T::kFullUpdatePartitions);
+template <typename T>
+using HasFullUpdatePartitionFieldImpl =
+    decltype(T::kFullUpdatePartitionField);
+
+template <typename T>
+constexpr std::size_t FullUpdatePartitions() {
+  if constexpr (meta::kIsDetected<HasFullUpdatePartitionsImpl, T>) {
+    return T::kFullUpdatePartitions;
+  } else {
+    return 1;
+  }
+}
+
+using KeyRange = std::pair<std::int64_t, std::int64_t>;
+
+// Splits [min_key, max_key] into at most `partitions` adjacent closed ranges
+std::vector<KeyRange> SplitKeyRange(std::int64_t min_key, std::int64_t max_key,
+                                    std::size_t partitions);
+
 // Cluster host type policy
 template <typename T>
 using HasClusterHostTypeImpl = decltype(T::kClusterHostType);
@@ -340,6 +383,15 @@ struct PolicyChecker {
       "please set its value to `nullptr`");
   static_assert(CheckUpdatedFieldType<PostgreCachePolicy>());
 
+  static_assert(FullUpdatePartitions<PostgreCachePolicy>() > 0,
+                "`kFullUpdatePartitions` must be positive");
+  static_assert(FullUpdatePartitions<PostgreCachePolicy>() == 1 ||
+                    meta::kIsDetected<HasFullUpdatePartitionFieldImpl,
+                                      PostgreCachePolicy>,
+                "The PosgreSQL cache policy must contain a static member "
+                "`kFullUpdatePartitionField` with an integer column to "
+                "split full updates by");
+
   static_assert(ClusterHostType<PostgreCachePolicy>() &
                     storages::postgres::kClusterHostRolesMask,
                 "Cluster host role must be specified for caching component, "
@@ -368,6 +420,12 @@ inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+
+// Rows parsed by a full update partition and the time it took
+struct PartitionParseStats {
+  std::size_t rows{0};
+  tracing::ScopeTime::DurationMillis elapsed{0};
+};
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -395,6 +453,8 @@ class PostgreCache final
   constexpr static auto kClusterHostTypeFlags =
       pg_cache::detail::ClusterHostType<PolicyType>();
   constexpr static auto kName = PolicyType::kName;
+  constexpr static std::size_t kFullUpdatePartitions =
+      pg_cache::detail::FullUpdatePartitions<PolicyType>();
 
   PostgreCache(const ComponentConfig&, const ComponentContext&);
   ~PostgreCache() override;
@@ -420,8 +480,23 @@ class PostgreCache final
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
 
+  void UpdateCpuRelaxIterationsParse(
+      std::size_t changes, tracing::ScopeTime::DurationMillis elapsed_parse);
+
+  void FullUpdatePartitioned(cache::UpdateStatisticsScope& stats_scope);
+  pg_cache::detail::PartitionParseStats LoadPartition(
+      storages::postgres::Cluster& cluster, pg_cache::detail::KeyRange range,
+      DataType& data_cache, engine::Mutex& data_mutex,
+      cache::UpdateStatisticsScope& stats_scope);
+  void MergeResults(storages::postgres::ResultSet res, DataType& data_cache,
+                    engine::Mutex& data_mutex,
+                    cache::UpdateStatisticsScope& stats_scope,
+                    tracing::ScopeTime& scope) const;
+
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
+  static storages::postgres::Query GetPartitionBoundsQuery();
+  static storages::postgres::Query GetPartitionQuery();
 
   std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
 
@@ -486,6 +561,11 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
   LOG_INFO() << "Cache " << kName << " full update query `"
              << GetAllQuery().Statement() << "` incremental update query `"
              << GetDeltaQuery().Statement() << "`";
+  if constexpr (kFullUpdatePartitions > 1) {
+    LOG_INFO() << "Cache " << kName << " full update is split into "
+               << kFullUpdatePartitions << " partitions by query `"
+               << GetPartitionQuery().Statement() << "`";
+  }
 
   this->StartPeriodicUpdates();
 }
@@ -527,6 +607,36 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
   }
 }
 
+template <typename PostgreCachePolicy>
+storages::postgres::Query
+PostgreCache<PostgreCachePolicy>::GetPartitionBoundsQuery() {
+  if constexpr (kFullUpdatePartitions > 1) {
+    // Unlike min()/max() over a subquery, these are planned as index scans
+    // stopping at the first entry
+    return storages::postgres::Query{fmt::format(
+        "select (select q.{0} from ({1}) as q where q.{0} is not null "
+        "order by q.{0} limit 1)::bigint, "
+        "(select q.{0} from ({1}) as q where q.{0} is not null "
+        "order by q.{0} desc limit 1)::bigint",
+        PolicyType::kFullUpdatePartitionField, GetAllQuery().Statement())};
+  } else {
+    UINVARIANT(false, "Full update partitioning is disabled");
+  }
+}
+
+template <typename PostgreCachePolicy>
+storages::postgres::Query
+PostgreCache<PostgreCachePolicy>::GetPartitionQuery() {
+  if constexpr (kFullUpdatePartitions > 1) {
+    return storages::postgres::Query{
+        fmt::format("select * from ({1}) as q where q.{0} between $1 and $2",
+                    PolicyType::kFullUpdatePartitionField,
+                    GetAllQuery().Statement())};
+  } else {
+    UINVARIANT(false, "Full update partitioning is disabled");
+  }
+}
+
 template <typename PostgreCachePolicy>
 std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(
     const ComponentConfig& config) {
@@ -561,6 +671,12 @@ void PostgreCache<PostgreCachePolicy>::Update(
   if constexpr (!kIncrementalUpdates) {
     type = cache::UpdateType::kFull;
   }
+  if constexpr (kFullUpdatePartitions > 1) {
+    if (type == cache::UpdateType::kFull) {
+      FullUpdatePartitioned(stats_scope);
+      return;
+    }
+  }
   const auto query =
       (type == cache::UpdateType::kFull) ? GetAllQuery() : GetDeltaQuery();
   const std::chrono::milliseconds timeout = (type == cache::UpdateType::kFull)
@@ -634,17 +750,9 @@ void PostgreCache<PostgreCachePolicy>::Update(
   }
 
   if (changes > 0) {
-    const auto elapsed_parse =
-        scope.ElapsedTotal(std::string{pg_cache::detail::kParseStage});
-    if (elapsed_parse > pg_cache::detail::kCpuRelaxThreshold) {
-      cpu_relax_iterations_parse_ = static_cast<std::size_t>(
-          static_cast<double>(changes) /
-          (elapsed_parse / pg_cache::detail::kCpuRelaxInterval));
-      LOG_TRACE() << "Elapsed time for parsing " << kName << " "
-                  << elapsed_parse.count() << " for " << changes
-                  << " data items is over threshold. Will relax CPU every "
-                  << cpu_relax_iterations_parse_ << " iterations";
-    }
+    UpdateCpuRelaxIterationsParse(
+        changes,
+        scope.ElapsedTotal(std::string{pg_cache::detail::kParseStage}));
   }
   if (changes > 0 || type == cache::UpdateType::kFull) {
     // Set current cache
@@ -682,6 +790,148 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
   }
 }
 
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::UpdateCpuRelaxIterationsParse(
+    std::size_t changes, tracing::ScopeTime::DurationMillis elapsed_parse) {
+  if (elapsed_parse > pg_cache::detail::kCpuRelaxThreshold) {
+    cpu_relax_iterations_parse_ = static_cast<std::size_t>(
+        static_cast<double>(changes) /
+        (elapsed_parse / pg_cache::detail::kCpuRelaxInterval));
+    LOG_TRACE() << "Elapsed time for parsing " << kName << " "
+                << elapsed_parse.count() << " for " << changes
+                << " data items is over threshold. Will relax CPU every "
+                << cpu_relax_iterations_parse_ << " iterations";
+  }
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::FullUpdatePartitioned(
+    cache::UpdateStatisticsScope& stats_scope) {
+  namespace pg = storages::postgres;
+
+  auto data_cache = std::make_unique<DataType>();
+  engine::Mutex data_mutex;
+  // Partitions are parsed in parallel, the per-task parse rate is what
+  // CpuRelax is tuned by
+  pg_cache::detail::PartitionParseStats parse_stats;
+
+  for (auto& cluster : clusters_) {
+    const auto bounds = cluster->Execute(
+        kClusterHostTypeFlags,
+        pg::CommandControl{full_update_timeout_,
+                           pg_cache::detail::kStatementTimeoutOff},
+        GetPartitionBoundsQuery());
+    const auto [min_key, max_key] =
+        bounds.Front()
+            .template As<std::optional<std::int64_t>,
+                         std::optional<std::int64_t>>();
+    if (!min_key || !max_key) continue;
+
+    std::vector<engine::TaskWithResult<pg_cache::detail::PartitionParseStats>>
+        tasks;
+    tasks.reserve(kFullUpdatePartitions);
+    for (const auto& range : pg_cache::detail::SplitKeyRange(
+             *min_key, *max_key, kFullUpdatePartitions)) {
+      tasks.push_back(utils::Async(
+          "pg_cache_partition",
+          [this, &cluster, range, &data_cache, &data_mutex, &stats_scope] {
+            return LoadPartition(*cluster, range, *data_cache, data_mutex,
+                                 stats_scope);
+          }));
+    }
+    for (const auto& partition_stats : engine::GetAll(tasks)) {
+      parse_stats.rows += partition_stats.rows;
+      parse_stats.elapsed += partition_stats.elapsed;
+    }
+  }
+
+  if (parse_stats.rows > 0) {
+    UpdateCpuRelaxIterationsParse(parse_stats.rows, parse_stats.elapsed);
+  }
+
+  stats_scope.Finish(data_cache->size());
+  pg_cache::detail::OnWritesDone(*data_cache);
+  this->Set(std::move(data_cache));
+}
+
+template <typename PostgreCachePolicy>
+pg_cache::detail::PartitionParseStats
+PostgreCache<PostgreCachePolicy>::LoadPartition(
+    storages::postgres::Cluster& cluster, pg_cache::detail::KeyRange range,
+    DataType& data_cache, engine::Mutex& data_mutex,
+    cache::UpdateStatisticsScope& stats_scope) {
+  namespace pg = storages::postgres;
+  const auto start = std::chrono::steady_clock::now();
+  const pg::CommandControl cc{full_update_timeout_,
+                              pg_cache::detail::kStatementTimeoutOff};
+
+  pg_cache::detail::PartitionParseStats parse_stats;
+  auto scope = tracing::Span::CurrentSpan().CreateScopeTime(
+      std::string{pg_cache::detail::kFetchStage});
+  if (chunk_size_ > 0) {
+    auto trx = cluster.Begin(kClusterHostTypeFlags, pg::Transaction::RO, cc);
+    auto portal =
+        trx.MakePortal(GetPartitionQuery(), range.first, range.second);
+    while (portal) {
+      scope.Reset(std::string{pg_cache::detail::kFetchStage});
+      auto res = portal.Fetch(chunk_size_);
+      stats_scope.IncreaseDocumentsReadCount(res.Size());
+      parse_stats.rows += res.Size();
+
+      scope.Reset(std::string{pg_cache::detail::kParseStage});
+      MergeResults(std::move(res), data_cache, data_mutex, stats_scope, scope);
+    }
+    trx.Commit();
+  } else {
+    auto res = cluster.Execute(kClusterHostTypeFlags, cc, GetPartitionQuery(),
+                               range.first, range.second);
+    stats_scope.IncreaseDocumentsReadCount(res.Size());
+    parse_stats.rows += res.Size();
+
+    scope.Reset(std::string{pg_cache::detail::kParseStage});
+    MergeResults(std::move(res), data_cache, data_mutex, stats_scope, scope);
+  }
+  scope.Reset();
+  parse_stats.elapsed =
+      scope.ElapsedTotal(std::string{pg_cache::detail::kParseStage});
+
+  stats_scope.AccountPartitionDuration(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start));
+  return parse_stats;
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::MergeResults(
+    storages::postgres::ResultSet res, DataType& data_cache,
+    engine::Mutex& data_mutex, cache::UpdateStatisticsScope& stats_scope,
+    tracing::ScopeTime& scope) const {
+  // Rows are parsed concurrently, only the insertion is serialized
+  std::vector<ValueType> values;
+  values.reserve(res.Size());
+
+  auto rows = res.AsSetOf<RawValueType>(storages::postgres::kRowTag);
+  utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+  for (auto p = rows.begin(); p != rows.end(); ++p) {
+    relax.Relax();
+    try {
+      values.push_back(pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+    } catch (const std::exception& e) {
+      stats_scope.IncreaseDocumentsParseFailures(1);
+      LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+                  << compiler::GetTypeName<ValueType>() << "': " << e.what();
+    }
+  }
+
+  std::lock_guard lock{data_mutex};
+  for (auto& value : values) {
+    relax.Relax();
+    using pg_cache::detail::CacheInsertOrAssign;
+    CacheInsertOrAssign(data_cache, std::move(value),
+                        PostgreCachePolicy::kKeyMember);
+  }
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
@@ -22,6 +22,7 @@
 
 #include <userver/compiler/demangle.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/meta.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -812,6 +813,39 @@ struct TupleDataExtractor<std::tuple<T...>>
     : RowDataExtractorBase<std::index_sequence_for<T...>, T...> {};
 //@}
 
+//@{
+/** @name Bulk extraction */
+// Vectors are resized once and the rows are decoded right into their
+// elements, skipping the per-row Row/Field objects and checks.
+template <typename Container>
+inline constexpr bool kCanDecodeInPlace =
+    meta::kIsVector<Container> &&
+    std::is_default_constructible_v<typename Container::value_type> &&
+    !std::is_same_v<typename Container::value_type, bool>;
+
+template <typename Tuple, std::size_t... Indexes>
+void DecodeRowFields(const ResultWrapper& res, std::size_t row_index,
+                     Tuple&& tuple, std::index_sequence<Indexes...>) {
+  (FieldView{res, row_index, Indexes}.To(std::get<Indexes>(tuple)), ...);
+}
+
+template <typename Container>
+void DecodeRows(const ResultWrapper& res, Container& c, FieldTag) {
+  for (std::size_t i = 0; i < c.size(); ++i) {
+    FieldView{res, i, 0}.To(c[i]);
+  }
+}
+
+template <typename Container>
+void DecodeRows(const ResultWrapper& res, Container& c, RowTag) {
+  using RowType = io::RowType<typename Container::value_type>;
+  for (std::size_t i = 0; i < c.size(); ++i) {
+    DecodeRowFields(res, i, RowType::GetTuple(c[i]),
+                    std::make_index_sequence<RowType::size>{});
+  }
+}
+//@}
+
 }  // namespace detail
 
 template <typename T>
@@ -958,10 +992,16 @@ Container ResultSet::AsContainer() const {
   detail::AssertSaneTypeToDeserialize<Container>();
   using ValueType = typename Container::value_type;
   Container c;
+  auto res = AsSetOf<ValueType>();
+  if constexpr (detail::kCanDecodeInPlace<Container>) {
+    c.resize(res.Size());
+    detail::DecodeRows(*pimpl_, c, kFieldTag);
+    return c;
+  }
+
   if constexpr (io::traits::kCanReserve<Container>) {
     c.reserve(Size());
   }
-  auto res = AsSetOf<ValueType>();
 
   auto inserter = io::traits::Inserter(c);
   auto row_it = res.begin();
@@ -977,10 +1017,28 @@ Container ResultSet::AsContainer(RowTag) const {
   detail::AssertSaneTypeToDeserialize<Container>();
   using ValueType = typename Container::value_type;
   Container c;
+  auto res = AsSetOf<ValueType>(kRowTag);
+  if constexpr (detail::kCanDecodeInPlace<Container>) {
+    constexpr auto tuple_size = io::RowType<ValueType>::size;
+    if (!res.IsEmpty()) {
+      if (tuple_size > FieldCount()) {
+        throw InvalidTupleSizeRequested(FieldCount(), tuple_size);
+      } else if (tuple_size < FieldCount()) {
+        LOG_LIMITED_WARNING()
+            << "Row size is greater that the number of data members in "
+               "C++ user datatype "
+            << compiler::GetTypeName<ValueType>();
+      }
+    }
+
+    c.resize(res.Size());
+    detail::DecodeRows(*pimpl_, c, kRowTag);
+    return c;
+  }
+
   if constexpr (io::traits::kCanReserve<Container>) {
     c.reserve(Size());
   }
-  auto res = AsSetOf<ValueType>(kRowTag);
 
   auto inserter = io::traits::Inserter(c);
   auto row_it = res.begin();
@@ -1,9 +1,37 @@
 #include <userver/cache/base_postgres_cache.hpp>
 
+#include <algorithm>
+
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace components::pg_cache::detail {
+
+std::vector<KeyRange> SplitKeyRange(std::int64_t min_key, std::int64_t max_key,
+                                    std::size_t partitions) {
+  UASSERT(min_key <= max_key);
+  UASSERT(partitions > 0);
+  if (partitions == 1) return {{min_key, max_key}};
+
+  // Unsigned arithmetic does not overflow on the whole int64 range
+  const auto min = static_cast<std::uint64_t>(min_key);
+  const auto max = static_cast<std::uint64_t>(max_key);
+  const auto step = (max - min) / partitions + 1;
+
+  std::vector<KeyRange> ranges;
+  ranges.reserve(partitions);
+  for (auto lower = min;; lower += step) {
+    const auto upper = lower + std::min(step - 1, max - lower);
+    ranges.emplace_back(static_cast<std::int64_t>(lower),
+                        static_cast<std::int64_t>(upper));
+    if (upper == max) break;
+  }
+  return ranges;
+}
+
+}  // namespace components::pg_cache::detail
+
 namespace components::impl {
 
 std::string GetPostgreCacheSchema() {
@@ -5,6 +5,7 @@
 #include <boost/functional/hash.hpp>
 
 #include <userver/components/minimal_server_component_list.hpp>
+#include <userver/utest/utest.hpp>
 #include <userver/utils/projected_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -98,6 +99,19 @@ struct PostgresExamplePolicy {
   //
   // Required: no
   static constexpr bool kMayReturnNull = false;
+
+  // Integer column of the query results to split full updates by.
+  //
+  // Required: **yes** if `kFullUpdatePartitions` is greater than 1
+  static constexpr const char* kFullUpdatePartitionField = "id";
+
+  // Number of `kFullUpdatePartitionField` ranges loaded in parallel on full
+  // updates, each one on its own connection.
+  //
+  // Default value is 1, the whole data is loaded by a single query.
+  //
+  // Required: no
+  static constexpr std::size_t kFullUpdatePartitions = 4;
 };
 
 }  // namespace example
@@ -323,6 +337,9 @@ static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 
+static_assert(MyCache1::kFullUpdatePartitions == 4);
+static_assert(MyCache2::kFullUpdatePartitions == 1);
+
 // Update() instantiation test
 [[maybe_unused]] void VerifyUpdateCompiles(
     const components::ComponentConfig& config,
@@ -344,6 +361,21 @@ inline auto SampleOfComponentRegistration() {
   /*! [Pg Cache Trivial Usage] */
 }
 
+TEST(PostgreCache, SplitKeyRange) {
+  using pg_cache::detail::KeyRange;
+  using pg_cache::detail::SplitKeyRange;
+  using Ranges = std::vector<KeyRange>;
+  constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+  constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+
+  EXPECT_EQ(SplitKeyRange(1, 10, 1), (Ranges{{1, 10}}));
+  EXPECT_EQ(SplitKeyRange(1, 10, 2), (Ranges{{1, 5}, {6, 10}}));
+  EXPECT_EQ(SplitKeyRange(1, 10, 3), (Ranges{{1, 4}, {5, 8}, {9, 10}}));
+  EXPECT_EQ(SplitKeyRange(-5, -4, 4), (Ranges{{-5, -5}, {-4, -4}}));
+  EXPECT_EQ(SplitKeyRange(7, 7, 4), (Ranges{{7, 7}}));
+  EXPECT_EQ(SplitKeyRange(kMin, kMax, 2), (Ranges{{kMin, -1}, {0, kMax}}));
+}
+
 }  // namespace components::example
 
 USERVER_NAMESPACE_END
@@ -148,6 +148,8 @@ bool AddTypeBufferCategories(std::size_t n_fields,
 
 struct ResultWrapper::CachedFieldBufferCategories final {
   boost::container::small_vector<io::BufferCategory, 16> data;
+  // Checked once here instead of on every field access
+  bool all_fields_binary{false};
 };
 
 ResultWrapper::ResultWrapper(ResultHandle&& res) : handle_{std::move(res)} {
@@ -193,6 +195,15 @@ void ResultWrapper::FillBufferCategories(const UserTypes& types) {
         (f == buffer_categories_.end() ? io::BufferCategory::kNoParser
                                        : f->second);
   }
+
+  bool all_fields_binary = true;
+  for (std::size_t f_no = 0; f_no < n_fields; ++f_no) {
+    if (PQfformat(handle_.get(), f_no) != io::kPgBinaryDataFormat) {
+      all_fields_binary = false;
+      break;
+    }
+  }
+  cached_buffer_categories_->all_fields_binary = all_fields_binary;
 }
 
 ExecStatusType ResultWrapper::GetStatus() const {
@@ -272,7 +283,8 @@ std::size_t ResultWrapper::GetFieldLength(std::size_t row,
 
 io::FieldBuffer ResultWrapper::GetFieldBuffer(std::size_t row,
                                               std::size_t col) const {
-  if (PQfformat(handle_.get(), col) != io::kPgBinaryDataFormat) {
+  if (!cached_buffer_categories_->all_fields_binary &&
+      PQfformat(handle_.get(), col) != io::kPgBinaryDataFormat) {
     throw ResultSetError{
         fmt::format("Column with index {} has text format\n", col) +
         logging::stacktrace_cache::to_string(boost::stacktrace::stacktrace{})};
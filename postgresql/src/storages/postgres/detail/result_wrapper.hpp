@@ -78,7 +78,7 @@ class ResultWrapper {
   io::TypeBufferCategory buffer_categories_;
 
   struct CachedFieldBufferCategories;
-  USERVER_NAMESPACE::utils::FastPimpl<CachedFieldBufferCategories, 88, 8>
+  USERVER_NAMESPACE::utils::FastPimpl<CachedFieldBufferCategories, 96, 8>
       cached_buffer_categories_;
 };
 
@@ -1,10 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include <limits>
+#include <string>
+#include <vector>
 
 #include <storages/postgres/detail/connection.hpp>
 
 #include <storages/postgres/util_benchmark.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/typed_result_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,6 +17,13 @@ namespace {
 namespace pg = storages::postgres;
 using namespace pg::bench;
 
+struct BenchRow {
+  std::int64_t id;
+  std::int32_t value;
+  double ratio;
+  std::string name;
+};
+
 BENCHMARK_F(PgConnection, BoolRoundtrip)(benchmark::State& state) {
   RunStandalone(state, [this, &state] {
     bool v = true;
@@ -53,6 +64,55 @@ BENCHMARK_F(PgConnection, Int64Roundtrip)(benchmark::State& state) {
   });
 }
 
+BENCHMARK_DEFINE_F(PgConnection, RowsDecodeBulk)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = FetchRows(state.range(0));
+    for (auto _ : state) {
+      auto rows = res.AsContainer<std::vector<BenchRow>>(pg::kRowTag);
+      benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, RowsDecodeBulk)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 16);
+
+BENCHMARK_DEFINE_F(PgConnection, RowsDecodeByRow)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = FetchRows(state.range(0));
+    for (auto _ : state) {
+      std::vector<BenchRow> rows;
+      rows.reserve(res.Size());
+      for (auto row : res.AsSetOf<BenchRow>(pg::kRowTag)) {
+        rows.push_back(std::move(row));
+      }
+      benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, RowsDecodeByRow)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 16);
+
+BENCHMARK_DEFINE_F(PgConnection, Int64ColumnDecodeBulk)
+(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = GetConnection().Execute(
+        "select i from generate_series(1, $1) i",
+        static_cast<std::int64_t>(state.range(0)));
+    for (auto _ : state) {
+      auto ids = res.AsContainer<std::vector<std::int64_t>>();
+      benchmark::DoNotOptimize(ids);
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, Int64ColumnDecodeBulk)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 16);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
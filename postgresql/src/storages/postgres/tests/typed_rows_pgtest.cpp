@@ -165,6 +165,42 @@ UTEST_P(PostgreConnection, TypedResultIterators) {
   EXPECT_EQ(++reverse_it, tuples_res.crend());
 }
 
+UTEST_P(PostgreConnection, TypedResultBulkContainer) {
+  using MyStruct = static_test::MyAggregateStruct;
+
+  CheckConnection(GetConn());
+  pg::ResultSet res{nullptr};
+
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute("select i, 'str' || i::text, i::float8 / 2 "
+                               "from generate_series(1, 100) i"));
+  ASSERT_EQ(100, res.Size());
+
+  const auto structs = res.AsContainer<std::vector<MyStruct>>(pg::kRowTag);
+  const auto struct_list = res.AsContainer<std::list<MyStruct>>(pg::kRowTag);
+  ASSERT_EQ(res.Size(), structs.size());
+  ASSERT_EQ(res.Size(), struct_list.size());
+
+  auto list_it = struct_list.begin();
+  for (const auto& s : structs) {
+    EXPECT_EQ(s.int_member, list_it->int_member);
+    EXPECT_EQ(s.string_member, "str" + std::to_string(s.int_member));
+    EXPECT_EQ(s.string_member, list_it->string_member);
+    EXPECT_EQ(s.double_member, list_it->double_member);
+    ++list_it;
+  }
+
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute("select i from generate_series(1, 100) i"));
+  const auto ints = res.AsContainer<std::vector<int>>();
+  ASSERT_EQ(res.Size(), ints.size());
+  for (std::size_t i = 0; i < ints.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i) + 1, ints[i]);
+  }
+  UEXPECT_THROW(res.AsContainer<std::vector<MyStruct>>(pg::kRowTag),
+                pg::InvalidTupleSizeRequested);
+}
+
 UTEST_P(PostgreConnection, OptionalFields) {
   using MyStruct = static_test::MyStructWithOptional;
 
@@ -58,6 +58,13 @@ void PgConnection::RunStandalone(benchmark::State& state,
   });
 }
 
+ResultSet PgConnection::FetchRows(std::size_t rows_count) const {
+  return conn_->Execute(
+      "select i, i::integer, i::double precision / 3, 'string ' || i::text "
+      "from generate_series(1, $1) i",
+      static_cast<std::int64_t>(rows_count));
+}
+
 bool PgConnection::IsConnectionValid() const {
   return conn_ && conn_->IsConnected();
 }
@@ -5,6 +5,7 @@
 #include <benchmark/benchmark.h>
 
 #include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/result_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,6 +23,10 @@ class PgConnection : public benchmark::Fixture {
 
   detail::Connection& GetConnection() const noexcept { return *conn_; }
 
+  // Fetches `rows_count` rows of (bigint, integer, double precision, text) for
+  // the result set decoding benchmarks
+  ResultSet FetchRows(std::size_t rows_count) const;
+
   // Should be used for starting the benchmark's coroutine environment instead
   // of engine::RunStandalone
   void RunStandalone(benchmark::State& state, std::function<void()> payload);
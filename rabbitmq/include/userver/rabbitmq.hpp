@@ -10,6 +10,7 @@
 #include <userver/urabbitmq/client.hpp>
 #include <userver/urabbitmq/client_settings.hpp>
 #include <userver/urabbitmq/component.hpp>
+#include <userver/urabbitmq/confirmation_future.hpp>
 #include <userver/urabbitmq/consumer_base.hpp>
 #include <userver/urabbitmq/consumer_component_base.hpp>
 #include <userver/urabbitmq/consumer_settings.hpp>
@@ -28,7 +29,7 @@
 /// current coroutine for carrying out network I/O.
 ///
 /// @section feature Features
-/// - Publishing messages;
+/// - Publishing messages, including pipelined publisher confirms;
 /// - Consuming messages;
 /// - Creating Exchanges, Queues and Bindings;
 /// - Transport level security;
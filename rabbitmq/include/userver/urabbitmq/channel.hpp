@@ -4,10 +4,12 @@
 /// @brief Publisher interface for the broker.
 
 #include <memory>
+#include <vector>
 
 #include <userver/utils/fast_pimpl.hpp>
 
 #include <userver/urabbitmq/broker_interface.hpp>
+#include <userver/urabbitmq/confirmation_future.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -77,6 +79,44 @@ class ReliableChannel final : IReliableChannelInterface {
                     deadline);
   }
 
+  /// @brief Publish a message to an exchange without waiting for
+  /// the broker confirmation.
+  ///
+  /// Messages are pipelined: every connection keeps a window of up to
+  /// `max_unconfirmed_publishes` messages awaiting confirmation, and this
+  /// method only blocks when the window is full. A single broker confirm
+  /// resolves all the messages it covers at once.
+  ///
+  /// @param exchange the exchange to publish to
+  /// @param routing_key the routing key
+  /// @param message the message to send
+  /// @param deadline deadline for the message to be sent, doesn't limit the
+  /// confirmation wait
+  /// @returns a future for the broker confirmation
+  [[nodiscard]] ConfirmationFuture PublishReliableAsync(
+      const Exchange& exchange, const std::string& routing_key,
+      const std::string& message, MessageType type, engine::Deadline deadline);
+
+  /// @brief overload of PublishReliableAsync
+  [[nodiscard]] ConfirmationFuture PublishReliableAsync(
+      const Exchange& exchange, const std::string& routing_key,
+      const std::string& message, engine::Deadline deadline) {
+    return PublishReliableAsync(exchange, routing_key, message,
+                                MessageType::kTransient, deadline);
+  }
+
+  /// @brief Publish a batch of messages to an exchange and await
+  /// confirmation of all of them from the broker.
+  ///
+  /// Messages are pipelined via `PublishReliableAsync`, which is much faster
+  /// than publishing them one by one with `PublishReliable`.
+  ///
+  /// @throws std::runtime_error if any of the messages wasn't confirmed
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            MessageType type, engine::Deadline deadline);
+
  private:
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
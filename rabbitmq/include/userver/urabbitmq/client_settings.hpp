@@ -57,6 +57,13 @@ struct PoolSettings final {
   /// (tcp error/protocol error/write timeout) leads to a errors burst:
   /// all outstanding request will fails at once
   size_t max_in_flight_requests = 5;
+
+  /// A per-connection limit for reliable publishes that were sent to the
+  /// broker but are not confirmed yet (see
+  /// `ReliableChannel::PublishReliableAsync`).
+  /// Publishing blocks until some of the outstanding messages are confirmed
+  /// once the limit is reached.
+  size_t max_unconfirmed_publishes = 1000;
 };
 
 class TestsHelper;
@@ -44,13 +44,14 @@ namespace components {
 /// @snippet samples/rabbitmq_service/tests/conftest.py  RabbitMQ service sample - secdist
 ///
 /// ## Static options:
-/// Name                    | Description                                                          | Default value
-/// ----------------------- | -------------------------------------------------------------------- | ---------------
-/// secdist_alias           | name of the key in secdist config                                    | components name
-/// min_pool_size           | minimum connections pool size (per host)                             | 5
-/// max_pool_size           | maximum connections pool size (per host, consumers excluded)         | 10
-/// max_in_flight_requests  | per-connection limit for requests awaiting response from the broker  | 5
-/// use_secure_connection   | whether to use TLS for connections                                   | true
+/// Name                      | Description                                                         | Default value
+/// ------------------------- | ------------------------------------------------------------------- | ---------------
+/// secdist_alias             | name of the key in secdist config                                   | components name
+/// min_pool_size             | minimum connections pool size (per host)                            | 5
+/// max_pool_size             | maximum connections pool size (per host, consumers excluded)        | 10
+/// max_in_flight_requests    | per-connection limit for requests awaiting response from the broker | 5
+/// max_unconfirmed_publishes | per-connection limit for reliable publishes awaiting broker confirm | 1000
+/// use_secure_connection     | whether to use TLS for connections                                  | true
 ///
 // clang-format on
 
@@ -0,0 +1,50 @@
+#pragma once
+
+/// @file userver/urabbitmq/confirmation_future.hpp
+/// @brief @copybrief urabbitmq::ConfirmationFuture
+
+#include <memory>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq {
+
+namespace impl {
+class DeferredWrapper;
+}
+
+/// @brief A handle to a broker confirmation of a message published with
+/// `ReliableChannel::PublishReliableAsync`.
+///
+/// Dropping the future without waiting is allowed: the message is still
+/// published and confirmed, the outcome is just discarded.
+class ConfirmationFuture final {
+ public:
+  ~ConfirmationFuture();
+
+  ConfirmationFuture(ConfirmationFuture&& other) noexcept;
+  ConfirmationFuture& operator=(ConfirmationFuture&& other) noexcept;
+
+  /// @brief Wait for the broker to confirm the message.
+  ///
+  /// @throws std::runtime_error if the message was rejected by the broker,
+  /// the channel broke before the confirmation arrived or the deadline
+  /// expired.
+  void Wait(engine::Deadline deadline);
+
+  /// @brief Whether the broker has already acked or rejected the message,
+  /// that is `Wait` won't block.
+  bool IsReady() const noexcept;
+
+ private:
+  friend class ReliableChannel;
+  explicit ConfirmationFuture(std::shared_ptr<impl::DeferredWrapper> wrapper);
+
+  std::shared_ptr<impl::DeferredWrapper> wrapper_;
+};
+
+}  // namespace urabbitmq
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 /// @brief Base class for your consumers.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/utils/periodic_task.hpp>
 
@@ -70,6 +72,24 @@ class ConsumerBase {
   /// It is however guaranteed for message to be requeued if `Process` fails.
   virtual void Process(std::string message) = 0;
 
+  /// @brief Override this method in derived class to handle a batch of
+  /// messages at once, only called if batch mode is enabled via
+  /// `ConsumerSettings::max_batch_size`.
+  ///
+  /// If this method returns successfully the whole batch would be acked with
+  /// a single `basic.ack` (best effort), if this method throws the whole batch
+  /// would be requeued.
+  ///
+  /// The delivery is at-least-once for the whole batch: a failure of any
+  /// message requeues all of them, including the ones that have already been
+  /// processed, so the processing must be idempotent. Throw only if the batch
+  /// should be retried as a whole; messages that can never be processed should
+  /// be handled (e.g. logged or sent elsewhere) rather than fail the batch.
+  ///
+  /// Default implementation calls `Process` for every message in order, so the
+  /// messages before the failed one are delivered again as well.
+  virtual void ProcessBatch(std::vector<std::string> messages);
+
  private:
   std::shared_ptr<Client> client_;
   const ConsumerSettings settings_;
@@ -4,6 +4,8 @@
 /// @brief Base component for your consumers.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/components/loggable_component_base.hpp>
 
@@ -34,10 +36,13 @@ namespace urabbitmq {
 /// @snippet samples/rabbitmq_service/static_config.yaml  RabbitMQ consumer sample - static config
 ///
 /// ## Static options:
-/// Name             | Description
-/// rabbit_name      | Name of the RabbitMQ component to use for consumption
-/// queue            | Name of the queue to consume from
-/// prefetch_count   | prefetch_count for the consumer, limits the amount of in-flight messages
+/// Name              | Description
+/// rabbit_name       | Name of the RabbitMQ component to use for consumption
+/// queue             | Name of the queue to consume from
+/// prefetch_count    | prefetch_count for the consumer, limits the amount of in-flight messages
+/// max_batch_size    | enables batch mode (see `ProcessBatch`) if non-zero, maximum amount of messages in a batch; 0 by default
+/// max_batch_delay   | batch mode: how long to wait for a batch to fill up; 10ms by default
+/// batch_concurrency | batch mode: amount of batches processed concurrently; 1 by default
 ///
 // clang-format on
 class ConsumerComponentBase : public components::LoggableComponentBase {
@@ -66,6 +71,23 @@ class ConsumerComponentBase : public components::LoggableComponentBase {
   /// It is however guaranteed for message to be requeued if `Process` fails.
   virtual void Process(std::string message) = 0;
 
+  /// @brief Override this method in derived class to handle a batch of
+  /// messages at once, only called if `max_batch_size` is set.
+  ///
+  /// If this method returns successfully the whole batch would be acked with
+  /// a single `basic.ack` (best effort), if this method throws the whole batch
+  /// would be requeued.
+  ///
+  /// The delivery is at-least-once for the whole batch: a failure of any
+  /// message requeues all of them, including the ones that have already been
+  /// processed, so the processing must be idempotent. Throw only if the batch
+  /// should be retried as a whole; messages that can never be processed should
+  /// be handled (e.g. logged or sent elsewhere) rather than fail the batch.
+  ///
+  /// Default implementation calls `Process` for every message in order, so the
+  /// messages before the failed one are delivered again as well.
+  virtual void ProcessBatch(std::vector<std::string> messages);
+
  private:
   // This is actually just a subclass of `ConsumerBase`
   class Impl;
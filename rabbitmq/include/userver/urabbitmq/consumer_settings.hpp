@@ -3,6 +3,7 @@
 /// @file userver/urabbitmq/consumer_settings.hpp
 /// @brief Consumer settings.
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/urabbitmq/typedefs.hpp>
@@ -24,6 +25,22 @@ struct ConsumerSettings final {
   /// Settings this value to 1 basically makes a consumer synchronous, which
   /// could be of use for some workloads
   std::uint16_t prefetch_count;
+
+  /// Enables batch mode if non-zero: messages are passed to
+  /// `ConsumerBase::ProcessBatch` in batches of up to this size, and a
+  /// successfully processed batch is acked with a single `basic.ack`
+  /// (multiple=true) instead of an ack per message.
+  ///
+  /// Keep `prefetch_count` at least `max_batch_size * batch_concurrency`,
+  /// otherwise batches will never fill up.
+  std::size_t max_batch_size{0};
+
+  /// Batch mode: how long to wait for a batch to fill up before passing
+  /// whatever has arrived so far to `ConsumerBase::ProcessBatch`
+  std::chrono::milliseconds max_batch_delay{10};
+
+  /// Batch mode: amount of batches that might be processed concurrently
+  std::size_t batch_concurrency{1};
 };
 
 }  // namespace urabbitmq
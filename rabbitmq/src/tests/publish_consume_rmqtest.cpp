@@ -75,6 +75,70 @@ class ThrowingConsumer final : public urabbitmq::ConsumerBase {
   engine::ConditionVariable cond_;
 };
 
+class BatchConsumer final : public urabbitmq::ConsumerBase {
+ public:
+  using urabbitmq::ConsumerBase::ConsumerBase;
+  ~BatchConsumer() override { Stop(); }
+
+  void Process(std::string) override {
+    ADD_FAILURE() << "Process shouldn't be called in batch mode";
+  }
+
+  void ProcessBatch(std::vector<std::string> messages) override {
+    if (fail_first_batch_.exchange(false)) {
+      throw std::runtime_error{"first batch fails"};
+    }
+
+    const auto batch_size = messages.size();
+    {
+      auto locked = batch_sizes_.Lock();
+      locked->push_back(batch_size);
+    }
+
+    if ((consumed_ += batch_size) >= expected_consumed_) {
+      event_.Send();
+    }
+  }
+
+  void ExpectConsume(size_t count) { expected_consumed_ = count; }
+
+  void FailFirstBatch() { fail_first_batch_ = true; }
+
+  std::vector<size_t> Wait() {
+    [[maybe_unused]] auto res = event_.WaitForEventFor(utest::kMaxTestWaitTime);
+
+    auto locked = batch_sizes_.Lock();
+    return *locked;
+  }
+
+  size_t GetConsumed() const { return consumed_; }
+
+ private:
+  concurrent::Variable<std::vector<size_t>> batch_sizes_;
+  std::atomic<size_t> expected_consumed_{0};
+  std::atomic<size_t> consumed_{0};
+  std::atomic<bool> fail_first_batch_{false};
+  engine::SingleConsumerEvent event_;
+};
+
+std::vector<std::string> MakeMessages(size_t count) {
+  std::vector<std::string> messages;
+  messages.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+  return messages;
+}
+
+urabbitmq::ConsumerSettings MakeBatchSettings(const urabbitmq::Queue& queue,
+                                              size_t batch_concurrency) {
+  urabbitmq::ConsumerSettings settings{queue, 200};
+  settings.max_batch_size = 50;
+  settings.max_batch_delay = std::chrono::milliseconds{20};
+  settings.batch_concurrency = batch_concurrency;
+  return settings;
+}
+
 }  // namespace
 
 UTEST(Consumer, CreateOnInvalidQueueWorks) {
@@ -150,6 +214,54 @@ UTEST(Consumer, ExhaustesQueue) {
   consumer.Wait();
 }
 
+UTEST(Consumer, PublishReliableAsyncWorks) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  const size_t messages_count = 1000;
+  auto channel = client->GetReliableChannel(client.GetDeadline());
+  std::vector<urabbitmq::ConfirmationFuture> confirmations;
+  confirmations.reserve(messages_count);
+  for (size_t i = 0; i < messages_count; ++i) {
+    confirmations.push_back(channel.PublishReliableAsync(
+        client.GetExchange(), client.GetRoutingKey(), std::to_string(i),
+        urabbitmq::MessageType::kTransient, client.GetDeadline()));
+  }
+  for (auto& confirmation : confirmations) {
+    UEXPECT_NO_THROW(confirmation.Wait(client.GetDeadline()));
+    EXPECT_TRUE(confirmation.IsReady());
+  }
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+
+  EXPECT_EQ(consumer.Wait().size(), messages_count);
+}
+
+UTEST(Consumer, PublishReliableBatchWorks) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < 500; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+
+  auto channel = client->GetReliableChannel(client.GetDeadline());
+  channel.PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                               messages, urabbitmq::MessageType::kTransient,
+                               client.GetDeadline());
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages.size());
+  consumer.Start();
+
+  EXPECT_EQ(consumer.Wait().size(), messages.size());
+}
+
 UTEST(Consumer, ThrowsReturnsToQueue) {
   ClientWrapper client{};
   client.SetupRmqEntities();
@@ -234,4 +346,65 @@ UTEST(Consumer, ForDifferentQueuesWork) {
       .RemoveQueue(second_queue, client.GetDeadline());
 }
 
+UTEST(Consumer, BatchConsumeWorks) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+
+  const auto messages = MakeMessages(1000);
+  client->GetReliableChannel(client.GetDeadline())
+      .PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                            messages, urabbitmq::MessageType::kTransient,
+                            client.GetDeadline());
+
+  BatchConsumer consumer{client.Get(),
+                         MakeBatchSettings(client.GetQueue(), 1)};
+  consumer.ExpectConsume(messages.size());
+  consumer.Start();
+
+  const auto batch_sizes = consumer.Wait();
+  EXPECT_EQ(consumer.GetConsumed(), messages.size());
+  EXPECT_LT(batch_sizes.size(), messages.size());
+  for (const auto batch_size : batch_sizes) {
+    EXPECT_LE(batch_size, 50);
+  }
+}
+
+UTEST(Consumer, BatchConsumeConcurrentWorks) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+
+  const auto messages = MakeMessages(1000);
+  client->GetReliableChannel(client.GetDeadline())
+      .PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                            messages, urabbitmq::MessageType::kTransient,
+                            client.GetDeadline());
+
+  BatchConsumer consumer{client.Get(),
+                         MakeBatchSettings(client.GetQueue(), 4)};
+  consumer.ExpectConsume(messages.size());
+  consumer.Start();
+  consumer.Wait();
+  EXPECT_EQ(consumer.GetConsumed(), messages.size());
+}
+
+UTEST(Consumer, BatchThrowsReturnsToQueue) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+
+  const auto messages = MakeMessages(200);
+  client->GetReliableChannel(client.GetDeadline())
+      .PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                            messages, urabbitmq::MessageType::kTransient,
+                            client.GetDeadline());
+
+  BatchConsumer consumer{client.Get(),
+                         MakeBatchSettings(client.GetQueue(), 2)};
+  consumer.FailFirstBatch();
+  consumer.ExpectConsume(messages.size());
+  consumer.Start();
+  consumer.Wait();
+
+  EXPECT_EQ(consumer.GetConsumed(), messages.size());
+}
+
 USERVER_NAMESPACE_END
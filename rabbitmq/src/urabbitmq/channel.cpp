@@ -44,6 +44,29 @@ void ReliableChannel::PublishReliable(const Exchange& exchange,
       .Wait(deadline);
 }
 
+ConfirmationFuture ReliableChannel::PublishReliableAsync(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::string& message, MessageType type, engine::Deadline deadline) {
+  return ConfirmationFuture{ConnectionHelper::PublishReliableAsync(
+      *impl_, exchange, routing_key, message, type, deadline)};
+}
+
+void ReliableChannel::PublishReliableBatch(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::vector<std::string>& messages, MessageType type,
+    engine::Deadline deadline) {
+  std::vector<ConfirmationFuture> confirmations;
+  confirmations.reserve(messages.size());
+  for (const auto& message : messages) {
+    confirmations.push_back(
+        PublishReliableAsync(exchange, routing_key, message, type, deadline));
+  }
+
+  for (auto& confirmation : confirmations) {
+    confirmation.Wait(deadline);
+  }
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
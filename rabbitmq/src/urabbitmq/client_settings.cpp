@@ -72,10 +72,15 @@ PoolSettings Parse(const yaml_config::YamlConfig& config,
       config["max_pool_size"].As<size_t>(result.max_pool_size);
   result.max_in_flight_requests = config["max_in_flight_requests"].As<size_t>(
       result.max_in_flight_requests);
+  result.max_unconfirmed_publishes =
+      config["max_unconfirmed_publishes"].As<size_t>(
+          result.max_unconfirmed_publishes);
 
   UINVARIANT(result.min_pool_size <= result.max_pool_size,
              "max_pool_size is less than min_pool_size");
   UINVARIANT(result.max_pool_size > 0, "max_pool_size is set to zero");
+  UINVARIANT(result.max_unconfirmed_publishes > 0,
+             "max_unconfirmed_publishes is set to zero");
 
   return result;
 }
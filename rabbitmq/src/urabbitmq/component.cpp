@@ -72,6 +72,11 @@ properties:
         description: |
           per-connection limit for requests awaiting response from the broker
         defaultDescription: 5
+    max_unconfirmed_publishes:
+        type: integer
+        description: |
+          per-connection limit for reliable publishes awaiting broker confirm
+        defaultDescription: 1000
     use_secure_connection:
         type: boolean
         description: whether to use TLS for connections
@@ -0,0 +1,34 @@
+#include <userver/urabbitmq/confirmation_future.hpp>
+
+#include <userver/utils/assert.hpp>
+
+#include <urabbitmq/impl/deferred_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq {
+
+ConfirmationFuture::ConfirmationFuture(
+    std::shared_ptr<impl::DeferredWrapper> wrapper)
+    : wrapper_{std::move(wrapper)} {}
+
+ConfirmationFuture::~ConfirmationFuture() = default;
+
+ConfirmationFuture::ConfirmationFuture(ConfirmationFuture&& other) noexcept =
+    default;
+
+ConfirmationFuture& ConfirmationFuture::operator=(
+    ConfirmationFuture&& other) noexcept = default;
+
+void ConfirmationFuture::Wait(engine::Deadline deadline) {
+  UINVARIANT(wrapper_, "Wait called on a moved-out ConfirmationFuture");
+  wrapper_->Wait(deadline);
+}
+
+bool ConfirmationFuture::IsReady() const noexcept {
+  return wrapper_ && wrapper_->IsReady();
+}
+
+}  // namespace urabbitmq
+
+USERVER_NAMESPACE_END
@@ -26,7 +26,8 @@ class Connection final {
  public:
   Connection(clients::dns::Resolver& resolver, const EndpointInfo& endpoint,
              const AuthSettings& auth_settings, size_t max_in_flight_requests,
-             bool secure, statistics::ConnectionStatistics& stats,
+             size_t max_unconfirmed_publishes, bool secure,
+             statistics::ConnectionStatistics& stats,
              engine::Deadline deadline);
   ~Connection();
 
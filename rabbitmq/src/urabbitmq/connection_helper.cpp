@@ -81,6 +81,15 @@ impl::ResponseAwaiter ConnectionHelper::PublishReliable(
   });
 }
 
+std::shared_ptr<impl::DeferredWrapper> ConnectionHelper::PublishReliableAsync(
+    const ConnectionPtr& connection, const Exchange& exchange,
+    const std::string& routing_key, const std::string& message,
+    MessageType type, engine::Deadline deadline) {
+  tracing::Span span{"reliable_publish_async"};
+  return connection->GetReliableChannel().PublishAsync(exchange, routing_key,
+                                                       message, type, deadline);
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
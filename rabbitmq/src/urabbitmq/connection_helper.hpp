@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include <userver/engine/deadline.hpp>
 #include <userver/urabbitmq/typedefs.hpp>
 #include <userver/utils/flags.hpp>
@@ -57,6 +59,13 @@ class ConnectionHelper final {
       const std::string& routing_key, const std::string& message,
       MessageType type, engine::Deadline deadline);
 
+  [[nodiscard]] static std::shared_ptr<impl::DeferredWrapper>
+  PublishReliableAsync(const ConnectionPtr& connection,
+                       const Exchange& exchange,
+                       const std::string& routing_key,
+                       const std::string& message, MessageType type,
+                       engine::Deadline deadline);
+
  private:
   template <typename Func>
   static impl::ResponseAwaiter WithSpan(const char* name, Func&& fn) {
@@ -1,5 +1,6 @@
 #include "consumer_base_impl.hpp"
 
+#include <algorithm>
 #include <string>
 
 #include <fmt/format.h>
@@ -28,6 +29,9 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
     : dispatcher_{engine::current_task::GetTaskProcessor()},
       queue_name_{settings.queue.GetUnderlying()},
       prefetch_count_{settings.prefetch_count},
+      max_batch_size_{settings.max_batch_size},
+      max_batch_delay_{settings.max_batch_delay},
+      batch_concurrency_{std::max<std::size_t>(settings.batch_concurrency, 1)},
       connection_ptr_{std::move(connection)},
       channel_{connection_ptr_->GetChannel()} {
   // We take ownership of the connection, because if it remains pooled
@@ -37,11 +41,25 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
 
 ConsumerBaseImpl::~ConsumerBaseImpl() { Stop(); }
 
-void ConsumerBaseImpl::Start(DispatchCallback cb) {
+void ConsumerBaseImpl::Start(DispatchCallback cb,
+                             BatchDispatchCallback batch_cb) {
   const auto start_deadline = engine::Deadline::FromDuration(kStartTimeout);
   channel_.SetQos(prefetch_count_, start_deadline);
 
   dispatch_callback_ = std::move(cb);
+  batch_dispatch_callback_ = std::move(batch_cb);
+
+  if (IsBatchMode()) {
+    deliveries_queue_ = DeliveryQueue::Create();
+    deliveries_producer_.emplace(deliveries_queue_->GetProducer());
+    for (std::size_t i = 0; i < batch_concurrency_; ++i) {
+      bts_.Detach(engine::AsyncNoSpan(
+          dispatcher_,
+          [this, consumer = deliveries_queue_->GetConsumer()]() mutable {
+            RunBatchWorker(std::move(consumer));
+          }));
+    }
+  }
 
   LOG_INFO() << "Starting a consumer for '" << queue_name_ << "' queue";
 
@@ -59,7 +77,11 @@ void ConsumerBaseImpl::Start(DispatchCallback cb) {
       [this](const AMQP::Message& message, uint64_t delivery_tag, bool) {
         // We received a message but won't ack it, so it will be requeued
         // at some point
-        if (!stopped_) {
+        if (stopped_) return;
+
+        if (IsBatchMode()) {
+          OnBatchedMessage(message, delivery_tag);
+        } else {
           OnMessage(message, delivery_tag);
         }
       },
@@ -91,6 +113,8 @@ bool ConsumerBaseImpl::IsBroken() const {
   return broken_ || !connection_ptr_.IsUsable();
 }
 
+bool ConsumerBaseImpl::IsBatchMode() const { return max_batch_size_ != 0; }
+
 void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
                                  uint64_t delivery_tag) {
   std::string span_name{fmt::format("consume_{}_{}", queue_name_,
@@ -128,6 +152,116 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
       }));
 }
 
+void ConsumerBaseImpl::OnBatchedMessage(const AMQP::Message& message,
+                                        uint64_t delivery_tag) {
+  {
+    std::lock_guard<std::mutex> lock{unsettled_mutex_};
+    unsettled_.emplace_back(delivery_tag, SettleState::kPending);
+  }
+
+  std::string trace_id = message.headers().get("u-trace-id");
+  Delivery delivery{std::string{message.body(), message.bodySize()},
+                    std::move(trace_id), delivery_tag};
+  // The queue is unbounded, its size is effectively limited by prefetch_count
+  [[maybe_unused]] const bool pushed =
+      deliveries_producer_->PushNoblock(std::move(delivery));
+  UASSERT(pushed);
+}
+
+void ConsumerBaseImpl::RunBatchWorker(DeliveryQueue::Consumer consumer) {
+  std::vector<Delivery> batch;
+  Delivery delivery;
+  while (!engine::current_task::ShouldCancel()) {
+    if (!consumer.Pop(delivery)) break;
+    batch.push_back(std::move(delivery));
+
+    const auto batch_deadline =
+        engine::Deadline::FromDuration(max_batch_delay_);
+    while (batch.size() < max_batch_size_ &&
+           consumer.Pop(delivery, batch_deadline)) {
+      batch.push_back(std::move(delivery));
+    }
+
+    // We are stopping: unacked messages will be requeued by the broker
+    if (engine::current_task::ShouldCancel()) break;
+
+    ProcessBatch(std::move(batch));
+    batch.clear();
+  }
+}
+
+void ConsumerBaseImpl::ProcessBatch(std::vector<Delivery>&& batch) {
+  UASSERT(!batch.empty());
+  // The whole batch is attributed to the trace of its first message
+  auto span = tracing::Span::MakeSpan(
+      fmt::format("consume_batch_{}_{}", queue_name_,
+                  consumer_tag_.value_or("ctag:unknown")),
+      batch.front().trace_id, {});
+  span.AddTag("batch_size", batch.size());
+
+  std::vector<std::string> messages;
+  messages.reserve(batch.size());
+  for (auto& delivery : batch) {
+    messages.push_back(std::move(delivery.message));
+  }
+
+  bool success = false;
+  try {
+    batch_dispatch_callback_(std::move(messages));
+    success = true;
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to process the consumed batch of " << batch.size()
+                << " messages, " << ex.what() << "; would requeue";
+  }
+
+  try {
+    SettleBatch(batch, success);
+  } catch (const std::exception& ex) {
+    LOG_WARNING()
+        << "Failed to " << (success ? "ack" : "requeue")
+        << " the batch, it will be requeued by RabbitMQ at some point";
+  }
+}
+
+void ConsumerBaseImpl::SettleBatch(const std::vector<Delivery>& batch,
+                                   bool success) {
+  if (!success) {
+    // Rejects must reach the broker before any multiple-ack covering them
+    for (const auto& delivery : batch) {
+      channel_.Reject(delivery.delivery_tag, true, {});
+    }
+  }
+
+  std::lock_guard<engine::Mutex> ack_lock{ack_mutex_};
+
+  std::optional<uint64_t> ack_up_to;
+  {
+    std::lock_guard<std::mutex> lock{unsettled_mutex_};
+    for (const auto& delivery : batch) {
+      const auto it = std::lower_bound(
+          unsettled_.begin(), unsettled_.end(), delivery.delivery_tag,
+          [](const auto& entry, uint64_t tag) { return entry.first < tag; });
+      UASSERT(it != unsettled_.end() && it->first == delivery.delivery_tag);
+      it->second = success ? SettleState::kAcked : SettleState::kRejected;
+    }
+
+    while (!unsettled_.empty() &&
+           unsettled_.front().second != SettleState::kPending) {
+      if (unsettled_.front().second == SettleState::kAcked) {
+        ack_up_to = unsettled_.front().first;
+      }
+      unsettled_.pop_front();
+    }
+  }
+
+  if (ack_up_to.has_value()) {
+    channel_.AckMultiple(*ack_up_to, {});
+  }
+  if (success) {
+    channel_.AccountMessagesConsumed(batch.size());
+  }
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
@@ -1,8 +1,15 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include <userver/concurrent/background_task_storage.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <urabbitmq/connection_ptr.hpp>
@@ -26,18 +33,38 @@ class ConsumerBaseImpl final {
   ~ConsumerBaseImpl();
 
   using DispatchCallback = std::function<void(std::string message)>;
+  using BatchDispatchCallback =
+      std::function<void(std::vector<std::string> messages)>;
 
-  void Start(DispatchCallback cb);
+  void Start(DispatchCallback cb, BatchDispatchCallback batch_cb);
 
   bool IsBroken() const;
 
  private:
+  struct Delivery final {
+    std::string message;
+    std::string trace_id;
+    uint64_t delivery_tag{0};
+  };
+  using DeliveryQueue = concurrent::NonFifoMpmcQueue<Delivery>;
+
+  enum class SettleState { kPending, kAcked, kRejected };
+
+  bool IsBatchMode() const;
+
   void OnMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void OnBatchedMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void RunBatchWorker(DeliveryQueue::Consumer consumer);
+  void ProcessBatch(std::vector<Delivery>&& batch);
+  void SettleBatch(const std::vector<Delivery>& batch, bool success);
   void Stop();
 
   engine::TaskProcessor& dispatcher_;
   const std::string queue_name_;
   uint16_t prefetch_count_;
+  const std::size_t max_batch_size_;
+  const std::chrono::milliseconds max_batch_delay_;
+  const std::size_t batch_concurrency_;
 
   ConnectionPtr connection_ptr_;
   impl::AmqpChannel& channel_;
@@ -45,6 +72,22 @@ class ConsumerBaseImpl final {
   std::optional<std::string> consumer_tag_;
 
   DispatchCallback dispatch_callback_;
+  BatchDispatchCallback batch_dispatch_callback_;
+
+  // Batch mode: deliveries are pushed from the ev-thread and popped by
+  // `batch_concurrency_` workers.
+  std::shared_ptr<DeliveryQueue> deliveries_queue_;
+  std::optional<DeliveryQueue::Producer> deliveries_producer_;
+
+  // Batch mode: delivery tags in delivery order, that are not covered by a
+  // multiple-ack yet. basic.ack with multiple=true acks every outstanding
+  // delivery up to the tag, so with concurrent batches we may only ack up to
+  // the first still pending delivery. std::mutex, because deliveries are
+  // appended from the ev-thread.
+  std::mutex unsettled_mutex_;
+  std::deque<std::pair<uint64_t, SettleState>> unsettled_;
+  // Keeps multiple-acks ordered and non-overlapping
+  engine::Mutex ack_mutex_;
 
   std::atomic<bool> stopped_{false};
 
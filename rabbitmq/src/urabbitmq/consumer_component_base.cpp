@@ -16,8 +16,17 @@ ConsumerSettings Parse(const yaml_config::YamlConfig& config,
   ConsumerSettings settings;
   settings.queue = Queue{config["queue"].As<std::string>()};
   settings.prefetch_count = config["prefetch_count"].As<uint16_t>();
+  settings.max_batch_size =
+      config["max_batch_size"].As<std::size_t>(settings.max_batch_size);
+  settings.max_batch_delay =
+      config["max_batch_delay"].As<std::chrono::milliseconds>(
+          settings.max_batch_delay);
+  settings.batch_concurrency =
+      config["batch_concurrency"].As<std::size_t>(settings.batch_concurrency);
 
   UINVARIANT(settings.prefetch_count > 0, "prefetch_count is set to zero");
+  UINVARIANT(settings.batch_concurrency > 0,
+             "batch_concurrency is set to zero");
 
   return settings;
 }
@@ -40,6 +49,11 @@ class ConsumerComponentBase::Impl final : public ConsumerBase {
     parent_->Process(std::move(message));
   }
 
+  void ProcessBatch(std::vector<std::string> messages) override {
+    UASSERT(parent_ != nullptr);
+    parent_->ProcessBatch(std::move(messages));
+  }
+
  private:
   ConsumerComponentBase* parent_{nullptr};
 };
@@ -61,6 +75,12 @@ void ConsumerComponentBase::OnAllComponentsLoaded() { impl_->Start(this); }
 
 void ConsumerComponentBase::OnAllComponentsAreStopping() { impl_->Stop(); }
 
+void ConsumerComponentBase::ProcessBatch(std::vector<std::string> messages) {
+  for (auto& message : messages) {
+    Process(std::move(message));
+  }
+}
+
 yaml_config::Schema ConsumerComponentBase::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
 type: object
@@ -76,6 +96,19 @@ properties:
     prefetch_count:
         type: integer
         description: prefetch_count for the consumer
+    max_batch_size:
+        type: integer
+        description: |
+          enables batch mode if non-zero, maximum amount of messages in a batch
+        defaultDescription: 0
+    max_batch_delay:
+        type: string
+        description: batch mode, how long to wait for a batch to fill up
+        defaultDescription: 10ms
+    batch_concurrency:
+        type: integer
+        description: batch mode, amount of batches processed concurrently
+        defaultDescription: 1
 )");
 }
 
@@ -1,6 +1,8 @@
 #include "amqp_channel.hpp"
 
+#include <chrono>
 #include <optional>
+#include <shared_mutex>
 
 #include <userver/engine/task/task.hpp>
 #include <userver/tracing/span.hpp>
@@ -71,6 +73,44 @@ AMQP::Table CreateHeaders() {
   return headers;
 }
 
+AMQP::Envelope CreateEnvelope(const std::string& message, MessageType type) {
+  AMQP::Envelope envelope{message.data(), message.size()};
+  envelope.setPersistent(type == MessageType::kPersistent);
+  envelope.setHeaders(CreateHeaders());
+
+  return envelope;
+}
+
+// Callbacks are invoked from the ev-thread. AMQP::Reliable fans a multiple-ack
+// out to every message it covers within the same event loop iteration, so a
+// single confirm frame resolves the whole batch of outstanding publishes.
+template <typename OnDone>
+void SetupConfirmCallbacks(AMQP::DeferredPublish& publish,
+                           statistics::ConnectionStatistics& stats,
+                           std::shared_ptr<DeferredWrapper> deferred,
+                           OnDone on_done) {
+  const auto start = std::chrono::steady_clock::now();
+
+  publish
+      .onAck([&stats, deferred, on_done, start] {
+        stats.AccountPublishConfirmed(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start));
+        on_done();
+        deferred->Ok();
+      })
+      .onNack([&stats, deferred, on_done] {
+        stats.AccountPublishFailed();
+        on_done();
+        deferred->Fail("Message was rejected by the broker");
+      })
+      .onError([&stats, deferred, on_done](const char* error) {
+        stats.AccountPublishFailed();
+        on_done();
+        deferred->Fail(error);
+      });
+}
+
 }  // namespace
 
 AmqpChannel::AmqpChannel(AmqpConnection& conn) : conn_{conn} {}
@@ -186,6 +226,13 @@ void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline) {
   channel->ack(delivery_tag);
 }
 
+void AmqpChannel::AckMultiple(uint64_t delivery_tag,
+                              engine::Deadline deadline) {
+  // No way to acknowledge success, no way to handle synchronous errors
+  auto channel = conn_.GetChannel(deadline);
+  channel->ack(delivery_tag, AMQP::multiple);
+}
+
 void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
                          engine::Deadline deadline) {
   // No way to acknowledge success, no way to handle synchronous errors
@@ -229,6 +276,10 @@ void AmqpChannel::AccountMessageConsumed() {
   conn_.GetStatistics().AccountMessageConsumed();
 }
 
+void AmqpChannel::AccountMessagesConsumed(size_t count) {
+  conn_.GetStatistics().AccountMessagesConsumed(count);
+}
+
 AmqpReliableChannel::AmqpReliableChannel(AmqpConnection& conn) : conn_{conn} {}
 
 AmqpReliableChannel::~AmqpReliableChannel() = default;
@@ -238,30 +289,46 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
                                              const std::string& message,
                                              MessageType type,
                                              engine::Deadline deadline) {
-  AMQP::Envelope envelope{message.data(), message.size()};
-  envelope.setPersistent(type == MessageType::kPersistent);
-  envelope.setHeaders(CreateHeaders());
+  const auto envelope = CreateEnvelope(message, type);
 
   auto awaiter = conn_.GetAwaiter(deadline);
 
   {
     auto reliable = conn_.GetReliableChannel(deadline);
 
-    reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
-        .onAck([this, deferred = awaiter.GetWrapper()] {
-          AccountMessagePublished();
-          deferred->Ok();
-        })
-        .onError([deferred = awaiter.GetWrapper()](const char* error) {
-          deferred->Fail(error);
-        });
+    SetupConfirmCallbacks(
+        reliable->publish(exchange.GetUnderlying(), routing_key, envelope),
+        conn_.GetStatistics(), awaiter.GetWrapper(), [] {});
   }
 
   return awaiter;
 }
 
-void AmqpReliableChannel::AccountMessagePublished() {
-  conn_.GetStatistics().AccountMessagePublished();
+std::shared_ptr<DeferredWrapper> AmqpReliableChannel::PublishAsync(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::string& message, MessageType type, engine::Deadline deadline) {
+  const auto envelope = CreateEnvelope(message, type);
+
+  auto& window = conn_.GetUnconfirmedWindow();
+  if (!window.try_lock_shared_until(deadline)) {
+    throw std::runtime_error{
+        "Failed to publish within specified deadline: too many unconfirmed "
+        "messages"};
+  }
+  std::shared_lock<engine::Semaphore> window_lock{window, std::adopt_lock};
+
+  auto deferred = DeferredWrapper::Create();
+  {
+    auto reliable = conn_.GetReliableChannel(deadline);
+
+    // The slot is handed over to the callbacks from now on
+    SetupConfirmCallbacks(
+        reliable->publish(exchange.GetUnderlying(), routing_key, envelope),
+        conn_.GetStatistics(), deferred, [&window] { window.unlock_shared(); });
+    window_lock.release();
+  }
+
+  return deferred;
 }
 
 }  // namespace urabbitmq::impl
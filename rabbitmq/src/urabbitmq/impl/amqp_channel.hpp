@@ -27,6 +27,7 @@ namespace urabbitmq::impl {
 
 class AmqpConnection;
 class AmqpReliableChannel;
+class DeferredWrapper;
 
 class AmqpChannel final {
  public:
@@ -59,6 +60,9 @@ class AmqpChannel final {
 
   void Ack(uint64_t delivery_tag, engine::Deadline deadline);
 
+  // Acks all the outstanding deliveries up to and including `delivery_tag`
+  void AckMultiple(uint64_t delivery_tag, engine::Deadline deadline);
+
   void Reject(uint64_t delivery_tag, bool requeue, engine::Deadline deadline);
 
   void SetQos(uint16_t prefetch_count, engine::Deadline deadline);
@@ -74,6 +78,7 @@ class AmqpChannel final {
 
  private:
   void AccountMessageConsumed();
+  void AccountMessagesConsumed(size_t count);
 
   friend class urabbitmq::ConsumerBaseImpl;
 
@@ -90,9 +95,16 @@ class AmqpReliableChannel final {
                           const std::string& message, MessageType type,
                           engine::Deadline deadline);
 
- private:
-  void AccountMessagePublished();
+  // Doesn't wait for the broker confirm, the returned wrapper is signaled
+  // once the message is acked/nacked. Blocks until there is a free slot in the
+  // connection unconfirmed publishes window.
+  std::shared_ptr<DeferredWrapper> PublishAsync(const Exchange& exchange,
+                                                const std::string& routing_key,
+                                                const std::string& message,
+                                                MessageType type,
+                                                engine::Deadline deadline);
 
+ private:
   AmqpConnection& conn_;
 };
 
@@ -39,8 +39,10 @@ ConnectionLock::ConnectionLock(ConnectionLock&& other) noexcept
 
 AmqpConnection::AmqpConnection(AmqpConnectionHandler& handler,
                                size_t max_in_flight_requests,
+                               size_t max_unconfirmed_publishes,
                                engine::Deadline deadline)
     : handler_{handler},
+      unconfirmed_window_{max_unconfirmed_publishes},
       conn_{CreateConnection(handler_, deadline)},
       channel_{CreateChannel(deadline)},
       reliable_channel_{CreateChannel(deadline)},
@@ -94,6 +96,10 @@ ResponseAwaiter AmqpConnection::GetAwaiter(engine::Deadline deadline) {
   return ResponseAwaiter{std::move(lock)};
 }
 
+engine::Semaphore& AmqpConnection::GetUnconfirmedWindow() {
+  return unconfirmed_window_;
+}
+
 ConnectionLock AmqpConnection::Lock(engine::Deadline deadline) {
   return {mutex_, deadline};
 }
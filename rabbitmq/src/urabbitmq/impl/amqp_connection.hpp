@@ -50,7 +50,7 @@ class LockedChannelProxy final {
 class AmqpConnection final {
  public:
   AmqpConnection(AmqpConnectionHandler& handler, size_t max_in_flight_requests,
-                 engine::Deadline deadline);
+                 size_t max_unconfirmed_publishes, engine::Deadline deadline);
   ~AmqpConnection();
 
   AMQP::Connection& GetNative();
@@ -67,6 +67,11 @@ class AmqpConnection final {
 
   ResponseAwaiter GetAwaiter(engine::Deadline deadline);
 
+  // Limits the amount of reliable publishes awaiting confirmation from the
+  // broker. Locked on publish and unlocked from the ev-thread once the broker
+  // acks/nacks the message.
+  engine::Semaphore& GetUnconfirmedWindow();
+
  private:
   friend class AmqpConnectionLocker;
   [[nodiscard]] ConnectionLock Lock(engine::Deadline deadline);
@@ -89,6 +94,10 @@ class AmqpConnection final {
 
   AmqpConnectionHandler& handler_;
 
+  // Declared before the channels: pending confirm callbacks reference it and
+  // could be released during channels destruction.
+  engine::Semaphore unconfirmed_window_;
+
   AMQP::Connection conn_;
 
   AMQP::Channel channel_;
@@ -27,6 +27,8 @@ class DeferredWrapper : public std::enable_shared_from_this<DeferredWrapper> {
 
   void Wait(engine::Deadline deadline);
 
+  bool IsReady() const noexcept;
+
   void Wrap(AMQP::Deferred& deferred);
 
   void WrapGet(AMQP::DeferredGet& deferred, std::string& message);
@@ -6,6 +6,16 @@ USERVER_NAMESPACE_BEGIN
 
 namespace urabbitmq::statistics {
 
+namespace {
+
+constexpr double kConfirmLatencyBoundsMs[] = {1,  2,   5,   10,   20,   50,
+                                              100, 200, 500, 1000, 2000, 5000};
+
+}  // namespace
+
+ConnectionStatistics::ConnectionStatistics()
+    : publish_confirm_latency_ms_{kConfirmLatencyBoundsMs} {}
+
 void ConnectionStatistics::AccountConnectionCreated() {
   ++connections_created_;
 }
@@ -22,10 +32,22 @@ void ConnectionStatistics::AccountRead(size_t bytes_read) {
   bytes_read_ += bytes_read;
 }
 
-void ConnectionStatistics::AccountMessagePublished() { ++messages_published_; }
-
 void ConnectionStatistics::AccountMessageConsumed() { ++messages_consumed_; }
 
+void ConnectionStatistics::AccountMessagesConsumed(size_t count) {
+  messages_consumed_ += count;
+}
+
+void ConnectionStatistics::AccountPublishConfirmed(
+    std::chrono::milliseconds latency) {
+  ++messages_published_;
+  publish_confirm_latency_ms_.Account(latency.count());
+}
+
+void ConnectionStatistics::AccountPublishFailed() {
+  ++messages_publish_failed_;
+}
+
 ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   Frozen result{};
   result.connections_created = connections_created_.Load();
@@ -34,10 +56,16 @@ ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   result.bytes_read = bytes_read_.Load();
   result.messages_published = messages_published_.Load();
   result.messages_consumed = messages_consumed_.Load();
+  result.messages_publish_failed = messages_publish_failed_.Load();
+  result.publish_confirm_latency_ms.Add(
+      publish_confirm_latency_ms_.GetView());
 
   return result;
 }
 
+ConnectionStatistics::Frozen::Frozen()
+    : publish_confirm_latency_ms{kConfirmLatencyBoundsMs} {}
+
 ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
     const Frozen& other) {
   connections_created += other.connections_created;
@@ -46,6 +74,8 @@ ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
   bytes_read += other.bytes_read;
   messages_published += other.messages_published;
   messages_consumed += other.messages_consumed;
+  messages_publish_failed += other.messages_publish_failed;
+  publish_confirm_latency_ms.Add(other.publish_confirm_latency_ms.GetView());
 
   return *this;
 }
@@ -58,6 +88,8 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["bytes_read"] = value.bytes_read;
   writer["messages_published"] = value.messages_published;
   writer["messages_consumed"] = value.messages_consumed;
+  writer["messages_publish_failed"] = value.messages_publish_failed;
+  writer["publish_confirm_latency_ms"] = value.publish_confirm_latency_ms;
 }
 
 }  // namespace urabbitmq::statistics
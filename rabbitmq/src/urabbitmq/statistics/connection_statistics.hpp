@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/histogram_aggregator.hpp>
 #include <userver/utils/statistics/relaxed_counter.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
@@ -11,14 +14,19 @@ namespace urabbitmq::statistics {
 
 class ConnectionStatistics final {
  public:
+  ConnectionStatistics();
+
   void AccountConnectionCreated();
   void AccountConnectionClosed() noexcept;
 
   void AccountWrite(size_t bytes_written);
   void AccountRead(size_t bytes_read);
 
-  void AccountMessagePublished();
   void AccountMessageConsumed();
+  void AccountMessagesConsumed(size_t count);
+
+  void AccountPublishConfirmed(std::chrono::milliseconds latency);
+  void AccountPublishFailed();
 
   struct Frozen final {
     Frozen& operator+=(const Frozen& other);
@@ -31,6 +39,11 @@ class ConnectionStatistics final {
 
     size_t messages_published{0};
     size_t messages_consumed{0};
+
+    size_t messages_publish_failed{0};
+    utils::statistics::HistogramAggregator publish_confirm_latency_ms;
+
+    Frozen();
   };
   Frozen Get() const;
 
@@ -43,6 +56,9 @@ class ConnectionStatistics final {
 
   utils::statistics::RelaxedCounter<size_t> messages_published_{0};
   utils::statistics::RelaxedCounter<size_t> messages_consumed_{0};
+
+  utils::statistics::RelaxedCounter<size_t> messages_publish_failed_{0};
+  utils::statistics::Histogram publish_confirm_latency_ms_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
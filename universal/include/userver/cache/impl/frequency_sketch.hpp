@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Approximate access frequency of keys for the TinyLFU admission.
+///
+/// The first access of a key within a sample period is only recorded in
+/// the doorkeeper Bloom filter, the following ones go to a count-min sketch
+/// of counters saturating at 15. After a sample period of 10 accesses per
+/// cache entry all the counters are halved and the doorkeeper is cleared, so
+/// that the estimate follows the changes in the popularity of keys.
+template <typename T, typename Hash = std::hash<T>>
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity, const Hash& hash = Hash())
+      : hash_(hash) {
+    Resize(capacity);
+  }
+
+  /// Records an access of the key
+  void RecordAccess(const T& key) {
+    const auto hash = Mix(hash_(key));
+    if (!DoorkeeperTestAndSet(hash)) IncrementCounters(hash);
+
+    if (++additions_ >= sample_size_) Age();
+  }
+
+  /// Estimates the number of accesses of the key in the recent sample periods
+  std::uint32_t GetFrequency(const T& key) const {
+    const auto hash = Mix(hash_(key));
+    std::uint8_t frequency = kMaxFrequency;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      frequency = std::min(frequency, counters_[Index(hash, row)]);
+    }
+    return frequency + (DoorkeeperHas(hash) ? 1 : 0);
+  }
+
+  /// Resizes the sketch for the cache of `capacity` entries, forgetting all
+  /// the recorded accesses
+  void Resize(std::size_t capacity) {
+    capacity = std::max(capacity, std::size_t{1});
+
+    // About a counter per cache entry in each of the rows
+    const auto blocks = RoundUpToPowerOfTwo(
+        std::max(capacity * kDepth / kBlockSize, std::size_t{1}));
+    block_mask_ = blocks - 1;
+    counters_.assign(blocks * kBlockSize, 0);
+    sample_size_ = capacity * 10;
+    additions_ = 0;
+    // About a byte per cache entry. The keys of a sample period are mostly
+    // the popular ones, which fit; if the accesses are mostly distinct the
+    // doorkeeper fills up and the sketch counts every access as if there was
+    // no doorkeeper.
+    const auto doorkeeper_bits =
+        RoundUpToPowerOfTwo(std::max(capacity * 8, kDoorkeeperWordBits));
+    doorkeeper_mask_ = doorkeeper_bits - 1;
+    doorkeeper_.assign(doorkeeper_bits / kDoorkeeperWordBits, 0);
+  }
+
+  /// Forgets all the recorded accesses
+  void Clear() noexcept {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    additions_ = 0;
+    std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+  }
+
+ private:
+  static constexpr std::size_t kDepth = 4;
+  static constexpr std::size_t kBlockSize = 64;
+  static constexpr std::size_t kRowSize = kBlockSize / kDepth;
+  static constexpr std::uint8_t kMaxFrequency = 15;
+  static constexpr std::size_t kDoorkeeperWordBits = 64;
+  static constexpr std::size_t kDoorkeeperHashes = 2;
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t value) noexcept {
+    std::size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+  }
+
+  static std::uint64_t Mix(std::uint64_t value) noexcept {
+    // MurmurHash3 finalizer
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+  // All the counters of a key are in a single cache line block: the lower
+  // bits of the hash select the block, the higher ones the counters in it
+  std::size_t Index(std::uint64_t hash, std::size_t row) const noexcept {
+    const auto block = hash & block_mask_;
+    const auto offset = (hash >> (32 + row * 8)) & (kRowSize - 1);
+    return block * kBlockSize + row * kRowSize + offset;
+  }
+
+  // The doorkeeper is a Bloom filter of single bits. Its bits are taken from
+  // a rehash, so that they do not correlate with the counters of the key.
+  template <typename Func>
+  void ForEachDoorkeeperBit(std::uint64_t hash, Func func) const {
+    hash = Mix(hash);
+    for (std::size_t i = 0; i < kDoorkeeperHashes; ++i) {
+      const auto bit = (hash >> (i * 32)) & doorkeeper_mask_;
+      func(bit / kDoorkeeperWordBits,
+           std::uint64_t{1} << (bit % kDoorkeeperWordBits));
+    }
+  }
+
+  bool DoorkeeperHas(std::uint64_t hash) const noexcept {
+    bool has = true;
+    ForEachDoorkeeperBit(hash, [&](std::size_t word, std::uint64_t mask) {
+      has = has && (doorkeeper_[word] & mask);
+    });
+    return has;
+  }
+
+  // Returns whether the key was not in the doorkeeper before the call
+  bool DoorkeeperTestAndSet(std::uint64_t hash) noexcept {
+    bool added = false;
+    ForEachDoorkeeperBit(hash, [&](std::size_t word, std::uint64_t mask) {
+      if (!(doorkeeper_[word] & mask)) {
+        doorkeeper_[word] |= mask;
+        added = true;
+      }
+    });
+    return added;
+  }
+
+  // Conservative update: only the smallest counters are incremented, which
+  // reduces the overestimation of rare keys
+  void IncrementCounters(std::uint64_t hash) noexcept {
+    std::uint8_t min_frequency = kMaxFrequency;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      min_frequency = std::min(min_frequency, counters_[Index(hash, row)]);
+    }
+    if (min_frequency == kMaxFrequency) return;
+
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      auto& counter = counters_[Index(hash, row)];
+      if (counter == min_frequency) ++counter;
+    }
+  }
+
+  void Age() noexcept {
+    auto* const counters = counters_.data();
+    for (std::size_t i = 0; i < counters_.size(); ++i) counters[i] >>= 1;
+    additions_ /= 2;
+    std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+  }
+
+  Hash hash_;
+  std::vector<std::uint8_t> counters_;
+  std::size_t block_mask_{0};
+  std::size_t sample_size_{0};
+  std::size_t additions_{0};
+  std::vector<std::uint64_t> doorkeeper_;
+  std::size_t doorkeeper_mask_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
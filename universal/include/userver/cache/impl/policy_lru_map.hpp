@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <variant>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/cache/policy.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// cache::LruMap with the eviction policy selected at runtime
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class PolicyLruMap final {
+ public:
+  PolicyLruMap(std::size_t max_size, CachePolicy policy,
+               const Hash& hash = Hash(), const Equal& equal = Equal())
+      : map_(Create(max_size, policy, hash, equal)) {}
+
+  bool Put(const T& key, U value) {
+    return std::visit(
+        [&](auto& map) { return map.Put(key, std::move(value)); }, map_);
+  }
+
+  void Erase(const T& key) {
+    std::visit([&](auto& map) { map.Erase(key); }, map_);
+  }
+
+  U* Get(const T& key) {
+    return std::visit([&](auto& map) { return map.Get(key); }, map_);
+  }
+
+  U GetOr(const T& key, const U& default_value) {
+    return std::visit([&](auto& map) { return map.GetOr(key, default_value); },
+                      map_);
+  }
+
+  void SetMaxSize(std::size_t new_max_size) {
+    std::visit([&](auto& map) { map.SetMaxSize(new_max_size); }, map_);
+  }
+
+  void Clear() {
+    std::visit([](auto& map) { map.Clear(); }, map_);
+  }
+
+  template <typename Function>
+  void VisitAll(Function&& func) const {
+    std::visit([&](const auto& map) { map.VisitAll(func); }, map_);
+  }
+
+  std::size_t GetSize() const {
+    return std::visit([](const auto& map) { return map.GetSize(); }, map_);
+  }
+
+ private:
+  using Variant =
+      std::variant<LruMap<T, U, Hash, Equal, CachePolicy::kLRU>,
+                   LruMap<T, U, Hash, Equal, CachePolicy::kSLRU>,
+                   LruMap<T, U, Hash, Equal, CachePolicy::kWTinyLFU>>;
+
+  static Variant Create(std::size_t max_size, CachePolicy policy,
+                        const Hash& hash, const Equal& equal) {
+    switch (policy) {
+      case CachePolicy::kLRU:
+        return Variant{std::in_place_index<0>, max_size, hash, equal};
+      case CachePolicy::kSLRU:
+        return Variant{std::in_place_index<1>, max_size, hash, equal};
+      case CachePolicy::kWTinyLFU:
+        return Variant{std::in_place_index<2>, max_size, hash, equal};
+      case CachePolicy::kClock:
+        break;
+    }
+    UINVARIANT(false, "Unexpected cache policy");
+  }
+
+  Variant map_;
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -38,6 +39,10 @@ class SlruBase final {
 
   explicit SlruBase(std::size_t probation_size, std::size_t protected_size,
                     const Hash& hash = Hash(), const Equal& equal = Equal());
+
+  /// Gives 80% of `max_size` to the protected part
+  explicit SlruBase(std::size_t max_size, const Hash& hash,
+                    const Equal& equal);
   ~SlruBase() = default;
 
   SlruBase(SlruBase&& other) noexcept = default;
@@ -65,6 +70,8 @@ class SlruBase final {
   void SetMaxSize(std::size_t new_probation_size,
                   std::size_t new_protected_size);
 
+  void SetMaxSize(std::size_t new_max_size);
+
   void Clear() noexcept;
 
   template <typename Function>
@@ -81,6 +88,14 @@ class SlruBase final {
   NodeType ExtractNode(const T& key) noexcept;
 
  private:
+  static std::size_t GetProtectedSize(std::size_t max_size) noexcept {
+    return std::max(max_size / 5 * 4, std::size_t{1});
+  }
+
+  static std::size_t GetProbationSize(std::size_t max_size) noexcept {
+    return std::max(max_size - GetProtectedSize(max_size), std::size_t{1});
+  }
+
   cache::impl::LruBase<T, U, Hash, Equal> probation_part_;
   cache::impl::LruBase<T, U, Hash, Equal> protected_part_;
 };
@@ -92,6 +107,12 @@ SlruBase<T, U, Hash, Equal>::SlruBase(std::size_t probation_size,
     : probation_part_(probation_size, hash, equal),
       protected_part_(protected_size, hash, equal) {}
 
+template <typename T, typename U, typename Hash, typename Equal>
+SlruBase<T, U, Hash, Equal>::SlruBase(std::size_t max_size, const Hash& hash,
+                                      const Equal& equal)
+    : SlruBase(GetProbationSize(max_size), GetProtectedSize(max_size), hash,
+               equal) {}
+
 template <typename T, typename U, typename Hash, typename Equal>
 bool SlruBase<T, U, Hash, Equal>::Put(const T& key, U value) {
   auto* const value_ptr = protected_part_.Get(key);
@@ -177,6 +198,11 @@ void SlruBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_probation_size,
   protected_part_.SetMaxSize(new_protected_size);
 }
 
+template <typename T, typename U, typename Hash, typename Equal>
+void SlruBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  SetMaxSize(GetProbationSize(new_max_size), GetProtectedSize(new_max_size));
+}
+
 template <typename T, typename U, typename Hash, typename Equal>
 void SlruBase<T, U, Hash, Equal>::Clear() noexcept {
   probation_part_.Clear();
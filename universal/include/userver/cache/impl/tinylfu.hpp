@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Window TinyLFU, see https://arxiv.org/abs/1512.00727
+///
+/// New entries are put into the window LRU of 1% of the capacity. An entry
+/// evicted from the window is admitted into the main SLRU only if it is
+/// accessed more frequently than the entry the SLRU would evict for it.
+/// The window lets bursts of new keys get hits before they have gained
+/// frequency, the admission keeps one-hit wonders from evicting hot entries.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class TinyLfuBase final {
+ public:
+  using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+  explicit TinyLfuBase(std::size_t max_size, const Hash& hash = Hash(),
+                       const Equal& equal = Equal());
+
+  TinyLfuBase(TinyLfuBase&& other) noexcept = default;
+  TinyLfuBase& operator=(TinyLfuBase&& other) noexcept = default;
+
+  TinyLfuBase(const TinyLfuBase&) = delete;
+  TinyLfuBase& operator=(const TinyLfuBase&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T& key, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  const T* GetLeastUsedKey() const;
+
+  U* GetLeastUsedValue();
+
+  NodeType ExtractLeastUsedNode();
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  std::size_t GetSize() const;
+
+  std::size_t GetCapacity() const;
+
+ private:
+  static std::size_t GetWindowSize(std::size_t max_size) noexcept {
+    return std::max(max_size / 100, std::size_t{1});
+  }
+
+  static std::size_t GetMainSize(std::size_t max_size) noexcept {
+    return std::max(max_size - GetWindowSize(max_size), std::size_t{1});
+  }
+
+  static std::size_t GetProtectedSize(std::size_t main_size) noexcept {
+    return std::max(main_size / 5 * 4, std::size_t{1});
+  }
+
+  // Makes room in the window for a new entry, returns the evicted one
+  NodeType ExtractWindowVictim();
+
+  // Moves the candidate evicted from the window to the main part if it is
+  // accessed more frequently than the main part victim, returns the entry
+  // evicted from the cache
+  NodeType Admit(NodeType&& candidate);
+
+  FrequencySketch<T, Hash> sketch_;
+  LruBase<T, U, Hash, Equal> window_;
+  SlruBase<T, U, Hash, Equal> main_;
+  std::size_t main_size_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfuBase<T, U, Hash, Equal>::TinyLfuBase(std::size_t max_size,
+                                            const Hash& hash,
+                                            const Equal& equal)
+    : sketch_(max_size, hash),
+      window_(GetWindowSize(max_size), hash, equal),
+      // The main part is limited by main_size_ as a whole, the probation part
+      // may take all of it
+      main_(GetMainSize(max_size), GetProtectedSize(GetMainSize(max_size)),
+            hash, equal),
+      main_size_(GetMainSize(max_size)) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool TinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+  sketch_.RecordAccess(key);
+
+  auto* existing = window_.Get(key);
+  if (!existing) existing = main_.Get(key);
+  if (existing) {
+    *existing = std::move(value);
+    return false;
+  }
+
+  auto evicted = Admit(ExtractWindowVictim());
+  if (evicted) {
+    // Saves an allocation
+    evicted->SetKey(key);
+    evicted->SetValue(std::move(value));
+    window_.InsertNode(std::move(evicted));
+  } else {
+    window_.Put(key, std::move(value));
+  }
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* TinyLfuBase<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+  sketch_.RecordAccess(key);
+
+  auto* existing = window_.Get(key);
+  if (!existing) existing = main_.Get(key);
+  if (existing) return existing;
+
+  Admit(ExtractWindowVictim());
+  return window_.Emplace(key, std::forward<Args>(args)...);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+  window_.Erase(key);
+  main_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+  sketch_.RecordAccess(key);
+
+  auto* value = window_.Get(key);
+  if (value) return value;
+  return main_.Get(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const T* TinyLfuBase<T, U, Hash, Equal>::GetLeastUsedKey() const {
+  const auto* key = main_.GetLeastUsedKey();
+  if (key) return key;
+  return window_.GetLeastUsedKey();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::GetLeastUsedValue() {
+  auto* value = main_.GetLeastUsedValue();
+  if (value) return value;
+  return window_.GetLeastUsedValue();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::NodeType
+TinyLfuBase<T, U, Hash, Equal>::ExtractLeastUsedNode() {
+  auto node = main_.ExtractLeastUsedNode();
+  if (node) return node;
+  return window_.ExtractLeastUsedNode();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  main_size_ = GetMainSize(new_max_size);
+  window_.SetMaxSize(GetWindowSize(new_max_size));
+  main_.SetMaxSize(main_size_, GetProtectedSize(main_size_));
+  while (main_.GetSize() > main_size_ && main_.ExtractLeastUsedNode()) {
+  }
+  sketch_.Resize(new_max_size);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+  window_.Clear();
+  main_.Clear();
+  sketch_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  window_.VisitAll(std::forward<Function>(func));
+  main_.VisitAll(std::forward<Function>(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+  window_.VisitAll(std::forward<Function>(func));
+  main_.VisitAll(std::forward<Function>(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+  return window_.GetSize() + main_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+  return window_.GetCapacity() + main_size_;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::NodeType
+TinyLfuBase<T, U, Hash, Equal>::ExtractWindowVictim() {
+  if (window_.GetSize() < window_.GetCapacity()) return NodeType();
+  return window_.ExtractLeastUsedNode();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::NodeType
+TinyLfuBase<T, U, Hash, Equal>::Admit(NodeType&& candidate) {
+  if (!candidate) return NodeType();
+
+  if (main_.GetSize() < main_size_) {
+    main_.InsertNode(std::move(candidate));
+    return NodeType();
+  }
+
+  const auto* victim = main_.GetLeastUsedKey();
+  if (victim && sketch_.GetFrequency(candidate->GetKey()) >
+                    sketch_.GetFrequency(*victim)) {
+    auto evicted = main_.ExtractLeastUsedNode();
+    main_.InsertNode(std::move(candidate));
+    return evicted;
+  }
+  return std::move(candidate);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
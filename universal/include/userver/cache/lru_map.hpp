@@ -3,7 +3,12 @@
 /// @file userver/cache/lru_map.hpp
 /// @brief @copybrief cache::LruMap
 
+#include <type_traits>
+
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+#include <userver/cache/policy.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,8 +19,12 @@ namespace cache {
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
 /// thread safety
+///
+/// The eviction policy is LRU by default, see cache::CachePolicy for the other
+/// ones.
 template <typename T, typename U, typename Hash = std::hash<T>,
-          typename Equal = std::equal_to<T>>
+          typename Equal = std::equal_to<T>,
+          CachePolicy Policy = CachePolicy::kLRU>
 class LruMap final {
  public:
   explicit LruMap(size_t max_size, const Hash& hash = Hash(),
@@ -85,7 +94,16 @@ class LruMap final {
   std::size_t GetCapacity() const { return impl_.GetCapacity(); }
 
  private:
-  impl::LruBase<T, U, Hash, Equal> impl_;
+  static_assert(Policy != CachePolicy::kClock,
+                "CLOCK is implemented only by the concurrent caches");
+
+  using Impl = std::conditional_t<
+      Policy == CachePolicy::kLRU, impl::LruBase<T, U, Hash, Equal>,
+      std::conditional_t<Policy == CachePolicy::kSLRU,
+                         impl::SlruBase<T, U, Hash, Equal>,
+                         impl::TinyLfuBase<T, U, Hash, Equal>>>;
+
+  Impl impl_;
 };
 
 }  // namespace cache
@@ -0,0 +1,35 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Eviction policy of cache::LruMap and of the caches built on it
+enum class CachePolicy {
+  /// Evicts the least recently used entry
+  kLRU,
+
+  /// Segmented LRU: entries that are hit again move from the probation
+  /// segment to the protected one and are evicted only after all the
+  /// probation entries
+  kSLRU,
+
+  /// Window TinyLFU: new entries go through a small LRU window, then compete
+  /// with the SLRU victim for a place in the main part by the estimated access
+  /// frequency. Keeps the hit rate under scans and one-hit wonders at the cost
+  /// of a frequency sketch of about 5 to 10 bytes per entry.
+  kWTinyLFU,
+
+  /// CLOCK approximation of LRU: lookups only set the access bit of the
+  /// entry, the eviction skips and clears the set bits. Lookups are lock-free,
+  /// so the hot keys do not serialize the readers. Supported only by the
+  /// concurrent caches, e.g. cache::NWayLRU, not by cache::LruMap.
+  kClock,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
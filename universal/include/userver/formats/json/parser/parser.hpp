@@ -6,6 +6,7 @@
 #include <userver/formats/json/parser/map_parser.hpp>
 #include <userver/formats/json/parser/number_parser.hpp>
 #include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/skip_parser.hpp>
 #include <userver/formats/json/parser/string_parser.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +26,9 @@ class ParserState final {
 
   void PopMe(BaseParser& parser);
 
+  /// Returns true if all the pushed parsers have finished
+  bool IsEmpty() const noexcept;
+
   [[noreturn]] void ThrowError(const std::string& err_msg);
 
  private:
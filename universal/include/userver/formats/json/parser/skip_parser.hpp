@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+
+#include <userver/formats/json/parser/base_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+/// @brief Parser that accepts a value of any type and drops it
+///
+/// Object parsers may push it on unknown keys to ignore their values.
+class SkipParser final : public BaseParser {
+ public:
+  void Reset() { level_ = 0; }
+
+  SkipParser& GetParser() { return *this; }
+
+ protected:
+  void Null() override { MaybePopSelf(); }
+  void Bool(bool) override { MaybePopSelf(); }
+  void Int64(int64_t) override { MaybePopSelf(); }
+  void Uint64(uint64_t) override { MaybePopSelf(); }
+  void Double(double) override { MaybePopSelf(); }
+  void String(std::string_view) override { MaybePopSelf(); }
+
+  void StartObject() override { ++level_; }
+  void Key(std::string_view) override {}
+  void EndObject() override { EndLevel(); }
+
+  void StartArray() override { ++level_; }
+  void EndArray() override { EndLevel(); }
+
+  std::string GetPathItem() const override { return {}; }
+
+  std::string Expected() const override { return "value"; }
+
+ private:
+  void EndLevel() {
+    --level_;
+    MaybePopSelf();
+  }
+
+  void MaybePopSelf() {
+    if (level_ == 0) parser_state_->PopMe(*this);
+  }
+
+  std::size_t level_{0};
+};
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <userver/cache/lru_map.hpp>
 #include <userver/cache/lru_set.hpp>
 
+#include <cache/zipf_trace.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -51,4 +54,38 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+// Replays a Zipfian trace, the hit rate is reported in the `hit_rate` counter
+template <cache::CachePolicy Policy>
+void LruMapZipf(benchmark::State& state) {
+  constexpr std::size_t kKeysCount = 100'000;
+  constexpr std::size_t kTraceLength = 200'000;
+  const auto trace = cache::bench::MakeZipfTrace(kKeysCount, kTraceLength,
+                                                 state.range(1) / 100.0);
+
+  cache::LruMap<unsigned, unsigned, std::hash<unsigned>,
+                std::equal_to<unsigned>, Policy>
+      map(state.range(0));
+  std::size_t hits = 0;
+  std::size_t accesses = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto key : trace) {
+      if (map.Get(key)) {
+        ++hits;
+      } else {
+        map.Put(key, key);
+      }
+    }
+    accesses += trace.size();
+  }
+
+  state.SetItemsProcessed(accesses);
+  state.counters["hit_rate"] = static_cast<double>(hits) / accesses;
+}
+BENCHMARK_TEMPLATE(LruMapZipf, cache::CachePolicy::kLRU)
+    ->ArgsProduct({{1'000, 10'000}, {70, 90, 110}});
+BENCHMARK_TEMPLATE(LruMapZipf, cache::CachePolicy::kSLRU)
+    ->ArgsProduct({{1'000, 10'000}, {70, 90, 110}});
+BENCHMARK_TEMPLATE(LruMapZipf, cache::CachePolicy::kWTinyLFU)
+    ->ArgsProduct({{1'000, 10'000}, {70, 90, 110}});
+
 USERVER_NAMESPACE_END
@@ -1,6 +1,11 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 #include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+
+#include <cache/zipf_trace.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -81,4 +86,35 @@ void SlruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(SlruPutOverflow);
 
+// Compares the SLRU with and without the TinyLFU admission on a Zipfian trace
+// with periodic scans of never repeating keys, that flush a plain SLRU
+template <typename Cache>
+void ZipfWithScans(benchmark::State& state) {
+  constexpr std::size_t kKeysCount = 100'000;
+  constexpr std::size_t kScanLength = 5'000;
+  auto trace = cache::bench::MakeZipfTrace(kKeysCount, 100'000, 0.9);
+  std::vector<unsigned> scan(kScanLength);
+  for (std::size_t i = 0; i < kScanLength; ++i) scan[i] = kKeysCount + i;
+  trace.insert(trace.begin() + trace.size() / 2, scan.begin(), scan.end());
+
+  Cache cache(kElementsCount, std::hash<unsigned>{}, std::equal_to<unsigned>{});
+  std::size_t hits = 0;
+  std::size_t accesses = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto key : trace) {
+      if (cache.Get(key)) {
+        ++hits;
+      } else {
+        cache.Put(key, key);
+      }
+    }
+    accesses += trace.size();
+  }
+
+  state.SetItemsProcessed(accesses);
+  state.counters["hit_rate"] = static_cast<double>(hits) / accesses;
+}
+BENCHMARK_TEMPLATE(ZipfWithScans, Slru);
+BENCHMARK_TEMPLATE(ZipfWithScans, cache::impl::TinyLfuBase<unsigned, unsigned>);
+
 USERVER_NAMESPACE_END
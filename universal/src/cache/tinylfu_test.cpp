@@ -0,0 +1,134 @@
+#include <userver/cache/impl/tinylfu.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TinyLfu = cache::impl::TinyLfuBase<std::size_t, std::size_t>;
+
+}  // namespace
+
+TEST(FrequencySketch, Frequency) {
+  cache::impl::FrequencySketch<std::size_t> sketch(100);
+
+  for (std::size_t i = 0; i < 5; ++i) sketch.RecordAccess(1);
+  sketch.RecordAccess(2);
+
+  EXPECT_EQ(sketch.GetFrequency(1), 5);
+  EXPECT_EQ(sketch.GetFrequency(2), 1);
+  EXPECT_EQ(sketch.GetFrequency(3), 0);
+
+  sketch.Clear();
+  EXPECT_EQ(sketch.GetFrequency(1), 0);
+}
+
+TEST(FrequencySketch, Aging) {
+  constexpr std::size_t kCapacity = 10;
+  cache::impl::FrequencySketch<std::size_t> sketch(kCapacity);
+
+  for (std::size_t i = 0; i < 9; ++i) sketch.RecordAccess(1);
+  EXPECT_EQ(sketch.GetFrequency(1), 9);
+
+  // Fills up the sample period, all the counters are halved
+  for (std::size_t i = 0; i < kCapacity * 10 - 9; ++i) {
+    sketch.RecordAccess(1'000 + i);
+  }
+  EXPECT_LE(sketch.GetFrequency(1), 5);
+}
+
+TEST(TinyLfuBase, PutGet) {
+  TinyLfu cache(10);
+  EXPECT_TRUE(cache.Put(1, 10));
+  EXPECT_FALSE(cache.Put(1, 11));
+  EXPECT_EQ(*cache.Get(1), 11);
+  EXPECT_EQ(cache.Get(2), nullptr);
+
+  EXPECT_EQ(*cache.Emplace(2, std::size_t{20}), 20);
+  EXPECT_EQ(*cache.Emplace(2, std::size_t{21}), 20);
+  EXPECT_EQ(cache.GetSize(), 2);
+
+  cache.Erase(1);
+  EXPECT_EQ(cache.Get(1), nullptr);
+  EXPECT_EQ(cache.GetSize(), 1);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(TinyLfuBase, Capacity) {
+  constexpr std::size_t kMaxSize = 100;
+  TinyLfu cache(kMaxSize);
+  EXPECT_EQ(cache.GetCapacity(), kMaxSize);
+
+  for (std::size_t i = 0; i < 1000; ++i) {
+    cache.Put(i, i);
+    EXPECT_LE(cache.GetSize(), kMaxSize);
+  }
+  EXPECT_EQ(cache.GetSize(), kMaxSize);
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](const std::size_t& key, const std::size_t& value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, kMaxSize);
+}
+
+TEST(TinyLfuBase, ScanResistance) {
+  constexpr std::size_t kMaxSize = 100;
+  constexpr std::size_t kHotKeys = 50;
+  TinyLfu cache(kMaxSize);
+
+  for (std::size_t round = 0; round < 5; ++round) {
+    for (std::size_t i = 0; i < kHotKeys; ++i) cache.Put(i, i);
+  }
+
+  // Each of the scanned keys is seen once and may not evict the hot ones
+  for (std::size_t i = kHotKeys; i < kHotKeys + 10 * kMaxSize; ++i) {
+    cache.Put(i, i);
+  }
+
+  // The frequencies are approximate, but a plain LRU would have no hits at all
+  std::size_t cache_hit = 0;
+  for (std::size_t i = 0; i < kHotKeys; ++i) {
+    if (cache.Get(i)) cache_hit++;
+  }
+  EXPECT_LE(kHotKeys * 9 / 10, cache_hit);
+}
+
+TEST(TinyLfuBase, SetMaxSize) {
+  TinyLfu cache(100);
+  for (std::size_t i = 0; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 100);
+
+  cache.SetMaxSize(10);
+  EXPECT_EQ(cache.GetCapacity(), 10);
+  EXPECT_LE(cache.GetSize(), 10);
+
+  cache.SetMaxSize(200);
+  for (std::size_t i = 0; i < 200; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 200);
+}
+
+TEST(TinyLfuBase, LruMap) {
+  cache::LruMap<int, int, std::hash<int>, std::equal_to<int>,
+                cache::CachePolicy::kWTinyLFU>
+      map(2);
+  map.Put(1, 10);
+  map.Put(2, 20);
+  EXPECT_EQ(map.GetOr(1, -1), 10);
+  EXPECT_EQ(map.GetOr(2, -1), 20);
+
+  map.Put(3, 30);
+  EXPECT_EQ(map.GetSize(), 2);
+  EXPECT_NE(map.GetLeastUsed(), nullptr);
+}
+
+USERVER_NAMESPACE_END
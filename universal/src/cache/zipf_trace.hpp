@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::bench {
+
+/// Generates `length` keys from `[0, keys_count)`, the key of rank `i` is
+/// accessed with the probability proportional to `1 / (i + 1) ^ skew`.
+/// The keys are shuffled, so that the rank does not match the key value.
+inline std::vector<unsigned> MakeZipfTrace(std::size_t keys_count,
+                                           std::size_t length, double skew) {
+  std::vector<double> cdf(keys_count);
+  double sum = 0;
+  for (std::size_t i = 0; i < keys_count; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+    cdf[i] = sum;
+  }
+
+  std::vector<unsigned> keys(keys_count);
+  for (std::size_t i = 0; i < keys_count; ++i) {
+    keys[i] = static_cast<unsigned>(i);
+  }
+
+  // Fixed seed for the results to be comparable between runs
+  std::mt19937 gen(42);
+  std::shuffle(keys.begin(), keys.end(), gen);
+
+  std::uniform_real_distribution<double> distribution(0, sum);
+  std::vector<unsigned> trace;
+  trace.reserve(length);
+  for (std::size_t i = 0; i < length; ++i) {
+    const auto it =
+        std::lower_bound(cdf.begin(), cdf.end(), distribution(gen));
+    const auto rank =
+        std::min(static_cast<std::size_t>(it - cdf.begin()), keys_count - 1);
+    trace.push_back(keys[rank]);
+  }
+  return trace;
+}
+
+}  // namespace cache::bench
+
+USERVER_NAMESPACE_END
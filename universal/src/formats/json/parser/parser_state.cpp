@@ -121,6 +121,8 @@ void ParserState::ProcessInput(std::string_view sw) {
   }
 }
 
+bool ParserState::IsEmpty() const noexcept { return impl_->stack.empty(); }
+
 BaseParser& ParserState::GetTopParser() const {
   UASSERT(!impl_->stack.empty());
   return *impl_->stack.back().parser;
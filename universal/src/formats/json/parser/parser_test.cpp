@@ -359,6 +359,24 @@ TEST(JsonStringParser, JsonValueBad) {
   }
 }
 
+TEST(JsonStringParser, Skip) {
+  std::string inputs[] = {
+      R"({"a": [1, {"b": null}, []], "c": "d", "e": {}})",
+      R"([true, 1.5, -1])",
+      R"("string")",
+      R"(18446744073709551615)",
+  };
+  for (const auto& input : inputs) {
+    fjp::SkipParser parser;
+    parser.Reset();
+
+    fjp::ParserState state;
+    state.PushParser(parser);
+    EXPECT_NO_THROW(state.ProcessInput(input)) << "input: " << input;
+    EXPECT_TRUE(state.IsEmpty());
+  }
+}
+
 TEST(JsonStringParser, BomSymbol) {
   std::string input =
       "{\r\n\"track_id\": \"0000436301831\",\r\n\"service\": "